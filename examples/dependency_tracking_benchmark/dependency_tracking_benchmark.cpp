@@ -0,0 +1,123 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+// Measures the runtime overhead of dependency analysis for buffer accesses,
+// which grows with the number of operations that are tracked per buffer.
+//
+// Each round submits a number of kernels that access a buffer, followed by
+// one kernel that accesses it in the opposite way:
+// * readers: kernels that read the entire buffer, then one writer;
+// * partial writers: kernels that each write a separate page of the buffer,
+//   then one reader of the entire buffer.
+// The kernels are trivial, so the submission time is dominated by the
+// runtime.
+//
+// Usage: dependency_tracking_benchmark [max kernels per round]
+//                                      [number of rounds]
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <SYCL/sycl.hpp>
+
+enum class pattern { readers, partial_writers };
+
+const char *get_name(pattern p) {
+  switch(p) {
+  case pattern::readers:
+    return "readers";
+  case pattern::partial_writers:
+    return "partial writers";
+  }
+  return "";
+}
+
+constexpr std::size_t page_size = 1024;
+
+void submit_round(sycl::queue &q, sycl::buffer<int> &buff, pattern p,
+                  std::size_t num_kernels) {
+  for(std::size_t i = 0; i < num_kernels; ++i) {
+    q.submit([&](sycl::handler &cgh) {
+      if(p == pattern::readers) {
+        sycl::accessor<int, 1, sycl::access_mode::read> acc{buff, cgh};
+        cgh.single_task([=]() { (void)acc[0]; });
+      } else {
+        sycl::accessor<int, 1, sycl::access_mode::write> acc{
+            buff, cgh, sycl::range<1>{page_size}, sycl::id<1>{i * page_size}};
+        cgh.single_task([=]() { acc[0] = 1; });
+      }
+    });
+  }
+
+  q.submit([&](sycl::handler &cgh) {
+    if(p == pattern::readers) {
+      sycl::accessor<int, 1, sycl::access_mode::read_write> acc{buff, cgh};
+      cgh.single_task([=]() { acc[0] += 1; });
+    } else {
+      sycl::accessor<int, 1, sycl::access_mode::read> acc{buff, cgh};
+      cgh.single_task([=]() { (void)acc[0]; });
+    }
+  });
+}
+
+int main(int argc, char **argv) {
+  std::size_t max_num_kernels = 256;
+  int num_rounds = 10;
+  if(argc > 1)
+    max_num_kernels = std::max<std::size_t>(1, std::stoull(argv[1]));
+  if(argc > 2)
+    num_rounds = std::max(1, std::stoi(argv[2]));
+
+  sycl::queue q;
+  std::cout << "Running on " << q.get_device().get_info<sycl::info::device::name>()
+            << ", " << num_rounds << " rounds" << std::endl;
+
+  std::cout << std::setw(16) << "pattern" << std::setw(10) << "kernels"
+            << std::setw(20) << "submit [us/cg]" << std::setw(20)
+            << "total [us/cg]" << std::endl;
+
+  for(pattern p : {pattern::readers, pattern::partial_writers}) {
+    for(std::size_t num_kernels = 8; num_kernels <= max_num_kernels;
+        num_kernels *= 2) {
+      sycl::buffer<int> buff{
+          sycl::range<1>{num_kernels * page_size},
+          sycl::property_list{
+              sycl::property::buffer::AdaptiveCpp_page_size<1>{
+                  sycl::range<1>{page_size}}}};
+
+      // Warmup, which also JIT-compiles the kernels if needed
+      submit_round(q, buff, p, num_kernels);
+      q.wait();
+
+      auto start = std::chrono::high_resolution_clock::now();
+      for(int round = 0; round < num_rounds; ++round)
+        submit_round(q, buff, p, num_kernels);
+      auto submitted = std::chrono::high_resolution_clock::now();
+      q.wait();
+      auto stop = std::chrono::high_resolution_clock::now();
+
+      double num_command_groups =
+          static_cast<double>(num_rounds) * (num_kernels + 1);
+      double submit_time =
+          std::chrono::duration<double, std::micro>(submitted - start).count();
+      double total_time =
+          std::chrono::duration<double, std::micro>(stop - start).count();
+      std::cout << std::setw(16) << get_name(p) << std::setw(10)
+                << num_kernels << std::setw(20)
+                << submit_time / num_command_groups << std::setw(20)
+                << total_time / num_command_groups << std::endl;
+    }
+  }
+}
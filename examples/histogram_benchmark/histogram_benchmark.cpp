@@ -0,0 +1,121 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+// Measures the throughput of the histogram primitive of the AdaptiveCpp
+// algorithms library for uniform and skewed input distributions.
+//
+// Usage: histogram_benchmark [problem size] [number of iterations]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <SYCL/sycl.hpp>
+#include "hipSYCL/algorithms/algorithm.hpp"
+
+namespace algorithms = hipsycl::algorithms;
+
+enum class distribution { uniform, skewed, single_bin };
+
+const char *get_name(distribution d) {
+  switch(d) {
+  case distribution::uniform:
+    return "uniform";
+  case distribution::skewed:
+    return "skewed";
+  case distribution::single_bin:
+    return "single bin";
+  }
+  return "";
+}
+
+// Generates values in [0, 1)
+std::vector<float> generate_input(distribution d, std::size_t n) {
+  std::vector<float> values(n);
+  std::mt19937 gen{42};
+  std::uniform_real_distribution<float> uniform{0.0f, 1.0f};
+  // Most values end up in the lowest bins, which maximizes contention
+  // on the corresponding counters.
+  std::exponential_distribution<float> exponential{20.0f};
+
+  for(std::size_t i = 0; i < n; ++i) {
+    if(d == distribution::uniform)
+      values[i] = uniform(gen);
+    else if(d == distribution::skewed)
+      values[i] = std::fmod(exponential(gen), 1.0f);
+    else
+      values[i] = 0.5f;
+  }
+  return values;
+}
+
+int main(int argc, char **argv) {
+  std::size_t problem_size = 1 << 26;
+  int num_iterations = 10;
+  if(argc > 1)
+    problem_size = std::stoull(argv[1]);
+  if(argc > 2)
+    num_iterations = std::max(1, std::stoi(argv[2]));
+
+  sycl::queue q{sycl::property_list{sycl::property::queue::in_order{}}};
+  std::cout << "Running on " << q.get_device().get_info<sycl::info::device::name>()
+            << ", problem size " << problem_size << std::endl;
+
+  algorithms::util::allocation_cache cache{
+      algorithms::util::allocation_type::device};
+
+  float *data = sycl::malloc_device<float>(problem_size, q);
+  const std::size_t max_num_bins = 1 << 16;
+  uint32_t *counts = sycl::malloc_device<uint32_t>(max_num_bins, q);
+
+  std::cout << std::setw(12) << "distribution" << std::setw(10) << "bins"
+            << std::setw(16) << "time [ms]" << std::setw(20)
+            << "throughput [GE/s]" << std::endl;
+
+  for(distribution d : {distribution::uniform, distribution::skewed,
+                        distribution::single_bin}) {
+    std::vector<float> input = generate_input(d, problem_size);
+    q.copy(input.data(), data, problem_size).wait();
+
+    for(std::size_t num_bins = 16; num_bins <= max_num_bins; num_bins *= 16) {
+      double best_time = 0.0;
+      for(int i = 0; i <= num_iterations; ++i) {
+        algorithms::util::allocation_group scratch{
+            &cache, q.get_device().AdaptiveCpp_device_id()};
+
+        auto start = std::chrono::high_resolution_clock::now();
+        algorithms::histogram_even(q, scratch, data, data + problem_size,
+                                   counts, num_bins, 0.0f, 1.0f);
+        q.wait();
+        auto stop = std::chrono::high_resolution_clock::now();
+
+        double time =
+            std::chrono::duration<double, std::milli>(stop - start).count();
+        // The first iteration is warmup
+        if(i == 1 || (i > 1 && time < best_time))
+          best_time = time;
+      }
+      std::cout << std::setw(12) << get_name(d) << std::setw(10) << num_bins
+                << std::setw(16) << best_time << std::setw(20)
+                << problem_size / best_time * 1.e-6 << std::endl;
+    }
+  }
+
+  sycl::free(data, q);
+  sycl::free(counts, q);
+}
@@ -11,6 +11,7 @@
 #ifndef HIPSYCL_ALGORITHMS_ALGORITHM_HPP
 #define HIPSYCL_ALGORITHMS_ALGORITHM_HPP
 
+#include <algorithm>
 #include <functional>
 #include <iterator>
 #include <limits>
@@ -27,6 +28,8 @@
 #include "hipSYCL/algorithms/util/memory_streaming.hpp"
 #include "hipSYCL/algorithms/sort/bitonic_sort.hpp"
 #include "hipSYCL/algorithms/merge/merge.hpp"
+#include "hipSYCL/algorithms/histogram/histogram.hpp"
+#include "hipSYCL/algorithms/numeric.hpp"
 
 namespace hipsycl::algorithms {
 
@@ -455,6 +458,353 @@ sycl::event none_of(sycl::queue &q,
   });
 }
 
+namespace detail {
+
+template<class Index>
+struct minmax_index {
+  Index min;
+  Index max;
+};
+
+// Computes the smallest index i in [0, problem_size) for which
+// predicate(i) is true, or not_found if there is no such index.
+// not_found must not be smaller than problem_size.
+template <class Index, class Predicate>
+sycl::event first_index_of(sycl::queue &q,
+                           util::allocation_group &scratch_allocations,
+                           std::size_t problem_size, Index *out,
+                           Index not_found, Predicate predicate) {
+  auto kernel = [=](sycl::id<1> idx, auto& reducer) {
+    if(predicate(idx[0]))
+      reducer.combine(static_cast<Index>(idx[0]));
+  };
+  return transform_reduce_impl(q, scratch_allocations, out, not_found,
+                               problem_size, kernel, sycl::minimum<Index>{});
+}
+
+}
+
+// The following reductions store the position of the result relative to
+// first in out. If first==last, returns an event that is complete,
+// even if preceding enqueued operations are not yet complete, and *out
+// remains untouched.
+template <class ForwardIt, class Compare>
+sycl::event
+min_element(sycl::queue &q, util::allocation_group &scratch_allocations,
+            ForwardIt first, ForwardIt last,
+            typename std::iterator_traits<ForwardIt>::difference_type *out,
+            Compare comp) {
+  using difference_type =
+      typename std::iterator_traits<ForwardIt>::difference_type;
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  auto kernel = [=](sycl::id<1> idx, auto& reducer) {
+    reducer.combine(static_cast<difference_type>(idx[0]));
+  };
+  // Among equivalent elements, the smallest position wins
+  auto op = [=](difference_type a, difference_type b) {
+    auto it_a = first;
+    auto it_b = first;
+    std::advance(it_a, a);
+    std::advance(it_b, b);
+    if(comp(*it_b, *it_a))
+      return b;
+    if(comp(*it_a, *it_b))
+      return a;
+    return a < b ? a : b;
+  };
+  return detail::transform_reduce_impl(q, scratch_allocations, out,
+                                       difference_type{0}, problem_size,
+                                       kernel, op);
+}
+
+template <class ForwardIt>
+sycl::event
+min_element(sycl::queue &q, util::allocation_group &scratch_allocations,
+            ForwardIt first, ForwardIt last,
+            typename std::iterator_traits<ForwardIt>::difference_type *out) {
+  return min_element(q, scratch_allocations, first, last, out, std::less<>{});
+}
+
+template <class ForwardIt, class Compare>
+sycl::event
+max_element(sycl::queue &q, util::allocation_group &scratch_allocations,
+            ForwardIt first, ForwardIt last,
+            typename std::iterator_traits<ForwardIt>::difference_type *out,
+            Compare comp) {
+  using difference_type =
+      typename std::iterator_traits<ForwardIt>::difference_type;
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  auto kernel = [=](sycl::id<1> idx, auto& reducer) {
+    reducer.combine(static_cast<difference_type>(idx[0]));
+  };
+  // Among equivalent elements, the smallest position wins
+  auto op = [=](difference_type a, difference_type b) {
+    auto it_a = first;
+    auto it_b = first;
+    std::advance(it_a, a);
+    std::advance(it_b, b);
+    if(comp(*it_a, *it_b))
+      return b;
+    if(comp(*it_b, *it_a))
+      return a;
+    return a < b ? a : b;
+  };
+  return detail::transform_reduce_impl(q, scratch_allocations, out,
+                                       difference_type{0}, problem_size,
+                                       kernel, op);
+}
+
+template <class ForwardIt>
+sycl::event
+max_element(sycl::queue &q, util::allocation_group &scratch_allocations,
+            ForwardIt first, ForwardIt last,
+            typename std::iterator_traits<ForwardIt>::difference_type *out) {
+  return max_element(q, scratch_allocations, first, last, out, std::less<>{});
+}
+
+// Like std::minmax_element, finds the first smallest and the last
+// largest element.
+template <class ForwardIt, class Compare>
+sycl::event minmax_element(
+    sycl::queue &q, util::allocation_group &scratch_allocations,
+    ForwardIt first, ForwardIt last,
+    detail::minmax_index<
+        typename std::iterator_traits<ForwardIt>::difference_type> *out,
+    Compare comp) {
+  using difference_type =
+      typename std::iterator_traits<ForwardIt>::difference_type;
+  using index_type = detail::minmax_index<difference_type>;
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  auto kernel = [=](sycl::id<1> idx, auto& reducer) {
+    difference_type i = static_cast<difference_type>(idx[0]);
+    reducer.combine(index_type{i, i});
+  };
+  auto op = [=](index_type a, index_type b) {
+    auto min_a = first;
+    auto min_b = first;
+    auto max_a = first;
+    auto max_b = first;
+    std::advance(min_a, a.min);
+    std::advance(min_b, b.min);
+    std::advance(max_a, a.max);
+    std::advance(max_b, b.max);
+
+    index_type result;
+    if(comp(*min_b, *min_a))
+      result.min = b.min;
+    else if(comp(*min_a, *min_b))
+      result.min = a.min;
+    else
+      result.min = a.min < b.min ? a.min : b.min;
+
+    if(comp(*max_a, *max_b))
+      result.max = b.max;
+    else if(comp(*max_b, *max_a))
+      result.max = a.max;
+    else
+      result.max = a.max > b.max ? a.max : b.max;
+    return result;
+  };
+  return detail::transform_reduce_impl(q, scratch_allocations, out,
+                                       index_type{0, 0}, problem_size, kernel,
+                                       op);
+}
+
+template <class ForwardIt>
+sycl::event minmax_element(
+    sycl::queue &q, util::allocation_group &scratch_allocations,
+    ForwardIt first, ForwardIt last,
+    detail::minmax_index<
+        typename std::iterator_traits<ForwardIt>::difference_type> *out) {
+  return minmax_element(q, scratch_allocations, first, last, out,
+                        std::less<>{});
+}
+
+template <class ForwardIt, class UnaryPredicate>
+sycl::event
+count_if(sycl::queue &q, util::allocation_group &scratch_allocations,
+         ForwardIt first, ForwardIt last,
+         typename std::iterator_traits<ForwardIt>::difference_type *out,
+         UnaryPredicate p) {
+  using difference_type =
+      typename std::iterator_traits<ForwardIt>::difference_type;
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  auto kernel = [=](sycl::id<1> idx, auto& reducer) {
+    auto it = first;
+    std::advance(it, idx[0]);
+    if(p(*it))
+      reducer.combine(difference_type{1});
+  };
+  return detail::transform_reduce_impl(q, scratch_allocations, out,
+                                       difference_type{0}, problem_size,
+                                       kernel, sycl::plus<difference_type>{});
+}
+
+template <class ForwardIt, class T>
+sycl::event
+count(sycl::queue &q, util::allocation_group &scratch_allocations,
+      ForwardIt first, ForwardIt last,
+      typename std::iterator_traits<ForwardIt>::difference_type *out,
+      const T &value) {
+  return count_if(q, scratch_allocations, first, last, out,
+                  [=](const auto &x) { return x == value; });
+}
+
+// Stores the position of the first mismatch relative to first1 in out, or
+// std::distance(first1, last1) if the ranges are equal.
+template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+sycl::event
+mismatch(sycl::queue &q, util::allocation_group &scratch_allocations,
+         ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2,
+         typename std::iterator_traits<ForwardIt1>::difference_type *out,
+         BinaryPredicate p) {
+  using difference_type =
+      typename std::iterator_traits<ForwardIt1>::difference_type;
+  std::size_t problem_size = std::distance(first1, last1);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  return detail::first_index_of(
+      q, scratch_allocations, problem_size, out,
+      static_cast<difference_type>(problem_size), [=](std::size_t i) {
+        auto it1 = first1;
+        auto it2 = first2;
+        std::advance(it1, i);
+        std::advance(it2, i);
+        return !p(*it1, *it2);
+      });
+}
+
+template <class ForwardIt1, class ForwardIt2>
+sycl::event
+mismatch(sycl::queue &q, util::allocation_group &scratch_allocations,
+         ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2,
+         typename std::iterator_traits<ForwardIt1>::difference_type *out) {
+  return mismatch(q, scratch_allocations, first1, last1, first2, out,
+                  std::equal_to<>{});
+}
+
+// Stores the position of the first element of the first pair of equal
+// adjacent elements relative to first in out, or std::distance(first, last)
+// if there is no such pair.
+template <class ForwardIt, class BinaryPredicate>
+sycl::event
+adjacent_find(sycl::queue &q, util::allocation_group &scratch_allocations,
+              ForwardIt first, ForwardIt last,
+              typename std::iterator_traits<ForwardIt>::difference_type *out,
+              BinaryPredicate p) {
+  using difference_type =
+      typename std::iterator_traits<ForwardIt>::difference_type;
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+  if(problem_size == 1)
+    return q.single_task([=]() { *out = 1; });
+
+  return detail::first_index_of(
+      q, scratch_allocations, problem_size - 1, out,
+      static_cast<difference_type>(problem_size), [=](std::size_t i) {
+        auto it = first;
+        std::advance(it, i);
+        auto next = it;
+        ++next;
+        return static_cast<bool>(p(*it, *next));
+      });
+}
+
+template <class ForwardIt>
+sycl::event
+adjacent_find(sycl::queue &q, util::allocation_group &scratch_allocations,
+              ForwardIt first, ForwardIt last,
+              typename std::iterator_traits<ForwardIt>::difference_type *out) {
+  return adjacent_find(q, scratch_allocations, first, last, out,
+                       std::equal_to<>{});
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+sycl::event equal(sycl::queue &q, ForwardIt1 first1, ForwardIt1 last1,
+                  ForwardIt2 first2, detail::early_exit_flag_t *out,
+                  BinaryPredicate p) {
+  std::size_t problem_size = std::distance(first1, last1);
+  if(problem_size == 0)
+    return sycl::event{};
+  auto evt = detail::early_exit_for_each(q, problem_size, out,
+                                         [=](sycl::id<1> idx) -> bool {
+                                           auto it1 = first1;
+                                           auto it2 = first2;
+                                           std::advance(it1, idx[0]);
+                                           std::advance(it2, idx[0]);
+                                           return !p(*it1, *it2);
+                                         });
+  return q.single_task(evt, [=](){
+    *out = static_cast<detail::early_exit_flag_t>(!(*out));
+  });
+}
+
+template <class ForwardIt1, class ForwardIt2>
+sycl::event equal(sycl::queue &q, ForwardIt1 first1, ForwardIt1 last1,
+                  ForwardIt2 first2, detail::early_exit_flag_t *out) {
+  return equal(q, first1, last1, first2, out, std::equal_to<>{});
+}
+
+template <class ForwardIt1, class ForwardIt2, class Compare>
+sycl::event lexicographical_compare(
+    sycl::queue &q, util::allocation_group &scratch_allocations,
+    ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2, ForwardIt2 last2,
+    detail::early_exit_flag_t *out, Compare comp) {
+  std::size_t size1 = std::distance(first1, last1);
+  std::size_t size2 = std::distance(first2, last2);
+  std::size_t problem_size = std::min(size1, size2);
+  if(problem_size == 0)
+    return q.single_task([=]() {
+      *out = static_cast<detail::early_exit_flag_t>(size1 < size2);
+    });
+
+  auto* first_difference = scratch_allocations.obtain<std::size_t>(1);
+  auto evt = detail::first_index_of(
+      q, scratch_allocations, problem_size, first_difference, problem_size,
+      [=](std::size_t i) {
+        auto it1 = first1;
+        auto it2 = first2;
+        std::advance(it1, i);
+        std::advance(it2, i);
+        return comp(*it1, *it2) || comp(*it2, *it1);
+      });
+  return q.single_task(evt, [=]() {
+    std::size_t i = *first_difference;
+    if(i == problem_size) {
+      *out = static_cast<detail::early_exit_flag_t>(size1 < size2);
+    } else {
+      auto it1 = first1;
+      auto it2 = first2;
+      std::advance(it1, i);
+      std::advance(it2, i);
+      *out = static_cast<detail::early_exit_flag_t>(comp(*it1, *it2));
+    }
+  });
+}
+
+template <class ForwardIt1, class ForwardIt2>
+sycl::event lexicographical_compare(
+    sycl::queue &q, util::allocation_group &scratch_allocations,
+    ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2, ForwardIt2 last2,
+    detail::early_exit_flag_t *out) {
+  return lexicographical_compare(q, scratch_allocations, first1, last1, first2,
+                                 last2, out, std::less<>{});
+}
+
 template <class RandomIt, class Compare>
 sycl::event sort(sycl::queue &q, RandomIt first, RandomIt last,
                  Compare comp = std::less<>{}) {
@@ -494,6 +844,43 @@ sycl::event merge(sycl::queue& q,
         q, scratch_allocations, first1, last1, first2, last2, d_first, comp);
 }
 
+/// Counts the elements of [first, last) that fall into each bin of bins.
+/// bins maps elements to bin indices in [0, bins.get_num_bins()), or
+/// to bins.get_num_bins() for elements that should not be counted.
+/// histogram must provide storage for bins.get_num_bins() counts.
+template <class ForwardIt, class Count, class BinMapper>
+sycl::event histogram(sycl::queue &q,
+                      util::allocation_group &scratch_allocations,
+                      ForwardIt first, ForwardIt last, Count *histogram,
+                      BinMapper bins) {
+  return binning::histogram(q, scratch_allocations, first,
+                            std::distance(first, last), bins, histogram);
+}
+
+/// Histogram with num_bins bins of equal width in [lower, upper).
+template <class ForwardIt, class Count, class T>
+sycl::event histogram_even(sycl::queue &q,
+                           util::allocation_group &scratch_allocations,
+                           ForwardIt first, ForwardIt last, Count *histogram,
+                           std::size_t num_bins, T lower, T upper) {
+  return binning::histogram(q, scratch_allocations, first,
+                            std::distance(first, last),
+                            binning::even_bins<T>{num_bins, lower, upper},
+                            histogram);
+}
+
+/// Histogram with num_bins bins [boundaries[i], boundaries[i+1]), where
+/// boundaries contains num_bins+1 ascending values.
+template <class ForwardIt, class Count, class BoundaryIt>
+sycl::event histogram_range(sycl::queue &q,
+                            util::allocation_group &scratch_allocations,
+                            ForwardIt first, ForwardIt last, Count *histogram,
+                            std::size_t num_bins, BoundaryIt boundaries) {
+  return binning::histogram(
+      q, scratch_allocations, first, std::distance(first, last),
+      binning::range_bins<BoundaryIt>{num_bins, boundaries}, histogram);
+}
+
 }
 
 #endif
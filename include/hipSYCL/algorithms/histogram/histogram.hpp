@@ -0,0 +1,276 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef ACPP_ALGORITHMS_HISTOGRAM_HPP
+#define ACPP_ALGORITHMS_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/sycl/libkernel/atomic_builtins.hpp"
+#include "hipSYCL/sycl/libkernel/nd_item.hpp"
+#include "hipSYCL/sycl/libkernel/group_functions.hpp"
+#include "hipSYCL/algorithms/binary_search/index_search.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+
+namespace hipsycl::algorithms::binning {
+
+namespace detail {
+
+/// Computes floor(a * b / c) for a < c without overflowing 64 bits.
+inline uint64_t mul_div_bounded(uint64_t a, uint64_t b, uint64_t c) noexcept {
+  uint64_t product;
+  if(!__builtin_mul_overflow(a, b, &product))
+    return product / c;
+
+  // Double-and-add over the bits of b, maintaining a * (bits processed so
+  // far) = q * c + r with r < c.
+  uint64_t q = 0;
+  uint64_t r = 0;
+  auto add = [&](uint64_t v) {
+    // r + v might not be representable; since r, v < c, at most one
+    // multiple of c needs to be carried.
+    if(r >= c - v) {
+      r -= c - v;
+      ++q;
+    } else {
+      r += v;
+    }
+  };
+  for(int bit = 63; bit >= 0; --bit) {
+    q <<= 1;
+    add(r);
+    if((b >> bit) & 1)
+      add(a);
+  }
+  return q;
+}
+
+}
+
+// Bin mappers provide get_num_bins() and map values to a bin index
+// in [0, get_num_bins()). Values that do not belong to any bin are mapped
+// to get_num_bins().
+
+/// num_bins bins of equal width that cover [lower, upper).
+template<class T>
+class even_bins {
+public:
+  even_bins(std::size_t num_bins, T lower, T upper)
+      : _num_bins{num_bins}, _lower{lower}, _upper{upper} {
+    if constexpr(!std::is_integral_v<T>)
+      _scale = static_cast<double>(num_bins) /
+               (static_cast<double>(upper) - static_cast<double>(lower));
+  }
+
+  std::size_t get_num_bins() const noexcept { return _num_bins; }
+
+  template<class U>
+  std::size_t operator()(const U& x) const noexcept {
+    if(!(x >= _lower) || !(x < _upper))
+      return _num_bins;
+
+    std::size_t bin;
+    if constexpr(std::is_integral_v<T>) {
+      // Differences are computed modulo 2^64, which is correct for
+      // signed values since x >= lower.
+      uint64_t offset =
+          static_cast<uint64_t>(x) - static_cast<uint64_t>(_lower);
+      uint64_t width =
+          static_cast<uint64_t>(_upper) - static_cast<uint64_t>(_lower);
+      bin = static_cast<std::size_t>(
+          detail::mul_div_bounded(offset, _num_bins, width));
+    } else {
+      bin = static_cast<std::size_t>(
+          (static_cast<double>(x) - static_cast<double>(_lower)) * _scale);
+    }
+    // Guard against rounding at the upper end
+    return bin < _num_bins ? bin : _num_bins - 1;
+  }
+private:
+  std::size_t _num_bins;
+  T _lower;
+  T _upper;
+  double _scale = 0.0;
+};
+
+/// num_bins bins [boundaries[i], boundaries[i+1]), where boundaries
+/// contains num_bins+1 ascending values.
+template<class BoundaryIt>
+class range_bins {
+public:
+  range_bins(std::size_t num_bins, BoundaryIt boundaries)
+      : _num_bins{num_bins}, _boundaries{boundaries} {}
+
+  std::size_t get_num_bins() const noexcept { return _num_bins; }
+
+  template<class U>
+  std::size_t operator()(const U& x) const noexcept {
+    auto load = [this](std::size_t i) {
+      auto it = _boundaries;
+      std::advance(it, i);
+      return *it;
+    };
+    if(_num_bins == 0 || x < load(0) || !(x < load(_num_bins)))
+      return _num_bins;
+
+    std::size_t upper = binary_searching::index_upper_bound(
+        std::size_t{0}, _num_bins + 1, x, load,
+        [](const auto &a, const auto &b) { return a < b; });
+    return upper - 1;
+  }
+private:
+  std::size_t _num_bins;
+  BoundaryIt _boundaries;
+};
+
+/// Counts for each bin of bins the number of elements in [0, problem_size)
+/// mapped to it, and stores the counts in histogram.
+///
+/// On host devices, each thread counts a contiguous chunk of the input
+/// into private bins, which are then merged. On other devices, each work
+/// group accumulates its counts in local memory before committing them
+/// to the global histogram, unless the bins do not fit into local memory.
+template <class Count, class ForwardIt, class BinMapper>
+sycl::event histogram(sycl::queue &q,
+                      util::allocation_group &scratch_allocations,
+                      ForwardIt first, std::size_t problem_size,
+                      BinMapper bins, Count *histogram,
+                      std::size_t local_size = 256) {
+  static_assert(std::is_integral_v<Count>,
+                "Histogram counts must be of integral type");
+
+  const std::size_t num_bins = bins.get_num_bins();
+  if(num_bins == 0)
+    return sycl::event{};
+
+  auto get_bin = [=](std::size_t i) {
+    auto it = first;
+    std::advance(it, i);
+    return bins(*it);
+  };
+
+  auto zero_histogram = [&]() {
+    return q.parallel_for(sycl::range<1>{num_bins},
+                          [=](sycl::id<1> idx) { histogram[idx[0]] = Count{}; });
+  };
+
+  if(problem_size == 0)
+    return zero_histogram();
+
+  const std::size_t num_compute_units = std::max(
+      std::size_t{1},
+      static_cast<std::size_t>(
+          q.get_device().get_info<sycl::info::device::max_compute_units>()));
+
+  if(q.get_device().is_host()) {
+    // Chunks should be large enough to amortize clearing and merging
+    // their private bins.
+    const std::size_t min_chunk_size = std::max(std::size_t{4096}, num_bins);
+    const std::size_t num_chunks =
+        std::max(std::size_t{1},
+                 std::min(num_compute_units, problem_size / min_chunk_size));
+    const std::size_t chunk_size = (problem_size + num_chunks - 1) / num_chunks;
+    // Pad private bins to separate cache lines
+    constexpr std::size_t counts_per_cache_line =
+        std::max(std::size_t{1}, 64 / sizeof(Count));
+    const std::size_t private_stride =
+        (num_bins + counts_per_cache_line - 1) / counts_per_cache_line *
+        counts_per_cache_line;
+
+    Count *private_bins =
+        scratch_allocations.obtain<Count>(num_chunks * private_stride);
+
+    q.parallel_for(sycl::range<1>{num_chunks}, [=](sycl::id<1> idx) {
+      Count *chunk_bins = private_bins + idx[0] * private_stride;
+      for(std::size_t b = 0; b < num_bins; ++b)
+        chunk_bins[b] = Count{};
+
+      const std::size_t begin = idx[0] * chunk_size;
+      const std::size_t end = std::min(problem_size, begin + chunk_size);
+      for(std::size_t i = begin; i < end; ++i) {
+        std::size_t b = get_bin(i);
+        if(b < num_bins)
+          ++chunk_bins[b];
+      }
+    });
+
+    return q.parallel_for(sycl::range<1>{num_bins}, [=](sycl::id<1> idx) {
+      Count sum = Count{};
+      for(std::size_t c = 0; c < num_chunks; ++c)
+        sum += private_bins[c * private_stride + idx[0]];
+      histogram[idx[0]] = sum;
+    });
+  }
+
+  zero_histogram();
+
+  // Leave some local memory for the backend and other allocations
+  const std::size_t available_local_mem =
+      q.get_device().get_info<sycl::info::device::local_mem_size>() / 2;
+
+  if(num_bins * sizeof(Count) > available_local_mem) {
+    return q.parallel_for(sycl::range<1>{problem_size}, [=](sycl::id<1> idx) {
+      std::size_t b = get_bin(idx[0]);
+      if(b < num_bins)
+        sycl::detail::__acpp_atomic_fetch_add<
+            sycl::access::address_space::global_space>(
+            histogram + b, Count{1}, sycl::memory_order_relaxed,
+            sycl::memory_scope_device);
+    });
+  }
+
+  const std::size_t num_groups =
+      std::min((problem_size + local_size - 1) / local_size,
+               num_compute_units * 4);
+
+  return q.submit([&](sycl::handler &cgh) {
+    sycl::local_accessor<Count> local_bins{sycl::range<1>{num_bins}, cgh};
+    cgh.parallel_for(
+        sycl::nd_range<1>{num_groups * local_size, local_size},
+        [=](sycl::nd_item<1> idx) {
+          const std::size_t lid = idx.get_local_linear_id();
+          Count *group_bins = &(local_bins[0]);
+
+          for(std::size_t b = lid; b < num_bins; b += local_size)
+            group_bins[b] = Count{};
+          sycl::group_barrier(idx.get_group());
+
+          const std::size_t global_size = idx.get_global_range(0);
+          for(std::size_t i = idx.get_global_linear_id(); i < problem_size;
+              i += global_size) {
+            std::size_t b = get_bin(i);
+            if(b < num_bins)
+              sycl::detail::__acpp_atomic_fetch_add<
+                  sycl::access::address_space::local_space>(
+                  group_bins + b, Count{1}, sycl::memory_order_relaxed,
+                  sycl::memory_scope_work_group);
+          }
+          sycl::group_barrier(idx.get_group());
+
+          for(std::size_t b = lid; b < num_bins; b += local_size) {
+            Count count = group_bins[b];
+            if(count != Count{})
+              sycl::detail::__acpp_atomic_fetch_add<
+                  sycl::access::address_space::global_space>(
+                  histogram + b, count, sycl::memory_order_relaxed,
+                  sycl::memory_scope_device);
+          }
+        });
+  });
+}
+
+}
+
+#endif
@@ -23,6 +23,9 @@
 #include "hipSYCL/sycl/queue.hpp"
 #include "hipSYCL/algorithms/reduction/reduction_descriptor.hpp"
 #include "hipSYCL/algorithms/reduction/reduction_engine.hpp"
+#include "hipSYCL/algorithms/reduction/wg_model/group_reduction_algorithms.hpp"
+#include "hipSYCL/algorithms/reduction/wg_model/wi_reducer.hpp"
+#include "hipSYCL/algorithms/scan/scan_engine.hpp"
 #include "hipSYCL/algorithms/util/memory_streaming.hpp"
 
 namespace hipsycl::algorithms {
@@ -190,6 +193,117 @@ sycl::event transform_reduce_impl(sycl::queue &q,
 
 }
 
+/// Reduces each of the segments [offsets[s], offsets[s+1]) for s in
+/// [0, num_segments). k(i, reducer) combines element i into the reducer.
+/// On devices, each segment is processed by one work group, on host devices
+/// by one work item, such that the OpenMP backend distributes segments
+/// across threads.
+template <class T, class OffsetIt, class Kernel, class OutputIt,
+          class BinaryReductionOp>
+sycl::event segmented_reduction(sycl::queue &q, std::size_t num_segments,
+                                OffsetIt offsets, OutputIt output, T init,
+                                Kernel k, BinaryReductionOp op,
+                                std::size_t local_size = 128) {
+  if(num_segments == 0)
+    return sycl::event{};
+
+  auto operator_config = get_reduction_operator_configuration<T>(op);
+  using reducer_type =
+      reduction::wg_model::sequential_reducer<decltype(operator_config)>;
+
+  auto get_segment = [=](std::size_t segment, std::size_t &begin,
+                         std::size_t &end) {
+    auto segment_offset = offsets;
+    std::advance(segment_offset, segment);
+    begin = *segment_offset;
+    ++segment_offset;
+    end = *segment_offset;
+  };
+
+  auto store_result = [=](std::size_t segment, const reducer_type &reducer) {
+    auto segment_output = output;
+    std::advance(segment_output, segment);
+    *segment_output =
+        reducer.is_initialized() ? op(init, reducer.value()) : init;
+  };
+
+  if(q.get_device().is_host()) {
+    return q.parallel_for(sycl::range<1>{num_segments}, [=](sycl::id<1> idx) {
+      std::size_t begin, end;
+      get_segment(idx[0], begin, end);
+      reducer_type reducer{operator_config};
+      for(std::size_t i = begin; i < end; ++i)
+        k(sycl::id<1>{i}, reducer);
+      store_result(idx[0], reducer);
+    });
+  }
+
+  auto reduction_descriptor =
+      reduction::reduction_descriptor{operator_config, init, (T*)nullptr};
+  using group_reduction_type =
+      reduction::wg_model::group_reductions::generic_local_memory<
+          std::decay_t<decltype(reduction_descriptor)>>;
+  std::size_t local_mem = 0;
+  group_reduction_type group_reduction{local_mem, local_size};
+
+  return q.submit([&](sycl::handler &cgh) {
+    // Registers the local memory that the group reduction accesses directly
+    sycl::local_accessor<char> acc{sycl::range<1>{local_mem}, cgh};
+    cgh.parallel_for(
+        sycl::nd_range<1>{num_segments * local_size, local_size},
+        [=](sycl::nd_item<1> idx) {
+          std::size_t segment = idx.get_group_linear_id();
+          std::size_t begin, end;
+          get_segment(segment, begin, end);
+
+          reducer_type reducer{operator_config};
+          for(std::size_t i = begin + idx.get_local_linear_id(); i < end;
+              i += local_size)
+            k(sycl::id<1>{i}, reducer);
+
+          bool is_leader;
+          bool is_initialized;
+          T result = group_reduction(idx, reduction_descriptor, reducer,
+                                     is_leader, is_initialized);
+          if(is_leader) {
+            reducer_type group_reducer{operator_config};
+            if(is_initialized)
+              group_reducer.combine(result);
+            store_result(segment, group_reducer);
+          }
+        });
+  });
+}
+
+/// Head of a segment of equal keys, and the combined value of all
+/// elements since the most recent head.
+template<class T>
+struct keyed_value {
+  std::size_t num_heads;
+  T value;
+};
+
+// Combines keyed values such that values are only combined within segments.
+template<class BinaryOp>
+auto make_keyed_value_operator(BinaryOp op) {
+  return [=](const auto& a, const auto& b) {
+    using value_type = std::decay_t<decltype(a)>;
+    return value_type{a.num_heads + b.num_heads,
+                      b.num_heads > 0 ? b.value : op(a.value, b.value)};
+  };
+}
+
+template <class KeyIt, class BinaryPredicate>
+bool is_segment_head(KeyIt keys_first, std::size_t i, BinaryPredicate pred) {
+  if(i == 0)
+    return true;
+  auto key = keys_first;
+  std::advance(key, i - 1);
+  auto previous_key = *key;
+  ++key;
+  return !pred(previous_key, *key);
+}
+
 }
 
 // Note: All transform_reduce variants defined here behave slightly different than STL
@@ -272,6 +386,224 @@ sycl::event reduce(sycl::queue &q, util::allocation_group &scratch_allocations,
                 typename std::iterator_traits<ForwardIt>::value_type{});
 }
 
+/// Reduces each of the segments [offsets[s], offsets[s+1]) of the input
+/// starting at first, for s in [0, num_segments) with
+/// num_segments = distance(offsets_first, offsets_last) - 1, and stores the
+/// result of segment s in d_first[s]. Empty segments result in init.
+/// All segments are processed by a single kernel launch.
+template <class RandomIt, class OffsetIt, class OutputIt, class T,
+          class BinaryReductionOp, class UnaryTransformOp>
+sycl::event segmented_transform_reduce(sycl::queue &q, RandomIt first,
+                                       OffsetIt offsets_first,
+                                       OffsetIt offsets_last, OutputIt d_first,
+                                       T init, BinaryReductionOp reduce,
+                                       UnaryTransformOp transform) {
+  auto num_offsets = std::distance(offsets_first, offsets_last);
+  if(num_offsets < 2)
+    return sycl::event{};
+
+  auto kernel = [=](sycl::id<1> idx, auto& reducer) {
+    auto input = first;
+    std::advance(input, idx[0]);
+    reducer.combine(transform(*input));
+  };
+  return detail::segmented_reduction(q, num_offsets - 1, offsets_first,
+                                     d_first, init, kernel, reduce);
+}
+
+template <class RandomIt, class OffsetIt, class OutputIt, class T,
+          class BinaryOp>
+sycl::event segmented_reduce(sycl::queue &q, RandomIt first,
+                             OffsetIt offsets_first, OffsetIt offsets_last,
+                             OutputIt d_first, T init, BinaryOp binary_op) {
+  return segmented_transform_reduce(q, first, offsets_first, offsets_last,
+                                    d_first, init, binary_op,
+                                    [](auto x) { return x; });
+}
+
+template <class RandomIt, class OffsetIt, class OutputIt, class T>
+sycl::event segmented_reduce(sycl::queue &q, RandomIt first,
+                             OffsetIt offsets_first, OffsetIt offsets_last,
+                             OutputIt d_first, T init) {
+  return segmented_reduce(q, first, offsets_first, offsets_last, d_first, init,
+                          std::plus<T>{});
+}
+
+/// Computes an inclusive scan of each of the segments
+/// [offsets[s], offsets[s+1]) of the input independently, and writes the
+/// results to the same positions relative to d_first.
+template <class RandomIt1, class OffsetIt, class RandomIt2, class BinaryOp>
+sycl::event segmented_inclusive_scan(sycl::queue &q, RandomIt1 first,
+                                     OffsetIt offsets_first,
+                                     OffsetIt offsets_last, RandomIt2 d_first,
+                                     BinaryOp op) {
+  using value_type = typename std::iterator_traits<RandomIt1>::value_type;
+  auto num_offsets = std::distance(offsets_first, offsets_last);
+  if(num_offsets < 2)
+    return sycl::event{};
+
+  return scan::segmented_scan<true>(
+      q, num_offsets - 1, offsets_first,
+      [=](std::size_t i) -> value_type {
+        auto input = first;
+        std::advance(input, i);
+        return *input;
+      },
+      [=](std::size_t i, const value_type &x) {
+        auto output = d_first;
+        std::advance(output, i);
+        *output = x;
+      },
+      op, false, value_type{});
+}
+
+template <class RandomIt1, class OffsetIt, class RandomIt2>
+sycl::event segmented_inclusive_scan(sycl::queue &q, RandomIt1 first,
+                                     OffsetIt offsets_first,
+                                     OffsetIt offsets_last, RandomIt2 d_first) {
+  using value_type = typename std::iterator_traits<RandomIt1>::value_type;
+  return segmented_inclusive_scan(q, first, offsets_first, offsets_last,
+                                  d_first, std::plus<value_type>{});
+}
+
+/// Computes an exclusive scan of each of the segments
+/// [offsets[s], offsets[s+1]) of the input independently, starting each
+/// segment with init.
+template <class RandomIt1, class OffsetIt, class RandomIt2, class T,
+          class BinaryOp>
+sycl::event segmented_exclusive_scan(sycl::queue &q, RandomIt1 first,
+                                     OffsetIt offsets_first,
+                                     OffsetIt offsets_last, RandomIt2 d_first,
+                                     T init, BinaryOp op) {
+  auto num_offsets = std::distance(offsets_first, offsets_last);
+  if(num_offsets < 2)
+    return sycl::event{};
+
+  return scan::segmented_scan<false>(
+      q, num_offsets - 1, offsets_first,
+      [=](std::size_t i) -> T {
+        auto input = first;
+        std::advance(input, i);
+        return *input;
+      },
+      [=](std::size_t i, const T &x) {
+        auto output = d_first;
+        std::advance(output, i);
+        *output = x;
+      },
+      op, true, init);
+}
+
+template <class RandomIt1, class OffsetIt, class RandomIt2, class T>
+sycl::event segmented_exclusive_scan(sycl::queue &q, RandomIt1 first,
+                                     OffsetIt offsets_first,
+                                     OffsetIt offsets_last, RandomIt2 d_first,
+                                     T init) {
+  return segmented_exclusive_scan(q, first, offsets_first, offsets_last,
+                                  d_first, init, std::plus<T>{});
+}
+
+/// For each segment of consecutive keys in [keys_first, keys_last) for
+/// which pred holds, writes the first key of the segment to keys_out and the
+/// reduction of the corresponding values to values_out. The number of
+/// segments is stored in *num_segments_out, which must be accessible
+/// by the device.
+template <class KeyIt, class ValueIt, class KeyOutputIt, class ValueOutputIt,
+          class BinaryPredicate, class BinaryOp>
+sycl::event reduce_by_key(sycl::queue &q,
+                          util::allocation_group &scratch_allocations,
+                          KeyIt keys_first, KeyIt keys_last,
+                          ValueIt values_first, KeyOutputIt keys_out,
+                          ValueOutputIt values_out,
+                          std::size_t *num_segments_out, BinaryPredicate pred,
+                          BinaryOp op) {
+  using value_type = typename std::iterator_traits<ValueIt>::value_type;
+  using keyed_value_type = detail::keyed_value<value_type>;
+
+  std::size_t n = std::distance(keys_first, keys_last);
+  if(n == 0)
+    return q.single_task([=]() { *num_segments_out = 0; });
+
+  return scan::scan<true>(
+      q, scratch_allocations, n,
+      [=](std::size_t i) {
+        auto value = values_first;
+        std::advance(value, i);
+        std::size_t is_head = detail::is_segment_head(keys_first, i, pred);
+        return keyed_value_type{is_head, *value};
+      },
+      [=](std::size_t i, const keyed_value_type &x) {
+        std::size_t segment = x.num_heads - 1;
+        if(detail::is_segment_head(keys_first, i, pred)) {
+          auto key = keys_first;
+          auto key_output = keys_out;
+          std::advance(key, i);
+          std::advance(key_output, segment);
+          *key_output = *key;
+        }
+        if(i + 1 == n || detail::is_segment_head(keys_first, i + 1, pred)) {
+          auto value_output = values_out;
+          std::advance(value_output, segment);
+          *value_output = x.value;
+        }
+        if(i + 1 == n)
+          *num_segments_out = x.num_heads;
+      },
+      detail::make_keyed_value_operator(op), false, keyed_value_type{});
+}
+
+template <class KeyIt, class ValueIt, class KeyOutputIt, class ValueOutputIt>
+sycl::event reduce_by_key(sycl::queue &q,
+                          util::allocation_group &scratch_allocations,
+                          KeyIt keys_first, KeyIt keys_last,
+                          ValueIt values_first, KeyOutputIt keys_out,
+                          ValueOutputIt values_out,
+                          std::size_t *num_segments_out) {
+  using value_type = typename std::iterator_traits<ValueIt>::value_type;
+  return reduce_by_key(q, scratch_allocations, keys_first, keys_last,
+                       values_first, keys_out, values_out, num_segments_out,
+                       std::equal_to<>{}, std::plus<value_type>{});
+}
+
+/// Computes an inclusive scan of the values of each segment of consecutive
+/// keys in [keys_first, keys_last) for which pred holds.
+template <class KeyIt, class ValueIt, class OutputIt, class BinaryPredicate,
+          class BinaryOp>
+sycl::event inclusive_scan_by_key(sycl::queue &q,
+                                  util::allocation_group &scratch_allocations,
+                                  KeyIt keys_first, KeyIt keys_last,
+                                  ValueIt values_first, OutputIt d_first,
+                                  BinaryPredicate pred, BinaryOp op) {
+  using value_type = typename std::iterator_traits<ValueIt>::value_type;
+  using keyed_value_type = detail::keyed_value<value_type>;
+
+  return scan::scan<true>(
+      q, scratch_allocations, std::distance(keys_first, keys_last),
+      [=](std::size_t i) {
+        auto value = values_first;
+        std::advance(value, i);
+        std::size_t is_head = detail::is_segment_head(keys_first, i, pred);
+        return keyed_value_type{is_head, *value};
+      },
+      [=](std::size_t i, const keyed_value_type &x) {
+        auto output = d_first;
+        std::advance(output, i);
+        *output = x.value;
+      },
+      detail::make_keyed_value_operator(op), false, keyed_value_type{});
+}
+
+template <class KeyIt, class ValueIt, class OutputIt>
+sycl::event inclusive_scan_by_key(sycl::queue &q,
+                                  util::allocation_group &scratch_allocations,
+                                  KeyIt keys_first, KeyIt keys_last,
+                                  ValueIt values_first, OutputIt d_first) {
+  using value_type = typename std::iterator_traits<ValueIt>::value_type;
+  return inclusive_scan_by_key(q, scratch_allocations, keys_first, keys_last,
+                               values_first, d_first, std::equal_to<>{},
+                               std::plus<value_type>{});
+}
+
 }
 
 #endif
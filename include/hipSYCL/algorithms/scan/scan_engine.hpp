@@ -0,0 +1,252 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef ACPP_ALGORITHMS_SCAN_ENGINE_HPP
+#define ACPP_ALGORITHMS_SCAN_ENGINE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/sycl/libkernel/nd_item.hpp"
+#include "hipSYCL/sycl/libkernel/group_functions.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+
+namespace hipsycl::algorithms::scan {
+
+// All scans in this file operate on elements that are obtained using
+// load(i), and write results using store(i, value). For inclusive scans,
+// value contains element i, for exclusive scans it does not.
+// Exclusive scans always need an initial value; for inclusive scans it is
+// optional. No identity of the operator is required.
+
+/// Scans the elements [0, count) sequentially. Returns the combination
+/// of carry and all elements.
+template <bool IsInclusive, class T, class Load, class Store, class BinaryOp>
+T sequential_scan(std::size_t count, Load load, Store store, BinaryOp op,
+                  bool has_carry, T carry) {
+  for(std::size_t i = 0; i < count; ++i) {
+    T x = load(i);
+    if constexpr(IsInclusive) {
+      carry = has_carry ? op(carry, x) : x;
+      has_carry = true;
+      store(i, carry);
+    } else {
+      store(i, carry);
+      carry = op(carry, x);
+    }
+  }
+  return carry;
+}
+
+/// Scans the elements [0, count) cooperatively in a work group, processing
+/// one tile of the size of the work group at a time. local_mem must hold one
+/// element per work item. All work items of the group must call this
+/// function. Returns the combination of carry and all elements.
+template <bool IsInclusive, class T, class Load, class Store, class BinaryOp>
+T group_scan(sycl::nd_item<1> idx, T *local_mem, std::size_t count, Load load,
+             Store store, BinaryOp op, bool has_carry, T carry) {
+  const std::size_t lid = idx.get_local_linear_id();
+  const std::size_t local_size = idx.get_local_range(0);
+
+  for(std::size_t tile_begin = 0; tile_begin < count;
+      tile_begin += local_size) {
+    const std::size_t tile_size = std::min(local_size, count - tile_begin);
+    const bool is_active = lid < tile_size;
+
+    if(is_active)
+      local_mem[lid] = load(tile_begin + lid);
+    sycl::group_barrier(idx.get_group());
+
+    for(std::size_t offset = 1; offset < tile_size; offset *= 2) {
+      const bool needs_update = is_active && lid >= offset;
+      T x = needs_update ? op(local_mem[lid - offset], local_mem[lid]) : T{};
+      sycl::group_barrier(idx.get_group());
+      if(needs_update)
+        local_mem[lid] = x;
+      sycl::group_barrier(idx.get_group());
+    }
+
+    if(is_active) {
+      if constexpr(IsInclusive) {
+        T x = local_mem[lid];
+        store(tile_begin + lid, has_carry ? op(carry, x) : x);
+      } else {
+        store(tile_begin + lid,
+              lid == 0 ? carry : op(carry, local_mem[lid - 1]));
+      }
+    }
+
+    T tile_result = local_mem[tile_size - 1];
+    carry = has_carry ? op(carry, tile_result) : tile_result;
+    has_carry = true;
+    // Don't overwrite local memory while others might still read it
+    sycl::group_barrier(idx.get_group());
+  }
+  return carry;
+}
+
+/// Scans each of the segments [offsets[s], offsets[s+1]) for s in
+/// [0, num_segments) independently, using one work group per segment on
+/// devices, and one work item per segment on host devices.
+template <bool IsInclusive, class T, class OffsetIt, class Load, class Store,
+          class BinaryOp>
+sycl::event segmented_scan(sycl::queue &q, std::size_t num_segments,
+                           OffsetIt offsets, Load load, Store store,
+                           BinaryOp op, bool has_init, T init,
+                           std::size_t local_size = 128) {
+  if(num_segments == 0)
+    return sycl::event{};
+
+  auto get_segment = [=](std::size_t segment, std::size_t &begin,
+                         std::size_t &end) {
+    auto segment_offset = offsets;
+    std::advance(segment_offset, segment);
+    begin = *segment_offset;
+    ++segment_offset;
+    end = *segment_offset;
+  };
+
+  if(q.get_device().is_host()) {
+    return q.parallel_for(sycl::range<1>{num_segments}, [=](sycl::id<1> idx) {
+      std::size_t begin, end;
+      get_segment(idx[0], begin, end);
+      sequential_scan<IsInclusive>(
+          end - begin, [&](std::size_t i) { return load(begin + i); },
+          [&](std::size_t i, const T &x) { store(begin + i, x); }, op,
+          has_init, init);
+    });
+  }
+
+  return q.submit([&](sycl::handler &cgh) {
+    sycl::local_accessor<T> local_mem{sycl::range<1>{local_size}, cgh};
+    cgh.parallel_for(
+        sycl::nd_range<1>{num_segments * local_size, local_size},
+        [=](sycl::nd_item<1> idx) {
+          std::size_t begin, end;
+          get_segment(idx.get_group_linear_id(), begin, end);
+          group_scan<IsInclusive>(
+              idx, &(local_mem[0]), end - begin,
+              [&](std::size_t i) { return load(begin + i); },
+              [&](std::size_t i, const T &x) { store(begin + i, x); }, op,
+              has_init, init);
+        });
+  });
+}
+
+/// Scans the elements [0, n) using a reduce-then-scan approach:
+/// The input is split into blocks, the results of all blocks are scanned,
+/// and then each block is scanned again, starting with the combined
+/// results of the preceding blocks.
+/// Assumes an in-order queue.
+template <bool IsInclusive, class T, class Load, class Store, class BinaryOp>
+sycl::event scan(sycl::queue &q, util::allocation_group &scratch_allocations,
+                 std::size_t n, Load load, Store store, BinaryOp op,
+                 bool has_init, T init, std::size_t local_size = 128) {
+  if(n == 0)
+    return sycl::event{};
+
+  const bool is_host = q.get_device().is_host();
+  const std::size_t max_num_blocks = std::max(
+      std::size_t{1},
+      static_cast<std::size_t>(
+          q.get_device().get_info<sycl::info::device::max_compute_units>()) *
+          (is_host ? 1 : 4));
+  // Blocks should at least provide one tile of work for each work item
+  const std::size_t min_block_size = is_host ? 1 : local_size;
+  const std::size_t block_size =
+      std::max(min_block_size, (n + max_num_blocks - 1) / max_num_blocks);
+  const std::size_t num_blocks = (n + block_size - 1) / block_size;
+
+  // The result of a block is the same for inclusive and exclusive scans,
+  // but only inclusive scans can be carried out without initial value.
+  auto run_blocks = [&](auto is_inclusive, auto block_kernel) {
+    constexpr bool run_inclusive = decltype(is_inclusive)::value;
+    if(is_host) {
+      return q.parallel_for(sycl::range<1>{num_blocks}, [=](sycl::id<1> idx) {
+        block_kernel(idx[0], true, [=](std::size_t count, auto block_load,
+                                 auto block_store, bool has_carry, T carry) {
+          return sequential_scan<run_inclusive>(count, block_load,
+                                                block_store, op, has_carry,
+                                                carry);
+        });
+      });
+    } else {
+      return q.submit([&](sycl::handler &cgh) {
+        sycl::local_accessor<T> local_mem{sycl::range<1>{local_size}, cgh};
+        cgh.parallel_for(
+            sycl::nd_range<1>{num_blocks * local_size, local_size},
+            [=](sycl::nd_item<1> idx) {
+              block_kernel(idx.get_group_linear_id(),
+                           idx.get_local_linear_id() == 0,
+                           [&](std::size_t count, auto block_load,
+                               auto block_store, bool has_carry, T carry) {
+                             return group_scan<run_inclusive>(
+                                 idx, &(local_mem[0]), count, block_load,
+                                 block_store, op, has_carry, carry);
+                           });
+            });
+      });
+    }
+  };
+
+  auto get_block_size = [=](std::size_t block) {
+    return std::min(block_size, n - block * block_size);
+  };
+
+  if(num_blocks == 1) {
+    return run_blocks(std::bool_constant<IsInclusive>{},
+                      [=](std::size_t block, bool is_leader, auto block_scan) {
+                        block_scan(n, load, store, has_init, init);
+                      });
+  }
+
+  T* block_results = scratch_allocations.obtain<T>(num_blocks);
+
+  run_blocks(std::true_type{}, [=](std::size_t block, bool is_leader,
+                                   auto block_scan) {
+    std::size_t block_begin = block * block_size;
+    T result = block_scan(
+        get_block_size(block),
+        [=](std::size_t i) { return load(block_begin + i); },
+        [](std::size_t, const T &) {}, false, T{});
+    if(is_leader)
+      block_results[block] = result;
+  });
+
+  // Turn the block results into the combination of all preceding blocks.
+  // The number of blocks is small, so process them sequentially.
+  q.single_task([=]() {
+    std::size_t first_block = has_init ? 0 : 1;
+    T carry = has_init ? init : block_results[0];
+    for(std::size_t block = first_block; block < num_blocks; ++block) {
+      T block_result = block_results[block];
+      block_results[block] = carry;
+      carry = op(carry, block_result);
+    }
+  });
+
+  return run_blocks(std::bool_constant<IsInclusive>{},
+                    [=](std::size_t block, bool is_leader, auto block_scan) {
+    std::size_t block_begin = block * block_size;
+    bool has_carry = has_init || block > 0;
+    block_scan(
+        get_block_size(block),
+        [=](std::size_t i) { return load(block_begin + i); },
+        [=](std::size_t i, const T &x) { store(block_begin + i, x); },
+        has_carry, has_carry ? block_results[block] : T{});
+  });
+}
+
+}
+
+#endif
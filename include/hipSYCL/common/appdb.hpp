@@ -61,6 +61,37 @@ struct kernel_arg_entry {
   void dump(std::ostream& ostr, int indentation_level=0) const;
 };
 
+struct host_launch_candidate_statistics {
+  uint64_t num_samples = 0;
+  uint64_t total_time_ns = 0;
+
+  void dump(std::ostream& ostr, int indentation_level=0) const;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(num_samples);
+    pack(total_time_ns);
+  }
+};
+
+// Timings of the host launch configurations that have been tried for one
+// problem size bucket of a kernel.
+struct host_launch_tuning_entry {
+  static constexpr uint64_t no_selection = 1ull << 63;
+
+  std::vector<host_launch_candidate_statistics> candidates;
+  // Index of the fastest candidate once all candidates have been measured
+  uint64_t selected_candidate = no_selection;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(candidates);
+    pack(selected_candidate);
+  }
+
+  void dump(std::ostream& ostr, int indentation_level=0) const;
+};
+
 struct kernel_entry {
 
   template<class T>
@@ -69,6 +100,12 @@ struct kernel_entry {
     pack(num_registered_invocations);
     pack(retained_argument_indices);
     pack(first_iads_invocation_run);
+    pack(host_launch_tuning);
+    pack(loop_controlling_argument_indices);
+    pack(eager_specialization_values);
+    pack(num_pgo_training_launches);
+    pack(pgo_branch_counters);
+    pack(global_range);
   }
 
   void dump(std::ostream& ostr, int indentation_level=0) const;
@@ -82,6 +119,62 @@ struct kernel_entry {
   // to denote an unset/invalid value.
   static constexpr uint64_t no_usage = 1ull << 63;
   uint64_t first_iads_invocation_run = no_usage;
+
+  // Host launch tuning results, indexed by problem size bucket
+  std::unordered_map<uint64_t, host_launch_tuning_entry> host_launch_tuning;
+
+  // Indices of the arguments that control trip counts or strides of loops,
+  // as detected during JIT compilation. Only used by the analysis entry of
+  // a kernel, see glue::jit::get_kernel_analysis_id().
+  std::vector<int> loop_controlling_argument_indices;
+  // Values of loop-controlling arguments for which specialized binaries
+  // have been requested, indexed by argument index
+  std::unordered_map<uint64_t, std::vector<uint64_t>> eager_specialization_values;
+
+  // Profile-guided optimization: Number of launches of the instrumented
+  // binary, and the branch counters accumulated over these launches.
+  uint64_t num_pgo_training_launches = 0;
+  std::vector<uint64_t> pgo_branch_counters;
+
+  // Statistics of the number of work groups of launches, used
+  // to determine whether the global range can be specialized.
+  kernel_arg_entry global_range;
+};
+
+// Runtime statistics of a C++ standard parallelism operation for one
+// problem size
+struct stdpar_sample_entry {
+  uint64_t num_samples = 0;
+  uint64_t total_time_ns = 0;
+  uint64_t min_time_ns = 0;
+  uint64_t max_time_ns = 0;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(num_samples);
+    pack(total_time_ns);
+    pack(min_time_ns);
+    pack(max_time_ns);
+  }
+
+  void merge(const stdpar_sample_entry& other);
+
+  void dump(std::ostream& ostr, int indentation_level=0) const;
+};
+
+// Measurements of a C++ standard parallelism operation, indexed
+// by problem size
+struct stdpar_operation_entry {
+  std::unordered_map<uint64_t, stdpar_sample_entry> host_samples;
+  std::unordered_map<uint64_t, stdpar_sample_entry> offload_samples;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(host_samples);
+    pack(offload_samples);
+  }
+
+  void dump(std::ostream& ostr, int indentation_level=0) const;
 };
 
 struct binary_entry {
@@ -104,12 +197,16 @@ struct appdb_data {
   std::unordered_map<rt::kernel_configuration::id_type, binary_entry,
                      rt::kernel_id_hash>
       binaries;
+  // Offload heuristic data of C++ standard parallelism, indexed by
+  // operation hash
+  std::unordered_map<uint64_t, stdpar_operation_entry> stdpar_operations;
 
   template<class T>
   void pack(T &pack) {
     pack(kernels);
     pack(binaries);
     pack(content_version);
+    pack(stdpar_operations);
   }
 
   void dump(std::ostream& ostr, int indentation_level=0) const;
@@ -120,7 +217,7 @@ class appdb  {
 public:
   // DO NOT FORGET TO INCREMENT THIS WHEN ADDING/REMOVING
   // FIELDS OR OTHERWISE CHANGING THE DATA LAYOUT!
-  static const uint64_t format_version = 4;
+  static const uint64_t format_version = 9;
 
   appdb(const std::string& db_path);
   ~appdb();
@@ -95,6 +95,9 @@ bool endsWithBarrier(const llvm::BasicBlock *BB,
 llvm::CallInst *createBarrier(llvm::Instruction *InsertBefore,
                               hipsycl::compiler::SplitterAnnotationInfo &SAA);
 
+/// Dimensionality of the work-group range of the kernel F.
+std::size_t getRangeDim(llvm::Function &F);
+
 bool isWorkItemLoop(const llvm::Loop &L);
 bool isInWorkItemLoop(const llvm::Loop &L);
 bool isInWorkItemLoop(const llvm::Region &R, const llvm::LoopInfo &LI);
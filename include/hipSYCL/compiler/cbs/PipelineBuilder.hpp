@@ -24,7 +24,7 @@ namespace hipsycl::compiler {
 using OptLevel = llvm::OptimizationLevel;
 
 // build the CBS pipeline for the legacy PM
-void registerCBSPipelineLegacy(llvm::legacy::PassManagerBase &PM);
+void registerCBSPipelineLegacy(llvm::legacy::PassManagerBase &PM, unsigned OptLevel);
 
 // build the CBS pipeline for the new PM
 void registerCBSPipeline(llvm::ModulePassManager &MPM, OptLevel Opt, bool IsSscp);
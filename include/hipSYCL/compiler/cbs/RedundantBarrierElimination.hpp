@@ -0,0 +1,50 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_REDUNDANTBARRIERELIMINATION_HPP
+#define HIPSYCL_REDUNDANTBARRIERELIMINATION_HPP
+
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/IR/Function.h"
+#include "llvm/Pass.h"
+
+namespace hipsycl {
+namespace compiler {
+
+// Classifies the barrier regions of nd_range kernels and removes barriers
+// that do not order memory accesses of different work items. This avoids
+// sub-CFG formation at these barriers, and kernels in which all barriers
+// turn out to be redundant use the barrier-free work-item loops.
+class RedundantBarrierEliminationPassLegacy : public llvm::FunctionPass {
+public:
+  static char ID;
+
+  explicit RedundantBarrierEliminationPassLegacy() : llvm::FunctionPass(ID) {}
+
+  llvm::StringRef getPassName() const override {
+    return "hipSYCL redundant barrier elimination pass";
+  }
+
+  void getAnalysisUsage(llvm::AnalysisUsage &AU) const override;
+
+  bool runOnFunction(llvm::Function &F) override;
+};
+
+class RedundantBarrierEliminationPass
+    : public llvm::PassInfoMixin<RedundantBarrierEliminationPass> {
+public:
+  explicit RedundantBarrierEliminationPass() {}
+
+  llvm::PreservedAnalyses run(llvm::Function &F, llvm::FunctionAnalysisManager &AM);
+};
+} // namespace compiler
+} // namespace hipsycl
+
+#endif // HIPSYCL_REDUNDANTBARRIERELIMINATION_HPP
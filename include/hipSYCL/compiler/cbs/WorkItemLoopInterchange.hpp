@@ -0,0 +1,50 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_WORKITEMLOOPINTERCHANGE_HPP
+#define HIPSYCL_WORKITEMLOOPINTERCHANGE_HPP
+
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/IR/Function.h"
+#include "llvm/Pass.h"
+
+namespace hipsycl {
+namespace compiler {
+
+// Places barriers around innermost loops of nd_range kernels with barriers
+// that all work items of a group execute with the same trip count, such as
+// the loop over a local memory tile in a blocked matrix multiplication.
+// Sub-CFG formation then nests the work-item loop inside of these loops,
+// so that the vectorizer can operate across work items.
+class WorkItemLoopInterchangePassLegacy : public llvm::FunctionPass {
+public:
+  static char ID;
+
+  explicit WorkItemLoopInterchangePassLegacy() : llvm::FunctionPass(ID) {}
+
+  llvm::StringRef getPassName() const override {
+    return "hipSYCL work-item loop interchange pass";
+  }
+
+  void getAnalysisUsage(llvm::AnalysisUsage &AU) const override;
+
+  bool runOnFunction(llvm::Function &F) override;
+};
+
+class WorkItemLoopInterchangePass : public llvm::PassInfoMixin<WorkItemLoopInterchangePass> {
+public:
+  explicit WorkItemLoopInterchangePass() {}
+
+  llvm::PreservedAnalyses run(llvm::Function &F, llvm::FunctionAnalysisManager &AM);
+};
+} // namespace compiler
+} // namespace hipsycl
+
+#endif // HIPSYCL_WORKITEMLOOPINTERCHANGE_HPP
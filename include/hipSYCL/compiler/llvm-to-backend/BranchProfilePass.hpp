@@ -0,0 +1,57 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_BRANCH_PROFILE_PASS_HPP
+#define HIPSYCL_BRANCH_PROFILE_PASS_HPP
+
+#include <cstdint>
+#include <vector>
+#include <llvm/IR/PassManager.h>
+
+
+namespace hipsycl {
+namespace compiler {
+
+// Profile-guided optimization of JIT-compiled kernels. Both passes enumerate
+// the conditional branches of the module in the same order, so they must be
+// run on identical IR: A profile collected with an instrumented binary can only
+// be applied to a compilation of the same kernel configuration.
+//
+// Instrumented binaries count for each conditional branch i how many times
+// it was taken (counter 2*i) and not taken (counter 2*i+1) in the
+// global i64 array __acpp_sscp_pgo_counters. The number of counters is
+// stored in the global constant __acpp_sscp_pgo_num_counters.
+class BranchProfileInstrumentationPass
+    : public llvm::PassInfoMixin<BranchProfileInstrumentationPass> {
+public:
+  BranchProfileInstrumentationPass(unsigned CounterAddressSpace);
+
+  llvm::PreservedAnalyses run(llvm::Module &M,
+                              llvm::ModuleAnalysisManager &MAM);
+private:
+  unsigned CounterAddressSpace;
+};
+
+// Attaches branch weights from the counters of an instrumented binary.
+class BranchProfileApplicationPass
+    : public llvm::PassInfoMixin<BranchProfileApplicationPass> {
+public:
+  BranchProfileApplicationPass(const std::vector<uint64_t> &Counters);
+
+  llvm::PreservedAnalyses run(llvm::Module &M,
+                              llvm::ModuleAnalysisManager &MAM);
+private:
+  const std::vector<uint64_t>& Counters;
+};
+
+}
+}
+
+#endif
@@ -29,6 +29,12 @@ private:
   int KnownGroupSizeZ;
 };
 
+// Replaces calls to GetSizeBuiltinName with the constant KnownSize, and inserts
+// llvm.assume calls to assert that results of GetIdBuiltinName are in [0, KnownSize).
+bool applyKnownBuiltinSize(llvm::Module &M, long long KnownSize,
+                           llvm::StringRef GetSizeBuiltinName,
+                           llvm::StringRef GetIdBuiltinName);
+
 }
 }
 
@@ -0,0 +1,37 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SSCP_KNOWN_NUM_GROUPS_OPT_HPP
+#define HIPSYCL_SSCP_KNOWN_NUM_GROUPS_OPT_HPP
+
+#include <llvm/IR/PassManager.h>
+
+
+namespace hipsycl {
+namespace compiler {
+
+// Together with KnownGroupSizeOptPass, this bakes the global range
+// of a launch into the kernel.
+class KnownNumGroupsOptPass : public llvm::PassInfoMixin<KnownNumGroupsOptPass> {
+public:
+  KnownNumGroupsOptPass(long long KnownNumGroupsX = -1, long long KnownNumGroupsY = -1,
+                        long long KnownNumGroupsZ = -1);
+  llvm::PreservedAnalyses run(llvm::Module &M,
+                              llvm::ModuleAnalysisManager &MAM);
+private:
+  long long KnownNumGroupsX;
+  long long KnownNumGroupsY;
+  long long KnownNumGroupsZ;
+};
+
+}
+}
+
+#endif
@@ -29,6 +29,7 @@
 namespace llvm {
 class Module;
 class Function;
+class MemoryBufferRef;
 }
 
 namespace hipsycl {
@@ -168,6 +169,12 @@ public:
                                      std::vector<int> *RetainedArgumentIndices = nullptr);
 
   const std::vector<std::pair<std::string, std::vector<int>*>>& getDeadArgumentEliminationConfig() const;
+
+  // Enable detection of the integer arguments of a kernel that control trip counts or
+  // strides of loops. LoopControllingArgumentIndices will be filled with their indices
+  // in ascending order. Arguments that were specialized are no longer detected.
+  void enableLoopControllingArgumentAnalysis(const std::string &KernelName,
+                                             std::vector<int> *LoopControllingArgumentIndices);
 protected:
   virtual AddressSpaceMap getAddressSpaceMap() const = 0;
   virtual bool isKernelAfterFlavoring(llvm::Function& F) = 0;
@@ -215,17 +222,32 @@ protected:
   int KnownGroupSizeX = 0;
   int KnownGroupSizeY = 0;
   int KnownGroupSizeZ = 0;
+  // Like known group sizes, non-zero if the number of work groups is known at jit time.
+  long long KnownNumGroupsX = 0;
+  long long KnownNumGroupsY = 0;
+  long long KnownNumGroupsZ = 0;
 
   // Will be >= 0 if set by option. Backends using this should therefore check >= 0.
   std::int64_t KnownLocalMemSize = -1;
 
   bool GlobalSizesFitInInt = false;
   bool IsFastMath = false;
+  // Only run a minimal optimization pipeline (tier 0 of tiered JIT compilation)
+  bool IsBaselineOptimization = false;
+  // Profile-guided optimization: Either build a binary that collects a branch
+  // profile, or optimize using the branch profile of such a binary.
+  bool IsProfileInstrumentation = false;
+  // Indices of pointer arguments of kernels that do not alias other arguments
+  std::vector<int> NoAliasPointerArguments;
+  std::vector<uint64_t> BranchProfile;
 
 private:
 
   void resolveExternalSymbols(llvm::Module& M);
   void setFailedIR(llvm::Module& M);
+  bool linkBitcodeBuffer(llvm::Module &M, llvm::MemoryBufferRef Bitcode,
+                         const std::string &ForcedTriple, const std::string &ForcedDataLayout,
+                         bool LinkOnlyNeeded);
   void runKernelDeadArgumentElimination(llvm::Module &M, llvm::Function *F, PassHandler &PH,
                                         std::vector<int>& RetainedIndicesOut);
 
@@ -247,6 +269,7 @@ private:
   std::string ErroringCode;
 
   std::vector<std::pair<std::string, std::vector<int>*>> FunctionsForDeadArgumentElimination;
+  std::vector<std::pair<std::string, std::vector<int>*>> KernelsForLoopControllingArgumentAnalysis;
 
 };
 
@@ -0,0 +1,45 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_LOOP_CONTROLLING_ARGUMENTS_PASS_HPP
+#define HIPSYCL_LOOP_CONTROLLING_ARGUMENTS_PASS_HPP
+
+#include <string>
+#include <vector>
+#include <llvm/IR/PassManager.h>
+
+
+namespace hipsycl {
+namespace compiler {
+
+// Analysis that finds the integer arguments of a kernel that determine
+// trip counts or strides of loops inside the kernel. Such arguments
+// are profitable targets for specialization, since it allows
+// full unrolling, vectorization without remainder loops, and
+// strength reduction. The pass does not modify the IR.
+class LoopControllingArgumentsPass
+    : public llvm::PassInfoMixin<LoopControllingArgumentsPass> {
+public:
+  // ArgumentIndicesOut will be filled with the indices of the loop-controlling
+  // arguments of KernelName in ascending order.
+  LoopControllingArgumentsPass(const std::string &KernelName,
+                               std::vector<int> &ArgumentIndicesOut);
+
+  llvm::PreservedAnalyses run(llvm::Module &M,
+                              llvm::ModuleAnalysisManager &MAM);
+private:
+  std::string KernelName;
+  std::vector<int>& ArgumentIndices;
+};
+
+}
+}
+
+#endif
@@ -35,7 +35,16 @@ protected:
   virtual AddressSpaceMap getAddressSpaceMap() const override;
   virtual void migrateKernelProperties(llvm::Function* From, llvm::Function* To) override;
 private:
+  // Generates a relocatable object in memory
+  bool emitObjectInProcess(llvm::Module &FlavoredModule, std::string &out);
+  // Generates a shared library using an external clang invocation
+  bool emitSharedLibraryWithClang(llvm::Module &FlavoredModule, std::string &out);
+
   std::vector<std::string> KernelNames;
+  // CPU and features to generate code for. If empty, the executing
+  // machine is targeted.
+  std::string TargetCPU;
+  std::string TargetFeatures;
 };
 
 }
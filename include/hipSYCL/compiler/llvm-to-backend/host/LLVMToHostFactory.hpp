@@ -22,6 +22,29 @@ namespace compiler {
 std::unique_ptr<LLVMToBackendTranslator>
 createLLVMToHostTranslator(const std::vector<std::string> &KernelNames);
 
+/// Returns true if Binary is a relocatable object (or an archive of
+/// relocatable objects) as produced by the in-process code generation
+/// of the host translator, and false if it is a shared library.
+bool isRelocatableHostObject(const std::string &Binary);
+
+/// Links a relocatable host object into the in-process JIT.
+/// Returns an opaque handle, or nullptr on failure, in which case
+/// ErrorOut describes the problem.
+void *loadHostObject(const std::string &Object, std::string &ErrorOut);
+
+/// Returns the address of a symbol of a loaded host object, or nullptr.
+void *getHostObjectSymbol(void *Handle, const std::string &SymbolName);
+
+void unloadHostObject(void *Handle);
+
+/// Returns the name of the CPU microarchitecture of the executing machine,
+/// e.g. "znver4", as understood by LLVM.
+std::string getHostTargetCPU();
+
+/// Returns the CPU features of the executing machine in LLVM's
+/// target feature string format (e.g. "+avx2,-avx512f"), in a stable order.
+std::string getHostTargetFeatures();
+
 }
 }
 
@@ -347,15 +347,16 @@ public:
     __acpp_kernel_name_template<KernelBodyT><<<1, 1>>>();                   \
   }                                                                            \
   if constexpr (is_launch_from_module()) {                                     \
-    invoke_from_module<KernelNameT, KernelBodyT>(nodeptr, grid, block,         \
-                                                 shared_mem, __VA_ARGS__);     \
+    self->template invoke_from_module<KernelNameT, KernelBodyT>(               \
+        nodeptr, grid, block, shared_mem, __VA_ARGS__);                        \
   } else {                                                                     \
     __acpp_launch_integrated_kernel(f, grid, block, shared_mem, stream,     \
                                        __VA_ARGS__)                            \
   }
 
   hiplike_kernel_launcher()
-      : _queue{nullptr}, _invoker{[](rt::dag_node*) {}} {}
+      : _queue{nullptr},
+        _invoker{[](rt::dag_node *, hiplike_kernel_launcher *) {}} {}
 
   virtual ~hiplike_kernel_launcher() {}
 
@@ -393,8 +394,12 @@ public:
                          << effective_local_range.size() << std::endl;
     }
 
-    _invoker = [=](rt::dag_node* node) mutable {
-      assert(_queue != nullptr);
+    // The invoker receives the launcher as argument instead of capturing
+    // this, such that copies of the launcher invoke on their own queue.
+    _invoker = [=](rt::dag_node *node,
+                   hiplike_kernel_launcher *self) mutable {
+      Queue_type *queue = self->_queue;
+      assert(queue != nullptr);
       
       static_cast<rt::kernel_operation *>(node->get_operation())
           ->initialize_embedded_pointers(k);
@@ -404,12 +409,12 @@ public:
         __acpp_invoke_kernel(
             node, hiplike_dispatch::single_task_kernel<kernel_name_t>,
             kernel_name_t, Kernel, dim3(1, 1, 1), dim3(1, 1, 1),
-            dynamic_local_memory, _queue->get_native_type(), k);
+            dynamic_local_memory, queue->get_native_type(), k);
 
       } else if constexpr (type == rt::kernel_type::custom) {
        
-        sycl::interop_handle handle{_queue->get_device(),
-                                    static_cast<void *>(_queue)};
+        sycl::interop_handle handle{queue->get_device(),
+                                    static_cast<void *>(queue)};
 
         k(handle);
 
@@ -435,7 +440,7 @@ public:
               hiplike_dispatch::make_kernel_launch_range<Dim>(grid_range),
               hiplike_dispatch::make_kernel_launch_range<Dim>(
                   effective_local_range),
-              required_dynamic_local_mem, _queue->get_native_type(), k,
+              required_dynamic_local_mem, queue->get_native_type(), k,
               global_range, offset, is_with_offset);
 
         } else if constexpr (type == rt::kernel_type::ndrange_parallel_for) {
@@ -449,7 +454,7 @@ public:
               hiplike_dispatch::make_kernel_launch_range<Dim>(grid_range),
               hiplike_dispatch::make_kernel_launch_range<Dim>(
                   effective_local_range),
-              required_dynamic_local_mem, _queue->get_native_type(), k, offset);
+              required_dynamic_local_mem, queue->get_native_type(), k, offset);
 
         } else if constexpr (type ==
                               rt::kernel_type::hierarchical_parallel_for) {
@@ -463,7 +468,7 @@ public:
               hiplike_dispatch::make_kernel_launch_range<Dim>(grid_range),
               hiplike_dispatch::make_kernel_launch_range<Dim>(
                   effective_local_range),
-              required_dynamic_local_mem, _queue->get_native_type(), k,
+              required_dynamic_local_mem, queue->get_native_type(), k,
               effective_local_range);
 
         } else if constexpr (type == rt::kernel_type::scoped_parallel_for) {
@@ -490,7 +495,7 @@ public:
                 hiplike_dispatch::make_kernel_launch_range<Dim>(grid_range),
                 hiplike_dispatch::make_kernel_launch_range<Dim>(
                     effective_local_range),
-                required_dynamic_local_mem, _queue->get_native_type(),
+                required_dynamic_local_mem, queue->get_native_type(),
                 multiversioned_kernel_body, multiversioning_props, grid_range,
                 effective_local_range);
           };
@@ -528,7 +533,12 @@ public:
 
   virtual void invoke(rt::dag_node *node,
                       const rt::kernel_configuration &) final override {
-    _invoker(node);
+    _invoker(node, this);
+  }
+
+  virtual std::unique_ptr<rt::backend_kernel_launcher>
+  clone() const final override {
+    return std::make_unique<hiplike_kernel_launcher>(*this);
   }
 
   virtual rt::kernel_type get_kernel_type() const final override {
@@ -644,7 +654,7 @@ private:
 
   Queue_type *_queue;
   rt::kernel_type _type;
-  std::function<void (rt::dag_node*)> _invoker;
+  std::function<void (rt::dag_node*, hiplike_kernel_launcher*)> _invoker;
 };
 
 }
@@ -53,6 +53,11 @@ make_kernel_launcher(sycl::id<Dim> offset, sycl::range<Dim> local_range,
   using name_traits = kernel_name_traits<KernelNameTag, Kernel>;
 
   kernel_launcher_data static_launcher_data;
+  // The global size is also needed outside of SSCP, since the runtime
+  // estimates the cost of launches based on it.
+  for(int i = 0; i < 3; ++i)
+    static_launcher_data.global_size[i] =
+        i < Dim ? global_range[Dim - i - 1] : 1;
   common::auto_small_vector<std::unique_ptr<rt::backend_kernel_launcher>>
       launchers;
 #ifdef __ACPP_ENABLE_HIP_TARGET__
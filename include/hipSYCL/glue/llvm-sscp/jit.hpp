@@ -21,11 +21,13 @@
 #include "hipSYCL/runtime/kernel_cache.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/application.hpp"
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 #include <atomic>
 #include <fstream>
 #include <string>
+#include <string_view>
 
 namespace hipsycl {
 namespace glue {
@@ -226,6 +228,19 @@ private:
 
 };
 
+// Id of the appdb entry that holds the results of IR analyses of a kernel,
+// which do not depend on the kernel configuration.
+inline rt::kernel_configuration::id_type
+get_kernel_analysis_id(rt::hcf_object_id hcf_object,
+                       std::string_view kernel_name) {
+  rt::kernel_configuration config;
+  config.append_base_configuration(
+      rt::kernel_base_config_parameter::hcf_object_id, hcf_object);
+  config.append_base_configuration(
+      rt::kernel_base_config_parameter::single_kernel, kernel_name);
+  return config.generate_id();
+}
+
 inline rt::result compile(compiler::LLVMToBackendTranslator *translator,
                           const std::string &source,
                           const rt::kernel_configuration &config,
@@ -361,8 +376,34 @@ inline rt::result compile(compiler::LLVMToBackendTranslator* translator,
         rt::error_info{"jit::compile: Could not obtain HCF object"});
   }
 
-  return compile(translator, hcf, image_name, config,
-                 output);
+  // For single-kernel compilations, record which kernel arguments control
+  // loops such that the adaptivity engine can specialize them eagerly.
+  std::vector<int> loop_controlling_args;
+  bool is_single_kernel = translator->getKernels().size() == 1;
+  if(is_single_kernel)
+    translator->enableLoopControllingArgumentAnalysis(
+        translator->getKernels()[0], &loop_controlling_args);
+
+  rt::result err = compile(translator, hcf, image_name, config, output);
+
+  if(err.is_success() && is_single_kernel && !loop_controlling_args.empty()) {
+    auto analysis_id =
+        get_kernel_analysis_id(hcf_object, translator->getKernels()[0]);
+    // Specialized arguments are no longer detected, so merge with the
+    // results of previous compilations.
+    common::filesystem::persistent_storage::get()
+        .get_this_app_db()
+        .read_write_access([&](common::db::appdb_data &appdb) {
+          auto &indices =
+              appdb.kernels[analysis_id].loop_controlling_argument_indices;
+          for(int i : loop_controlling_args)
+            if(std::find(indices.begin(), indices.end(), i) == indices.end())
+              indices.push_back(i);
+          std::sort(indices.begin(), indices.end());
+        });
+  }
+
+  return err;
 }
 
 namespace dead_argument_elimination {
@@ -376,18 +417,20 @@ inline rt::result compile_kernel(
 
   assert(translator->getKernels().size() == 1);
 
-  rt::result err = rt::make_success();
-
-  common::filesystem::persistent_storage::get()
-      .get_this_app_db()
-      .read_write_access([&](common::db::appdb_data &appdb) {
-        std::vector<int> *retained_args =
-            &(appdb.kernels[binary_id].retained_argument_indices);
-
-        translator->enableDeadArgumentElminiation(translator->getKernels()[0],
-                                                  retained_args);
-        err = compile(translator, hcf_object, image_name, config, output);
-      });
+  // Don't hold the appdb lock during compilation, which might take place
+  // on a background thread.
+  std::vector<int> retained_args;
+  translator->enableDeadArgumentElminiation(translator->getKernels()[0],
+                                            &retained_args);
+  rt::result err = compile(translator, hcf_object, image_name, config, output);
+
+  if(err.is_success()) {
+    common::filesystem::persistent_storage::get()
+        .get_this_app_db()
+        .read_write_access([&](common::db::appdb_data &appdb) {
+          appdb.kernels[binary_id].retained_argument_indices = std::move(retained_args);
+        });
+  }
 
   return err;
 }
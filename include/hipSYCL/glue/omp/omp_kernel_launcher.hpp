@@ -13,6 +13,8 @@
 
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include <cassert>
+#include <cstddef>
+#include <memory>
 #include <tuple>
 #ifdef _OPENMP
 #include <omp.h>
@@ -85,6 +87,28 @@ void parallel_invocation(Function kernel) noexcept {
   }
 }
 
+/// Scratch memory for group algorithms of nd_range kernels. The memory is
+/// allocated once per thread and is never initialized, so kernels pay
+/// neither for zeroing it nor, since untouched pages are not backed by
+/// physical memory, for the parts they do not use.
+class host_group_scratch_memory {
+public:
+  // 128 kiB as local memory for group algorithms
+  static constexpr std::size_t size = 128 * 1024;
+
+  static void* get() noexcept {
+    thread_local std::unique_ptr<storage> scratch;
+    if(!scratch)
+      // Default-initialization leaves the storage uninitialized
+      scratch.reset(new storage);
+    return scratch.get();
+  }
+private:
+  struct alignas(sizeof(double) * 16) storage {
+    unsigned char data[size];
+  };
+};
+
 #ifdef __ACPP_USE_ACCELERATED_CPU__
 extern "C" size_t __acpp_cbs_local_id_x;
 extern "C" size_t __acpp_cbs_local_id_y;
@@ -172,8 +196,7 @@ inline void parallel_for_ndrange_kernel(
     sycl::detail::host_local_memory::request_from_threadprivate_pool(
         num_local_mem_bytes);
 
-    // 128 kiB as local memory for group algorithms
-    std::aligned_storage_t<128*1024, sizeof(double) * 16> group_shared_memory_ptr{};
+    void* group_shared_memory_ptr = host_group_scratch_memory::get();
 #ifdef __ACPP_USE_ACCELERATED_CPU__
     std::function<void()> barrier_impl = [] () noexcept {
       assert(false && "splitting seems to have failed");
@@ -182,7 +205,7 @@ inline void parallel_for_ndrange_kernel(
 
     host::iterate_range_omp_for(num_groups, [&](sycl::id<Dim> &&group_id) {
       iterate_nd_range_omp(f, std::move(group_id), num_groups, local_size, offset,
-        num_local_mem_bytes, &group_shared_memory_ptr, barrier_impl);
+        num_local_mem_bytes, group_shared_memory_ptr, barrier_impl);
     });
 #elif defined(HIPSYCL_HAS_FIBERS)
     host::static_range_decomposition<Dim> group_decomposition{
@@ -205,7 +228,7 @@ inline void parallel_for_ndrange_kernel(
                                     local_size,
                                     num_groups,
                                     &barrier_impl,
-                                    &group_shared_memory_ptr};
+                                    group_shared_memory_ptr};
 
       f(this_item);
     });
@@ -461,6 +484,11 @@ public:
     _invoker(node);
   }
 
+  virtual std::unique_ptr<rt::backend_kernel_launcher>
+  clone() const final override {
+    return std::make_unique<omp_kernel_launcher>(*this);
+  }
+
   virtual rt::kernel_type get_kernel_type() const final override {
     return _type;
   }
@@ -20,6 +20,25 @@
 namespace hipsycl {
 namespace rt {
 
+/// Describes how the work groups of a kernel are distributed across
+/// the threads of a host device.
+struct host_launch_configuration {
+  /// Number of work groups (or rows, if flatten is false) that a thread
+  /// obtains at a time. 0 denotes a static schedule that assigns one
+  /// contiguous block to each thread.
+  std::size_t groups_per_chunk = 0;
+  /// If true, the work group range is flattened and individual work groups
+  /// are distributed. Otherwise, only entire rows of work groups along
+  /// dimension 0 are distributed.
+  bool flatten = true;
+  /// If tuning is in progress, the index of this configuration in the list
+  /// of candidates. The runtime of the launch should then be reported using
+  /// kernel_adaptivity_engine::register_host_launch_timing(). -1 otherwise.
+  int candidate = -1;
+};
+
+class backend_allocator;
+
 class kernel_adaptivity_engine {
 public:
   kernel_adaptivity_engine(
@@ -38,7 +57,80 @@ public:
   finalize_binary_configuration(kernel_configuration &config);
 
   std::string select_image_and_kernels(std::vector<std::string>* kernel_names_out);
+
+  /// Implements tiered JIT compilation. If enabled and the fully optimized
+  /// binary for config is not available yet, config is turned into a
+  /// baseline configuration that is cheap to JIT-compile. Once the kernel
+  /// has been launched sufficiently often, the optimized binary is compiled
+  /// in the background and picked up by subsequent launches.
+  ///
+  /// \c make_jit_compiler(config, binary_id) must return a callable with
+  /// signature result(std::string&) that compiles the given configuration
+  /// without referencing state of the current launch.
+  /// Must be called after finalize_binary_configuration().
+  /// \return The id of the binary that should be used for this launch.
+  template <class JitCompilerFactory>
+  kernel_configuration::id_type
+  select_compilation_tier(kernel_configuration &config,
+                          kernel_configuration::id_type binary_id,
+                          JitCompilerFactory &&make_jit_compiler,
+                          kernel_cache &cache) const {
+    if(!is_tiered_compilation_enabled() || cache.is_binary_available(binary_id))
+      return binary_id;
+
+    if(cache.register_invocation(binary_id) >= get_tier_up_threshold())
+      cache.compile_in_background(binary_id,
+                                  make_jit_compiler(config, binary_id));
+
+    config.set_build_flag(kernel_build_flag::baseline_optimization);
+    return config.generate_id();
+  }
+
+  /// Selects the distribution of work groups across threads for host
+  /// backends. If no optimal configuration is known yet for this kernel
+  /// and problem size, returns the next candidate configuration to measure.
+  /// Must be called after finalize_binary_configuration().
+  host_launch_configuration select_host_launch_configuration() const;
+
+  void register_host_launch_timing(const host_launch_configuration &config,
+                                   uint64_t time_ns) const;
+
+  /// If all pointer arguments of the kernel point into allocations known to
+  /// allocator, config is turned into a configuration which lists the
+  /// arguments that no other argument shares an allocation with. The JIT
+  /// compiler marks these as noalias, unless the kernel accesses memory
+  /// through pointers that do not originate from its arguments.
+  /// Otherwise, the binary remains generic.
+  /// Must be called after finalize_binary_configuration().
+  /// \return The id of the binary that should be used for this launch.
+  kernel_configuration::id_type
+  select_noalias_variant(kernel_configuration &config,
+                         kernel_configuration::id_type binary_id,
+                         const backend_allocator *allocator) const;
+
+  /// Implements profile-guided optimization. For the first launches of the
+  /// binary binary_id, config is turned into a configuration that collects a
+  /// branch profile. Afterwards, the collected profile is added to config
+  /// to guide the optimization of the final binary. The appdb is only
+  /// accessed until the profile of binary_id is complete.
+  /// Must be called after finalize_binary_configuration().
+  /// \return The id of the binary that should be used for this launch.
+  kernel_configuration::id_type
+  select_pgo_variant(kernel_configuration &config,
+                     kernel_configuration::id_type binary_id);
+
+  /// Whether the binary selected by select_pgo_variant() collects a profile.
+  /// The counters of the binary should then be reported using
+  /// register_pgo_branch_counters() after the launch.
+  bool is_pgo_training_launch() const;
+
+  void register_pgo_branch_counters(const std::vector<uint64_t> &counters) const;
 private:
+  bool is_host_launch_tuning_enabled() const;
+  bool is_tiered_compilation_enabled() const;
+  std::size_t get_tier_up_threshold() const;
+  uint64_t get_problem_size_bucket() const;
+
   hcf_object_id _hcf;
   std::string_view _kernel_name;
   const hcf_kernel_info* _kernel_info;
@@ -51,6 +143,12 @@ private:
   std::size_t _local_mem_size;
 
   int _adaptivity_level;
+  // Identifies the kernel and its base configuration in the appdb
+  kernel_configuration::id_type _base_config_id = {};
+  bool _has_base_config_id = false;
+  // Identifies the binary whose branch profile is being collected
+  kernel_configuration::id_type _pgo_profile_id = {};
+  bool _is_pgo_training_launch = false;
 };
 
 }
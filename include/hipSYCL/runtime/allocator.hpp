@@ -50,6 +50,16 @@ public:
   virtual result mem_advise(const void *addr, std::size_t num_bytes,
                             int advise) const = 0;
 
+  // Query the base address and size of the allocation containing the given
+  // pointer. If the allocation is unknown or the backend does not track
+  // allocations, returns non-success result.
+  virtual result query_allocation_range(const void *ptr, const void *&base_out,
+                                        std::size_t &size_out) const {
+    return make_error(__acpp_here(),
+                      error_info{"Allocation ranges cannot be queried",
+                                 error_type::feature_not_supported});
+  }
+
   virtual ~backend_allocator(){}
 };
 
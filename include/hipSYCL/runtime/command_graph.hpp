@@ -0,0 +1,134 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_RT_COMMAND_GRAPH_HPP
+#define HIPSYCL_RT_COMMAND_GRAPH_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "dag_node.hpp"
+#include "device_id.hpp"
+#include "error.hpp"
+#include "hints.hpp"
+
+#ifdef ACPP_GENERATE_EXPORT_HEADERS
+#include <accp_rt_export.h>
+#else
+#define ACPP_RT_EXPORT
+#endif
+
+namespace hipsycl {
+namespace rt {
+
+class operation;
+class backend_executor;
+class runtime;
+
+class executable_command_graph;
+
+/// A sequence of operations that is recorded once and can then be
+/// instantiated into an executable_command_graph that is replayed
+/// many times.
+///
+/// Recorded nodes are never submitted; they only serve as handles that
+/// later recorded operations can depend on. Dependencies on nodes that
+/// were not recorded into this graph are not part of the graph.
+class ACPP_RT_EXPORT command_graph {
+public:
+  command_graph(runtime* rt);
+
+  /// Records op. Returns a node that represents op within the graph,
+  /// and that may be passed as requirement to subsequent record() calls.
+  /// The hints must contain a bind_to_device hint, and op must support
+  /// operation::clone(). Each instantiation works on its own copy of op.
+  result record(std::unique_ptr<operation> op, const node_list_t &requirements,
+                const execution_hints &hints, dag_node_ptr &node_out);
+
+  std::size_t get_num_nodes() const;
+
+  /// Resolves executors, execution lanes and dependencies of all
+  /// recorded operations.
+  result instantiate(std::shared_ptr<executable_command_graph> &out) const;
+
+private:
+  struct recorded_node {
+    std::shared_ptr<operation> op;
+    dag_node_ptr node;
+    std::vector<std::size_t> dependencies;
+  };
+
+  runtime* _rt;
+  std::vector<recorded_node> _nodes;
+  mutable std::mutex _mutex;
+};
+
+/// A command graph for which all scheduling decisions have been made.
+/// Executing it dispatches the recorded operations directly to the
+/// execution lanes that were selected during instantiation, without
+/// going through the dag builder or scheduler.
+class ACPP_RT_EXPORT executable_command_graph {
+public:
+  /// Submits all operations of the graph. Root operations depend on
+  /// external_dependencies, which may contain nodes that have not yet been
+  /// submitted.
+  /// If submission_hints contain a node_group hint, it is attached to all
+  /// created nodes.
+  /// sink_out receives a node that completes once all operations
+  /// of this execution have completed.
+  result execute(const execution_hints &submission_hints,
+                 const node_list_t &external_dependencies,
+                 dag_node_ptr &sink_out);
+
+  /// Replaces the kernel function object of the SSCP kernel that was
+  /// recorded as recorded_node for all subsequent executions.
+  /// kernel_name must be the name of the recorded kernel, and data must
+  /// point to size bytes of the new kernel function object.
+  /// Executions that have already been submitted are not affected.
+  result set_kernel_args(const dag_node_ptr &recorded_node,
+                         const char *kernel_name, const void *data,
+                         std::size_t size);
+
+  std::size_t get_num_nodes() const;
+
+private:
+  friend class command_graph;
+
+  struct executable_node {
+    // Submitted by every execution. set_kernel_args() replaces it with a
+    // modified copy while previous executions still reference it.
+    std::shared_ptr<operation> op;
+    // The node returned when the operation was recorded
+    dag_node_ptr recorded_node;
+    execution_hints hints;
+    device_id dev;
+    // The executor that nodes are assigned to
+    backend_executor* executor;
+    // The executor that operations are actually submitted to. For
+    // multi-lane executors this is the executor of the selected lane.
+    backend_executor* lane_executor;
+    std::vector<std::size_t> dependencies;
+    // Whether the node depends on the external dependencies of an execution
+    bool is_root;
+  };
+
+  executable_command_graph(runtime* rt);
+
+  runtime* _rt;
+  std::vector<executable_node> _nodes;
+  std::mutex _mutex;
+};
+
+}
+}
+
+#endif
@@ -50,9 +50,6 @@ public:
 
   std::size_t get_current_dag_size() const;
 private:
-  bool is_conflicting_access(const memory_requirement *mem_req,
-                             const data_user &user) const;
-
   dag_node_ptr build_node(std::unique_ptr<operation> op,
                           const requirements_list &requirements,
                           const execution_hints &hints);
@@ -43,9 +43,11 @@ using weak_node_list_t = common::small_vector<std::weak_ptr<dag_node>, 8>;
 class ACPP_RT_EXPORT dag_node
 {
 public:
+  /// The operation may be shared with other nodes, e.g. when the same
+  /// operation is replayed multiple times from a command graph.
   dag_node(const execution_hints& hints,
           const node_list_t& requirements,
-          std::unique_ptr<operation> op,
+          std::shared_ptr<operation> op,
           runtime* rt);
 
   ~dag_node();
@@ -92,6 +94,11 @@ public:
 
   // Add requirement if not already present
   void add_requirement(dag_node_ptr requirement);
+  // Add requirement if not already present, without searching the
+  // requirement graph for edges that the new requirement makes redundant.
+  // For callers that already know the relevant ordering, e.g. from
+  // data_user_tracker.
+  void add_direct_requirement(dag_node_ptr requirement);
   operation* get_operation() const;
   const weak_node_list_t& get_requirements() const;
 
@@ -130,7 +137,7 @@ private:
   std::size_t _assigned_execution_index;
 
   std::shared_ptr<dag_node_event> _event;
-  std::unique_ptr<operation> _operation;
+  std::shared_ptr<operation> _operation;
   /// This is a temporary solution to access operations
   /// executed for requirements; we should move to an
   /// API consisting of subnodes to properly handle
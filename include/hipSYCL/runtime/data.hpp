@@ -206,11 +206,29 @@ struct data_user
 };
 
 
+/// Tracks the operations that access a memory region.
+///
+/// Users are indexed by the page range that they access. For each page range,
+/// only the most recent writer and the readers that were added after it are
+/// kept. Since each of these readers is ordered after the writer, a new
+/// access never needs to depend on more than one of these two groups:
+/// * A read only conflicts with the most recent writer;
+/// * A write conflicts with the readers since the most recent writer,
+///   or with the writer itself if there are no such readers.
+/// Users of page ranges that are entirely covered by a new write are dropped,
+/// because the new writer will be ordered after them.
+///
+/// Page ranges are kept in the order of their most recent access. A writer
+/// is ordered after all users of its page range that existed when it was
+/// added, so a conflict query for a subrange of the writer's page range
+/// can stop at page ranges that were last accessed before the writer.
+///
+/// This allows answering conflict queries without searching the dependency
+/// graph for redundant edges.
 class data_user_tracker
 {
 public:
-  using user_iterator = std::vector<data_user>::iterator;
-  using const_user_iterator = std::vector<data_user>::const_iterator;
+  using page_range = std::pair<id<3>, range<3>>;
 
   data_user_tracker() = default;
   data_user_tracker(const data_user_tracker& other);
@@ -223,13 +241,48 @@ public:
   template<class F>
   void for_each_user(F f){
     std::lock_guard<std::mutex> lock{_lock};
-    // Iterate in reverse order over the users since
+    // Iterate in reverse order over the page ranges since
     // this will iterate over the newest users first.
-    // This is a more advantageous pattern e.g. during
-    // DAG construction as it allows finding the relevant users
-    // quicker.
-    for(int i = _users.size() - 1; i >= 0; --i) {
-      f(_users[i]);
+    for(int i = _epochs.size() - 1; i >= 0; --i) {
+      for(int j = _epochs[i].readers.size() - 1; j >= 0; --j)
+        f(_epochs[i].readers[j]);
+      if(_epochs[i].has_writer)
+        f(_epochs[i].last_writer);
+    }
+  }
+
+  /// Invokes f for all users that an access with the given mode to the
+  /// given page range has to be ordered after.
+  template<class F>
+  void for_each_conflicting_user(sycl::access::mode mode,
+                                 const page_range &pages, F f) {
+    std::lock_guard<std::mutex> lock{_lock};
+
+    bool is_write = mode != sycl::access::mode::read;
+    // Users added before this point are ordered before a conflicting
+    // user that was already found.
+    std::size_t ordered_before = 0;
+    for(auto it = _epochs.rbegin(); it != _epochs.rend(); ++it) {
+      auto& epoch = *it;
+      if(epoch.last_access < ordered_before)
+        break;
+      if(!page_ranges_intersect(epoch.pages, pages))
+        continue;
+
+      bool is_ordered_through_readers = false;
+      if(is_write) {
+        for(auto& reader : epoch.readers) {
+          if(!reader.user.expired()) {
+            is_ordered_through_readers = true;
+            f(reader);
+          }
+        }
+      }
+      if(!is_ordered_through_readers && epoch.has_writer)
+        f(epoch.last_writer);
+
+      if(epoch.has_writer && page_range_contains(epoch.pages, pages))
+        ordered_before = std::max(ordered_before, epoch.writer_access);
     }
   }
 
@@ -237,24 +290,33 @@ public:
 
   void release_dead_users();
 
-  template<class Predicate>
   void add_user(dag_node_ptr user, 
                 sycl::access::mode mode, 
                 sycl::access::target target, 
                 id<3> offset,
                 range<3> range,
-                Predicate replaces_user) {
-    std::lock_guard<std::mutex> lock{_lock};
+                const page_range& pages);
 
-    _users.erase(std::remove_if(_users.begin(), _users.end(), replaces_user), 
-      _users.end());
+private:
+  struct access_epoch {
+    page_range pages;
+    bool has_writer = false;
+    data_user last_writer;
+    // Read accesses since last_writer
+    std::vector<data_user> readers;
+    // Positions of the writer and of the most recent user in the
+    // sequence of all accesses
+    std::size_t writer_access = 0;
+    std::size_t last_access = 0;
+  };
 
-    _users.push_back(
-      data_user{std::weak_ptr<dag_node>(user), mode, target, offset, range});
-  }
+  static bool page_ranges_intersect(const page_range &a, const page_range &b);
+  static bool page_range_contains(const page_range &outer,
+                                  const page_range &inner);
 
-private:
-  std::vector<data_user> _users;
+  // Ordered by last_access
+  std::vector<access_epoch> _epochs;
+  std::size_t _num_accesses = 0;
   mutable std::mutex _lock;
 };
 
@@ -65,6 +65,11 @@ public:
     _event->wait();
   }
 
+  virtual bool is_available() const override {
+    return _t0.get_event()->is_complete() && (!_t1 || _t1->is_complete()) &&
+           _event->is_complete();
+  }
+
 private:
   host_timestamped_event _t0;
   std::shared_ptr<dag_node_event> _t1;
@@ -165,6 +165,13 @@ public:
     return entry.is_present();
   }
 
+  template <class HintT,
+            std::enable_if_t<std::is_base_of_v<hints::execution_hint, HintT>,
+                             int> = 0>
+  void clear_hint() {
+    get_entry<HintT>() = HintT{};
+  }
+
 private:
 
   template<class T>
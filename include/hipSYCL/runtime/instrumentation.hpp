@@ -62,6 +62,8 @@ public:
   /// This does not need to be called manually, as the instrumentation_set
   /// will call it automatically if an instrumentation result is requested.
   virtual void wait() const = 0;
+  /// Whether the result is available, such that wait() would not block
+  virtual bool is_available() const = 0;
   virtual ~instrumentation() = default;
 };
 
@@ -98,6 +100,23 @@ public:
     return i;
   }
 
+  /// Returns the given instrumentation if it was set up and its results
+  /// are available, and nullptr otherwise. Never blocks.
+  template<typename Instr>
+  const std::shared_ptr<Instr> get_if_available() const {
+    if(!_registration_complete)
+      return nullptr;
+
+    for(const auto& current : _instrs) {
+      if(current.first == typeid(Instr)) {
+        if(!current.second->is_available())
+          return nullptr;
+        return std::static_pointer_cast<Instr>(current.second);
+      }
+    }
+    return nullptr;
+  }
+
   template<typename Instr>
   void add_instrumentation(std::shared_ptr<Instr> instr) {
     assert(!_registration_complete);
@@ -160,6 +179,8 @@ public:
   }
 
   virtual void wait() const override {}
+
+  virtual bool is_available() const override { return true; }
 private:
   profiler_clock::time_point _time;
 };
@@ -16,6 +16,7 @@
 #include <memory>
 #include <optional>
 #include <array>
+#include <functional>
 #include "hipSYCL/common/hcf_container.hpp"
 #include "hipSYCL/common/small_map.hpp"
 #include "hipSYCL/common/unordered_dense.hpp"
@@ -259,6 +260,8 @@ private:
   mutable std::mutex _mutex;
 };
 
+class worker_thread;
+
 class ACPP_RT_EXPORT kernel_cache {
 public:
   using code_object_id = kernel_configuration::id_type;
@@ -266,6 +269,8 @@ public:
 
   static std::shared_ptr<kernel_cache> get();
 
+  ~kernel_cache();
+
   template<class KernelT>
   void register_kernel() {
     // This function is not needed in the current implementation, but it might
@@ -326,7 +331,8 @@ public:
     // TODO: We might want to allow JIT compilation in parallel at some point
     std::lock_guard<std::mutex> lock{_mutex};
 
-    if(!persistent_cache_lookup(id_of_binary, compiled_binary)){
+    if(!background_binary_lookup(id_of_binary, compiled_binary) &&
+       !persistent_cache_lookup(id_of_binary, compiled_binary)){
       if(!jit_compile(compiled_binary))
         return nullptr;
 
@@ -350,6 +356,26 @@ public:
     return new_object;
   }
 
+  using background_jit_compiler = std::function<result(std::string &)>;
+
+  /// Schedules JIT compilation of the binary with id \c id_of_binary on a
+  /// background thread, unless it has been scheduled before. Once compilation
+  /// has finished, the binary is stored in the persistent cache and will be
+  /// picked up by get_or_construct_jit_code_object() instead of invoking the
+  /// JIT compiler again. \c jit_compile must not reference state of the
+  /// caller, since it may execute after the caller has returned.
+  void compile_in_background(code_object_id id_of_binary,
+                             background_jit_compiler jit_compile);
+
+  /// Whether the binary with the provided id can be obtained without
+  /// JIT compilation, either from a previous background compilation
+  /// or from the persistent cache.
+  bool is_binary_available(code_object_id id_of_binary) const;
+
+  /// Counts invocations of kernels using the binary with the provided id.
+  /// \return The number of invocations including this one.
+  std::size_t register_invocation(code_object_id id_of_binary);
+
   // Unload entire cache and release resources to prepare runtime shutdown.
   void unload();
 
@@ -357,6 +383,7 @@ public:
   static std::string get_persistent_cache_file(code_object_id id_of_binary);
 private:
   bool persistent_cache_lookup(code_object_id id_of_binary, std::string& out) const;
+  bool background_binary_lookup(code_object_id id_of_binary, std::string& out) const;
   void persistent_cache_store(code_object_id id_of_binary, const std::string& data) const;
   
   const code_object* get_code_object_impl(code_object_id id) const;
@@ -386,6 +413,21 @@ private:
       _code_objects;
   
   bool _is_first_jit_compilation = true;
+
+  // Results of background compilations, guarded by _background_mutex
+  // such that they can be stored while _mutex is held for a foreground
+  // JIT compilation.
+  mutable std::mutex _background_mutex;
+  ankerl::unordered_dense::map<code_object_id, std::string, rt::kernel_id_hash>
+      _background_binaries;
+  ankerl::unordered_dense::set<code_object_id, rt::kernel_id_hash>
+      _scheduled_background_compilations;
+  // Memoizes positive results of is_binary_available()
+  mutable ankerl::unordered_dense::set<code_object_id, rt::kernel_id_hash>
+      _available_binaries;
+  ankerl::unordered_dense::map<code_object_id, std::size_t, rt::kernel_id_hash>
+      _invocation_counts;
+  std::unique_ptr<worker_thread> _background_worker;
 };
 
 namespace detail {
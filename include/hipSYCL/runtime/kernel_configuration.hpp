@@ -47,6 +47,13 @@ enum class kernel_build_option : int {
   known_group_size_y,
   known_group_size_z,
   known_local_mem_size,
+  known_num_groups_x,
+  known_num_groups_y,
+  known_num_groups_z,
+  // Branch counters collected by a pgo_instrumentation binary
+  pgo_branch_profile,
+  // Indices of pointer arguments that point into distinct allocations
+  noalias_pointer_arguments,
 
   ptx_version,
   ptx_target_device,
@@ -55,12 +62,23 @@ enum class kernel_build_option : int {
   amdgpu_rocm_device_libs_path,
   amdgpu_rocm_path,
 
-  spirv_dynamic_local_mem_allocation_size
+  spirv_dynamic_local_mem_allocation_size,
+
+  host_target_cpu,
+  host_target_features,
+  // Identifies the host CPU and its features in configuration ids, without
+  // hashing the full feature string for every launch
+  host_target_id
 };
 
 enum class kernel_build_flag : int {
   global_sizes_fit_in_int,
   fast_math,
+  // Tier 0 of tiered JIT compilation: Only run a minimal optimization
+  // pipeline to minimize JIT latency
+  baseline_optimization,
+  // Collect a branch profile for profile-guided optimization
+  pgo_instrumentation,
 
   ptx_ftz,
   ptx_approx_div,
@@ -11,6 +11,7 @@
 #ifndef HIPSYCL_KERNEL_LAUNCHER_HPP
 #define HIPSYCL_KERNEL_LAUNCHER_HPP
 
+#include <cstring>
 #include <limits>
 #include <optional>
 #include <vector>
@@ -72,6 +73,9 @@ public:
   virtual void set_params(void*) = 0;
   virtual void invoke(dag_node *node,
                       const kernel_configuration &config) = 0;
+  // Returns a launcher for the same kernel that does not share any state
+  // with this one.
+  virtual std::unique_ptr<backend_kernel_launcher> clone() const = 0;
 
   void set_backend_capabilities(const backend_kernel_launch_capabilities& cap) {
     _capabilities = cap;
@@ -124,6 +128,45 @@ public:
   const kernel_configuration& get_kernel_configuration() const {
     return _kernel_config;
   }
+
+  // Total number of work items of the launch
+  std::size_t get_global_size() const {
+    return _static_data.global_size.size();
+  }
+
+  kernel_launcher clone() const {
+    common::auto_small_vector<std::unique_ptr<backend_kernel_launcher>>
+        kernels;
+    for(const auto& backend_launcher : _kernels)
+      kernels.emplace_back(backend_launcher->clone());
+
+    kernel_launcher result{_static_data, std::move(kernels)};
+    result._kernel_config = _kernel_config;
+    return result;
+  }
+
+  // Overwrites the beginning of the SSCP kernel argument blob, which holds
+  // the kernel function object. This is only possible if launches on
+  // the given backend go through SSCP.
+  rt::result update_sscp_kernel_args(backend_id id, const void *data,
+                                     std::size_t size) {
+    for(auto& backend_launcher : _kernels) {
+      if(backend_launcher->get_backend_score(id) >= 0)
+        return make_error(
+            __acpp_here(),
+            error_info{"Kernel arguments can only be updated for SSCP kernels",
+                       error_type::feature_not_supported});
+    }
+    if(!_static_data.sscp_kernel_id ||
+       _static_data.kernel_args.size() < size) {
+      return make_error(
+          __acpp_here(),
+          error_info{"Kernel arguments do not match the kernel",
+                     error_type::invalid_parameter_error});
+    }
+    std::memcpy(_static_data.kernel_args.data(), data, size);
+    return make_success();
+  }
 private:
   
   common::auto_small_vector<std::unique_ptr<backend_kernel_launcher>>
@@ -13,9 +13,12 @@
 
 #include <cmath>
 #include <cassert>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <atomic>
 #include <mutex>
+#include <unordered_map>
 
 #include "backend.hpp"
 #include "device_id.hpp"
@@ -108,6 +111,102 @@ private:
   std::vector<submission> _last_submissions;
 };
 
+/// Estimates how much work is outstanding on the execution lanes of a device.
+///
+/// Every submission is recorded together with its expected execution time.
+/// Expected execution times are learned per kernel and coarse launch size
+/// (or per class of data transfer) from execution start and finish
+/// timestamps of previous submissions. Since lanes are in-order queues,
+/// completed submissions can be removed from the front of the lane without
+/// querying every event.
+///
+/// Requesting timestamps adds two events to the sampled submissions, so
+/// only every sample_interval-th submission of an operation is measured.
+class ACPP_RT_EXPORT lane_occupancy_tracker {
+public:
+  lane_occupancy_tracker() = default;
+  lane_occupancy_tracker(std::size_t num_lanes, std::size_t sample_interval);
+
+  /// Expected execution time of op in nanoseconds
+  double estimate_cost(operation *op) const;
+  /// Whether execution timestamps should be requested for the next
+  /// submission of op to improve the cost estimate.
+  bool should_sample(operation *op);
+
+  void insert(std::size_t lane, const dag_node_ptr &node, operation *op);
+  /// Removes completed submissions from the lane, and learns from
+  /// their execution timestamps.
+  void update(std::size_t lane, inorder_queue *q);
+
+  /// Expected time in nanoseconds until all submissions of the lane
+  /// have completed
+  double get_expected_backlog(std::size_t lane) const;
+  /// Expected time in nanoseconds until node has completed. Returns 0
+  /// if node is not outstanding in the given lane.
+  double get_expected_completion(std::size_t lane,
+                                 const dag_node_ptr &node) const;
+
+private:
+  struct cost_key {
+    // Global kernel name, or 0 for other operations
+    std::uintptr_t kernel;
+    // Type of the operation and size class of the launch or transfer
+    std::size_t bucket;
+
+    bool operator==(const cost_key &other) const {
+      return kernel == other.kernel && bucket == other.bucket;
+    }
+  };
+
+  struct cost_key_hash {
+    std::size_t operator()(const cost_key &key) const {
+      return std::hash<std::uintptr_t>{}(key.kernel) ^
+             (std::hash<std::size_t>{}(key.bucket) << 1);
+    }
+  };
+
+  struct submission {
+    std::weak_ptr<dag_node> node;
+    // Only used to identify the submission, never dereferenced
+    const dag_node *node_address;
+    cost_key key;
+    // Sum of the expected costs of all submissions of the lane
+    // up to and including this one
+    double expected_end;
+  };
+
+  struct lane {
+    std::deque<submission> submissions;
+    // Running sums of the expected costs of the submissions that were
+    // inserted into and removed from the lane
+    double inserted_cost = 0.0;
+    double retired_cost = 0.0;
+    std::unordered_map<const dag_node *, double> expected_ends;
+  };
+
+  struct cost_estimate {
+    double mean_ns = 0.0;
+    std::size_t num_samples = 0;
+    std::size_t num_submissions = 0;
+  };
+
+  static cost_key get_cost_key(operation *op);
+  // Returns false if the execution timestamps of s are not yet available.
+  // Never blocks, since it is invoked while the executor is locked.
+  bool learn(const submission &s);
+  void retire(lane &l, const submission &s);
+
+  std::vector<lane> _lanes;
+  // Completed submissions whose timestamps were not yet available
+  std::vector<submission> _pending_samples;
+  std::unordered_map<cost_key, cost_estimate, cost_key_hash> _costs;
+  // Sum of the estimates of all measured operations, which is used for
+  // operations that were not measured yet
+  double _total_measured_cost = 0.0;
+  std::size_t _num_measured_costs = 0;
+  std::size_t _sample_interval = 0;
+};
+
 /// An executor that submits tasks by serializing them onto 
 /// to multiple inorder queues (e.g. CUDA streams)
 class ACPP_RT_EXPORT multi_queue_executor : public backend_executor
@@ -148,6 +247,10 @@ public:
   virtual bool is_submitted_by_me(const dag_node_ptr& node) const override;
 
   bool find_assigned_lane_index(const dag_node_ptr& node, std::size_t& index_out) const;
+
+  // Returns the executor managing the given lane of the given device.
+  // Submitting to it directly bypasses lane selection.
+  inorder_executor* get_lane_executor(device_id dev, std::size_t lane) const;
 private:
   
 
@@ -183,6 +286,8 @@ private:
     backend_execution_lane_range kernel_lanes;
 
     moving_statistics submission_statistics;
+    lane_occupancy_tracker occupancy;
+    std::mutex occupancy_lock;
 
     void add_executor(std::unique_ptr<inorder_executor>&& e)
     {
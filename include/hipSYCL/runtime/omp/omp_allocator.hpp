@@ -11,6 +11,10 @@
 #ifndef HIPSYCL_OMP_ALLOCATOR_HPP
 #define HIPSYCL_OMP_ALLOCATOR_HPP
 
+#include <cstdint>
+#include <map>
+#include <mutex>
+
 #include "../allocator.hpp"
 
 namespace hipsycl {
@@ -36,8 +40,18 @@ public:
 
   virtual result mem_advise(const void *addr, std::size_t num_bytes,
                             int advise) const override;
+
+  virtual result query_allocation_range(const void *ptr, const void *&base_out,
+                                        std::size_t &size_out) const override;
 private:
   device_id _my_device;
+
+  // Allocations are only tracked if noalias inference is enabled, since
+  // tracking serializes all allocations and deallocations.
+  bool _track_allocations;
+  // Sizes of live allocations, indexed by base address
+  mutable std::mutex _allocation_mutex;
+  std::map<std::uintptr_t, std::size_t> _allocations;
 };
 
 }
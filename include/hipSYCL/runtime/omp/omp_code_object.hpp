@@ -64,15 +64,23 @@ public:
   virtual void *get_module() const;
   virtual omp_sscp_kernel *get_kernel(std::string_view backend_kernel_name) const;
 
+  // Returns the branch counters of a binary built with the pgo-instrumentation
+  // flag, and resets them. Empty if the binary does not collect a profile.
+  std::vector<uint64_t> take_pgo_branch_counters() const;
+
 private:
   result build(const std::string &source, const std::vector<std::string> &kernel_names);
+  void *get_symbol(const std::string &symbol_name) const;
 
   hcf_object_id _hcf;
   kernel_configuration::id_type _id;
   std::string _kernel_cache_path;
 
   result _build_result;
+  // Either a handle from dlopen(), or a handle to a kernel object
+  // linked into the in-process JIT.
   void *_module;
+  bool _is_jit_linked;
 
   std::vector<std::string> _kernel_names;
   std::unordered_map<std::string_view, omp_sscp_kernel*> _kernels;
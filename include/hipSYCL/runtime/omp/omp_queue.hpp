@@ -22,6 +22,7 @@ namespace hipsycl {
 namespace rt {
 
 class omp_queue;
+class omp_backend;
 
 class omp_sscp_code_object_invoker : public sscp_code_object_invoker {
 public:
@@ -50,7 +51,7 @@ private:
 class omp_queue : public inorder_queue
 {
 public:
-  omp_queue(backend_id id);
+  omp_queue(omp_backend* be, backend_id id);
   virtual ~omp_queue();
 
   /// Inserts an event into the stream
@@ -84,6 +85,7 @@ public:
 
   worker_thread& get_worker();
 private:
+  omp_backend* _backend;
   const backend_id _backend_id;
   worker_thread _worker;
 
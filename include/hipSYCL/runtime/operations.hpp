@@ -85,6 +85,12 @@ public:
 
   virtual result dispatch(operation_dispatcher* dispatch, const dag_node_ptr& node) = 0;
 
+  /// Returns a copy of the operation that does not share state with this
+  /// one, or nullptr if the operation cannot be copied.
+  virtual std::unique_ptr<operation> clone() const { return nullptr; }
+  /// Whether clone() returns a copy of the operation
+  virtual bool can_clone() const { return false; }
+
   instrumentation_set &get_instrumentations();
   const instrumentation_set &get_instrumentations() const;
 
@@ -354,6 +360,9 @@ public:
     return dispatcher->dispatch_kernel(this, node);
   }
 
+  std::unique_ptr<operation> clone() const override;
+  bool can_clone() const override { return true; }
+
   /// Initialize embedded pointers of a kernel. A kernel might consist
   /// of multiple blob components, such as the body as well as reduction
   /// variables.
@@ -416,6 +425,9 @@ public:
     return _kernel_name;
   }
 private:
+  kernel_operation(const char *kernel_name, kernel_launcher &&launcher,
+                   const node_list_t &requirements);
+
   const char* _kernel_name;
   kernel_launcher _launcher;
   // We store shared_ptr to the memory requirement nodes to make sure
@@ -492,6 +504,9 @@ public:
   }
   void dump(std::ostream &ostr, int indentation = 0) const override final;
 
+  std::unique_ptr<operation> clone() const final override;
+  bool can_clone() const final override { return true; }
+
   virtual bool has_preferred_backend(backend_id &preferred_backend,
                                      device_id &preferred_device) const override {
     if (_source.get_device().get_full_backend_descriptor().hw_platform !=
@@ -522,6 +537,11 @@ public:
     return dispatcher->dispatch_prefetch(this, node);
   }
 
+  std::unique_ptr<operation> clone() const final override {
+    return std::make_unique<prefetch_operation>(_ptr, _num_bytes, _target);
+  }
+  bool can_clone() const final override { return true; }
+
   const void *get_pointer() const { return _ptr; }
   std::size_t get_num_bytes() const { return _num_bytes; }
   device_id get_target() const { return _target; }
@@ -544,6 +564,11 @@ public:
     return dispatcher->dispatch_memset(this, node);
   }
 
+  std::unique_ptr<operation> clone() const final override {
+    return std::make_unique<memset_operation>(_ptr, _pattern, _num_bytes);
+  }
+  bool can_clone() const final override { return true; }
+
   void *get_pointer() const { return _ptr; }
   unsigned char get_pattern() const { return _pattern; }
   std::size_t get_num_bytes() const { return _num_bytes; }
@@ -14,6 +14,7 @@
 #include "dag_manager.hpp"
 #include "backend.hpp"
 #include "settings.hpp"
+#include "usm_memory_pool.hpp"
 
 #include <memory>
 #include <iostream>
@@ -46,10 +47,15 @@ public:
 
   const backend_manager &backends() const { return _backends; }
 
+  usm_memory_pool_manager &usm_pools() { return _usm_pools; }
+
 private:
   // !! Attention: order is important, as backends have to be still present,
   // when the dag_manager is destructed!
   backend_manager _backends;
+  // Pools must be destroyed after the dag_manager has waited for all
+  // operations that might still use pool allocations.
+  usm_memory_pool_manager _usm_pools;
   dag_manager _dag_manager;
 };
 
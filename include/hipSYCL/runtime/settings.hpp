@@ -102,6 +102,7 @@ enum class setting {
   dag_req_optimization_depth,
   mqe_lane_statistics_max_size,
   mqe_lane_statistics_decay_time_sec,
+  mqe_lane_timing_sample_interval,
   default_selector_behavior,
   hcf_dump_directory,
   persistent_runtime,
@@ -114,7 +115,15 @@ enum class setting {
   adaptivity_level,
   jitopt_iads_relative_threshold,
   jitopt_iads_relative_eviction_threshold,
-  jitopt_iads_relative_threshold_min_data
+  jitopt_iads_relative_threshold_min_data,
+  jitopt_host_launch_tuning_samples,
+  jitopt_tiered_compilation,
+  jitopt_tier_up_threshold,
+  jitopt_eager_specialization_max_variants,
+  jitopt_pgo_training_launches,
+  jitopt_known_global_range,
+  jitopt_noalias_inference,
+  usm_pool_release_threshold
 };
 
 template <setting S> struct setting_trait {};
@@ -135,6 +144,8 @@ HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::mqe_lane_statistics_max_size,
                               "rt_mqe_lane_statistics_max_size", std::size_t);
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::mqe_lane_statistics_decay_time_sec,
                               "rt_mqe_lane_statistics_decay_time_sec", double);
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::mqe_lane_timing_sample_interval,
+                              "rt_mqe_lane_timing_sample_interval", std::size_t);
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::default_selector_behavior,
                               "default_selector_behavior", default_selector_behavior);
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::hcf_dump_directory,
@@ -153,6 +164,23 @@ HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_iads_relative_eviction_threshold,
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_iads_relative_threshold_min_data,
                               "jitopt_iads_relative_threshold_min_data",
                               std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_host_launch_tuning_samples,
+                              "jitopt_host_launch_tuning_samples",
+                              std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_tiered_compilation,
+                              "jitopt_tiered_compilation", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_tier_up_threshold,
+                              "jitopt_tier_up_threshold", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_eager_specialization_max_variants,
+                              "jitopt_eager_specialization_max_variants", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_pgo_training_launches,
+                              "jitopt_pgo_training_launches", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_known_global_range,
+                              "jitopt_known_global_range", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_noalias_inference,
+                              "jitopt_noalias_inference", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::usm_pool_release_threshold,
+                              "rt_usm_pool_release_threshold", std::size_t)
 
 class settings
 {
@@ -171,6 +199,8 @@ public:
       return _mqe_lane_statistics_max_size;
     } else if constexpr (S == setting::mqe_lane_statistics_decay_time_sec) {
       return _mqe_lane_statistics_decay_time_sec;
+    } else if constexpr (S == setting::mqe_lane_timing_sample_interval) {
+      return _mqe_lane_timing_sample_interval;
     } else if constexpr (S == setting::default_selector_behavior) {
       return _default_selector_behavior;
     } else if constexpr (S == setting::hcf_dump_directory) {
@@ -197,6 +227,22 @@ public:
       return _jitopt_iads_relative_threshold_min_data;
     } else if constexpr(S == setting::jitopt_iads_relative_eviction_threshold) {
       return _jitopt_iads_relative_eviction_threshold;
+    } else if constexpr(S == setting::jitopt_host_launch_tuning_samples) {
+      return _jitopt_host_launch_tuning_samples;
+    } else if constexpr(S == setting::jitopt_tiered_compilation) {
+      return _jitopt_tiered_compilation;
+    } else if constexpr(S == setting::jitopt_tier_up_threshold) {
+      return _jitopt_tier_up_threshold;
+    } else if constexpr(S == setting::jitopt_eager_specialization_max_variants) {
+      return _jitopt_eager_specialization_max_variants;
+    } else if constexpr(S == setting::jitopt_pgo_training_launches) {
+      return _jitopt_pgo_training_launches;
+    } else if constexpr(S == setting::jitopt_known_global_range) {
+      return _jitopt_known_global_range;
+    } else if constexpr(S == setting::jitopt_noalias_inference) {
+      return _jitopt_noalias_inference;
+    } else if constexpr(S == setting::usm_pool_release_threshold) {
+      return _usm_pool_release_threshold;
     }
     return typename setting_trait<S>::type{};
   }
@@ -220,6 +266,8 @@ public:
         setting::mqe_lane_statistics_max_size>(100);
     _mqe_lane_statistics_decay_time_sec = get_environment_variable_or_default<
         setting::mqe_lane_statistics_decay_time_sec>(10.0);
+    _mqe_lane_timing_sample_interval = get_environment_variable_or_default<
+        setting::mqe_lane_timing_sample_interval>(16);
     _default_selector_behavior =
         get_environment_variable_or_default<setting::default_selector_behavior>(
             default_selector_behavior::strict);
@@ -249,6 +297,24 @@ public:
         get_environment_variable_or_default<setting::jitopt_iads_relative_eviction_threshold>(0.1);
     _jitopt_iads_relative_threshold_min_data =
         get_environment_variable_or_default<setting::jitopt_iads_relative_threshold_min_data>(1024);
+    _jitopt_host_launch_tuning_samples =
+        get_environment_variable_or_default<setting::jitopt_host_launch_tuning_samples>(3);
+    _jitopt_tiered_compilation =
+        get_environment_variable_or_default<setting::jitopt_tiered_compilation>(false);
+    _jitopt_tier_up_threshold =
+        get_environment_variable_or_default<setting::jitopt_tier_up_threshold>(16);
+    _jitopt_eager_specialization_max_variants =
+        get_environment_variable_or_default<
+            setting::jitopt_eager_specialization_max_variants>(4);
+    _jitopt_pgo_training_launches =
+        get_environment_variable_or_default<setting::jitopt_pgo_training_launches>(0);
+    _jitopt_known_global_range =
+        get_environment_variable_or_default<setting::jitopt_known_global_range>(true);
+    _jitopt_noalias_inference =
+        get_environment_variable_or_default<setting::jitopt_noalias_inference>(false);
+    _usm_pool_release_threshold =
+        get_environment_variable_or_default<setting::usm_pool_release_threshold>(
+            std::size_t{256} * 1024 * 1024);
   }
 
 private:
@@ -266,6 +332,7 @@ private:
   std::size_t _dag_requirement_optimization_depth;
   std::size_t _mqe_lane_statistics_max_size;
   double _mqe_lane_statistics_decay_time_sec;
+  std::size_t _mqe_lane_timing_sample_interval;
   default_selector_behavior _default_selector_behavior;
   std::string _hcf_dump_directory;
   bool _persistent_runtime;
@@ -280,6 +347,14 @@ private:
   double _jitopt_iads_relative_threshold;
   double _jitopt_iads_relative_eviction_threshold;
   std::size_t _jitopt_iads_relative_threshold_min_data;
+  std::size_t _jitopt_host_launch_tuning_samples;
+  bool _jitopt_tiered_compilation;
+  std::size_t _jitopt_tier_up_threshold;
+  std::size_t _jitopt_eager_specialization_max_variants;
+  std::size_t _jitopt_pgo_training_launches;
+  bool _jitopt_known_global_range;
+  bool _jitopt_noalias_inference;
+  std::size_t _usm_pool_release_threshold;
 };
 
 }
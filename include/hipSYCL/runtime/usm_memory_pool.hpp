@@ -0,0 +1,129 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_RT_USM_MEMORY_POOL_HPP
+#define HIPSYCL_RT_USM_MEMORY_POOL_HPP
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "dag_node.hpp"
+#include "device_id.hpp"
+#include "error.hpp"
+
+#ifdef ACPP_GENERATE_EXPORT_HEADERS
+#include <accp_rt_export.h>
+#else
+#define ACPP_RT_EXPORT
+#endif
+
+namespace hipsycl {
+namespace rt {
+
+class backend_allocator;
+class backend_manager;
+
+/// Identifies an ordering domain for pool allocations, e.g. an in-order queue.
+/// All operations submitted within the same stream are guaranteed to execute
+/// in submission order. Stream id 0 denotes the absence of any ordering
+/// guarantees.
+using usm_pool_stream_id = std::size_t;
+
+/// A per-device pool of device allocations with stream-ordered semantics.
+///
+/// Freed blocks are not returned to the backend immediately. Instead, they are
+/// kept together with the operations that must complete before the block can
+/// be reused (release dependencies). A block can be handed out again
+/// * immediately, if it is requested from the same stream it was freed on,
+///   since all later operations in that stream are ordered after the
+///   last use of the block;
+/// * from any stream, once all release dependencies have completed.
+///
+/// Checking release dependencies never blocks.
+class ACPP_RT_EXPORT usm_memory_pool {
+public:
+  usm_memory_pool(device_id dev, backend_allocator *alloc,
+                  std::size_t release_threshold);
+  ~usm_memory_pool();
+
+  usm_memory_pool(const usm_memory_pool&) = delete;
+  usm_memory_pool& operator=(const usm_memory_pool&) = delete;
+
+  /// Returns nullptr if the allocation could not be carried out.
+  void *allocate(std::size_t min_alignment, std::size_t size_bytes,
+                 usm_pool_stream_id stream);
+
+  /// Returns ptr to the pool. ptr may be reused once all nodes in
+  /// release_dependencies have completed, or earlier by requests from
+  /// the same stream.
+  result free(void *ptr, usm_pool_stream_id stream,
+              const node_list_t &release_dependencies);
+
+  /// Waits for pending release dependencies and returns cached blocks
+  /// to the backend until at most min_bytes_to_keep bytes remain cached.
+  void trim(std::size_t min_bytes_to_keep);
+
+  /// When the amount of cached memory exceeds this threshold, blocks
+  /// whose release dependencies have completed are returned to the backend.
+  void set_release_threshold(std::size_t bytes);
+  std::size_t get_release_threshold() const;
+
+  /// Total number of bytes currently obtained from the backend
+  std::size_t get_reserved_size() const;
+  /// Number of bytes currently handed out to users
+  std::size_t get_used_size() const;
+
+  bool owns(const void *ptr) const;
+  device_id get_device() const;
+private:
+  struct block {
+    void *ptr;
+    std::size_t size;
+    usm_pool_stream_id stream;
+    node_list_t release_dependencies;
+  };
+
+  using free_list_t = std::multimap<std::size_t, block>;
+
+  bool is_reusable(block &b, usm_pool_stream_id stream) const;
+  void release_completed_blocks(std::size_t max_cached_bytes);
+  free_list_t::iterator release_block(free_list_t::iterator it);
+
+  device_id _dev;
+  backend_allocator *_allocator;
+  std::size_t _release_threshold;
+
+  std::size_t _reserved_bytes = 0;
+  std::size_t _cached_bytes = 0;
+  free_list_t _free_blocks;
+  std::unordered_map<void *, std::size_t> _live_blocks;
+  mutable std::mutex _mutex;
+};
+
+/// Owns one usm_memory_pool per device. Pools are created lazily.
+class ACPP_RT_EXPORT usm_memory_pool_manager {
+public:
+  usm_memory_pool_manager(backend_manager *backends);
+
+  usm_memory_pool *get_pool(device_id dev);
+private:
+  backend_manager *_backends;
+  std::vector<std::unique_ptr<usm_memory_pool>> _pools;
+  std::mutex _mutex;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,344 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_PSTL_MULTI_DEVICE_DISPATCH_HPP
+#define HIPSYCL_PSTL_MULTI_DEVICE_DISPATCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/runtime.hpp"
+#include "hipSYCL/sycl/libkernel/functional.hpp"
+#include "offload.hpp"
+#include "sycl_glue.hpp"
+
+namespace hipsycl::stdpar::detail {
+
+/// Identity of binary reduction operations. Partitions of a reduction
+/// other than the first are initialized with it.
+template<class BinaryOp, class T, class = void>
+struct partition_identity {
+  static constexpr bool is_available = false;
+};
+
+template<class U, class T>
+struct partition_identity<std::plus<U>, T,
+                          std::enable_if_t<std::is_arithmetic_v<T>>> {
+  static constexpr bool is_available = true;
+  static constexpr T value = T{};
+};
+
+template<class U, class T>
+struct partition_identity<std::multiplies<U>, T,
+                          std::enable_if_t<std::is_arithmetic_v<T>>> {
+  static constexpr bool is_available = true;
+  static constexpr T value = T{1};
+};
+
+template <class BinaryOp, class T>
+struct partition_identity<
+    BinaryOp, T,
+    std::enable_if_t<sycl::has_known_identity<BinaryOp, T>::value>> {
+  static constexpr bool is_available = true;
+  static constexpr T value = sycl::known_identity_v<BinaryOp, T>;
+};
+
+/// Splits large offloaded algorithms across all devices available to the
+/// stdpar runtime, if multi-device execution was enabled using
+/// ACPP_STDPAR_MULTI_DEVICE. Partition i is executed on the device with
+/// index i, and partition sizes are proportional to the device weights.
+/// Device weights are refined whenever the runtime of a partitioned
+/// reduction can be measured.
+///
+/// Operations on other devices are ordered after all operations previously
+/// submitted to the primary queue, and the primary queue is ordered after
+/// all partitions. Therefore, partitioned algorithms can be treated like
+/// operations submitted to the primary queue.
+class multi_device_dispatch {
+public:
+  // Splitting work into smaller parts is not worth the additional
+  // synchronization between devices.
+  static constexpr std::size_t min_partition_size = 1024 * 1024;
+
+  template<typename... Iterators>
+  static std::size_t get_num_partitions(std::size_t problem_size) {
+    constexpr bool is_random_access =
+        (std::is_base_of_v<
+             std::random_access_iterator_tag,
+             typename std::iterator_traits<Iterators>::iterator_category> &&
+         ...);
+    if constexpr(!is_random_access) {
+      return 1;
+    } else {
+      std::size_t num_devices = stdpar_tls_runtime::get().get_num_devices();
+      return std::max(std::size_t{1}, std::min(num_devices,
+                                               problem_size / min_partition_size));
+    }
+  }
+
+  /// Invokes f(queue, begin, end) for each partition [begin, end) of
+  /// [0, problem_size). The accessed iterators are used to place the
+  /// memory of each partition on the device that processes it.
+  template<class F, typename... Iterators>
+  static void for_each_partition(sycl::queue &q, std::size_t problem_size,
+                                 F &&f, Iterators... accessed) {
+    std::size_t num_partitions = get_num_partitions<Iterators...>(problem_size);
+    if(num_partitions <= 1) {
+      f(q, 0, problem_size);
+      return;
+    }
+
+    submit_partitions(
+        q, get_partition_bounds(num_partitions, problem_size),
+        [&](sycl::queue &partition_queue, std::size_t partition,
+            std::size_t begin, std::size_t end) {
+          f(partition_queue, begin, end);
+        },
+        accessed...);
+  }
+
+  /// Computes op(init, ...) of the partial results that
+  /// f(queue, scratch, begin, end, output, partition_init) writes to output
+  /// for each partition [begin, end) of [0, problem_size), and waits
+  /// for completion. Reductions are only partitioned if op has a known
+  /// identity for T.
+  template <class T, class BinaryOp, class F, typename... Iterators>
+  static T reduce_partitions(sycl::queue &q, std::size_t problem_size,
+                             const T &init, BinaryOp op, F &&f,
+                             Iterators... accessed) {
+    auto& rt = stdpar_tls_runtime::get();
+
+    std::size_t num_partitions = 1;
+    if constexpr(partition_identity<BinaryOp, T>::is_available)
+      num_partitions = get_num_partitions<Iterators...>(problem_size);
+
+    // Note: Using scratch allocation_groups that expire at the end of the
+    // scope is safe because we wait on q before they expire, and q is ordered
+    // after all partitions. Each partition obtains its own allocations from
+    // the thread-local caches, so partitions running concurrently on
+    // different queues never share scratch memory.
+    auto output_scratch_group =
+        rt.make_scratch_group<algorithms::util::allocation_type::host>();
+    T* outputs = output_scratch_group.obtain<T>(num_partitions);
+
+    if(num_partitions <= 1) {
+      auto reduction_scratch_group =
+          rt.make_scratch_group<algorithms::util::allocation_type::device>();
+      f(q, reduction_scratch_group, 0, problem_size, outputs, init);
+      q.wait();
+      return outputs[0];
+    } else {
+      // The runtime of the partitions is only meaningful if they do not
+      // need to wait for other operations first.
+      bool is_measurable = rt.get_num_outstanding_operations() == 0;
+      auto bounds = get_partition_bounds(num_partitions, problem_size);
+
+      std::deque<algorithms::util::allocation_group,
+                 libc_allocator<algorithms::util::allocation_group>>
+          reduction_scratch_groups;
+      std::vector<std::vector<sycl::event>,
+                  libc_allocator<std::vector<sycl::event>>>
+          completion_events(num_partitions);
+
+      uint64_t start = get_time_now();
+      submit_partitions(
+          q, bounds,
+          [&](sycl::queue &partition_queue, std::size_t partition,
+              std::size_t begin, std::size_t end) {
+            reduction_scratch_groups.emplace_back(
+                &rt.get_scratch_cache<
+                    algorithms::util::allocation_type::device>(),
+                partition_queue.get_device().AdaptiveCpp_device_id());
+            T partition_init = init;
+            if constexpr(partition_identity<BinaryOp, T>::is_available)
+              if(partition > 0)
+                partition_init = partition_identity<BinaryOp, T>::value;
+            f(partition_queue, reduction_scratch_groups.back(), begin, end,
+              outputs + partition, partition_init);
+            if(is_measurable)
+              completion_events[partition] = partition_queue.get_wait_list();
+          },
+          accessed...);
+
+      if(is_measurable)
+        update_device_weights(bounds, completion_events, start);
+      q.wait();
+
+      T result = outputs[0];
+      for(std::size_t i = 1; i < num_partitions; ++i)
+        result = op(result, outputs[i]);
+      return result;
+    }
+  }
+
+  /// Moves weights[i] halfway towards the throughput measured for partition
+  /// [bounds[i], bounds[i + 1]), which completed elapsed_times[i]
+  /// nanoseconds after submission. The sum of the weights is preserved.
+  template <class BoundsVector, class TimeVector, class WeightVector>
+  static void update_weights(const BoundsVector &bounds,
+                             const TimeVector &elapsed_times,
+                             WeightVector &weights) {
+    constexpr double update_rate = 0.5;
+    std::size_t num_partitions = bounds.size() - 1;
+    auto throughput = [&](std::size_t i) {
+      return (bounds[i + 1] - bounds[i] + 1) /
+             (static_cast<double>(elapsed_times[i]) + 1.0);
+    };
+
+    double total_weight = 0.0;
+    double total_throughput = 0.0;
+    for(std::size_t i = 0; i < num_partitions; ++i) {
+      total_weight += weights[i];
+      total_throughput += throughput(i);
+    }
+    for(std::size_t i = 0; i < num_partitions; ++i) {
+      double measured_weight = total_weight * throughput(i) / total_throughput;
+      weights[i] =
+          (1.0 - update_rate) * weights[i] + update_rate * measured_weight;
+    }
+  }
+private:
+  using bounds_vector = std::vector<std::size_t, libc_allocator<std::size_t>>;
+
+  static bounds_vector get_partition_bounds(std::size_t num_partitions,
+                                            std::size_t problem_size) {
+    auto& rt = stdpar_tls_runtime::get();
+
+    double total_weight = 0.0;
+    for(std::size_t i = 0; i < num_partitions; ++i)
+      total_weight += rt.get_device_weight(i);
+
+    bounds_vector bounds(num_partitions + 1, 0);
+    double cumulative_weight = 0.0;
+    for(std::size_t i = 0; i < num_partitions; ++i) {
+      cumulative_weight += rt.get_device_weight(i);
+      bounds[i + 1] = std::min(
+          problem_size, static_cast<std::size_t>(
+                            problem_size * (cumulative_weight / total_weight)));
+      bounds[i + 1] = std::max(bounds[i + 1], bounds[i]);
+    }
+    bounds[num_partitions] = problem_size;
+    return bounds;
+  }
+
+  template<class It>
+  static void place_partition(sycl::queue &q, It first, std::size_t begin,
+                              std::size_t end) {
+    if constexpr(has_contiguous_elements<It>::value) {
+      if(end > begin) {
+        auto partition_begin = std::next(first, begin);
+        prefetch(q, std::addressof(*partition_begin),
+                 (end - begin) *
+                     sizeof(typename std::iterator_traits<It>::value_type));
+      }
+    }
+  }
+
+  template<class F, typename... Iterators>
+  static void submit_partitions(sycl::queue &q, const bounds_vector &bounds,
+                                F &&f, Iterators... accessed) {
+    auto& rt = stdpar_tls_runtime::get();
+    std::size_t num_partitions = bounds.size() - 1;
+
+    auto barrier = [](sycl::queue &barrier_queue,
+                      const std::vector<sycl::event> &dependencies) {
+      if(dependencies.empty())
+        return;
+      barrier_queue.submit([&](sycl::handler &cgh) {
+        cgh.depends_on(dependencies);
+        cgh.AdaptiveCpp_enqueue_custom_operation([](sycl::interop_handle &) {});
+      });
+    };
+
+    std::vector<sycl::event> primary_dependencies = q.get_wait_list();
+    std::vector<sycl::event> partition_completion;
+    for(std::size_t i = 1; i < num_partitions; ++i) {
+      sycl::queue& partition_queue = rt.get_queue(i);
+      barrier(partition_queue, primary_dependencies);
+      (place_partition(partition_queue, accessed, bounds[i], bounds[i + 1]),
+       ...);
+      f(partition_queue, i, bounds[i], bounds[i + 1]);
+      for(const auto &evt : partition_queue.get_wait_list())
+        partition_completion.push_back(evt);
+    }
+    (place_partition(q, accessed, bounds[0], bounds[1]), ...);
+    f(q, 0, bounds[0], bounds[1]);
+
+    barrier(q, partition_completion);
+  }
+
+  static bool is_complete(const std::vector<sycl::event>& events) {
+    for(const auto& evt : events)
+      if (evt.get_info<sycl::info::event::command_execution_status>() !=
+          sycl::info::event_command_status::complete)
+        return false;
+    return true;
+  }
+
+  template<class EventVector>
+  static void update_device_weights(const bounds_vector &bounds,
+                                    const EventVector &completion_events,
+                                    uint64_t start) {
+    // Polling at a fixed fraction of the elapsed time bounds the relative
+    // error of the measurement, while long-running partitions only cause
+    // a few wakeups of the calling thread.
+    constexpr uint64_t poll_interval_divisor = 32;
+    constexpr uint64_t min_poll_interval = 1000;
+    constexpr uint64_t max_poll_interval = 1000 * 1000;
+
+    auto& rt = stdpar_tls_runtime::get();
+    std::size_t num_partitions = bounds.size() - 1;
+
+    // Operations may still be cached in the dag builder, in which case
+    // they would never complete while we are polling.
+    rt::runtime_keep_alive_token requires_runtime;
+    requires_runtime.get()->dag().flush_sync();
+
+    std::vector<uint64_t, libc_allocator<uint64_t>> elapsed_times(
+        num_partitions, 0);
+    std::size_t num_pending = num_partitions;
+    while(num_pending > 0) {
+      uint64_t elapsed = get_time_now() - start;
+      for(std::size_t i = 0; i < num_partitions; ++i) {
+        if(elapsed_times[i] == 0 && is_complete(completion_events[i])) {
+          elapsed_times[i] = std::max(elapsed, uint64_t{1});
+          --num_pending;
+        }
+      }
+      if(num_pending > 0) {
+        uint64_t poll_interval =
+            std::clamp(elapsed / poll_interval_divisor, min_poll_interval,
+                       max_poll_interval);
+        std::this_thread::sleep_for(std::chrono::nanoseconds{poll_interval});
+      }
+    }
+
+    std::vector<double, libc_allocator<double>> weights(num_partitions);
+    for(std::size_t i = 0; i < num_partitions; ++i)
+      weights[i] = rt.get_device_weight(i);
+    update_weights(bounds, elapsed_times, weights);
+    for(std::size_t i = 0; i < num_partitions; ++i)
+      rt.set_device_weight(i, weights[i]);
+  }
+};
+
+}
+
+#endif
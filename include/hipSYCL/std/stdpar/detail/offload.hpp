@@ -30,8 +30,11 @@
 #include <algorithm>
 #include <chrono>
 #include <limits>
+#include <mutex>
 #include <sys/types.h>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace hipsycl::stdpar {
 
@@ -178,12 +181,278 @@ inline void prefetch(sycl::queue& q, const void* ptr, std::size_t bytes) noexcep
   }
 }
 
+/// Cost model for migrating shared USM memory between host and device:
+/// migrating n bytes is assumed to take latency + n / bandwidth ns.
+struct transfer_model {
+  // Fixed cost per migration in ns
+  double latency = 0.0;
+  // Migration bandwidth in bytes/ns. A value <= 0 indicates that migrations
+  // are free, e.g. because host and device share physical memory.
+  double bandwidth = 0.0;
+
+  double estimate_transfer_time(std::size_t num_bytes) const {
+    if(num_bytes == 0 || bandwidth <= 0.0)
+      return 0.0;
+    return latency + static_cast<double>(num_bytes) / bandwidth;
+  }
+};
+
+inline transfer_model measure_transfer_model(const sycl::device& dev) {
+  constexpr std::size_t small_size = 64 * 1024;
+  constexpr std::size_t large_size = 8 * 1024 * 1024;
+  constexpr int num_runs = 3;
+
+  // Peak PCIe bandwidth, used if the measurement cannot be carried out
+  transfer_model fallback;
+  fallback.bandwidth = 32.0;
+
+  // Use a separate queue so that the measurement is not ordered
+  // after user operations.
+  sycl::queue q{dev, sycl::property_list{sycl::property::queue::in_order{}}};
+  char* data = sycl::malloc_shared<char>(large_size, q);
+  if(!data)
+    return fallback;
+
+  auto measure = [&](std::size_t num_bytes) -> double {
+    uint64_t best = std::numeric_limits<uint64_t>::max();
+    for(int i = 0; i < num_runs; ++i) {
+      // Touching the data on the host makes it host-resident
+      std::memset(data, i, num_bytes);
+      uint64_t start = get_time_now();
+      q.prefetch(data, num_bytes);
+      q.wait();
+      best = std::min(best, get_time_now() - start);
+    }
+    return static_cast<double>(best);
+  };
+  double small_time = measure(small_size);
+  double large_time = measure(large_size);
+  sycl::free(data, q);
+
+  transfer_model model;
+  double delta_time = large_time - small_time;
+  if(delta_time > 0.0) {
+    model.bandwidth = static_cast<double>(large_size - small_size) / delta_time;
+    model.latency =
+        std::max(0.0, small_time - static_cast<double>(small_size) /
+                                       model.bandwidth);
+  }
+  HIPSYCL_DEBUG_INFO << "[stdpar] Measured memory migration model for device "
+                     << dev.get_info<sycl::info::device::name>()
+                     << ": latency " << model.latency << " ns, bandwidth "
+                     << model.bandwidth << " bytes/ns" << std::endl;
+  return model;
+}
+
+/// Returns the transfer model for the device, measuring it upon first use.
+inline transfer_model get_transfer_model(const sycl::device& dev) {
+  using entry = std::pair<rt::device_id, transfer_model>;
+  static std::vector<entry, libc_allocator<entry>> models;
+  static std::mutex mutex;
+
+  rt::device_id id = dev.AdaptiveCpp_device_id();
+  std::lock_guard<std::mutex> lock{mutex};
+  for(const auto& m : models)
+    if(m.first == id)
+      return m.second;
+
+  transfer_model model = measure_transfer_model(dev);
+  models.push_back(std::make_pair(id, model));
+  return model;
+}
+
+template<class T, class = void>
+struct has_contiguous_elements : std::false_type {};
+
+// Random access iterators whose pointer type is a raw pointer to the value
+// type, which covers raw pointers as well as the iterators of contiguous
+// standard containers.
+template <class T>
+struct has_contiguous_elements<
+    T, std::void_t<typename std::iterator_traits<T>::iterator_category,
+                   typename std::iterator_traits<T>::pointer>>
+    : std::bool_constant<
+          std::is_base_of_v<
+              std::random_access_iterator_tag,
+              typename std::iterator_traits<T>::iterator_category> &&
+          std::is_pointer_v<typename std::iterator_traits<T>::pointer> &&
+          std::is_same_v<
+              std::remove_cv_t<std::remove_pointer_t<
+                  typename std::iterator_traits<T>::pointer>>,
+              std::remove_cv_t<
+                  typename std::iterator_traits<T>::value_type>>> {};
+
+/// Invokes h(lookup_result, begin, end) for each USM allocation that the
+/// algorithm arguments point into, where [begin, end) is the byte range
+/// relative to the start of the allocation that an algorithm with the given
+/// problem size might access. For iterators over contiguous elements this is
+/// the range covered by problem_size elements, for all other pointers (e.g.
+/// pointers captured by a function object) the remainder of the allocation.
+/// unknown_handler() is invoked for each pointer that does not point
+/// into a USM allocation.
+template<class Handler, class UnknownHandler, class Size, typename... Args>
+void visit_accessed_allocation_ranges(Handler &&h,
+                                      UnknownHandler &&unknown_handler,
+                                      Size problem_size, const Args &...args) {
+  auto f = [&](const auto& arg) {
+    using arg_type = std::decay_t<decltype(arg)>;
+    int num_pointers = 0;
+    for_each_contained_pointer([&](void*){ ++num_pointers; }, arg);
+
+    std::size_t max_accessed_bytes = std::numeric_limits<std::size_t>::max();
+    if constexpr(has_contiguous_elements<arg_type>::value) {
+      if(num_pointers == 1)
+        max_accessed_bytes =
+            static_cast<std::size_t>(problem_size) *
+            sizeof(typename std::iterator_traits<arg_type>::value_type);
+    }
+
+    for_each_contained_pointer([&](void* ptr){
+      unified_shared_memory::allocation_lookup_result lookup_result;
+      if(unified_shared_memory::allocation_lookup(ptr, lookup_result)) {
+        uint64_t size = lookup_result.info->allocation_size;
+        uint64_t begin = std::min<uint64_t>(
+            size, static_cast<char *>(ptr) -
+                      static_cast<char *>(lookup_result.root_address));
+        uint64_t end = begin + std::min<uint64_t>(size - begin,
+                                                  max_accessed_bytes);
+        h(lookup_result, begin, end);
+      } else {
+        unknown_handler();
+      }
+    }, arg);
+  };
+  (f(args), ...);
+}
+
+/// Invokes h(info, begin, end) for each USM allocation that the algorithm
+/// arguments point into, where [begin, end) is the accessed byte range
+/// relative to the start of the allocation.
+template<class Handler, class Size, typename... Args>
+void for_each_accessed_allocation_range(Handler &&h, Size problem_size,
+                                        const Args &...args) {
+  visit_accessed_allocation_ranges(
+      [&](const auto &lookup_result, uint64_t begin, uint64_t end) {
+        h(lookup_result.info, begin, end);
+      },
+      []() {}, problem_size, args...);
+}
+
+// The residency of an allocation is tracked as a single byte range. Need to
+// use atomic builtins until we can use C++ 20 atomic_ref. Concurrent updates
+// may leave the range imprecise, which only affects offloading decisions.
+template<class AllocationInfo>
+std::pair<uint64_t, uint64_t>
+get_device_resident_range(AllocationInfo *info) {
+  return std::make_pair(
+      __atomic_load_n(&info->device_resident_begin, __ATOMIC_RELAXED),
+      __atomic_load_n(&info->device_resident_end, __ATOMIC_RELAXED));
+}
+
+template<class AllocationInfo>
+void set_device_resident_range(AllocationInfo *info, uint64_t begin,
+                               uint64_t end) {
+  if(begin >= end)
+    begin = end = 0;
+  __atomic_store_n(&info->device_resident_begin, begin, __ATOMIC_RELAXED);
+  __atomic_store_n(&info->device_resident_end, end, __ATOMIC_RELAXED);
+}
+
+/// Number of bytes in [begin, end) that are currently device-resident
+template<class AllocationInfo>
+uint64_t get_num_device_resident_bytes(AllocationInfo *info, uint64_t begin,
+                                       uint64_t end) {
+  auto resident = get_device_resident_range(info);
+  uint64_t overlap_begin = std::max(begin, resident.first);
+  uint64_t overlap_end = std::min(end, resident.second);
+  return overlap_end > overlap_begin ? overlap_end - overlap_begin : 0;
+}
+
+template<class AllocationInfo>
+void mark_device_resident(AllocationInfo *info, uint64_t begin, uint64_t end) {
+  if(begin >= end)
+    return;
+  auto resident = get_device_resident_range(info);
+  if(resident.first < resident.second) {
+    begin = std::min(begin, resident.first);
+    end = std::max(end, resident.second);
+  }
+  set_device_resident_range(info, begin, end);
+}
+
+template<class AllocationInfo>
+void mark_host_resident(AllocationInfo *info, uint64_t begin, uint64_t end) {
+  auto resident = get_device_resident_range(info);
+  if(end <= resident.first || begin >= resident.second)
+    return;
+  // Keep the larger of the remaining parts
+  uint64_t lower_part = begin > resident.first ? begin - resident.first : 0;
+  uint64_t upper_part = resident.second > end ? resident.second - end : 0;
+  if(lower_part >= upper_part)
+    set_device_resident_range(info, resident.first, resident.first + lower_part);
+  else
+    set_device_resident_range(info, end, resident.second);
+}
+
+/// Records the memory that an operation that is about to be offloaded
+/// might access, if dependency tracking is enabled.
+template<class Size, typename... Args>
+void track_device_accesses(Size problem_size, const Args&... args) {
+  auto& rt = stdpar_tls_runtime::get();
+  if(!rt.is_dependency_tracking_enabled())
+    return;
+
+  auto& tracker = rt.get_device_access_tracker();
+  visit_accessed_allocation_ranges(
+      [&](const auto &lookup_result, uint64_t begin, uint64_t end) {
+        uint64_t root =
+            reinterpret_cast<uint64_t>(lookup_result.root_address);
+        tracker.add_range(root + begin, root + end);
+      },
+      [&]() { tracker.add_unknown_range(); }, problem_size, args...);
+}
+
+/// Returns whether executing an algorithm with the given arguments on the
+/// host cannot interfere with outstanding offloaded operations, such that it
+/// does not need to wait for them. Always returns false if dependency
+/// tracking is disabled.
+template<class AlgorithmType, class Size, typename... Args>
+bool is_independent_of_outstanding_operations(AlgorithmType type,
+                                              Size problem_size,
+                                              const Args &...args) {
+  auto& rt = stdpar_tls_runtime::get();
+  if(!rt.is_dependency_tracking_enabled())
+    return false;
+  if(rt.get_num_outstanding_operations() == 0)
+    return true;
+
+  const auto& tracker = rt.get_device_access_tracker();
+  bool is_independent = true;
+  visit_accessed_allocation_ranges(
+      [&](const auto &lookup_result, uint64_t begin, uint64_t end) {
+        uint64_t root =
+            reinterpret_cast<uint64_t>(lookup_result.root_address);
+        if(tracker.overlaps(root + begin, root + end))
+          is_independent = false;
+      },
+      [&]() { is_independent = false; }, problem_size, args...);
+
+  if(is_independent)
+    HIPSYCL_DEBUG_INFO << "[stdpar] Executing algorithm on host without "
+                          "waiting for "
+                       << rt.get_num_outstanding_operations()
+                       << " independent outstanding operations" << std::endl;
+  return is_independent;
+}
+
 template<class AlgorithmType, class Size, typename... Args>
 void prepare_offloading(AlgorithmType type, Size problem_size, const Args&... args) {
   auto& q = detail::single_device_dispatch::get_queue();
   std::size_t current_batch_id = stdpar::detail::stdpar_tls_runtime::get()
                                      .get_current_offloading_batch_id();
 
+  track_device_accesses(problem_size, args...);
+
 #ifndef __ACPP_STDPAR_ASSUME_SYSTEM_USM__
   // Use "first" mode in case of automatic prefetch decision for now
   const auto prefetch_mode =
@@ -218,10 +487,17 @@ void prepare_offloading(AlgorithmType type, Size problem_size, const Args&... ar
         prefetch(q, lookup_result.root_address, prefetch_size);
         __atomic_store_n(most_recent_offload_batch_ptr, current_batch_id,
                           __ATOMIC_RELEASE);
+        mark_device_resident(lookup_result.info, 0, prefetch_size);
       }
     }
   };
   
+  for_each_accessed_allocation_range(
+      [&](auto *info, uint64_t begin, uint64_t end) {
+        mark_device_resident(info, begin, end);
+      },
+      problem_size, args...);
+  
 
   if(prefetch_mode == prefetch_mode::after_sync) {
     int submission_id_in_batch = stdpar::detail::stdpar_tls_runtime::get()
@@ -436,62 +712,81 @@ bool should_offload(AlgorithmType type, Size n, const Args &...args) {
 
   auto decide_offloading_viability = [&](std::optional<bool> is_currently_offloading = {}){
 
-    // Instead of hardcoding peak PCIe speeds, this should be measured
-    double data_transfer_time_estimate = 0;
-
-#if !defined(__ACPP_STDPAR_ASSUME_SYSTEM_USM__)
-    std::size_t used_memory = 0;
-    for_each_contained_pointer([&](void* ptr){
-      unified_shared_memory::allocation_lookup_result lookup_result;
-  
-      if(ptr && unified_shared_memory::allocation_lookup(ptr, lookup_result)) {
-        used_memory += lookup_result.info->allocation_size;
-      }
-    }, args...);
-
-    if(detail::stdpar_tls_runtime::get().get_current_offloading_batch_id() > 0)
-      data_transfer_time_estimate = used_memory / 32.0;
-#endif
-
     double host_time_estimate = 0.0;
     double offload_time_estimate = 0.0;
+    // Sum of the widths of the ranges within which the runtimes
+    // are expected to lie
+    double host_time_uncertainty = 0.0;
+    double offload_time_uncertainty = 0.0;
     
     num_predicted_ops = 0;
 
     for_each_known_op_in_batch([&](op_id op) -> bool{
       auto& db = detail::stdpar_tls_runtime::get().get_offload_db();
-      double current_host_estimate = db.estimate_runtime(
+      runtime_estimate current_host_estimate = db.estimate_runtime_bounds(
           op.first, op.second, offload_heuristic_db::host_device_id);
-      double current_offload_estimate = db.estimate_runtime(
+      runtime_estimate current_offload_estimate = db.estimate_runtime_bounds(
           op.first, op.second, offload_heuristic_db::offload_device_id);
       
-      if(current_host_estimate <= 0.0 || current_offload_estimate <= 0.0) {
+      if(!current_host_estimate.is_valid() ||
+         !current_offload_estimate.is_valid()) {
         // Abort when we have no data for a given operation
         return false;
       }
 
-      host_time_estimate += current_host_estimate;
-      offload_time_estimate += current_offload_estimate;
+      host_time_estimate += current_host_estimate.expected;
+      offload_time_estimate += current_offload_estimate.expected;
+      host_time_uncertainty +=
+          current_host_estimate.upper - current_host_estimate.lower;
+      offload_time_uncertainty +=
+          current_offload_estimate.upper - current_offload_estimate.lower;
       ++num_predicted_ops;
 
       return true;
     });
 
-    
-
     if(host_time_estimate <= 0.0)
       // If we don't have host sampling data, offload.
       return true;
+
+    // Only change the offloading behavior if the difference between host and
+    // offload estimates is large compared to their uncertainty.
+    double tolerance = std::clamp(
+        0.5 * (host_time_uncertainty / host_time_estimate +
+               offload_time_uncertainty / offload_time_estimate),
+        0.2, 0.5);
     
-    if(is_currently_offloading.has_value()){
-      if(is_currently_offloading.value()) {
-        host_time_estimate += data_transfer_time_estimate;
-      } else {
-        offload_time_estimate += data_transfer_time_estimate;
-      }
+    // Time required to migrate data that is accessed by the operation
+    // to the device if we offload, or back to the host otherwise.
+    double to_device_transfer_time_estimate = 0;
+    double to_host_transfer_time_estimate = 0;
 
+#if !defined(__ACPP_STDPAR_ASSUME_SYSTEM_USM__)
+    std::size_t to_device_bytes = 0;
+    std::size_t to_host_bytes = 0;
+    for_each_accessed_allocation_range(
+        [&](auto *info, uint64_t begin, uint64_t end) {
+          uint64_t resident = get_num_device_resident_bytes(info, begin, end);
+          to_host_bytes += resident;
+          to_device_bytes += (end - begin) - resident;
+        },
+        n, args...);
+
+    if(to_device_bytes > 0 || to_host_bytes > 0) {
+      transfer_model model = get_transfer_model(
+          detail::single_device_dispatch::get_queue().get_device());
+      to_device_transfer_time_estimate =
+          model.estimate_transfer_time(to_device_bytes);
+      to_host_transfer_time_estimate =
+          model.estimate_transfer_time(to_host_bytes);
+    }
+#endif
+
+    host_time_estimate += to_host_transfer_time_estimate;
+    offload_time_estimate += to_device_transfer_time_estimate;
+
+    if(is_currently_offloading.has_value()){
       double ratio = host_time_estimate / offload_time_estimate;
-      double tolerance = 0.2;
       if(ratio >= (1.0 - tolerance) && ratio <= (1.0 + tolerance))
         return is_currently_offloading.value();
 
@@ -575,6 +870,14 @@ private:
 template<class AlgorithmType, class Size, class F, typename... Args>
 auto host_instrumentation(F&& f, AlgorithmType t, Size n, Args... args) {
 #ifndef __ACPP_STDPAR_UNCONDITIONAL_OFFLOAD__
+#if !defined(__ACPP_STDPAR_ASSUME_SYSTEM_USM__)
+  // Data accessed on the host migrates back to host memory
+  for_each_accessed_allocation_range(
+      [&](auto *info, uint64_t begin, uint64_t end) {
+        mark_host_resident(info, begin, end);
+      },
+      n, args...);
+#endif
   uint64_t hash = get_operation_hash(t, n, args...);
   host_invocation_measurement m{hash, n};
   return m(f);
@@ -610,7 +913,9 @@ auto device_instrumentation(F&& f, AlgorithmType t, Size n, Args... args) {
     hipsycl::stdpar::detail::stdpar_tls_runtime::get()                         \
         .increment_num_outstanding_operations();                               \
   } else {                                                                     \
-    __acpp_stdpar_barrier();                                                   \
+    if (!hipsycl::stdpar::detail::is_independent_of_outstanding_operations(    \
+            algorithm_type_object, problem_size, __VA_ARGS__))                 \
+      __acpp_stdpar_barrier();                                                 \
     host_instrumentation([&]() { fallback_invoker(); }, algorithm_type_object, \
                          problem_size, __VA_ARGS__);                           \
   }                                                                            \
@@ -627,7 +932,8 @@ auto device_instrumentation(F&& f, AlgorithmType t, Size n, Args... args) {
   if (is_offloaded)                                                            \
     hipsycl::stdpar::detail::prepare_offloading(algorithm_type_object,         \
                                                 problem_size, __VA_ARGS__);    \
-  else                                                                         \
+  else if (!hipsycl::stdpar::detail::is_independent_of_outstanding_operations( \
+               algorithm_type_object, problem_size, __VA_ARGS__))              \
     __acpp_stdpar_barrier();                                                   \
   return_type ret =                                                            \
       is_offloaded                                                             \
@@ -651,8 +957,10 @@ auto device_instrumentation(F&& f, AlgorithmType t, Size n, Args... args) {
   auto &q = hipsycl::stdpar::detail::single_device_dispatch::get_queue();      \
   bool is_offloaded = hipsycl::stdpar::detail::should_offload(                 \
       algorithm_type_object, problem_size, __VA_ARGS__);                       \
+  bool is_independent_of_device = false;                                       \
   const auto blocking_fallback_invoker = [&]() {                               \
-    q.wait();                                                                  \
+    if (!is_independent_of_device)                                             \
+      q.wait();                                                                \
     return host_instrumentation([&]() { return fallback_invoker(); },          \
                                 algorithm_type_object, problem_size,           \
                                 __VA_ARGS__);                                  \
@@ -660,8 +968,13 @@ auto device_instrumentation(F&& f, AlgorithmType t, Size n, Args... args) {
   if (is_offloaded)                                                            \
     hipsycl::stdpar::detail::prepare_offloading(algorithm_type_object,         \
                                                 problem_size, __VA_ARGS__);    \
-  else                                                                         \
-    __acpp_stdpar_barrier();                                                   \
+  else {                                                                       \
+    is_independent_of_device =                                                 \
+        hipsycl::stdpar::detail::is_independent_of_outstanding_operations(     \
+            algorithm_type_object, problem_size, __VA_ARGS__);                 \
+    if (!is_independent_of_device)                                             \
+      __acpp_stdpar_barrier();                                                 \
+  }                                                                            \
   return_type ret =                                                            \
       is_offloaded                                                             \
           ? device_instrumentation([&]() { return offload_invoker(q); },       \
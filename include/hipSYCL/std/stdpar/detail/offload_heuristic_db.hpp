@@ -11,19 +11,22 @@
 #ifndef HIPSYCL_PSTL_OFFLOAD_HEURISTIC_HPP
 #define HIPSYCL_PSTL_OFFLOAD_HEURISTIC_HPP
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
-#include <sstream>
+#include <string>
 #include <typeinfo>
 #include <unordered_map>
-#include <fstream>
 #include <optional>
 #include <memory>
 #include <vector>
 #include <mutex>
 #include "hipSYCL/runtime/settings.hpp"
 #include "hipSYCL/std/stdpar/detail/allocation_map.hpp"
+#include "hipSYCL/common/appdb.hpp"
+#include "hipSYCL/common/filesystem.hpp"
 #include "hipSYCL/common/stable_running_hash.hpp"
 
 
@@ -52,6 +55,15 @@ struct any_of {};
 struct none_of {};
 struct sort {};
 struct merge {};
+struct min_element {};
+struct max_element {};
+struct minmax_element {};
+struct count {};
+struct count_if {};
+struct equal {};
+struct mismatch {};
+struct adjacent_find {};
+struct lexicographical_compare {};
 
 
 struct transform_reduce {};
@@ -74,156 +86,295 @@ using host_malloc_unordered_map =
     std::unordered_map<K, V, std::hash<K>, std::equal_to<K>,
                        libc_allocator<std::pair<const K, V>>>;
 
-class offload_heuristic_db_storage {
-public:
+/// Predicted runtime of an operation, together with the range within which
+/// the runtime is expected to lie.
+struct runtime_estimate {
+  double expected = 0.0;
+  double lower = 0.0;
+  double upper = 0.0;
 
-  static std::shared_ptr<offload_heuristic_db_storage> get() {
-    static std::shared_ptr<offload_heuristic_db_storage> instance =
-        std::make_shared<offload_heuristic_db_storage>();
-    return instance;
+  bool is_valid() const {
+    return expected > 0.0;
   }
+};
+
+/// Predicts the runtime of an operation on one device for arbitrary problem
+/// sizes from the problem sizes that have been measured.
+///
+/// Between measured problem sizes, runtimes are interpolated piecewise
+/// linearly in log(problem size) - log(runtime) space, i.e. as power law
+/// between neighboring measurements. Beyond the measured range, the slope of
+/// the outermost segment is extrapolated, or linear scaling is assumed if only
+/// a single problem size has been measured. The bounds of the estimate are
+/// derived from the spread of the measured runtimes and widen with the
+/// distance from the measured range.
+///
+/// Measured problem sizes are grouped into buckets of a quarter of a power
+/// of two, so the number of sample points is bounded regardless of how
+/// many distinct problem sizes an application uses.
+class offload_performance_model {
+public:
+  struct sample_point {
+    uint64_t problem_size = 0;
+    uint64_t num_samples = 0;
+    double total_time = 0.0;
+    double min_time = 0.0;
+    double max_time = 0.0;
 
-  offload_heuristic_db_storage() {
-    std::fstream f{get_dataset_filename().c_str(), std::ios::in};
-    if(f.is_open()) {
-      std::string line;
-      while(std::getline(f, line)) {
-        std::stringstream sstr{line};
-        uint64_t hash;
-        entry e;
-        sstr >> hash;
-        e.read(sstr);
-
-        _entries[hash] = e;
-      } 
+    double get_mean_time() const {
+      return total_time / num_samples;
     }
+  };
+
+  /// Returns the center of the bucket that problem_size belongs to.
+  /// Sizes below 8 are their own bucket.
+  static uint64_t get_problem_size_bucket(uint64_t problem_size) {
+    constexpr int mantissa_bits = 2;
+    int msb = 0;
+    while((problem_size >> msb) > 1)
+      ++msb;
+    if(msb <= mantissa_bits)
+      return problem_size;
+
+    int shift = msb - mantissa_bits;
+    return ((problem_size >> shift) << shift) | (uint64_t{1} << (shift - 1));
   }
 
-  ~offload_heuristic_db_storage() {
-    std::fstream f{get_dataset_filename().c_str(),
-                   std::ios::out | std::ios::trunc};
-    for (const auto &entry : _entries) {
-      f << entry.first << " ";
-      entry.second.write(f);
-      f << "\n";
+  void add_samples(sample_point samples) {
+    if(samples.num_samples == 0)
+      return;
+
+    samples.problem_size = get_problem_size_bucket(samples.problem_size);
+    auto it = std::lower_bound(
+        _points.begin(), _points.end(), samples.problem_size,
+        [](const sample_point &p, uint64_t problem_size) {
+          return p.problem_size < problem_size;
+        });
+    if(it != _points.end() && it->problem_size == samples.problem_size) {
+      it->num_samples += samples.num_samples;
+      it->total_time += samples.total_time;
+      it->min_time = std::min(it->min_time, samples.min_time);
+      it->max_time = std::max(it->max_time, samples.max_time);
+    } else {
+      _points.insert(it, samples);
     }
   }
 
-  using device_t = int;
-
-  struct device_entry {
-    device_t dev;
-    uint64_t problem_size;
-    double runtime = std::numeric_limits<double>::max();
-    uint64_t num_samples = 0;
+  void add_sample(uint64_t problem_size, double time) {
+    add_samples(sample_point{problem_size, 1, time, time, time});
+  }
 
-    void merge(const device_entry& other) {
-      if(dev == other.dev && problem_size == other.problem_size) {
-        uint64_t aggregated_num_samples = num_samples + other.num_samples;
-        runtime = (num_samples * runtime + other.num_samples * other.runtime) /
-                  aggregated_num_samples;
-        num_samples = aggregated_num_samples;
-      }
+  runtime_estimate estimate(uint64_t problem_size) const {
+    if(_points.empty())
+      return runtime_estimate{};
+
+    auto it = std::lower_bound(
+        _points.begin(), _points.end(), problem_size,
+        [](const sample_point &p, uint64_t problem_size) {
+          return p.problem_size < problem_size;
+        });
+    if(it != _points.end() && it->problem_size == problem_size) {
+      return make_estimate(it->get_mean_time(), it->min_time, it->max_time);
     }
 
-    bool is_sampled() const {
-      return runtime < std::numeric_limits<double>::max();
+    double x = get_log_size(problem_size);
+    if(_points.size() == 1)
+      return extrapolate(_points.front(), 1.0, x);
+    if(it == _points.begin())
+      return extrapolate(_points[0], get_slope(_points[0], _points[1]), x);
+    if(it == _points.end()) {
+      const sample_point &last = _points[_points.size() - 1];
+      const sample_point &second_last = _points[_points.size() - 2];
+      return extrapolate(last, get_slope(second_last, last), x);
     }
 
-    friend std::istream& operator>>(std::istream& in, device_entry& entry) {
-      in >> entry.dev;
-      in >> entry.problem_size;
-      in >> entry.runtime;
-      in >> entry.num_samples;
+    const sample_point& lower = *(it - 1);
+    const sample_point& upper = *it;
+    double x0 = get_log_size(lower.problem_size);
+    double x1 = get_log_size(upper.problem_size);
+    double t = (x - x0) / (x1 - x0);
+    auto interpolate = [&](double y0, double y1) {
+      return std::exp((1.0 - t) * get_log_time(y0) + t * get_log_time(y1));
+    };
+    return make_estimate(
+        interpolate(lower.get_mean_time(), upper.get_mean_time()),
+        interpolate(lower.min_time, upper.min_time),
+        interpolate(lower.max_time, upper.max_time));
+  }
 
-      return in;
-    }
+  template<class F>
+  void for_each_sample_point(F&& f) const {
+    for(const auto& p : _points)
+      f(p);
+  }
+private:
+  // Runtimes are in ns; clamp to avoid log(0)
+  static double get_log_time(double time) {
+    return std::log(std::max(time, 1.0));
+  }
 
-    friend std::ostream& operator<<(std::ostream& out, const device_entry& entry) {
-      out << entry.dev << " ";
-      out << entry.problem_size << " ";
-      out << entry.runtime << " ";
-      out << entry.num_samples << " ";
+  static double get_log_size(uint64_t problem_size) {
+    return std::log(static_cast<double>(std::max(problem_size, uint64_t{1})));
+  }
 
-      return out;
-    }
-  };
+  static double get_slope(const sample_point& a, const sample_point& b) {
+    double slope = (get_log_time(b.get_mean_time()) -
+                    get_log_time(a.get_mean_time())) /
+                   (get_log_size(b.problem_size) - get_log_size(a.problem_size));
+    // Noisy measurements may suggest runtimes that decrease with
+    // problem size, or grow absurdly fast.
+    return std::min(std::max(slope, 0.0), 2.0);
+  }
 
-  struct entry {
-    
-    std::vector<device_entry, libc_allocator<device_entry>> entries;
-
-    void merge(const entry& other) {
-      auto merge_or_insert = [this](auto& other_entry){
-        for(auto& own_entry : entries) {
-          if (own_entry.dev == other_entry.dev &&
-              own_entry.problem_size == other_entry.problem_size) {
-            own_entry.merge(other_entry);
-            return;
-          }
-        }
-        entries.push_back(other_entry);
-      };
+  static runtime_estimate make_estimate(double expected, double lower,
+                                        double upper) {
+    runtime_estimate e;
+    e.expected = std::max(expected, 1.0);
+    e.lower = std::min(lower, e.expected);
+    e.upper = std::max(upper, e.expected);
+    return e;
+  }
 
-      
-      for(auto& other_entry: other.entries) {
-        merge_or_insert(other_entry);  
-      }
-    }
+  static runtime_estimate extrapolate(const sample_point &p, double slope,
+                                      double x) {
+    double distance = x - get_log_size(p.problem_size);
+    double factor = std::exp(slope * distance);
+    // Widen bounds by 25% per doubling of the distance from the
+    // measured problem size
+    double uncertainty = 1.0 + 0.25 * std::abs(distance) / std::log(2.0);
+    return make_estimate(p.get_mean_time() * factor,
+                         p.min_time * factor / uncertainty,
+                         p.max_time * factor * uncertainty);
+  }
 
-    void read(std::istream& istr) {
-      
-      int num_entries = 0;
-      istr >> num_entries;
-      for(int i = 0; i < num_entries; ++i) {
-        device_entry dev_entry;
-        istr >> dev_entry;
-        entries.push_back(dev_entry);
-      }
-    }
+  std::vector<sample_point, libc_allocator<sample_point>> _points;
+};
 
-    void write(std::ostream& ostr) const {
-      
-      ostr << entries.size() << " ";
-      for(const auto &entry : entries)
-        ostr << entry << " ";
-    }
-  };
+struct offload_operation_models {
+  offload_performance_model host;
+  offload_performance_model offload;
+};
 
+/// Process-wide offload heuristic data. Measurements are persisted in the
+/// application database, into which the measurements of each thread are
+/// merged once the thread's offload_heuristic_db is destroyed.
+class offload_heuristic_db_storage {
+public:
 
-  auto get_entries() const {
-    std::lock_guard<std::mutex> lock{_lock};
-    return _entries;
+  static std::shared_ptr<offload_heuristic_db_storage> get() {
+    static std::shared_ptr<offload_heuristic_db_storage> instance =
+        std::make_shared<offload_heuristic_db_storage>();
+    return instance;
+  }
+
+  using model_map = host_malloc_unordered_map<uint64_t, offload_operation_models>;
+
+  offload_heuristic_db_storage()
+  : _dataset_id{get_dataset_id()} {
+    common::filesystem::persistent_storage::get().get_this_app_db().read_access(
+        [&](const common::db::appdb_data &appdb) {
+          for(const auto& op : appdb.stdpar_operations) {
+            auto& models = _models[op.first];
+            for(const auto& s : op.second.host_samples)
+              models.host.add_samples(to_sample_point(s.first, s.second));
+            for(const auto& s : op.second.offload_samples)
+              models.offload.add_samples(to_sample_point(s.first, s.second));
+          }
+        });
   }
 
-  void update_entry_map(const host_malloc_unordered_map<uint64_t, entry>& entry_map) {
+  /// Returns the key under which measurements of an operation are stored.
+  /// Measurements of different datasets are kept separate.
+  uint64_t get_key(uint64_t op_hash) const {
+    if(_dataset_id == 0)
+      return op_hash;
+    common::stable_running_hash hash;
+    hash(&_dataset_id, sizeof(_dataset_id));
+    hash(&op_hash, sizeof(op_hash));
+    return hash.get_current_hash();
+  }
+
+  model_map get_models() const {
     std::lock_guard<std::mutex> lock{_lock};
-    for(const auto& e : entry_map) {
-      auto it = _entries.find(e.first);
-      if(it == _entries.end()) {
-        _entries[e.first] = e.second;
-      } else {
-        auto& own_entry = it->second;
-        own_entry.merge(e.second);
+    return _models;
+  }
+
+  /// Adds new measurements to the storage and the application database.
+  void commit(const model_map& new_samples) {
+    if(new_samples.empty())
+      return;
+
+    {
+      std::lock_guard<std::mutex> lock{_lock};
+      for(const auto& op : new_samples) {
+        auto& models = _models[op.first];
+        op.second.host.for_each_sample_point(
+            [&](const auto &p) { models.host.add_samples(p); });
+        op.second.offload.for_each_sample_point(
+            [&](const auto &p) { models.offload.add_samples(p); });
       }
     }
+
+    common::filesystem::persistent_storage::get()
+        .get_this_app_db()
+        .read_write_access([&](common::db::appdb_data &appdb) {
+          for(const auto& op : new_samples) {
+            auto& entry = appdb.stdpar_operations[op.first];
+            rebucket(entry.host_samples);
+            rebucket(entry.offload_samples);
+            op.second.host.for_each_sample_point([&](const auto &p) {
+              entry.host_samples[p.problem_size].merge(to_db_entry(p));
+            });
+            op.second.offload.for_each_sample_point([&](const auto &p) {
+              entry.offload_samples[p.problem_size].merge(to_db_entry(p));
+            });
+          }
+        });
   }
   
 private:
+  using sample_point = offload_performance_model::sample_point;
+
+  static sample_point to_sample_point(uint64_t problem_size,
+                                      const common::db::stdpar_sample_entry &e) {
+    return sample_point{problem_size, e.num_samples,
+                        static_cast<double>(e.total_time_ns),
+                        static_cast<double>(e.min_time_ns),
+                        static_cast<double>(e.max_time_ns)};
+  }
 
-  static std::string get_dataset_filename() {
-    return ".acpp-stdpar-"+get_dataset_name();
+  // Merges entries that were stored with exact problem sizes by previous
+  // versions into their buckets
+  template <class SampleMap>
+  static void rebucket(SampleMap& samples) {
+    SampleMap bucketed;
+    for(const auto& s : samples)
+      bucketed[offload_performance_model::get_problem_size_bucket(s.first)]
+          .merge(s.second);
+    samples = std::move(bucketed);
   }
 
-  static std::string get_dataset_name() {
+  static common::db::stdpar_sample_entry to_db_entry(const sample_point& p) {
+    common::db::stdpar_sample_entry e;
+    e.num_samples = p.num_samples;
+    e.total_time_ns = static_cast<uint64_t>(p.total_time);
+    e.min_time_ns = static_cast<uint64_t>(p.min_time);
+    e.max_time_ns = static_cast<uint64_t>(p.max_time);
+    return e;
+  }
+
+  static uint64_t get_dataset_id() {
     std::string dataset_name;
     if(rt::try_get_environment_variable("stdpar_dataset_name", dataset_name)) {
-      return dataset_name;
+      common::stable_running_hash hash;
+      hash(dataset_name.data(), dataset_name.size());
+      return hash.get_current_hash();
     }
-    return ".acpp-stdpar-profile";
+    return 0;
   }
 
-  host_malloc_unordered_map<uint64_t, entry> _entries;
+  uint64_t _dataset_id;
+  model_map _models;
   mutable std::mutex _lock;
 };
 
@@ -231,88 +382,29 @@ class offload_heuristic_db {
 public:
   offload_heuristic_db()
   : _storage{offload_heuristic_db_storage::get()} {
-    _entries = _storage->get_entries();
+    _models = _storage->get_models();
   }
 
   ~offload_heuristic_db() {
-    _storage->update_entry_map(_entries);
+    _storage->commit(_new_samples);
   }
 
-  using device_t = offload_heuristic_db_storage::device_t;
+  using device_t = int;
   static constexpr device_t host_device_id = -1;
   static constexpr device_t offload_device_id = 0;
 
+  /// Returns the expected runtime in ns, or 0 if no estimate is possible
   double estimate_runtime(uint64_t op_hash, std::size_t problem_size, device_t dev) const {
-    auto it = _entries.find(op_hash);
-    if(it == _entries.end())
-      return 0.0;
-
-    // We attempt to find the closest measurements around the requested problem size,
-    // and then interpolate linearly.
-
-    // First find closest sampling point
-    int64_t delta = std::numeric_limits<int>::max();
-    std::size_t closest_problem_size = 0;
-    double closest_runtime = 0.0;
-    for(auto& e : it->second.entries) {
-      if(e.dev == dev) {
-        // If we find the required problem size exactly, we can just return it.
-        if(e.problem_size == problem_size)
-          return e.runtime;
-
-        int64_t current_delta = std::abs((int64_t)e.problem_size - (int64_t)problem_size);
-        if(current_delta < delta) {
-          delta = current_delta;
-          closest_problem_size = e.problem_size;
-          closest_runtime = e.runtime;
-        }
-      }
-    }
-    // Find 2nd closest sampling point
-    delta = std::numeric_limits<int>::max();
-    std::size_t closest_problem_size2 = 0;
-    double closest_runtime2 = 0.0;
-    for(auto& e : it->second.entries) {
-      if(e.dev == dev) {
-        int64_t current_delta = std::abs((int64_t)e.problem_size - (int64_t)problem_size);
-        if(current_delta < delta && e.problem_size != closest_problem_size) {
-          delta = current_delta;
-          closest_problem_size2 = e.problem_size;
-          closest_runtime2 = e.runtime;
-        }
-      }
-    }
-
-    if(closest_problem_size2 < closest_problem_size) {
-      std::swap(closest_problem_size, closest_problem_size2);
-      std::swap(closest_runtime, closest_runtime2);
-    }
-
-    
-    double runtime_lower = closest_runtime;
-    double runtime_upper = closest_runtime2;
-    std::size_t problem_size_lower = closest_problem_size;
-    std::size_t problem_size_upper = closest_problem_size2;
-
-    // If we have neither, then both lower bound and upper bound problem size might still be 0.
-    // We need to catch this case to avoid division by zero.
-    if(problem_size_lower == problem_size_upper) {
-      return 0.0;
-    }
+    return estimate_runtime_bounds(op_hash, problem_size, dev).expected;
+  }
 
-    double delta_x = problem_size_upper - problem_size_lower;
-    double delta_y = runtime_upper - runtime_lower;
-    
-    double m = delta_y / delta_x;
-
-    double result = m * (problem_size - problem_size_lower) + runtime_lower;
-    // If the interpolation results in a negative value, we cannot just return 0, as this
-    // is generally interpreted as "couldn't estimate". In this case however, we could estimate,
-    // but the estimate is just too low due to inaccuracies. So we just return a value that
-    // is smaller than the measurement accuracy.
-    if(result <= 0.0)
-      return 1.e-20;
-    return result;
+  runtime_estimate estimate_runtime_bounds(uint64_t op_hash,
+                                           std::size_t problem_size,
+                                           device_t dev) const {
+    auto it = _models.find(_storage->get_key(op_hash));
+    if(it == _models.end())
+      return runtime_estimate{};
+    return get_model(it->second, dev).estimate(problem_size);
   }
 
   void update_entry(uint64_t op_hash, std::size_t problem_size, device_t dev, double runtime) {
@@ -327,25 +419,26 @@ public:
       ++op_invocation_count;
     }
 
-    auto& e = _entries[op_hash];
-
-    offload_heuristic_db_storage::device_entry d_entry {dev, problem_size, runtime, 1};
-    
-    for(auto& measurement_entry : e.entries) {
-      if(measurement_entry.dev == dev && measurement_entry.problem_size == problem_size) {
-        measurement_entry.merge(d_entry);
-        return;
-      }
-    }
+    uint64_t key = _storage->get_key(op_hash);
+    get_model(_models[key], dev).add_sample(problem_size, runtime);
+    get_model(_new_samples[key], dev).add_sample(problem_size, runtime);
+  }
 
-    e.entries.push_back(d_entry);
+private:
+  static offload_performance_model &get_model(offload_operation_models &m,
+                                              device_t dev) {
+    return dev == host_device_id ? m.host : m.offload;
   }
 
+  static const offload_performance_model &
+  get_model(const offload_operation_models &m, device_t dev) {
+    return dev == host_device_id ? m.host : m.offload;
+  }
 
-private:
   std::shared_ptr<offload_heuristic_db_storage> _storage;
-  host_malloc_unordered_map<uint64_t, offload_heuristic_db_storage::entry>
-      _entries;
+  offload_heuristic_db_storage::model_map _models;
+  // Measurements that have not yet been committed to the storage
+  offload_heuristic_db_storage::model_map _new_samples;
   host_malloc_unordered_map<uint64_t, uint64_t> _kernel_invocation_counts;
 };
 
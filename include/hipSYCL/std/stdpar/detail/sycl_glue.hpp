@@ -14,11 +14,17 @@
 
 
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <new>
+#include <utility>
+#include <thread>
+#include <vector>
 #include <unistd.h>
+#include <sys/mman.h>
 
 #include <hipSYCL/algorithms/util/allocation_cache.hpp>
 #include <hipSYCL/sycl/queue.hpp>
@@ -56,6 +62,55 @@ inline sycl::queue construct_default_queue() {
         hipsycl::sycl::property::queue::AdaptiveCpp_coarse_grained_events{}}};
 }
 
+/// Records the memory that outstanding offloaded operations might access.
+/// Ranges are absolute address ranges [begin, end). If the memory accessed
+/// by an operation cannot be determined, any memory is assumed to be
+/// accessed.
+class device_access_tracker {
+public:
+  void add_range(uint64_t begin, uint64_t end) {
+    if(begin >= end)
+      return;
+    for(auto& r : _ranges) {
+      if(begin <= r.second && r.first <= end) {
+        r.first = std::min(r.first, begin);
+        r.second = std::max(r.second, end);
+        return;
+      }
+    }
+    // Avoid expensive conflict checks for long chains of operations
+    if(_ranges.size() >= max_num_ranges)
+      _has_unknown_ranges = true;
+    else
+      _ranges.push_back(std::make_pair(begin, end));
+  }
+
+  void add_unknown_range() {
+    _has_unknown_ranges = true;
+  }
+
+  bool overlaps(uint64_t begin, uint64_t end) const {
+    if(_has_unknown_ranges)
+      return true;
+    for(const auto& r : _ranges)
+      if(begin < r.second && r.first < end)
+        return true;
+    return false;
+  }
+
+  void reset() {
+    _ranges.clear();
+    _has_unknown_ranges = false;
+  }
+private:
+  static constexpr std::size_t max_num_ranges = 64;
+
+  std::vector<std::pair<uint64_t, uint64_t>,
+              libc_allocator<std::pair<uint64_t, uint64_t>>>
+      _ranges;
+  bool _has_unknown_ranges = false;
+};
+
 class stdpar_tls_runtime {
 private:
   stdpar_tls_runtime()
@@ -71,8 +126,48 @@ private:
                   ->has(rt::device_support_aspect::
                             work_item_independent_forward_progress))
             _has_independent_work_item_forward_progress = true;
+          if (!rt::try_get_environment_variable(
+                  "stdpar_dependency_tracking",
+                  _is_dependency_tracking_enabled))
+            _is_dependency_tracking_enabled = false;
+
+          bool is_multi_device_enabled = false;
+          if (rt::try_get_environment_variable("stdpar_multi_device",
+                                               is_multi_device_enabled) &&
+              is_multi_device_enabled)
+            init_secondary_devices();
         }
 
+  // Creates queues for all other devices of the backend of the primary
+  // queue, which can access the same shared USM allocations.
+  void init_secondary_devices() {
+    sycl::device primary_dev = _queue.get_device();
+    _device_weights.push_back(
+        primary_dev.get_info<sycl::info::device::max_compute_units>());
+
+    for(const auto& dev : sycl::device::get_devices()) {
+      if(dev.get_backend() == primary_dev.get_backend() &&
+         dev != primary_dev) {
+        _secondary_queues.push_back(sycl::queue{
+            dev, hipsycl::sycl::property_list{
+                     hipsycl::sycl::property::queue::in_order{},
+                     hipsycl::sycl::property::queue::
+                         AdaptiveCpp_coarse_grained_events{}}});
+        _device_weights.push_back(
+            dev.get_info<sycl::info::device::max_compute_units>());
+      }
+    }
+
+    double total_weight = 0.0;
+    for(double w : _device_weights)
+      total_weight += std::max(w, 1.0);
+    for(double& w : _device_weights)
+      w = std::max(w, 1.0) / total_weight;
+
+    HIPSYCL_DEBUG_INFO << "[stdpar] Multi-device execution uses "
+                       << _device_weights.size() << " devices" << std::endl;
+  }
+
   ~stdpar_tls_runtime() {
     _device_scratch_cache.purge();
     _shared_scratch_cache.purge();
@@ -85,6 +180,14 @@ private:
   algorithms::util::allocation_cache _host_scratch_cache;
   int _outstanding_offloaded_operations = 0;
   bool _has_independent_work_item_forward_progress = false;
+  bool _is_dependency_tracking_enabled = false;
+  // Queues of additional devices that offloaded algorithms can be
+  // partitioned across
+  std::vector<sycl::queue, libc_allocator<sycl::queue>> _secondary_queues;
+  // Relative throughput of the primary device followed by the
+  // secondary devices
+  std::vector<double, libc_allocator<double>> _device_weights;
+  device_access_tracker _device_accesses;
 
   offload_heuristic_db _offload_db;
   std::vector<uint64_t, libc_allocator<uint64_t>> _instrumented_ops_in_batch;
@@ -116,6 +219,39 @@ public:
     return _has_independent_work_item_forward_progress;
   }
 
+  /// Number of devices that offloaded algorithms can be partitioned across,
+  /// including the device of the primary queue
+  std::size_t get_num_devices() const {
+    return _secondary_queues.size() + 1;
+  }
+
+  /// Returns the queue for device index dev, where index 0 is the
+  /// primary queue.
+  sycl::queue& get_queue(std::size_t dev) {
+    if(dev == 0)
+      return _queue;
+    return _secondary_queues[dev - 1];
+  }
+
+  /// Relative throughput of the device with index dev
+  double get_device_weight(std::size_t dev) const {
+    if(_device_weights.empty())
+      return 1.0;
+    return _device_weights[dev];
+  }
+
+  void set_device_weight(std::size_t dev, double weight) {
+    _device_weights[dev] = weight;
+  }
+
+  bool is_dependency_tracking_enabled() const {
+    return _is_dependency_tracking_enabled;
+  }
+
+  device_access_tracker& get_device_access_tracker() {
+    return _device_accesses;
+  }
+
   int get_num_outstanding_operations() const {
     return _outstanding_offloaded_operations;
   }
@@ -153,6 +289,7 @@ public:
     _instrumented_ops_in_batch.clear();
     _instrumented_op_problem_sizes_in_batch.clear();
 #endif
+    _device_accesses.reset();
     reset_num_outstanding_operations();
     ++offloading_batch_counter();
   }
@@ -230,12 +367,120 @@ private:
   uint64_t next_multiple_of(uint64_t a, uint64_t b) {
     return ceil_division(a, b) * b;
   }
+
+  // Small objects are not allocated at page granularity. Instead, they are
+  // carved out of slabs, where each slab only contains objects of a single
+  // size class.
+  static constexpr std::size_t num_size_classes = 14;
+  static constexpr std::size_t size_classes[num_size_classes] = {
+      16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048};
+  // Identifies slabs that do not hold small objects in _slab_size_classes
+  static constexpr uint8_t no_size_class = 0xff;
+
+  struct free_object {
+    free_object* next;
+  };
+
+  struct free_list {
+    free_object* head = nullptr;
+    std::size_t size = 0;
+
+    void push(free_object* obj) {
+      obj->next = head;
+      head = obj;
+      ++size;
+    }
+
+    free_object* pop() {
+      free_object* obj = head;
+      if(obj) {
+        head = obj->next;
+        --size;
+      }
+      return obj;
+    }
+  };
+
+  // Objects that a thread has freed, or that it has obtained from the pool
+  // in advance. Allocating and freeing only operates on this cache, and
+  // only exchanges objects with the pool in batches.
+  struct thread_cache {
+    memory_pool* pool = nullptr;
+    free_list objects[num_size_classes];
+
+    ~thread_cache() {
+      if(pool) {
+        for(std::size_t i = 0; i < num_size_classes; ++i)
+          pool->return_objects(i, objects[i], objects[i].size);
+      }
+    }
+  };
+
+  struct slab_info {
+    // Objects of this slab that are neither allocated nor held by a thread
+    // cache
+    free_list objects;
+    // Objects of this slab that have been handed out to thread caches
+    std::size_t num_in_use = 0;
+    // Neighbours in the list of slabs of the size class with free objects
+    slab_info* prev = nullptr;
+    slab_info* next = nullptr;
+  };
+
+  struct size_class_state {
+    std::atomic<int> lock{0};
+    // Slabs that have objects in their free lists
+    slab_info* slabs_with_objects = nullptr;
+    // Remaining space in the most recent slab of this size class
+    char* slab_current = nullptr;
+    char* slab_end = nullptr;
+  };
+
+  class spin_lock_guard {
+  public:
+    spin_lock_guard(std::atomic<int>& lock)
+    : _lock{lock} {
+      int expected = 0;
+      while (!_lock.compare_exchange_weak(expected, 1,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed))
+        expected = 0;
+    }
+
+    ~spin_lock_guard() {
+      _lock.store(0, std::memory_order_release);
+    }
+  private:
+    std::atomic<int>& _lock;
+  };
 public:
-  memory_pool(std::size_t size)
+  static constexpr std::size_t slab_size = 64 * 1024;
+  static constexpr std::size_t max_small_object_size =
+      size_classes[num_size_classes - 1];
+
+  /// Invoked when a slab is taken from or returned to the page-granular
+  /// part of the pool, while holding the lock of the slab's size class.
+  using slab_callback = void (*)(void* slab, std::size_t size);
+
+  enum class huge_page_mode {
+    // Rely on the default paging behavior
+    none,
+    // Request transparent huge pages for the pool
+    transparent,
+    // Back the pool with explicitly reserved huge pages
+    explicit_2mb,
+    explicit_1gb
+  };
+
+  memory_pool(std::size_t size, huge_page_mode huge_pages = huge_page_mode::none,
+              bool prefault = false, slab_callback on_slab_claimed = nullptr,
+              slab_callback on_slab_released = nullptr)
       : _pool_size{size}, _pool{nullptr},
         _free_space_map{size > 0 ? size : 1024},
-        _page_size{static_cast<std::size_t>(sysconf(_SC_PAGESIZE))} {
-    init();
+        _page_size{static_cast<std::size_t>(sysconf(_SC_PAGESIZE))},
+        _slab_size_classes{nullptr}, _slabs{nullptr},
+        _on_slab_claimed{on_slab_claimed}, _on_slab_released{on_slab_released} {
+    init(huge_pages, prefault);
   }
 
   void* claim(std::size_t size) {
@@ -260,16 +505,66 @@ public:
 
   void release(void* ptr, std::size_t size) {
     if(_pool && is_from_pool(ptr)) {
+      // Needs to match the size that was used in claim()
+      if(size < _page_size)
+        size = _page_size;
       uint64_t address = reinterpret_cast<uint64_t>(ptr)-reinterpret_cast<uint64_t>(_base_address);
       _free_space_map.release(address, size);
     }
   }
 
+  /// Allocates an object of at most max_small_object_size bytes
+  /// from a slab. Returns nullptr if the pool is exhausted.
+  void* claim_small(std::size_t size) {
+    if(_pool_size == 0 || !_slab_size_classes)
+      return nullptr;
+
+    assert(size <= max_small_object_size);
+    std::size_t size_class = get_size_class(size);
+
+    thread_cache& cache = get_thread_cache();
+    free_list& objects = cache.objects[size_class];
+    if(!objects.head)
+      obtain_objects(size_class, objects, get_batch_size(size_class));
+
+    return objects.pop();
+  }
+
+  /// Returns an object allocated by claim_small() to the pool. Only operates
+  /// on the calling thread's cache unless that cache has grown large.
+  /// Slabs are released once all of their objects are back in the pool,
+  /// except for the slab that new objects of the size class are carved from.
+  /// Each thread cache keeps the slabs of up to 2 batches of objects per size
+  /// class alive.
+  void release_small(void* ptr) {
+    std::size_t size_class = get_slab_size_class(ptr);
+    assert(size_class < num_size_classes);
+
+    thread_cache& cache = get_thread_cache();
+    free_list& objects = cache.objects[size_class];
+    objects.push(static_cast<free_object*>(ptr));
+
+    // Don't let threads that free more than they allocate hoard objects.
+    std::size_t batch_size = get_batch_size(size_class);
+    if(objects.size > 2 * batch_size)
+      return_objects(size_class, objects, batch_size);
+  }
+
+  /// Whether ptr was allocated using claim_small()
+  bool is_small_object(void* ptr) const {
+    return is_from_pool(ptr) && _slab_size_classes &&
+           get_slab_size_class(ptr) != no_size_class;
+  }
+
   ~memory_pool() {
     // Memory pool might be destroyed after runtime shutdown, so rely on OS
     // to clean up for now
     //if(_pool)
     //  sycl::free(_pool, detail::single_device_dispatch::get_queue());
+    if(_slab_size_classes)
+      __libc_free(_slab_size_classes);
+    if(_slabs)
+      __libc_free(_slabs);
   }
 
   std::size_t get_size() const {
@@ -285,24 +580,276 @@ public:
   }
 private:
 
-  void init() {
+  void init(huge_page_mode huge_pages, bool prefault) {
     HIPSYCL_DEBUG_INFO << "[stdpar] Building a memory pool of size "
                        << static_cast<double>(_pool_size) / (1024 * 1024 * 1024)
                        << " GB" << std::endl;
-    // Make sure to allocate an additional page so that we can fix alignment if needed
-    _pool = sycl::malloc_shared(
-        _pool_size + _page_size, detail::single_device_dispatch::get_queue());
-    uint64_t aligned_pool_base = next_multiple_of((uint64_t)_pool, _page_size);
+    // Aligning the pool to the huge page size also aligns all blocks of the
+    // free space map of at least this size, so that they can be mapped
+    // using huge pages.
+    std::size_t alignment =
+        std::max(_page_size, get_huge_page_size(huge_pages));
+
+    auto& q = detail::single_device_dispatch::get_queue();
+    if(huge_pages != huge_page_mode::none && _pool_size > 0) {
+      // For host devices, USM allocations are regular host memory, so we can
+      // control how the pool is mapped.
+      if(q.get_device().get_backend() == sycl::backend::omp)
+        _pool = map_host_pool(huge_pages, alignment);
+      else
+        HIPSYCL_DEBUG_WARNING
+            << "[stdpar] Huge pages for the memory pool are only supported "
+               "for host devices, ignoring request"
+            << std::endl;
+    }
+    // Make sure to allocate additional space so that we can fix alignment if needed
+    if(!_pool)
+      _pool = sycl::malloc_shared(_pool_size + alignment, q);
+    uint64_t aligned_pool_base = next_multiple_of((uint64_t)_pool, alignment);
     _base_address = (void*)aligned_pool_base;
     assert(aligned_pool_base % _page_size == 0);
+
+    if(_pool && _pool_size > 0 && prefault)
+      prefault_pages();
+
+    if(_pool && _pool_size > 0) {
+      std::size_t num_slabs = ceil_division(_pool_size, slab_size);
+      _slab_size_classes = static_cast<uint8_t*>(__libc_malloc(num_slabs));
+      _slabs = static_cast<slab_info*>(
+          __libc_malloc(num_slabs * sizeof(slab_info)));
+      if(_slab_size_classes && _slabs) {
+        std::memset(_slab_size_classes, no_size_class, num_slabs);
+        for(std::size_t i = 0; i < num_slabs; ++i)
+          new (&_slabs[i]) slab_info{};
+      } else {
+        __libc_free(_slab_size_classes);
+        __libc_free(_slabs);
+        _slab_size_classes = nullptr;
+        _slabs = nullptr;
+      }
+    }
+  }
+
+  static std::size_t get_huge_page_size(huge_page_mode mode) {
+    if(mode == huge_page_mode::explicit_1gb)
+      return 1024 * 1024 * 1024;
+    else if(mode != huge_page_mode::none)
+      return 2 * 1024 * 1024;
+    return 0;
+  }
+
+  // Maps anonymous memory for the pool, or returns nullptr on failure.
+  // Falls back to transparent huge pages if explicit huge pages are not
+  // available.
+  void* map_host_pool(huge_page_mode mode, std::size_t alignment) {
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT) && defined(MADV_HUGEPAGE)
+    if(mode == huge_page_mode::explicit_2mb ||
+       mode == huge_page_mode::explicit_1gb) {
+      int page_size_flag = (mode == huge_page_mode::explicit_1gb ? 30 : 21)
+                           << MAP_HUGE_SHIFT;
+      // Huge page mappings are always aligned to the huge page size
+      void *ptr = mmap(nullptr, next_multiple_of(_pool_size, alignment),
+                       PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | page_size_flag,
+                       -1, 0);
+      if(ptr != MAP_FAILED)
+        return ptr;
+      HIPSYCL_DEBUG_WARNING << "[stdpar] Could not map memory pool using "
+                               "explicit huge pages, falling back to "
+                               "transparent huge pages"
+                            << std::endl;
+    }
+
+    void *ptr = mmap(nullptr, _pool_size + alignment, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(ptr == MAP_FAILED)
+      return nullptr;
+    void *aligned_ptr = (void *)next_multiple_of((uint64_t)ptr, alignment);
+    if(madvise(aligned_ptr, _pool_size, MADV_HUGEPAGE) != 0)
+      HIPSYCL_DEBUG_WARNING << "[stdpar] Transparent huge pages are not "
+                               "available for the memory pool"
+                            << std::endl;
+    return ptr;
+#else
+    HIPSYCL_DEBUG_WARNING
+        << "[stdpar] Huge pages are not supported on this platform"
+        << std::endl;
+    return nullptr;
+#endif
+  }
+
+  // Touches all pages of the pool from multiple threads, so that page faults
+  // are not taken by the first algorithms using the memory.
+  void prefault_pages() {
+    std::size_t num_pages = ceil_division(_pool_size, _page_size);
+    std::size_t num_threads = std::max(
+        1u, std::min(std::thread::hardware_concurrency(), 64u));
+    std::size_t pages_per_thread = ceil_division(num_pages, num_threads);
+
+    auto touch = [this, num_pages, pages_per_thread](std::size_t thread_id) {
+      volatile char *base = static_cast<char *>(_base_address);
+      std::size_t end = std::min(num_pages, (thread_id + 1) * pages_per_thread);
+      for(std::size_t i = thread_id * pages_per_thread; i < end; ++i)
+        base[i * _page_size] = 0;
+    };
+
+    std::vector<std::thread, libc_allocator<std::thread>> threads;
+    threads.reserve(num_threads - 1);
+    for(std::size_t i = 1; i < num_threads; ++i)
+      threads.emplace_back(touch, i);
+    touch(0);
+    for(auto& t : threads)
+      t.join();
+  }
+
+  static std::size_t get_size_class(std::size_t size) {
+    for(std::size_t i = 0; i < num_size_classes; ++i)
+      if(size <= size_classes[i])
+        return i;
+    return num_size_classes - 1;
+  }
+
+  static std::size_t get_batch_size(std::size_t size_class) {
+    // Exchange roughly 8KB with the pool at a time
+    std::size_t batch_size = 8192 / size_classes[size_class];
+    return std::min(std::max(batch_size, std::size_t{4}), std::size_t{64});
+  }
+
+  std::size_t get_slab_index(void* ptr) const {
+    return (reinterpret_cast<uint64_t>(ptr) -
+            reinterpret_cast<uint64_t>(_base_address)) / slab_size;
+  }
+
+  uint8_t get_slab_size_class(void* ptr) const {
+    return __atomic_load_n(&_slab_size_classes[get_slab_index(ptr)],
+                           __ATOMIC_ACQUIRE);
+  }
+
+  thread_cache& get_thread_cache() {
+    static thread_local thread_cache cache;
+    if(!cache.pool)
+      cache.pool = this;
+    // The cache is bound to the first pool a thread uses
+    assert(cache.pool == this);
+    return cache;
+  }
+
+  void link_slab(size_class_state& state, slab_info* slab) {
+    slab->prev = nullptr;
+    slab->next = state.slabs_with_objects;
+    if(slab->next)
+      slab->next->prev = slab;
+    state.slabs_with_objects = slab;
+  }
+
+  void unlink_slab(size_class_state& state, slab_info* slab) {
+    if(slab->prev)
+      slab->prev->next = slab->next;
+    else
+      state.slabs_with_objects = slab->next;
+    if(slab->next)
+      slab->next->prev = slab->prev;
+    slab->prev = nullptr;
+    slab->next = nullptr;
+  }
+
+  // Returns a slab without objects in use to the page-granular part of the
+  // pool. Its objects are all in its free list at this point.
+  void release_slab(size_class_state& state, std::size_t slab_index) {
+    slab_info& slab = _slabs[slab_index];
+    unlink_slab(state, &slab);
+    slab.objects = free_list{};
+
+    char* address = static_cast<char*>(_base_address) + slab_index * slab_size;
+    if(state.slab_end == address + slab_size) {
+      state.slab_current = nullptr;
+      state.slab_end = nullptr;
+    }
+    __atomic_store_n(&_slab_size_classes[slab_index], no_size_class,
+                     __ATOMIC_RELEASE);
+    if(_on_slab_released)
+      _on_slab_released(address, slab_size);
+    release(address, slab_size);
   }
 
+  // Moves up to num_objects objects of the given size class from the pool
+  // to the provided list, creating a new slab if needed.
+  void obtain_objects(std::size_t size_class, free_list &out,
+                      std::size_t num_objects) {
+    size_class_state& state = _size_class_states[size_class];
+    spin_lock_guard lock{state.lock};
+
+    for(std::size_t i = 0; i < num_objects; ++i) {
+      if(slab_info* slab = state.slabs_with_objects) {
+        out.push(slab->objects.pop());
+        ++slab->num_in_use;
+        if(!slab->objects.head)
+          unlink_slab(state, slab);
+        continue;
+      }
+
+      std::size_t object_size = size_classes[size_class];
+      if(state.slab_current + object_size > state.slab_end) {
+        char* slab = static_cast<char*>(claim(slab_size));
+        if(!slab)
+          return;
+        // Blocks of the free space map are aligned to their size, so each
+        // slab occupies exactly one entry of _slab_size_classes.
+        assert((slab - static_cast<char*>(_base_address)) % slab_size == 0);
+        __atomic_store_n(&_slab_size_classes[get_slab_index(slab)],
+                         static_cast<uint8_t>(size_class), __ATOMIC_RELEASE);
+        if(_on_slab_claimed)
+          _on_slab_claimed(slab, slab_size);
+        state.slab_current = slab;
+        state.slab_end = slab + slab_size;
+      }
+      out.push(reinterpret_cast<free_object*>(state.slab_current));
+      ++_slabs[get_slab_index(state.slab_current)].num_in_use;
+      state.slab_current += object_size;
+    }
+  }
+
+  // Moves up to num_objects objects from the provided list back to the pool
+  void return_objects(std::size_t size_class, free_list &in,
+                      std::size_t num_objects) {
+    size_class_state& state = _size_class_states[size_class];
+    spin_lock_guard lock{state.lock};
+
+    std::size_t object_size = size_classes[size_class];
+    for(std::size_t i = 0; i < num_objects; ++i) {
+      free_object* obj = in.pop();
+      if(!obj)
+        return;
+
+      std::size_t slab_index = get_slab_index(obj);
+      slab_info& slab = _slabs[slab_index];
+      if(!slab.objects.head)
+        link_slab(state, &slab);
+      slab.objects.push(obj);
+      assert(slab.num_in_use > 0);
+      --slab.num_in_use;
+
+      // Keep the slab if new objects can still be carved out of it
+      bool is_carved_from = state.slab_current + object_size <= state.slab_end &&
+                            get_slab_index(state.slab_current) == slab_index;
+      if(slab.num_in_use == 0 && !is_carved_from)
+        release_slab(state, slab_index);
+    }
+  }
 
   std::size_t _pool_size;
   void* _pool;
   void* _base_address;
   free_space_map _free_space_map;
   std::size_t _page_size;
+  // Size class of each slab-sized region of the pool, or no_size_class
+  uint8_t* _slab_size_classes;
+  // Bookkeeping of each slab-sized region of the pool, protected by the
+  // lock of the slab's size class
+  slab_info* _slabs;
+  slab_callback _on_slab_claimed;
+  slab_callback _on_slab_released;
+  size_class_state _size_class_states[num_size_classes];
 };
 
 class unified_shared_memory {
@@ -312,6 +859,11 @@ class unified_shared_memory {
     // heuristic, touches this value - so it may not be up to date
     // if there is no prefetch!
     int64_t most_recent_offload_batch;
+    // Byte range [device_resident_begin, device_resident_end) relative to
+    // the start of the allocation that is assumed to currently reside in
+    // device memory. Maintained by the offload heuristic.
+    uint64_t device_resident_begin;
+    uint64_t device_resident_end;
   };
 
   using allocation_map_t = allocation_map<allocation_map_payload>;
@@ -333,6 +885,7 @@ public:
     if(thread_local_storage::get().disabled_stack == 0) {
       
       void* ptr = nullptr;
+      bool is_small_object = false;
       push_disabled();
       if (alignment != 0) {
         ptr = sycl::aligned_alloc_shared(alignment, n,
@@ -348,7 +901,10 @@ public:
           mem_pool = usm_manager.get_memory_pool();
         }
 
-        if(n < mem_pool->get_size() / 2) {
+        if(n <= memory_pool::max_small_object_size) {
+          ptr = mem_pool->claim_small(n);
+          is_small_object = ptr != nullptr;
+        } else if(n < mem_pool->get_size() / 2) {
           ptr = mem_pool->claim(n);
         }
         // ptr will still be nullptr if pool was not used, or pool allocation
@@ -360,10 +916,15 @@ public:
       get()._is_initialized = true;
       pop_disabled();
 
-      if(ptr) {
+      // Small objects are not tracked individually, since this would
+      // cost more than the allocation itself. Instead, their slab is
+      // registered as a whole when the pool creates it.
+      if(ptr && !is_small_object) {
         allocation_map_t::value_type v;
         v.allocation_size = n;
         v.most_recent_offload_batch = -1;
+        v.device_resident_begin = 0;
+        v.device_resident_end = 0;
         get()._allocation_map.insert(reinterpret_cast<uint64_t>(ptr), v);
       }
 
@@ -397,6 +958,15 @@ public:
         // the request.
         return;
 
+      memory_pool* mem_pool = get().get_memory_pool();
+      if(mem_pool && mem_pool->is_small_object(ptr)) {
+        // Setting up the thread cache on first use may allocate
+        push_disabled();
+        mem_pool->release_small(ptr);
+        pop_disabled();
+        return;
+      }
+
       push_disabled();
       auto* map_entry = get()._allocation_map.get_entry_of_root_address(
               reinterpret_cast<uint64_t>(ptr));
@@ -406,7 +976,6 @@ public:
         uint64_t allocation_size = map_entry->allocation_size;
 
         get()._allocation_map.erase(reinterpret_cast<uint64_t>(ptr));
-        memory_pool* mem_pool = get().get_memory_pool();
         if(mem_pool && mem_pool->is_from_pool(ptr)) {
           mem_pool->release(ptr, allocation_size);
         } else {
@@ -445,13 +1014,56 @@ private:
       memory_pool* mem_pool = (memory_pool *)__libc_malloc(sizeof(memory_pool));
       std::size_t pool_size = get_mem_pool_size_gb() * 1024 * 1024 * 1024;
 
-      new (mem_pool) memory_pool{pool_size};
+      bool prefault = false;
+      if(!rt::try_get_environment_variable("stdpar_mem_pool_prefault",
+                                           prefault))
+        prefault = false;
+
+      new (mem_pool)
+          memory_pool{pool_size, get_mem_pool_huge_page_mode(), prefault,
+                      &register_slab, &unregister_slab};
       __atomic_store_n(&_memory_pool,
                        mem_pool,
                        __ATOMIC_RELEASE);
     }
   }
 
+  static void register_slab(void* slab, std::size_t size) {
+    push_disabled();
+    allocation_map_t::value_type v;
+    v.allocation_size = size;
+    v.most_recent_offload_batch = -1;
+    v.device_resident_begin = 0;
+    v.device_resident_end = 0;
+    get()._allocation_map.insert(reinterpret_cast<uint64_t>(slab), v);
+    pop_disabled();
+  }
+
+  static void unregister_slab(void* slab, std::size_t) {
+    push_disabled();
+    get()._allocation_map.erase(reinterpret_cast<uint64_t>(slab));
+    pop_disabled();
+  }
+
+  memory_pool::huge_page_mode get_mem_pool_huge_page_mode() {
+    std::string mode;
+    if(rt::try_get_environment_variable("stdpar_mem_pool_huge_pages", mode)) {
+      if(mode == "none") {
+        return memory_pool::huge_page_mode::none;
+      } else if(mode == "transparent") {
+        return memory_pool::huge_page_mode::transparent;
+      } else if(mode == "2mb") {
+        return memory_pool::huge_page_mode::explicit_2mb;
+      } else if(mode == "1gb") {
+        return memory_pool::huge_page_mode::explicit_1gb;
+      } else {
+        HIPSYCL_DEBUG_ERROR << "Invalid memory pool huge page mode: " << mode
+                            << ", falling back to 'none'\n";
+      }
+    }
+    return memory_pool::huge_page_mode::none;
+  }
+
   double get_mem_pool_size_gb() {
     auto dev = detail::single_device_dispatch::get_queue().get_device();
 
@@ -19,6 +19,7 @@
 #include "../detail/stdpar_builtins.hpp"
 #include "../detail/stdpar_defs.hpp"
 #include "../detail/offload.hpp"
+#include "../detail/multi_device_dispatch.hpp"
 #include "hipSYCL/algorithms/algorithm.hpp"
 #include "hipSYCL/std/stdpar/detail/offload_heuristic_db.hpp"
 
@@ -31,7 +32,14 @@ template <class ForwardIt, class UnaryFunction2>
 HIPSYCL_STDPAR_ENTRYPOINT void for_each(hipsycl::stdpar::par_unseq, ForwardIt first,
                                         ForwardIt last, UnaryFunction2 f) {
   auto offloader = [&](auto& queue) {
-    hipsycl::algorithms::for_each(queue, first, last, f);
+    hipsycl::stdpar::detail::multi_device_dispatch::for_each_partition(
+        queue, std::distance(first, last),
+        [&](auto &partition_queue, std::size_t begin, std::size_t end) {
+          hipsycl::algorithms::for_each(partition_queue,
+                                        std::next(first, begin),
+                                        std::next(first, end), f);
+        },
+        first);
   };
 
   auto fallback = [&](){
@@ -78,7 +86,14 @@ ForwardIt2 transform(hipsycl::stdpar::par_unseq,
   auto offloader = [&](auto& queue){
     ForwardIt2 last = d_first;
     std::advance(last, std::distance(first1, last1));
-    hipsycl::algorithms::transform(queue, first1, last1, d_first, unary_op);
+    hipsycl::stdpar::detail::multi_device_dispatch::for_each_partition(
+        queue, std::distance(first1, last1),
+        [&](auto &partition_queue, std::size_t begin, std::size_t end) {
+          hipsycl::algorithms::transform(
+              partition_queue, std::next(first1, begin),
+              std::next(first1, end), std::next(d_first, begin), unary_op);
+        },
+        first1, d_first);
     return last;
   };
 
@@ -105,8 +120,15 @@ ForwardIt3 transform(hipsycl::stdpar::par_unseq,
   auto offloader = [&](auto &queue) {
     ForwardIt3 last = d_first;
     std::advance(last, std::distance(first1, last1));
-    hipsycl::algorithms::transform(queue, first1, last1, first2, d_first,
-                                   binary_op);
+    hipsycl::stdpar::detail::multi_device_dispatch::for_each_partition(
+        queue, std::distance(first1, last1),
+        [&](auto &partition_queue, std::size_t begin, std::size_t end) {
+          hipsycl::algorithms::transform(
+              partition_queue, std::next(first1, begin),
+              std::next(first1, end), std::next(first2, begin),
+              std::next(d_first, begin), binary_op);
+        },
+        first1, first2, d_first);
     return last;
   };
 
@@ -596,574 +618,2143 @@ ForwardIt3 merge(hipsycl::stdpar::par_unseq,
 }
 
 
+template <class ForwardIt>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt min_element(hipsycl::stdpar::par_unseq,
+                                                ForwardIt first,
+                                                ForwardIt last) {
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::min_element(queue, reduction_scratch_group, first,
+                                     last, output);
+    queue.wait();
+    return std::next(first, *output);
+  };
+
+  auto fallback = [&]() {
+    return std::min_element(hipsycl::stdpar::par_unseq_host_fallback, first,
+                            last);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::min_element{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
+}
+
+template <class ForwardIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt min_element(hipsycl::stdpar::par_unseq,
+                                                ForwardIt first,
+                                                ForwardIt last, Compare comp) {
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::min_element(queue, reduction_scratch_group, first,
+                                     last, output, comp);
+    queue.wait();
+    return std::next(first, *output);
+  };
+
+  auto fallback = [&]() {
+    return std::min_element(hipsycl::stdpar::par_unseq_host_fallback, first,
+                            last, comp);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::min_element{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
+}
+
+template <class ForwardIt>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt max_element(hipsycl::stdpar::par_unseq,
+                                                ForwardIt first,
+                                                ForwardIt last) {
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::max_element(queue, reduction_scratch_group, first,
+                                     last, output);
+    queue.wait();
+    return std::next(first, *output);
+  };
+
+  auto fallback = [&]() {
+    return std::max_element(hipsycl::stdpar::par_unseq_host_fallback, first,
+                            last);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::max_element{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
+}
+
+template <class ForwardIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt max_element(hipsycl::stdpar::par_unseq,
+                                                ForwardIt first,
+                                                ForwardIt last, Compare comp) {
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::max_element(queue, reduction_scratch_group, first,
+                                     last, output, comp);
+    queue.wait();
+    return std::next(first, *output);
+  };
+
+  auto fallback = [&]() {
+    return std::max_element(hipsycl::stdpar::par_unseq_host_fallback, first,
+                            last, comp);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::max_element{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
+}
+
+template <class ForwardIt>
+HIPSYCL_STDPAR_ENTRYPOINT std::pair<ForwardIt, ForwardIt>
+minmax_element(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last) {
+  using return_type = std::pair<ForwardIt, ForwardIt>;
+
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return return_type{first, first};
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        hipsycl::algorithms::detail::minmax_index<
+            typename std::iterator_traits<ForwardIt>::difference_type>>(1);
+    hipsycl::algorithms::minmax_element(queue, reduction_scratch_group, first,
+                                        last, output);
+    queue.wait();
+    return return_type{std::next(first, output->min),
+                       std::next(first, output->max)};
+  };
+
+  auto fallback = [&]() {
+    return std::minmax_element(hipsycl::stdpar::par_unseq_host_fallback, first,
+                               last);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::minmax_element{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), return_type, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
+}
+
+template <class ForwardIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT std::pair<ForwardIt, ForwardIt>
+minmax_element(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
+               Compare comp) {
+  using return_type = std::pair<ForwardIt, ForwardIt>;
+
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return return_type{first, first};
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        hipsycl::algorithms::detail::minmax_index<
+            typename std::iterator_traits<ForwardIt>::difference_type>>(1);
+    hipsycl::algorithms::minmax_element(queue, reduction_scratch_group, first,
+                                        last, output, comp);
+    queue.wait();
+    return return_type{std::next(first, output->min),
+                       std::next(first, output->max)};
+  };
+
+  auto fallback = [&]() {
+    return std::minmax_element(hipsycl::stdpar::par_unseq_host_fallback, first,
+                               last, comp);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::minmax_element{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), return_type, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
+}
+
+template <class ForwardIt, class T>
+HIPSYCL_STDPAR_ENTRYPOINT
+typename std::iterator_traits<ForwardIt>::difference_type
+count(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
+      const T &value) {
+  using difference_type =
+      typename std::iterator_traits<ForwardIt>::difference_type;
+
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return difference_type{0};
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<difference_type>(1);
+    hipsycl::algorithms::count(queue, reduction_scratch_group, first, last,
+                               output, value);
+    queue.wait();
+    return *output;
+  };
+
+  auto fallback = [&]() {
+    return std::count(hipsycl::stdpar::par_unseq_host_fallback, first, last,
+                      value);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::count{},
+                                 hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), difference_type, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), value);
+}
+
+template <class ForwardIt, class UnaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT
+typename std::iterator_traits<ForwardIt>::difference_type
+count_if(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
+         UnaryPredicate p) {
+  using difference_type =
+      typename std::iterator_traits<ForwardIt>::difference_type;
+
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return difference_type{0};
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<difference_type>(1);
+    hipsycl::algorithms::count_if(queue, reduction_scratch_group, first, last,
+                                  output, p);
+    queue.wait();
+    return *output;
+  };
+
+  auto fallback = [&]() {
+    return std::count_if(hipsycl::stdpar::par_unseq_host_fallback, first, last,
+                         p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::count_if{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), difference_type, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+}
+
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT bool equal(hipsycl::stdpar::par_unseq,
+                                     ForwardIt1 first1, ForwardIt1 last1,
+                                     ForwardIt2 first2) {
+  auto offloader = [&](auto &queue) {
+    if(first1 == last1)
+      return true;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+
+    auto *output = output_scratch_group
+                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    hipsycl::algorithms::equal(queue, first1, last1, first2, output);
+    queue.wait();
+    return static_cast<bool>(*output);
+  };
+
+  auto fallback = [&]() {
+    return std::equal(hipsycl::stdpar::par_unseq_host_fallback, first1, last1,
+                      first2);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::equal{},
+                                 hipsycl::stdpar::par_unseq{}),
+      std::distance(first1, last1), bool, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT bool equal(hipsycl::stdpar::par_unseq,
+                                     ForwardIt1 first1, ForwardIt1 last1,
+                                     ForwardIt2 first2, BinaryPredicate p) {
+  auto offloader = [&](auto &queue) {
+    if(first1 == last1)
+      return true;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+
+    auto *output = output_scratch_group
+                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    hipsycl::algorithms::equal(queue, first1, last1, first2, output, p);
+    queue.wait();
+    return static_cast<bool>(*output);
+  };
+
+  auto fallback = [&]() {
+    return std::equal(hipsycl::stdpar::par_unseq_host_fallback, first1, last1,
+                      first2, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::equal{},
+                                 hipsycl::stdpar::par_unseq{}),
+      std::distance(first1, last1), bool, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2, p);
+}
+
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT bool equal(hipsycl::stdpar::par_unseq,
+                                     ForwardIt1 first1, ForwardIt1 last1,
+                                     ForwardIt2 first2, ForwardIt2 last2) {
+  auto offloader = [&](auto &queue) {
+    if(std::distance(first1, last1) != std::distance(first2, last2))
+      return false;
+    if(first1 == last1)
+      return true;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+
+    auto *output = output_scratch_group
+                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    hipsycl::algorithms::equal(queue, first1, last1, first2, output);
+    queue.wait();
+    return static_cast<bool>(*output);
+  };
+
+  auto fallback = [&]() {
+    return std::equal(hipsycl::stdpar::par_unseq_host_fallback, first1, last1,
+                      first2, last2);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::equal{},
+                                 hipsycl::stdpar::par_unseq{}),
+      std::distance(first1, last1), bool, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2));
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT bool
+equal(hipsycl::stdpar::par_unseq, ForwardIt1 first1, ForwardIt1 last1,
+      ForwardIt2 first2, ForwardIt2 last2, BinaryPredicate p) {
+  auto offloader = [&](auto &queue) {
+    if(std::distance(first1, last1) != std::distance(first2, last2))
+      return false;
+    if(first1 == last1)
+      return true;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+
+    auto *output = output_scratch_group
+                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    hipsycl::algorithms::equal(queue, first1, last1, first2, output, p);
+    queue.wait();
+    return static_cast<bool>(*output);
+  };
+
+  auto fallback = [&]() {
+    return std::equal(hipsycl::stdpar::par_unseq_host_fallback, first1, last1,
+                      first2, last2, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::equal{},
+                                 hipsycl::stdpar::par_unseq{}),
+      std::distance(first1, last1), bool, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2), p);
+}
+
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT std::pair<ForwardIt1, ForwardIt2>
+mismatch(hipsycl::stdpar::par_unseq, ForwardIt1 first1, ForwardIt1 last1,
+         ForwardIt2 first2) {
+  using return_type = std::pair<ForwardIt1, ForwardIt2>;
+
+  auto offloader = [&](auto &queue) {
+    if(first1 == last1)
+      return return_type{first1, first2};
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt1>::difference_type>(1);
+    hipsycl::algorithms::mismatch(queue, reduction_scratch_group, first1,
+                                  last1, first2, output);
+    queue.wait();
+    return return_type{std::next(first1, *output), std::next(first2, *output)};
+  };
+
+  auto fallback = [&]() {
+    return std::mismatch(hipsycl::stdpar::par_unseq_host_fallback, first1,
+                         last1, first2);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::mismatch{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first1, last1), return_type, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT std::pair<ForwardIt1, ForwardIt2>
+mismatch(hipsycl::stdpar::par_unseq, ForwardIt1 first1, ForwardIt1 last1,
+         ForwardIt2 first2, BinaryPredicate p) {
+  using return_type = std::pair<ForwardIt1, ForwardIt2>;
+
+  auto offloader = [&](auto &queue) {
+    if(first1 == last1)
+      return return_type{first1, first2};
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt1>::difference_type>(1);
+    hipsycl::algorithms::mismatch(queue, reduction_scratch_group, first1,
+                                  last1, first2, output, p);
+    queue.wait();
+    return return_type{std::next(first1, *output), std::next(first2, *output)};
+  };
+
+  auto fallback = [&]() {
+    return std::mismatch(hipsycl::stdpar::par_unseq_host_fallback, first1,
+                         last1, first2, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::mismatch{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first1, last1), return_type, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2, p);
+}
+
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT std::pair<ForwardIt1, ForwardIt2>
+mismatch(hipsycl::stdpar::par_unseq, ForwardIt1 first1, ForwardIt1 last1,
+         ForwardIt2 first2, ForwardIt2 last2) {
+  using return_type = std::pair<ForwardIt1, ForwardIt2>;
+
+  auto offloader = [&](auto &queue) {
+    auto problem_size = std::min(std::distance(first1, last1),
+                                 std::distance(first2, last2));
+    if(problem_size == 0)
+      return return_type{first1, first2};
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt1>::difference_type>(1);
+    hipsycl::algorithms::mismatch(queue, reduction_scratch_group, first1,
+                                  std::next(first1, problem_size), first2,
+                                  output);
+    queue.wait();
+    return return_type{std::next(first1, *output), std::next(first2, *output)};
+  };
+
+  auto fallback = [&]() {
+    return std::mismatch(hipsycl::stdpar::par_unseq_host_fallback, first1,
+                         last1, first2, last2);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::mismatch{},
+          hipsycl::stdpar::par_unseq{}),
+      std::min(std::distance(first1, last1), std::distance(first2, last2)),
+      return_type, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2));
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT std::pair<ForwardIt1, ForwardIt2>
+mismatch(hipsycl::stdpar::par_unseq, ForwardIt1 first1, ForwardIt1 last1,
+         ForwardIt2 first2, ForwardIt2 last2, BinaryPredicate p) {
+  using return_type = std::pair<ForwardIt1, ForwardIt2>;
+
+  auto offloader = [&](auto &queue) {
+    auto problem_size = std::min(std::distance(first1, last1),
+                                 std::distance(first2, last2));
+    if(problem_size == 0)
+      return return_type{first1, first2};
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt1>::difference_type>(1);
+    hipsycl::algorithms::mismatch(queue, reduction_scratch_group, first1,
+                                  std::next(first1, problem_size), first2,
+                                  output, p);
+    queue.wait();
+    return return_type{std::next(first1, *output), std::next(first2, *output)};
+  };
+
+  auto fallback = [&]() {
+    return std::mismatch(hipsycl::stdpar::par_unseq_host_fallback, first1,
+                         last1, first2, last2, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::mismatch{},
+          hipsycl::stdpar::par_unseq{}),
+      std::min(std::distance(first1, last1), std::distance(first2, last2)),
+      return_type, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2), p);
+}
+
+template <class ForwardIt>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt adjacent_find(hipsycl::stdpar::par_unseq,
+                                                  ForwardIt first,
+                                                  ForwardIt last) {
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::adjacent_find(queue, reduction_scratch_group, first,
+                                       last, output);
+    queue.wait();
+    return std::next(first, *output);
+  };
+
+  auto fallback = [&]() {
+    return std::adjacent_find(hipsycl::stdpar::par_unseq_host_fallback, first,
+                              last);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::adjacent_find{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
+}
+
+template <class ForwardIt, class BinaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt
+adjacent_find(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
+              BinaryPredicate p) {
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::adjacent_find(queue, reduction_scratch_group, first,
+                                       last, output, p);
+    queue.wait();
+    return std::next(first, *output);
+  };
+
+  auto fallback = [&]() {
+    return std::adjacent_find(hipsycl::stdpar::par_unseq_host_fallback, first,
+                              last, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::adjacent_find{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+}
+
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT bool
+lexicographical_compare(hipsycl::stdpar::par_unseq, ForwardIt1 first1,
+                        ForwardIt1 last1, ForwardIt2 first2, ForwardIt2 last2) {
+  auto offloader = [&](auto &queue) {
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group
+                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    hipsycl::algorithms::lexicographical_compare(
+        queue, reduction_scratch_group, first1, last1, first2, last2, output);
+    queue.wait();
+    return static_cast<bool>(*output);
+  };
+
+  auto fallback = [&]() {
+    return std::lexicographical_compare(
+        hipsycl::stdpar::par_unseq_host_fallback, first1, last1, first2, last2);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::lexicographical_compare{},
+          hipsycl::stdpar::par_unseq{}),
+      std::min(std::distance(first1, last1), std::distance(first2, last2)),
+      bool, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2));
+}
+
+template <class ForwardIt1, class ForwardIt2, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT bool
+lexicographical_compare(hipsycl::stdpar::par_unseq, ForwardIt1 first1,
+                        ForwardIt1 last1, ForwardIt2 first2, ForwardIt2 last2,
+                        Compare comp) {
+  auto offloader = [&](auto &queue) {
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group
+                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    hipsycl::algorithms::lexicographical_compare(queue, reduction_scratch_group,
+                                                 first1, last1, first2, last2,
+                                                 output, comp);
+    queue.wait();
+    return static_cast<bool>(*output);
+  };
+
+  auto fallback = [&]() {
+    return std::lexicographical_compare(
+        hipsycl::stdpar::par_unseq_host_fallback, first1, last1, first2, last2,
+        comp);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::lexicographical_compare{},
+          hipsycl::stdpar::par_unseq{}),
+      std::min(std::distance(first1, last1), std::distance(first2, last2)),
+      bool, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2), comp);
+}
+
+
 //////////////////// par policy  /////////////////////////////////////
 
 
-template <class ForwardIt, class UnaryFunction2>
-HIPSYCL_STDPAR_ENTRYPOINT void for_each(hipsycl::stdpar::par, ForwardIt first,
-                                        ForwardIt last, UnaryFunction2 f) {
+template <class ForwardIt, class UnaryFunction2>
+HIPSYCL_STDPAR_ENTRYPOINT void for_each(hipsycl::stdpar::par, ForwardIt first,
+                                        ForwardIt last, UnaryFunction2 f) {
+  auto offloader = [&](auto& queue) {
+    hipsycl::stdpar::detail::multi_device_dispatch::for_each_partition(
+        queue, std::distance(first, last),
+        [&](auto &partition_queue, std::size_t begin, std::size_t end) {
+          hipsycl::algorithms::for_each(partition_queue,
+                                        std::next(first, begin),
+                                        std::next(first, end), f);
+        },
+        first);
+  };
+
+  auto fallback = [&](){
+    std::for_each(hipsycl::stdpar::par_host_fallback, first, last, f);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::for_each{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), f);
+}
+
+template<class ForwardIt, class Size, class UnaryFunction2>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt for_each_n(hipsycl::stdpar::par,
+                    ForwardIt first, Size n, UnaryFunction2 f) {
+  auto offloader = [&](auto& queue) {
+    ForwardIt last = first;
+    std::advance(last, std::max(n, Size{0}));
+    hipsycl::algorithms::for_each_n(queue, first, n, f);
+    return last;
+  };
+
+  auto fallback = [&]() {
+    return std::for_each_n(hipsycl::stdpar::par_host_fallback, first, n,
+                           f);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::for_each_n{},
+          hipsycl::stdpar::par{}),
+      n, ForwardIt, offloader, fallback, first, n, f);
+}
+
+template <class ForwardIt1, class ForwardIt2, class UnaryOperation>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt2 transform(hipsycl::stdpar::par,
+                     ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 d_first,
+                     UnaryOperation unary_op) {
+  
+  auto offloader = [&](auto& queue){
+    ForwardIt2 last = d_first;
+    std::advance(last, std::distance(first1, last1));
+    hipsycl::stdpar::detail::multi_device_dispatch::for_each_partition(
+        queue, std::distance(first1, last1),
+        [&](auto &partition_queue, std::size_t begin, std::size_t end) {
+          hipsycl::algorithms::transform(
+              partition_queue, std::next(first1, begin),
+              std::next(first1, end), std::next(d_first, begin), unary_op);
+        },
+        first1, d_first);
+    return last;
+  };
+
+  auto fallback = [&]() {
+    return std::transform(hipsycl::stdpar::par_host_fallback, first1,
+                          last1, d_first, unary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::transform{},
+          hipsycl::stdpar::par{}),
+      std::distance(first1, last1), ForwardIt2, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), d_first, unary_op);
+}
+
+template <class ForwardIt1, class ForwardIt2, class ForwardIt3,
+          class BinaryOperation>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt3 transform(hipsycl::stdpar::par,
+                     ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2,
+                     ForwardIt3 d_first, BinaryOperation binary_op) {
+
+  auto offloader = [&](auto &queue) {
+    ForwardIt3 last = d_first;
+    std::advance(last, std::distance(first1, last1));
+    hipsycl::stdpar::detail::multi_device_dispatch::for_each_partition(
+        queue, std::distance(first1, last1),
+        [&](auto &partition_queue, std::size_t begin, std::size_t end) {
+          hipsycl::algorithms::transform(
+              partition_queue, std::next(first1, begin),
+              std::next(first1, end), std::next(first2, begin),
+              std::next(d_first, begin), binary_op);
+        },
+        first1, first2, d_first);
+    return last;
+  };
+
+  auto fallback = [&]() {
+    return std::transform(hipsycl::stdpar::par_host_fallback, first1,
+                          last1, first2, d_first, binary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::transform{},
+          hipsycl::stdpar::par{}),
+      std::distance(first1, last1), ForwardIt3, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2, d_first, binary_op);
+}
+
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 copy(const hipsycl::stdpar::par,
+                                          ForwardIt1 first, ForwardIt1 last,
+                                          ForwardIt2 d_first) {
+  auto offloader = [&](auto& queue){
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    hipsycl::algorithms::copy(queue, first, last, d_first);
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::copy(hipsycl::stdpar::par_host_fallback, first, last,
+                     d_first);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::copy{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first);
+}
+
+template<class ForwardIt1, class ForwardIt2, class UnaryPredicate >
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt2 copy_if(hipsycl::stdpar::par,
+                   ForwardIt1 first, ForwardIt1 last,
+                   ForwardIt2 d_first,
+                   UnaryPredicate pred) {
+  auto offloader = [&](auto& queue){
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    hipsycl::algorithms::copy_if(queue, first, last, d_first, pred);
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::copy_if(hipsycl::stdpar::par_host_fallback, first, last,
+                        d_first, pred);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::copy_if{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, pred);
+}
+
+template<class ForwardIt1, class Size, class ForwardIt2 >
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt2 copy_n(hipsycl::stdpar::par,
+                   ForwardIt1 first, Size count, ForwardIt2 result ) {
+
+  auto offloader = [&](auto& queue){
+    ForwardIt2 last = result;
+    std::advance(last, std::max(count, Size{0}));
+    hipsycl::algorithms::copy_n(queue, first, count, result);
+    return last;
+  };
+
+  auto fallback = [&]() {
+    return std::copy_n(hipsycl::stdpar::par_host_fallback, first, count,
+                       result);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::copy_n{},
+                                 hipsycl::stdpar::par{}),
+      count, ForwardIt2, offloader, fallback, first, count, result);
+}
+
+template<class ForwardIt, class T >
+HIPSYCL_STDPAR_ENTRYPOINT
+void fill(hipsycl::stdpar::par,
+          ForwardIt first, ForwardIt last, const T& value) {
+  auto offloader = [&](auto& queue){
+    hipsycl::algorithms::fill(queue, first, last, value);
+  };
+
+  auto fallback = [&]() {
+    std::fill(hipsycl::stdpar::par_host_fallback, first, last, value);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::fill{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), value);
+}
+
+template <class ForwardIt, class Size, class T>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt fill_n(hipsycl::stdpar::par, ForwardIt first,
+                                           Size count, const T &value) {
+ 
+  auto offloader = [&](auto& queue){
+    ForwardIt last = first;
+    std::advance(last, std::max(count, Size{0}));
+    hipsycl::algorithms::fill_n(queue, first, count, value);
+    return last;
+  };
+
+  auto fallback = [&]() {
+    return std::fill_n(hipsycl::stdpar::par_host_fallback, first, count,
+                       value);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::fill_n{},
+                                 hipsycl::stdpar::par{}),
+      count, ForwardIt, offloader, fallback, first, count, value);
+}
+
+template <class ForwardIt, class Generator>
+HIPSYCL_STDPAR_ENTRYPOINT void generate(hipsycl::stdpar::par, ForwardIt first,
+                                        ForwardIt last, Generator g) {
+  auto offloader = [&](auto &queue) {
+    hipsycl::algorithms::generate(queue, first, last, g);
+  };
+
+  auto fallback = [&]() {
+    std::generate(hipsycl::stdpar::par_host_fallback, first, last, g);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::generate{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), g);
+}
+
+template <class ForwardIt, class Size, class Generator>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt generate_n(hipsycl::stdpar::par,
+                                               ForwardIt first, Size count,
+                                               Generator g) {
+  auto offloader = [&](auto& queue){
+    ForwardIt last = first;
+    std::advance(last, std::max(count, Size{0}));
+    hipsycl::algorithms::generate_n(queue, first, count, g);
+    return last;
+  };
+
+  auto fallback = [&]() {
+    return std::generate_n(hipsycl::stdpar::par_host_fallback, first,
+                           count, g);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(hipsycl::stdpar::algorithm(
+                             hipsycl::stdpar::algorithm_category::generate_n{},
+                             hipsycl::stdpar::par{}),
+                         count, ForwardIt, offloader, fallback, first, count,
+                         g);
+}
+
+template <class ForwardIt, class T>
+HIPSYCL_STDPAR_ENTRYPOINT
+void replace(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
+             const T &old_value, const T &new_value) {
+  auto offloader = [&](auto &queue) {
+    hipsycl::algorithms::replace(queue, first, last, old_value, new_value);
+  };
+
+  auto fallback = [&]() {
+    std::replace(hipsycl::stdpar::par_host_fallback, first, last,
+                 old_value, new_value);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::replace{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), old_value, new_value);
+}
+
+template <class ForwardIt, class UnaryPredicate, class T>
+HIPSYCL_STDPAR_ENTRYPOINT
+void replace_if(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
+                UnaryPredicate p, const T &new_value) {
+  
+  auto offloader = [&](auto& queue){
+    hipsycl::algorithms::replace_if(queue, first, last, p, new_value);
+  };
+
+  auto fallback = [&]() {
+    std::replace_if(hipsycl::stdpar::par_host_fallback, first, last, p,
+                    new_value);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::replace_if{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p, new_value);
+}
+
+template <class ForwardIt1, class ForwardIt2, class T>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2
+replace_copy(hipsycl::stdpar::par, ForwardIt1 first, ForwardIt1 last,
+             ForwardIt2 d_first, const T &old_value, const T &new_value) {
+
+  auto offloader = [&](auto &queue) {
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    hipsycl::algorithms::replace_copy(queue, first, last, d_first, old_value,
+                                      new_value);
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::replace_copy(hipsycl::stdpar::par_host_fallback, first,
+                             last, d_first, old_value, new_value);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::replace_copy{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, old_value, new_value);
+}
+
+template <class ForwardIt1, class ForwardIt2, class UnaryPredicate, class T>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 replace_copy_if(
+    hipsycl::stdpar::par, ForwardIt1 first,
+    ForwardIt1 last, ForwardIt2 d_first, UnaryPredicate p, const T &new_value) {
+
+  auto offloader = [&](auto &queue) {
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    hipsycl::algorithms::replace_copy_if(queue, first, last, d_first, p,
+                                         new_value);
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::replace_copy_if(hipsycl::stdpar::par_host_fallback, first,
+                                last, d_first, p, new_value);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+                             hipsycl::stdpar::algorithm_category::replace_copy_if{},
+                             hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, p, new_value);
+}
+
+/*
+template <class ForwardIt, class T>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find(const hipsycl::stdpar::par, ForwardIt first,
+                                         ForwardIt last, const T &value);
+
+template <class ForwardIt, class UnaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find_if(const hipsycl::stdpar::par,
+                                            ForwardIt first, ForwardIt last,
+                                            UnaryPredicate p);
+
+template <class ForwardIt, class UnaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find_if_not(const hipsycl::stdpar::par,
+                                                ForwardIt first, ForwardIt last,
+                                                UnaryPredicate q); */
+
+
+template<class ForwardIt, class UnaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT
+bool all_of(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
+            UnaryPredicate p ) {
+
+  auto offloader = [&](auto& queue){
+    
+    if(std::distance(first, last) == 0)
+      return true;
+    
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+
+    auto *output = output_scratch_group
+                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    hipsycl::algorithms::all_of(queue, first, last, output, p);
+    queue.wait();
+    return static_cast<bool>(*output);
+  };
+
+  auto fallback = [&](){
+    return std::all_of(hipsycl::stdpar::par_host_fallback, first, last, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::all_of{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first, last), bool, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+}
+
+template<class ForwardIt, class UnaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT
+bool any_of(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
+            UnaryPredicate p ) {
+  
+  auto offloader = [&](auto& queue){
+
+    if(std::distance(first, last) == 0)
+      return false;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+
+    auto *output = output_scratch_group
+                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    hipsycl::algorithms::any_of(queue, first, last, output, p);
+    queue.wait();
+    return static_cast<bool>(*output);
+  };
+
+  auto fallback = [&](){
+    return std::any_of(hipsycl::stdpar::par_host_fallback, first, last, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::any_of{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first, last), bool, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+}
+
+template<class ForwardIt, class UnaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT
+bool none_of(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
+            UnaryPredicate p ) {
+  
+  auto offloader = [&](auto& queue){
+
+    if(std::distance(first, last) == 0)
+      return true;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+
+    auto *output = output_scratch_group
+                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    hipsycl::algorithms::none_of(queue, first, last, output, p);
+    queue.wait();
+    return static_cast<bool>(*output);
+  };
+
+  auto fallback = [&](){
+    return std::none_of(hipsycl::stdpar::par_host_fallback, first, last, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::none_of{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first, last), bool, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+}
+
+template <class RandomIt>
+HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par, RandomIt first,
+                                        RandomIt last) {
   auto offloader = [&](auto& queue) {
-    hipsycl::algorithms::for_each(queue, first, last, f);
+    hipsycl::algorithms::sort(queue, first, last);
   };
 
   auto fallback = [&](){
-    std::for_each(hipsycl::stdpar::par_host_fallback, first, last, f);
+    std::sort(hipsycl::stdpar::par_host_fallback, first, last);
   };
 
   HIPSYCL_STDPAR_OFFLOAD_NORET(
       hipsycl::stdpar::algorithm(
-          hipsycl::stdpar::algorithm_category::for_each{},
+          hipsycl::stdpar::algorithm_category::sort{},
           hipsycl::stdpar::par{}),
       std::distance(first, last), offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), f);
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
 }
 
-template<class ForwardIt, class Size, class UnaryFunction2>
-HIPSYCL_STDPAR_ENTRYPOINT
-ForwardIt for_each_n(hipsycl::stdpar::par,
-                    ForwardIt first, Size n, UnaryFunction2 f) {
+template <class RandomIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par, RandomIt first,
+                                    RandomIt last, Compare comp) {
   auto offloader = [&](auto& queue) {
-    ForwardIt last = first;
-    std::advance(last, std::max(n, Size{0}));
-    hipsycl::algorithms::for_each_n(queue, first, n, f);
-    return last;
+    hipsycl::algorithms::sort(queue, first, last, comp);
   };
 
   auto fallback = [&]() {
-    return std::for_each_n(hipsycl::stdpar::par_host_fallback, first, n,
-                           f);
+    std::sort(hipsycl::stdpar::par_host_fallback, first, last, comp);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
       hipsycl::stdpar::algorithm(
-          hipsycl::stdpar::algorithm_category::for_each_n{},
+          hipsycl::stdpar::algorithm_category::sort{},
           hipsycl::stdpar::par{}),
-      n, ForwardIt, offloader, fallback, first, n, f);
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
 }
 
-template <class ForwardIt1, class ForwardIt2, class UnaryOperation>
+
+
+template<class ForwardIt1, class ForwardIt2,
+         class ForwardIt3, class Compare>
 HIPSYCL_STDPAR_ENTRYPOINT
-ForwardIt2 transform(hipsycl::stdpar::par,
-                     ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 d_first,
-                     UnaryOperation unary_op) {
-  
-  auto offloader = [&](auto& queue){
-    ForwardIt2 last = d_first;
-    std::advance(last, std::distance(first1, last1));
-    hipsycl::algorithms::transform(queue, first1, last1, d_first, unary_op);
-    return last;
+ForwardIt3 merge(hipsycl::stdpar::par,
+                  ForwardIt1 first1, ForwardIt1 last1,
+                  ForwardIt2 first2, ForwardIt2 last2,
+                  ForwardIt3 d_first, Compare comp) {
+  auto offloader = [&](auto &queue) {
+    auto scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    hipsycl::algorithms::merge(queue, scratch_group, first1, last1, first2,
+                               last2, d_first, comp);
+    auto d_last = d_first;
+    std::advance(d_last,
+                 std::distance(first1, last1) + std::distance(first2, last2));
+    return d_last;
   };
 
   auto fallback = [&]() {
-    return std::transform(hipsycl::stdpar::par_host_fallback, first1,
-                          last1, d_first, unary_op);
+    return std::merge(hipsycl::stdpar::par_unseq_host_fallback, first1, last1,
+                      first2, last2, d_first, comp);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::merge{},
+                                 hipsycl::stdpar::par_unseq{}),
+      std::distance(first1, last1) + std::distance(first2, last2), ForwardIt3,
+      offloader, fallback, first1, HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1),
+      first2, HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2), d_first, comp);
+}
+
+template<class ForwardIt1, class ForwardIt2,
+         class ForwardIt3, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt3 merge(hipsycl::stdpar::par,
+                  ForwardIt1 first1, ForwardIt1 last1,
+                  ForwardIt2 first2, ForwardIt2 last2,
+                  ForwardIt3 d_first) {
+  auto offloader = [&](auto &queue) {
+    auto scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    hipsycl::algorithms::merge(queue, scratch_group, first1, last1, first2,
+                               last2, d_first);
+    auto d_last = d_first;
+    std::advance(d_last,
+                 std::distance(first1, last1) + std::distance(first2, last2));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::merge(hipsycl::stdpar::par_host_fallback, first1, last1,
+                      first2, last2, d_first);
   };
 
   HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::merge{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first1, last1) + std::distance(first2, last2), ForwardIt3,
+      offloader, fallback, first1, HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1),
+      first2, HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2), d_first);
+}
+
+
+template <class ForwardIt>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt min_element(hipsycl::stdpar::par,
+                                                ForwardIt first,
+                                                ForwardIt last) {
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::min_element(queue, reduction_scratch_group, first,
+                                     last, output);
+    queue.wait();
+    return std::next(first, *output);
+  };
+
+  auto fallback = [&]() {
+    return std::min_element(hipsycl::stdpar::par_host_fallback, first,
+                            last);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
       hipsycl::stdpar::algorithm(
-          hipsycl::stdpar::algorithm_category::transform{},
+          hipsycl::stdpar::algorithm_category::min_element{},
           hipsycl::stdpar::par{}),
-      std::distance(first1, last1), ForwardIt2, offloader, fallback, first1,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), d_first, unary_op);
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
 }
 
-template <class ForwardIt1, class ForwardIt2, class ForwardIt3,
-          class BinaryOperation>
-HIPSYCL_STDPAR_ENTRYPOINT
-ForwardIt3 transform(hipsycl::stdpar::par,
-                     ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2,
-                     ForwardIt3 d_first, BinaryOperation binary_op) {
+template <class ForwardIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt min_element(hipsycl::stdpar::par,
+                                                ForwardIt first,
+                                                ForwardIt last, Compare comp) {
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::min_element(queue, reduction_scratch_group, first,
+                                     last, output, comp);
+    queue.wait();
+    return std::next(first, *output);
+  };
+
+  auto fallback = [&]() {
+    return std::min_element(hipsycl::stdpar::par_host_fallback, first,
+                            last, comp);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::min_element{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
+}
+
+template <class ForwardIt>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt max_element(hipsycl::stdpar::par,
+                                                ForwardIt first,
+                                                ForwardIt last) {
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::max_element(queue, reduction_scratch_group, first,
+                                     last, output);
+    queue.wait();
+    return std::next(first, *output);
+  };
+
+  auto fallback = [&]() {
+    return std::max_element(hipsycl::stdpar::par_host_fallback, first,
+                            last);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::max_element{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
+}
+
+template <class ForwardIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt max_element(hipsycl::stdpar::par,
+                                                ForwardIt first,
+                                                ForwardIt last, Compare comp) {
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
 
-  auto offloader = [&](auto &queue) {
-    ForwardIt3 last = d_first;
-    std::advance(last, std::distance(first1, last1));
-    hipsycl::algorithms::transform(queue, first1, last1, first2, d_first,
-                                   binary_op);
-    return last;
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::max_element(queue, reduction_scratch_group, first,
+                                     last, output, comp);
+    queue.wait();
+    return std::next(first, *output);
   };
 
   auto fallback = [&]() {
-    return std::transform(hipsycl::stdpar::par_host_fallback, first1,
-                          last1, first2, d_first, binary_op);
+    return std::max_element(hipsycl::stdpar::par_host_fallback, first,
+                            last, comp);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
       hipsycl::stdpar::algorithm(
-          hipsycl::stdpar::algorithm_category::transform{},
+          hipsycl::stdpar::algorithm_category::max_element{},
           hipsycl::stdpar::par{}),
-      std::distance(first1, last1), ForwardIt3, offloader, fallback, first1,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2, d_first, binary_op);
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
 }
 
-template <class ForwardIt1, class ForwardIt2>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 copy(const hipsycl::stdpar::par,
-                                          ForwardIt1 first, ForwardIt1 last,
-                                          ForwardIt2 d_first) {
-  auto offloader = [&](auto& queue){
-    ForwardIt2 d_last = d_first;
-    std::advance(d_last, std::distance(first, last));
-    hipsycl::algorithms::copy(queue, first, last, d_first);
-    return d_last;
-  };
+template <class ForwardIt>
+HIPSYCL_STDPAR_ENTRYPOINT std::pair<ForwardIt, ForwardIt>
+minmax_element(hipsycl::stdpar::par, ForwardIt first, ForwardIt last) {
+  using return_type = std::pair<ForwardIt, ForwardIt>;
 
-  auto fallback = [&]() {
-    return std::copy(hipsycl::stdpar::par_host_fallback, first, last,
-                     d_first);
-  };
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return return_type{first, first};
 
-  HIPSYCL_STDPAR_OFFLOAD(
-      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::copy{},
-                                 hipsycl::stdpar::par{}),
-      std::distance(first, last), ForwardIt2, offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first);
-}
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
 
-template<class ForwardIt1, class ForwardIt2, class UnaryPredicate >
-HIPSYCL_STDPAR_ENTRYPOINT
-ForwardIt2 copy_if(hipsycl::stdpar::par,
-                   ForwardIt1 first, ForwardIt1 last,
-                   ForwardIt2 d_first,
-                   UnaryPredicate pred) {
-  auto offloader = [&](auto& queue){
-    ForwardIt2 d_last = d_first;
-    std::advance(d_last, std::distance(first, last));
-    hipsycl::algorithms::copy_if(queue, first, last, d_first, pred);
-    return d_last;
+    auto *output = output_scratch_group.obtain<
+        hipsycl::algorithms::detail::minmax_index<
+            typename std::iterator_traits<ForwardIt>::difference_type>>(1);
+    hipsycl::algorithms::minmax_element(queue, reduction_scratch_group, first,
+                                        last, output);
+    queue.wait();
+    return return_type{std::next(first, output->min),
+                       std::next(first, output->max)};
   };
 
   auto fallback = [&]() {
-    return std::copy_if(hipsycl::stdpar::par_host_fallback, first, last,
-                        d_first, pred);
+    return std::minmax_element(hipsycl::stdpar::par_host_fallback, first,
+                               last);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
-      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::copy_if{},
-                                 hipsycl::stdpar::par{}),
-      std::distance(first, last), ForwardIt2, offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, pred);
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::minmax_element{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), return_type, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
 }
 
-template<class ForwardIt1, class Size, class ForwardIt2 >
-HIPSYCL_STDPAR_ENTRYPOINT
-ForwardIt2 copy_n(hipsycl::stdpar::par,
-                   ForwardIt1 first, Size count, ForwardIt2 result ) {
+template <class ForwardIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT std::pair<ForwardIt, ForwardIt>
+minmax_element(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
+               Compare comp) {
+  using return_type = std::pair<ForwardIt, ForwardIt>;
 
-  auto offloader = [&](auto& queue){
-    ForwardIt2 last = result;
-    std::advance(last, std::max(count, Size{0}));
-    hipsycl::algorithms::copy_n(queue, first, count, result);
-    return last;
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return return_type{first, first};
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        hipsycl::algorithms::detail::minmax_index<
+            typename std::iterator_traits<ForwardIt>::difference_type>>(1);
+    hipsycl::algorithms::minmax_element(queue, reduction_scratch_group, first,
+                                        last, output, comp);
+    queue.wait();
+    return return_type{std::next(first, output->min),
+                       std::next(first, output->max)};
   };
 
   auto fallback = [&]() {
-    return std::copy_n(hipsycl::stdpar::par_host_fallback, first, count,
-                       result);
+    return std::minmax_element(hipsycl::stdpar::par_host_fallback, first,
+                               last, comp);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
-      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::copy_n{},
-                                 hipsycl::stdpar::par{}),
-      count, ForwardIt2, offloader, fallback, first, count, result);
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::minmax_element{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), return_type, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
 }
 
-template<class ForwardIt, class T >
+template <class ForwardIt, class T>
 HIPSYCL_STDPAR_ENTRYPOINT
-void fill(hipsycl::stdpar::par,
-          ForwardIt first, ForwardIt last, const T& value) {
-  auto offloader = [&](auto& queue){
-    hipsycl::algorithms::fill(queue, first, last, value);
-  };
+typename std::iterator_traits<ForwardIt>::difference_type
+count(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
+      const T &value) {
+  using difference_type =
+      typename std::iterator_traits<ForwardIt>::difference_type;
 
-  auto fallback = [&]() {
-    std::fill(hipsycl::stdpar::par_host_fallback, first, last, value);
-  };
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return difference_type{0};
 
-  HIPSYCL_STDPAR_OFFLOAD_NORET(
-      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::fill{},
-                                 hipsycl::stdpar::par{}),
-      std::distance(first, last), offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), value);
-}
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
 
-template <class ForwardIt, class Size, class T>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt fill_n(hipsycl::stdpar::par, ForwardIt first,
-                                           Size count, const T &value) {
- 
-  auto offloader = [&](auto& queue){
-    ForwardIt last = first;
-    std::advance(last, std::max(count, Size{0}));
-    hipsycl::algorithms::fill_n(queue, first, count, value);
-    return last;
+    auto *output = output_scratch_group.obtain<difference_type>(1);
+    hipsycl::algorithms::count(queue, reduction_scratch_group, first, last,
+                               output, value);
+    queue.wait();
+    return *output;
   };
 
   auto fallback = [&]() {
-    return std::fill_n(hipsycl::stdpar::par_host_fallback, first, count,
-                       value);
+    return std::count(hipsycl::stdpar::par_host_fallback, first, last,
+                      value);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
-      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::fill_n{},
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::count{},
                                  hipsycl::stdpar::par{}),
-      count, ForwardIt, offloader, fallback, first, count, value);
+      std::distance(first, last), difference_type, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), value);
 }
 
-template <class ForwardIt, class Generator>
-HIPSYCL_STDPAR_ENTRYPOINT void generate(hipsycl::stdpar::par, ForwardIt first,
-                                        ForwardIt last, Generator g) {
+template <class ForwardIt, class UnaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT
+typename std::iterator_traits<ForwardIt>::difference_type
+count_if(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
+         UnaryPredicate p) {
+  using difference_type =
+      typename std::iterator_traits<ForwardIt>::difference_type;
+
   auto offloader = [&](auto &queue) {
-    hipsycl::algorithms::generate(queue, first, last, g);
+    if(first == last)
+      return difference_type{0};
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<difference_type>(1);
+    hipsycl::algorithms::count_if(queue, reduction_scratch_group, first, last,
+                                  output, p);
+    queue.wait();
+    return *output;
   };
 
   auto fallback = [&]() {
-    std::generate(hipsycl::stdpar::par_host_fallback, first, last, g);
+    return std::count_if(hipsycl::stdpar::par_host_fallback, first, last,
+                         p);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD_NORET(
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
       hipsycl::stdpar::algorithm(
-          hipsycl::stdpar::algorithm_category::generate{},
+          hipsycl::stdpar::algorithm_category::count_if{},
           hipsycl::stdpar::par{}),
-      std::distance(first, last), offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), g);
+      std::distance(first, last), difference_type, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
 }
 
-template <class ForwardIt, class Size, class Generator>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt generate_n(hipsycl::stdpar::par,
-                                               ForwardIt first, Size count,
-                                               Generator g) {
-  auto offloader = [&](auto& queue){
-    ForwardIt last = first;
-    std::advance(last, std::max(count, Size{0}));
-    hipsycl::algorithms::generate_n(queue, first, count, g);
-    return last;
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT bool equal(hipsycl::stdpar::par,
+                                     ForwardIt1 first1, ForwardIt1 last1,
+                                     ForwardIt2 first2) {
+  auto offloader = [&](auto &queue) {
+    if(first1 == last1)
+      return true;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+
+    auto *output = output_scratch_group
+                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    hipsycl::algorithms::equal(queue, first1, last1, first2, output);
+    queue.wait();
+    return static_cast<bool>(*output);
   };
 
   auto fallback = [&]() {
-    return std::generate_n(hipsycl::stdpar::par_host_fallback, first,
-                           count, g);
+    return std::equal(hipsycl::stdpar::par_host_fallback, first1, last1,
+                      first2);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(hipsycl::stdpar::algorithm(
-                             hipsycl::stdpar::algorithm_category::generate_n{},
-                             hipsycl::stdpar::par{}),
-                         count, ForwardIt, offloader, fallback, first, count,
-                         g);
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::equal{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first1, last1), bool, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2);
 }
 
-template <class ForwardIt, class T>
-HIPSYCL_STDPAR_ENTRYPOINT
-void replace(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
-             const T &old_value, const T &new_value) {
+template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT bool equal(hipsycl::stdpar::par,
+                                     ForwardIt1 first1, ForwardIt1 last1,
+                                     ForwardIt2 first2, BinaryPredicate p) {
   auto offloader = [&](auto &queue) {
-    hipsycl::algorithms::replace(queue, first, last, old_value, new_value);
+    if(first1 == last1)
+      return true;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+
+    auto *output = output_scratch_group
+                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    hipsycl::algorithms::equal(queue, first1, last1, first2, output, p);
+    queue.wait();
+    return static_cast<bool>(*output);
   };
 
   auto fallback = [&]() {
-    std::replace(hipsycl::stdpar::par_host_fallback, first, last,
-                 old_value, new_value);
+    return std::equal(hipsycl::stdpar::par_host_fallback, first1, last1,
+                      first2, p);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD_NORET(
-      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::replace{},
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::equal{},
                                  hipsycl::stdpar::par{}),
-      std::distance(first, last), offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), old_value, new_value);
+      std::distance(first1, last1), bool, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2, p);
 }
 
-template <class ForwardIt, class UnaryPredicate, class T>
-HIPSYCL_STDPAR_ENTRYPOINT
-void replace_if(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
-                UnaryPredicate p, const T &new_value) {
-  
-  auto offloader = [&](auto& queue){
-    hipsycl::algorithms::replace_if(queue, first, last, p, new_value);
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT bool equal(hipsycl::stdpar::par,
+                                     ForwardIt1 first1, ForwardIt1 last1,
+                                     ForwardIt2 first2, ForwardIt2 last2) {
+  auto offloader = [&](auto &queue) {
+    if(std::distance(first1, last1) != std::distance(first2, last2))
+      return false;
+    if(first1 == last1)
+      return true;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+
+    auto *output = output_scratch_group
+                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    hipsycl::algorithms::equal(queue, first1, last1, first2, output);
+    queue.wait();
+    return static_cast<bool>(*output);
   };
 
   auto fallback = [&]() {
-    std::replace_if(hipsycl::stdpar::par_host_fallback, first, last, p,
-                    new_value);
+    return std::equal(hipsycl::stdpar::par_host_fallback, first1, last1,
+                      first2, last2);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD_NORET(
-      hipsycl::stdpar::algorithm(
-          hipsycl::stdpar::algorithm_category::replace_if{},
-          hipsycl::stdpar::par{}),
-      std::distance(first, last), offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p, new_value);
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::equal{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first1, last1), bool, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2));
 }
 
-template <class ForwardIt1, class ForwardIt2, class T>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2
-replace_copy(hipsycl::stdpar::par, ForwardIt1 first, ForwardIt1 last,
-             ForwardIt2 d_first, const T &old_value, const T &new_value) {
+template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT bool
+equal(hipsycl::stdpar::par, ForwardIt1 first1, ForwardIt1 last1,
+      ForwardIt2 first2, ForwardIt2 last2, BinaryPredicate p) {
+  auto offloader = [&](auto &queue) {
+    if(std::distance(first1, last1) != std::distance(first2, last2))
+      return false;
+    if(first1 == last1)
+      return true;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
 
-  auto offloader = [&](auto &queue) {
-    ForwardIt2 d_last = d_first;
-    std::advance(d_last, std::distance(first, last));
-    hipsycl::algorithms::replace_copy(queue, first, last, d_first, old_value,
-                                      new_value);
-    return d_last;
+    auto *output = output_scratch_group
+                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    hipsycl::algorithms::equal(queue, first1, last1, first2, output, p);
+    queue.wait();
+    return static_cast<bool>(*output);
   };
 
   auto fallback = [&]() {
-    return std::replace_copy(hipsycl::stdpar::par_host_fallback, first,
-                             last, d_first, old_value, new_value);
+    return std::equal(hipsycl::stdpar::par_host_fallback, first1, last1,
+                      first2, last2, p);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
-      hipsycl::stdpar::algorithm(
-          hipsycl::stdpar::algorithm_category::replace_copy{},
-          hipsycl::stdpar::par{}),
-      std::distance(first, last), ForwardIt2, offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, old_value, new_value);
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::equal{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first1, last1), bool, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2), p);
 }
 
-template <class ForwardIt1, class ForwardIt2, class UnaryPredicate, class T>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 replace_copy_if(
-    hipsycl::stdpar::par, ForwardIt1 first,
-    ForwardIt1 last, ForwardIt2 d_first, UnaryPredicate p, const T &new_value) {
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT std::pair<ForwardIt1, ForwardIt2>
+mismatch(hipsycl::stdpar::par, ForwardIt1 first1, ForwardIt1 last1,
+         ForwardIt2 first2) {
+  using return_type = std::pair<ForwardIt1, ForwardIt2>;
 
   auto offloader = [&](auto &queue) {
-    ForwardIt2 d_last = d_first;
-    std::advance(d_last, std::distance(first, last));
-    hipsycl::algorithms::replace_copy_if(queue, first, last, d_first, p,
-                                         new_value);
-    return d_last;
+    if(first1 == last1)
+      return return_type{first1, first2};
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt1>::difference_type>(1);
+    hipsycl::algorithms::mismatch(queue, reduction_scratch_group, first1,
+                                  last1, first2, output);
+    queue.wait();
+    return return_type{std::next(first1, *output), std::next(first2, *output)};
   };
 
   auto fallback = [&]() {
-    return std::replace_copy_if(hipsycl::stdpar::par_host_fallback, first,
-                                last, d_first, p, new_value);
+    return std::mismatch(hipsycl::stdpar::par_host_fallback, first1,
+                         last1, first2);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
       hipsycl::stdpar::algorithm(
-                             hipsycl::stdpar::algorithm_category::replace_copy_if{},
-                             hipsycl::stdpar::par{}),
-      std::distance(first, last), ForwardIt2, offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, p, new_value);
+          hipsycl::stdpar::algorithm_category::mismatch{},
+          hipsycl::stdpar::par{}),
+      std::distance(first1, last1), return_type, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2);
 }
 
-/*
-template <class ForwardIt, class T>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find(const hipsycl::stdpar::par, ForwardIt first,
-                                         ForwardIt last, const T &value);
-
-template <class ForwardIt, class UnaryPredicate>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find_if(const hipsycl::stdpar::par,
-                                            ForwardIt first, ForwardIt last,
-                                            UnaryPredicate p);
-
-template <class ForwardIt, class UnaryPredicate>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find_if_not(const hipsycl::stdpar::par,
-                                                ForwardIt first, ForwardIt last,
-                                                UnaryPredicate q); */
-
+template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT std::pair<ForwardIt1, ForwardIt2>
+mismatch(hipsycl::stdpar::par, ForwardIt1 first1, ForwardIt1 last1,
+         ForwardIt2 first2, BinaryPredicate p) {
+  using return_type = std::pair<ForwardIt1, ForwardIt2>;
 
-template<class ForwardIt, class UnaryPredicate>
-HIPSYCL_STDPAR_ENTRYPOINT
-bool all_of(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
-            UnaryPredicate p ) {
+  auto offloader = [&](auto &queue) {
+    if(first1 == last1)
+      return return_type{first1, first2};
 
-  auto offloader = [&](auto& queue){
-    
-    if(std::distance(first, last) == 0)
-      return true;
-    
     auto output_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
                 hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
 
-    auto *output = output_scratch_group
-                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
-    hipsycl::algorithms::all_of(queue, first, last, output, p);
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt1>::difference_type>(1);
+    hipsycl::algorithms::mismatch(queue, reduction_scratch_group, first1,
+                                  last1, first2, output, p);
     queue.wait();
-    return static_cast<bool>(*output);
+    return return_type{std::next(first1, *output), std::next(first2, *output)};
   };
 
-  auto fallback = [&](){
-    return std::all_of(hipsycl::stdpar::par_host_fallback, first, last, p);
+  auto fallback = [&]() {
+    return std::mismatch(hipsycl::stdpar::par_host_fallback, first1,
+                         last1, first2, p);
   };
 
   HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
-      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::all_of{},
-                                 hipsycl::stdpar::par{}),
-      std::distance(first, last), bool, offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::mismatch{},
+          hipsycl::stdpar::par{}),
+      std::distance(first1, last1), return_type, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2, p);
 }
 
-template<class ForwardIt, class UnaryPredicate>
-HIPSYCL_STDPAR_ENTRYPOINT
-bool any_of(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
-            UnaryPredicate p ) {
-  
-  auto offloader = [&](auto& queue){
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT std::pair<ForwardIt1, ForwardIt2>
+mismatch(hipsycl::stdpar::par, ForwardIt1 first1, ForwardIt1 last1,
+         ForwardIt2 first2, ForwardIt2 last2) {
+  using return_type = std::pair<ForwardIt1, ForwardIt2>;
 
-    if(std::distance(first, last) == 0)
-      return false;
+  auto offloader = [&](auto &queue) {
+    auto problem_size = std::min(std::distance(first1, last1),
+                                 std::distance(first2, last2));
+    if(problem_size == 0)
+      return return_type{first1, first2};
 
     auto output_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
                 hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
 
-    auto *output = output_scratch_group
-                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
-    hipsycl::algorithms::any_of(queue, first, last, output, p);
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt1>::difference_type>(1);
+    hipsycl::algorithms::mismatch(queue, reduction_scratch_group, first1,
+                                  std::next(first1, problem_size), first2,
+                                  output);
     queue.wait();
-    return static_cast<bool>(*output);
+    return return_type{std::next(first1, *output), std::next(first2, *output)};
   };
 
-  auto fallback = [&](){
-    return std::any_of(hipsycl::stdpar::par_host_fallback, first, last, p);
+  auto fallback = [&]() {
+    return std::mismatch(hipsycl::stdpar::par_host_fallback, first1,
+                         last1, first2, last2);
   };
 
   HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
-      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::any_of{},
-                                 hipsycl::stdpar::par{}),
-      std::distance(first, last), bool, offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::mismatch{},
+          hipsycl::stdpar::par{}),
+      std::min(std::distance(first1, last1), std::distance(first2, last2)),
+      return_type, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2));
 }
 
-template<class ForwardIt, class UnaryPredicate>
-HIPSYCL_STDPAR_ENTRYPOINT
-bool none_of(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
-            UnaryPredicate p ) {
-  
-  auto offloader = [&](auto& queue){
+template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT std::pair<ForwardIt1, ForwardIt2>
+mismatch(hipsycl::stdpar::par, ForwardIt1 first1, ForwardIt1 last1,
+         ForwardIt2 first2, ForwardIt2 last2, BinaryPredicate p) {
+  using return_type = std::pair<ForwardIt1, ForwardIt2>;
 
-    if(std::distance(first, last) == 0)
-      return true;
+  auto offloader = [&](auto &queue) {
+    auto problem_size = std::min(std::distance(first1, last1),
+                                 std::distance(first2, last2));
+    if(problem_size == 0)
+      return return_type{first1, first2};
 
     auto output_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
                 hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
 
-    auto *output = output_scratch_group
-                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
-    hipsycl::algorithms::none_of(queue, first, last, output, p);
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt1>::difference_type>(1);
+    hipsycl::algorithms::mismatch(queue, reduction_scratch_group, first1,
+                                  std::next(first1, problem_size), first2,
+                                  output, p);
     queue.wait();
-    return static_cast<bool>(*output);
+    return return_type{std::next(first1, *output), std::next(first2, *output)};
   };
 
-  auto fallback = [&](){
-    return std::none_of(hipsycl::stdpar::par_host_fallback, first, last, p);
+  auto fallback = [&]() {
+    return std::mismatch(hipsycl::stdpar::par_host_fallback, first1,
+                         last1, first2, last2, p);
   };
 
   HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
-      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::none_of{},
-                                 hipsycl::stdpar::par{}),
-      std::distance(first, last), bool, offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::mismatch{},
+          hipsycl::stdpar::par{}),
+      std::min(std::distance(first1, last1), std::distance(first2, last2)),
+      return_type, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2), p);
 }
 
-template <class RandomIt>
-HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par, RandomIt first,
-                                        RandomIt last) {
-  auto offloader = [&](auto& queue) {
-    hipsycl::algorithms::sort(queue, first, last);
+template <class ForwardIt>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt adjacent_find(hipsycl::stdpar::par,
+                                                  ForwardIt first,
+                                                  ForwardIt last) {
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::adjacent_find(queue, reduction_scratch_group, first,
+                                       last, output);
+    queue.wait();
+    return std::next(first, *output);
   };
 
-  auto fallback = [&](){
-    std::sort(hipsycl::stdpar::par_host_fallback, first, last);
+  auto fallback = [&]() {
+    return std::adjacent_find(hipsycl::stdpar::par_host_fallback, first,
+                              last);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD_NORET(
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
       hipsycl::stdpar::algorithm(
-          hipsycl::stdpar::algorithm_category::sort{},
+          hipsycl::stdpar::algorithm_category::adjacent_find{},
           hipsycl::stdpar::par{}),
-      std::distance(first, last), offloader, fallback, first,
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
       HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
 }
 
-template <class RandomIt, class Compare>
-HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par, RandomIt first,
-                                    RandomIt last, Compare comp) {
-  auto offloader = [&](auto& queue) {
-    hipsycl::algorithms::sort(queue, first, last, comp);
+template <class ForwardIt, class BinaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt
+adjacent_find(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
+              BinaryPredicate p) {
+  auto offloader = [&](auto &queue) {
+    if(first == last)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+
+    auto *output = output_scratch_group.obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::adjacent_find(queue, reduction_scratch_group, first,
+                                       last, output, p);
+    queue.wait();
+    return std::next(first, *output);
   };
 
   auto fallback = [&]() {
-    std::sort(hipsycl::stdpar::par_host_fallback, first, last, comp);
+    return std::adjacent_find(hipsycl::stdpar::par_host_fallback, first,
+                              last, p);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD_NORET(
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
       hipsycl::stdpar::algorithm(
-          hipsycl::stdpar::algorithm_category::sort{},
+          hipsycl::stdpar::algorithm_category::adjacent_find{},
           hipsycl::stdpar::par{}),
-      std::distance(first, last), offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
 }
 
-
-
-template<class ForwardIt1, class ForwardIt2,
-         class ForwardIt3, class Compare>
-HIPSYCL_STDPAR_ENTRYPOINT
-ForwardIt3 merge(hipsycl::stdpar::par,
-                  ForwardIt1 first1, ForwardIt1 last1,
-                  ForwardIt2 first2, ForwardIt2 last2,
-                  ForwardIt3 d_first, Compare comp) {
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT bool
+lexicographical_compare(hipsycl::stdpar::par, ForwardIt1 first1,
+                        ForwardIt1 last1, ForwardIt2 first2, ForwardIt2 last2) {
   auto offloader = [&](auto &queue) {
-    auto scratch_group =
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
                 hipsycl::algorithms::util::allocation_type::device>();
 
-    hipsycl::algorithms::merge(queue, scratch_group, first1, last1, first2,
-                               last2, d_first, comp);
-    auto d_last = d_first;
-    std::advance(d_last,
-                 std::distance(first1, last1) + std::distance(first2, last2));
-    return d_last;
+    auto *output = output_scratch_group
+                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    hipsycl::algorithms::lexicographical_compare(
+        queue, reduction_scratch_group, first1, last1, first2, last2, output);
+    queue.wait();
+    return static_cast<bool>(*output);
   };
 
   auto fallback = [&]() {
-    return std::merge(hipsycl::stdpar::par_unseq_host_fallback, first1, last1,
-                      first2, last2, d_first, comp);
+    return std::lexicographical_compare(
+        hipsycl::stdpar::par_host_fallback, first1, last1, first2, last2);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
-      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::merge{},
-                                 hipsycl::stdpar::par_unseq{}),
-      std::distance(first1, last1) + std::distance(first2, last2), ForwardIt3,
-      offloader, fallback, first1, HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1),
-      first2, HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2), d_first, comp);
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::lexicographical_compare{},
+          hipsycl::stdpar::par{}),
+      std::min(std::distance(first1, last1), std::distance(first2, last2)),
+      bool, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2));
 }
 
-template<class ForwardIt1, class ForwardIt2,
-         class ForwardIt3, class Compare>
-HIPSYCL_STDPAR_ENTRYPOINT
-ForwardIt3 merge(hipsycl::stdpar::par,
-                  ForwardIt1 first1, ForwardIt1 last1,
-                  ForwardIt2 first2, ForwardIt2 last2,
-                  ForwardIt3 d_first) {
+template <class ForwardIt1, class ForwardIt2, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT bool
+lexicographical_compare(hipsycl::stdpar::par, ForwardIt1 first1,
+                        ForwardIt1 last1, ForwardIt2 first2, ForwardIt2 last2,
+                        Compare comp) {
   auto offloader = [&](auto &queue) {
-    auto scratch_group =
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>();
+    auto reduction_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
                 hipsycl::algorithms::util::allocation_type::device>();
 
-    hipsycl::algorithms::merge(queue, scratch_group, first1, last1, first2,
-                               last2, d_first);
-    auto d_last = d_first;
-    std::advance(d_last,
-                 std::distance(first1, last1) + std::distance(first2, last2));
-    return d_last;
+    auto *output = output_scratch_group
+                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    hipsycl::algorithms::lexicographical_compare(queue, reduction_scratch_group,
+                                                 first1, last1, first2, last2,
+                                                 output, comp);
+    queue.wait();
+    return static_cast<bool>(*output);
   };
 
   auto fallback = [&]() {
-    return std::merge(hipsycl::stdpar::par_host_fallback, first1, last1,
-                      first2, last2, d_first);
+    return std::lexicographical_compare(
+        hipsycl::stdpar::par_host_fallback, first1, last1, first2, last2,
+        comp);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
-      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::merge{},
-                                 hipsycl::stdpar::par{}),
-      std::distance(first1, last1) + std::distance(first2, last2), ForwardIt3,
-      offloader, fallback, first1, HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1),
-      first2, HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2), d_first);
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::lexicographical_compare{},
+          hipsycl::stdpar::par{}),
+      std::min(std::distance(first1, last1), std::distance(first2, last2)),
+      bool, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last2), comp);
 }
 
 }
@@ -18,6 +18,7 @@
 #include "../detail/sycl_glue.hpp"
 #include "../detail/stdpar_builtins.hpp"
 #include "../detail/offload.hpp"
+#include "../detail/multi_device_dispatch.hpp"
 #include "hipSYCL/algorithms/util/allocation_cache.hpp"
 #include "hipSYCL/algorithms/numeric.hpp"
 #include <iterator>
@@ -33,33 +34,19 @@ T transform_reduce(hipsycl::stdpar::par_unseq,
                     T init) {
   
   auto offloader = [&](auto& queue) {
-    // Note: Using a scratch allocation_group that expires at the end of the scope
-    // is safe because
-    // a) We synchronize before the end, so the allocation_group also lives until
-    // the kernels are complete;
-    // b) We have one allocation cache per thread-local in-order queue. So, subsequent operations
-    // fed from the same cache would wait for us anyway due to using the same in-order queue.
-    // These conditions ensure that no other operations can get access to the 
-    // cached scratch memory while we are using it.
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-    
-    T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first1,
-                                            last1, first2, output, init);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-    
     if(first1 == last1)
       return init;
-    else
-      return *output;
+    return hipsycl::stdpar::detail::multi_device_dispatch::reduce_partitions(
+        queue, std::distance(first1, last1), init, std::plus<T>{},
+        [&](auto &partition_queue, auto &reduction_scratch_group,
+            std::size_t begin, std::size_t end, T *output,
+            const T &partition_init) {
+          hipsycl::algorithms::transform_reduce(
+              partition_queue, reduction_scratch_group, std::next(first1, begin),
+              std::next(first1, end), std::next(first2, begin), output,
+              partition_init);
+        },
+        first1, first2);
   };
 
   auto fallback = [&]() {
@@ -85,27 +72,20 @@ T transform_reduce(hipsycl::stdpar::par_unseq,
                     T init,
                     BinaryReductionOp reduce,
                     BinaryTransformOp transform ) {
-  auto offloader = [&](auto& queue){
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-    
-    T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first1,
-                                          last1, first2, output, init, reduce,
-                                          transform);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-    
+  auto offloader = [&](auto& queue) {
     if(first1 == last1)
       return init;
-    else
-      return *output;
+    return hipsycl::stdpar::detail::multi_device_dispatch::reduce_partitions(
+        queue, std::distance(first1, last1), init, reduce,
+        [&](auto &partition_queue, auto &reduction_scratch_group,
+            std::size_t begin, std::size_t end, T *output,
+            const T &partition_init) {
+          hipsycl::algorithms::transform_reduce(
+              partition_queue, reduction_scratch_group, std::next(first1, begin),
+              std::next(first1, end), std::next(first2, begin), output,
+              partition_init, reduce, transform);
+        },
+        first1, first2);
   };
 
   auto fallback = [&]() {
@@ -133,25 +113,19 @@ T transform_reduce(hipsycl::stdpar::par_unseq,
                     UnaryTransformOp transform ) {
 
   auto offloader = [&](auto& queue) {
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-    
-    T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first, last,
-                                          output, init, reduce, transform);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-    
     if(first == last)
       return init;
-    else
-      return *output;
+    return hipsycl::stdpar::detail::multi_device_dispatch::reduce_partitions(
+        queue, std::distance(first, last), init, reduce,
+        [&](auto &partition_queue, auto &reduction_scratch_group,
+            std::size_t begin, std::size_t end, T *output,
+            const T &partition_init) {
+          hipsycl::algorithms::transform_reduce(
+              partition_queue, reduction_scratch_group, std::next(first, begin),
+              std::next(first, end), output, partition_init, reduce,
+              transform);
+        },
+        first);
   };
 
   auto fallback = [&]() {
@@ -175,27 +149,21 @@ reduce(hipsycl::stdpar::par_unseq, ForwardIt first,
 
   using result_type = typename std::iterator_traits<ForwardIt>::value_type;
 
-  auto offloader = [&](auto &queue) {
-
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-
-    result_type *output = output_scratch_group.obtain<result_type>(1);
-    hipsycl::algorithms::reduce(queue, reduction_scratch_group, first, last,
-                                output);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-
-    if (first == last)
+  auto offloader = [&](auto& queue) {
+    if(first == last)
       return result_type{};
-    else
-      return *output;
+    return hipsycl::stdpar::detail::multi_device_dispatch::reduce_partitions(
+        queue, std::distance(first, last), result_type{},
+        std::plus<result_type>{},
+        [&](auto &partition_queue, auto &reduction_scratch_group,
+            std::size_t begin, std::size_t end, result_type *output,
+            const result_type &partition_init) {
+          hipsycl::algorithms::reduce(partition_queue, reduction_scratch_group,
+                                      std::next(first, begin),
+                                      std::next(first, end), output,
+                                      partition_init);
+        },
+        first);
   };
 
   auto fallback = [&](){
@@ -214,28 +182,20 @@ HIPSYCL_STDPAR_ENTRYPOINT
 T reduce(hipsycl::stdpar::par_unseq, ForwardIt first,
          ForwardIt last, T init) {
 
-  auto offloader = [&](auto& queue){
-      
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-    
-    T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::reduce(queue, reduction_scratch_group, first, last,
-                                output, init);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-    
+  auto offloader = [&](auto& queue) {
     if(first == last)
       return init;
-    else
-      return *output;
-
+    return hipsycl::stdpar::detail::multi_device_dispatch::reduce_partitions(
+        queue, std::distance(first, last), init, std::plus<T>{},
+        [&](auto &partition_queue, auto &reduction_scratch_group,
+            std::size_t begin, std::size_t end, T *output,
+            const T &partition_init) {
+          hipsycl::algorithms::reduce(partition_queue, reduction_scratch_group,
+                                      std::next(first, begin),
+                                      std::next(first, end), output,
+                                      partition_init);
+        },
+        first);
   };
 
   auto fallback = [&]() {
@@ -255,27 +215,20 @@ HIPSYCL_STDPAR_ENTRYPOINT
 T reduce(hipsycl::stdpar::par_unseq, ForwardIt first,
          ForwardIt last, T init, BinaryOp binary_op) {
 
-  auto offloader = [&](auto& queue){
-      
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-    
-    T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::reduce(queue, reduction_scratch_group, first, last, output,
-                                init, binary_op);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-    
+  auto offloader = [&](auto& queue) {
     if(first == last)
       return init;
-    else
-      return *output;
+    return hipsycl::stdpar::detail::multi_device_dispatch::reduce_partitions(
+        queue, std::distance(first, last), init, binary_op,
+        [&](auto &partition_queue, auto &reduction_scratch_group,
+            std::size_t begin, std::size_t end, T *output,
+            const T &partition_init) {
+          hipsycl::algorithms::reduce(partition_queue, reduction_scratch_group,
+                                      std::next(first, begin),
+                                      std::next(first, end), output,
+                                      partition_init, binary_op);
+        },
+        first);
   };
 
   auto fallback = [&]() {
@@ -302,33 +255,19 @@ T transform_reduce(hipsycl::stdpar::par,
                     T init) {
   
   auto offloader = [&](auto& queue) {
-    // Note: Using a scratch allocation_group that expires at the end of the scope
-    // is safe because
-    // a) We synchronize before the end, so the allocation_group also lives until
-    // the kernels are complete;
-    // b) We have one allocation cache per thread-local in-order queue. So, subsequent operations
-    // fed from the same cache would wait for us anyway due to using the same in-order queue.
-    // These conditions ensure that no other operations can get access to the 
-    // cached scratch memory while we are using it.
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-    
-    T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first1,
-                                            last1, first2, output, init);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-    
     if(first1 == last1)
       return init;
-    else
-      return *output;
+    return hipsycl::stdpar::detail::multi_device_dispatch::reduce_partitions(
+        queue, std::distance(first1, last1), init, std::plus<T>{},
+        [&](auto &partition_queue, auto &reduction_scratch_group,
+            std::size_t begin, std::size_t end, T *output,
+            const T &partition_init) {
+          hipsycl::algorithms::transform_reduce(
+              partition_queue, reduction_scratch_group, std::next(first1, begin),
+              std::next(first1, end), std::next(first2, begin), output,
+              partition_init);
+        },
+        first1, first2);
   };
 
   auto fallback = [&]() {
@@ -354,27 +293,20 @@ T transform_reduce(hipsycl::stdpar::par,
                     T init,
                     BinaryReductionOp reduce,
                     BinaryTransformOp transform ) {
-  auto offloader = [&](auto& queue){
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-    
-    T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first1,
-                                          last1, first2, output, init, reduce,
-                                          transform);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-    
+  auto offloader = [&](auto& queue) {
     if(first1 == last1)
       return init;
-    else
-      return *output;
+    return hipsycl::stdpar::detail::multi_device_dispatch::reduce_partitions(
+        queue, std::distance(first1, last1), init, reduce,
+        [&](auto &partition_queue, auto &reduction_scratch_group,
+            std::size_t begin, std::size_t end, T *output,
+            const T &partition_init) {
+          hipsycl::algorithms::transform_reduce(
+              partition_queue, reduction_scratch_group, std::next(first1, begin),
+              std::next(first1, end), std::next(first2, begin), output,
+              partition_init, reduce, transform);
+        },
+        first1, first2);
   };
 
   auto fallback = [&]() {
@@ -402,25 +334,19 @@ T transform_reduce(hipsycl::stdpar::par,
                     UnaryTransformOp transform ) {
 
   auto offloader = [&](auto& queue) {
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-    
-    T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first, last,
-                                          output, init, reduce, transform);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-    
     if(first == last)
       return init;
-    else
-      return *output;
+    return hipsycl::stdpar::detail::multi_device_dispatch::reduce_partitions(
+        queue, std::distance(first, last), init, reduce,
+        [&](auto &partition_queue, auto &reduction_scratch_group,
+            std::size_t begin, std::size_t end, T *output,
+            const T &partition_init) {
+          hipsycl::algorithms::transform_reduce(
+              partition_queue, reduction_scratch_group, std::next(first, begin),
+              std::next(first, end), output, partition_init, reduce,
+              transform);
+        },
+        first);
   };
 
   auto fallback = [&]() {
@@ -444,27 +370,21 @@ reduce(hipsycl::stdpar::par, ForwardIt first,
 
   using result_type = typename std::iterator_traits<ForwardIt>::value_type;
 
-  auto offloader = [&](auto &queue) {
-
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-
-    result_type *output = output_scratch_group.obtain<result_type>(1);
-    hipsycl::algorithms::reduce(queue, reduction_scratch_group, first, last,
-                                output);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-
-    if (first == last)
+  auto offloader = [&](auto& queue) {
+    if(first == last)
       return result_type{};
-    else
-      return *output;
+    return hipsycl::stdpar::detail::multi_device_dispatch::reduce_partitions(
+        queue, std::distance(first, last), result_type{},
+        std::plus<result_type>{},
+        [&](auto &partition_queue, auto &reduction_scratch_group,
+            std::size_t begin, std::size_t end, result_type *output,
+            const result_type &partition_init) {
+          hipsycl::algorithms::reduce(partition_queue, reduction_scratch_group,
+                                      std::next(first, begin),
+                                      std::next(first, end), output,
+                                      partition_init);
+        },
+        first);
   };
 
   auto fallback = [&](){
@@ -483,28 +403,20 @@ HIPSYCL_STDPAR_ENTRYPOINT
 T reduce(hipsycl::stdpar::par, ForwardIt first,
          ForwardIt last, T init) {
 
-  auto offloader = [&](auto& queue){
-      
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-    
-    T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::reduce(queue, reduction_scratch_group, first, last,
-                                output, init);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-    
+  auto offloader = [&](auto& queue) {
     if(first == last)
       return init;
-    else
-      return *output;
-
+    return hipsycl::stdpar::detail::multi_device_dispatch::reduce_partitions(
+        queue, std::distance(first, last), init, std::plus<T>{},
+        [&](auto &partition_queue, auto &reduction_scratch_group,
+            std::size_t begin, std::size_t end, T *output,
+            const T &partition_init) {
+          hipsycl::algorithms::reduce(partition_queue, reduction_scratch_group,
+                                      std::next(first, begin),
+                                      std::next(first, end), output,
+                                      partition_init);
+        },
+        first);
   };
 
   auto fallback = [&]() {
@@ -524,27 +436,20 @@ HIPSYCL_STDPAR_ENTRYPOINT
 T reduce(hipsycl::stdpar::par, ForwardIt first,
          ForwardIt last, T init, BinaryOp binary_op) {
 
-  auto offloader = [&](auto& queue){
-      
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-    
-    T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::reduce(queue, reduction_scratch_group, first, last, output,
-                                init, binary_op);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-    
+  auto offloader = [&](auto& queue) {
     if(first == last)
       return init;
-    else
-      return *output;
+    return hipsycl::stdpar::detail::multi_device_dispatch::reduce_partitions(
+        queue, std::distance(first, last), init, binary_op,
+        [&](auto &partition_queue, auto &reduction_scratch_group,
+            std::size_t begin, std::size_t end, T *output,
+            const T &partition_init) {
+          hipsycl::algorithms::reduce(partition_queue, reduction_scratch_group,
+                                      std::next(first, begin),
+                                      std::next(first, end), output,
+                                      partition_init, binary_op);
+        },
+        first);
   };
 
   auto fallback = [&]() {
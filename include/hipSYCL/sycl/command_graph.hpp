@@ -0,0 +1,112 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SYCL_COMMAND_GRAPH_HPP
+#define HIPSYCL_SYCL_COMMAND_GRAPH_HPP
+
+#include <memory>
+#include <typeinfo>
+
+#include "hipSYCL/glue/error.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/command_graph.hpp"
+#include "event.hpp"
+#include "exception.hpp"
+
+namespace hipsycl {
+namespace sycl {
+
+class queue;
+
+class AdaptiveCpp_executable_command_graph {
+public:
+  std::size_t get_num_nodes() const {
+    return _graph->get_num_nodes();
+  }
+
+  /// Replaces the kernel function object of a recorded kernel for all
+  /// subsequent executions of the graph. recorded_kernel is the event that
+  /// was returned when the kernel was submitted during recording, and
+  /// kernel must be of the same type as the recorded kernel function.
+  /// Only kernels that are launched through the generic SSCP compiler
+  /// support this.
+  template <class KernelFunctor>
+  void set_kernel_args(const event &recorded_kernel,
+                       const KernelFunctor &kernel) {
+    auto err = _graph->set_kernel_args(detail::extract_rt_node(recorded_kernel),
+                                       typeid(KernelFunctor).name(), &kernel,
+                                       sizeof(KernelFunctor));
+    if(!err.is_success())
+      std::rethrow_exception(glue::throw_result(err));
+  }
+
+  friend bool operator==(const AdaptiveCpp_executable_command_graph &a,
+                         const AdaptiveCpp_executable_command_graph &b) {
+    return a._graph == b._graph;
+  }
+
+  friend bool operator!=(const AdaptiveCpp_executable_command_graph &a,
+                         const AdaptiveCpp_executable_command_graph &b) {
+    return !(a == b);
+  }
+private:
+  friend class AdaptiveCpp_command_graph;
+  friend class queue;
+
+  AdaptiveCpp_executable_command_graph(
+      std::shared_ptr<rt::executable_command_graph> graph)
+      : _graph{graph} {}
+
+  rt::runtime_keep_alive_token _requires_runtime;
+  std::shared_ptr<rt::executable_command_graph> _graph;
+};
+
+/// Records the operations submitted to a queue between
+/// queue::AdaptiveCpp_begin_recording() and queue::AdaptiveCpp_end_recording().
+/// Recorded operations are not executed; instead, finalize() turns them into
+/// an executable graph that can be executed repeatedly using
+/// queue::AdaptiveCpp_execute_graph().
+class AdaptiveCpp_command_graph {
+public:
+  AdaptiveCpp_command_graph()
+  : _graph{std::make_shared<rt::command_graph>(_requires_runtime.get())} {}
+
+  std::size_t get_num_nodes() const {
+    return _graph->get_num_nodes();
+  }
+
+  AdaptiveCpp_executable_command_graph finalize() const {
+    std::shared_ptr<rt::executable_command_graph> executable;
+    auto err = _graph->instantiate(executable);
+    if(!err.is_success())
+      std::rethrow_exception(glue::throw_result(err));
+    return AdaptiveCpp_executable_command_graph{executable};
+  }
+
+  friend bool operator==(const AdaptiveCpp_command_graph &a,
+                         const AdaptiveCpp_command_graph &b) {
+    return a._graph == b._graph;
+  }
+
+  friend bool operator!=(const AdaptiveCpp_command_graph &a,
+                         const AdaptiveCpp_command_graph &b) {
+    return !(a == b);
+  }
+private:
+  friend class queue;
+
+  rt::runtime_keep_alive_token _requires_runtime;
+  std::shared_ptr<rt::command_graph> _graph;
+};
+
+}
+}
+
+#endif
@@ -27,8 +27,17 @@
 namespace hipsycl {
 namespace sycl {
 
+class event;
+
+namespace detail {
+
+rt::dag_node_ptr extract_rt_node(const event&);
+
+}
+
 class event {
   friend class handler;
+  friend rt::dag_node_ptr detail::extract_rt_node(const event&);
 public:
   event()
   {}
@@ -238,6 +247,13 @@ HIPSYCL_SPECIALIZE_GET_INFO(event, reference_count)
   return _node.use_count();
 }
 
+namespace detail {
+
+inline rt::dag_node_ptr extract_rt_node(const event &e) {
+  return e._node;
+}
+
+}
 
 } // namespace sycl
 } // namespace hipsycl
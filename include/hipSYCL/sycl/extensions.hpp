@@ -74,5 +74,7 @@
 #define ACPP_EXT_QUEUE_PRIORITY
 #define ACPP_EXT_SPECIALIZED
 #define ACPP_EXT_DYNAMIC_FUNCTIONS
+#define ACPP_EXT_USM_MEMORY_POOL
+#define ACPP_EXT_COMMAND_GRAPH
 
 #endif
@@ -42,12 +42,14 @@
 #include "hipSYCL/runtime/kernel_launcher.hpp"
 #include "hipSYCL/runtime/operations.hpp"
 #include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/command_graph.hpp"
 #include "hipSYCL/runtime/dag_manager.hpp"
 #include "hipSYCL/runtime/dag_node.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/executor.hpp"
 #include "hipSYCL/runtime/util.hpp"
 #include "hipSYCL/glue/embedded_pointer.hpp"
+#include "hipSYCL/glue/error.hpp"
 #include "hipSYCL/glue/kernel_launcher_factory.hpp"
 #include "hipSYCL/glue/kernel_names.hpp"
 #include "hipSYCL/glue/generic/code_object.hpp"
@@ -905,6 +907,10 @@ private:
     static_assert(sizeof...(reductions) > 0,
                   "Overload resolution should never pick this overload without "
                   "reductions");
+    if(_recording_graph)
+      throw exception{make_error_code(errc::feature_not_supported),
+                      "Kernels with reductions cannot be recorded into "
+                      "command graphs"};
 
     if constexpr(KernelType == rt::kernel_type::ndrange_parallel_for) {
       _command_group_nodes.push_back(
@@ -1127,12 +1133,14 @@ private:
   handler(const context &ctx, async_handler handler,
           const rt::execution_hints &hints, rt::runtime* rt,
           algorithms::util::allocation_cache* cache,
-          std::weak_ptr<rt::dag_node>* most_recent_reduction_kernel)
+          std::weak_ptr<rt::dag_node>* most_recent_reduction_kernel,
+          rt::command_graph* recording_graph = nullptr)
       : _ctx{ctx}, _handler{handler}, _execution_hints{hints},
         _preferred_group_size1d{}, _preferred_group_size2d{},
         _preferred_group_size3d{}, _rt{rt}, _requirements{rt},
         _allocation_cache{cache},
-        _most_recent_reduction_kernel{most_recent_reduction_kernel}{}
+        _most_recent_reduction_kernel{most_recent_reduction_kernel},
+        _recording_graph{recording_graph} {}
 
   template<int Dim>
   range<Dim>& get_preferred_group_size() {
@@ -1178,6 +1186,20 @@ private:
           !req->is_known_complete())
         has_non_instant_dependency = true;
     }
+
+    if(_recording_graph) {
+      if(uses_buffers || op->is_requirement())
+        throw exception{make_error_code(errc::feature_not_supported),
+                        "Operations using buffers cannot be recorded into "
+                        "command graphs"};
+
+      rt::dag_node_ptr node;
+      auto err =
+          _recording_graph->record(std::move(op), requirements.get(), hints, node);
+      if(!err.is_success())
+        std::rethrow_exception(glue::throw_result(err));
+      return node;
+    }
     
     bool is_dedicated_in_order_queue = false;
     rt::backend_executor* executor = nullptr;
@@ -1242,6 +1264,7 @@ private:
   algorithms::util::allocation_cache* _allocation_cache;
 
   std::weak_ptr<rt::dag_node>* _most_recent_reduction_kernel;
+  rt::command_graph* _recording_graph;
 };
 
 namespace detail::handler {
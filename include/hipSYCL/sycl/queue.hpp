@@ -32,6 +32,7 @@
 #include "context.hpp"
 #include "event.hpp"
 #include "handler.hpp"
+#include "command_graph.hpp"
 #include "info/info.hpp"
 #include "detail/function_set.hpp"
 
@@ -155,6 +156,12 @@ class queue : public detail::property_carrying_object
     std::shared_ptr<rt::kernel_cache> kernel_cache;
     // For non-emulated in-order queues only
     std::atomic<bool> has_non_instant_operations = false;
+
+    // Set while submissions are recorded into a command graph instead
+    // of being executed.
+    std::shared_ptr<rt::command_graph> recording_graph;
+    // Replaces previous_submission for in-order emulation while recording
+    rt::dag_node_ptr previous_recorded_submission = nullptr;
   };
 
   template<typename, int, access::mode, access::target>
@@ -436,7 +443,8 @@ public:
                 hints,
                 _impl->requires_runtime.get(),
                 &(_impl->allocation_cache),
-                &(_impl->most_recent_reduction_kernel)};
+                &(_impl->most_recent_reduction_kernel),
+                _impl->recording_graph.get()};
 
     apply_preferred_group_size<1>(prop_list, cgh);
     apply_preferred_group_size<2>(prop_list, cgh);
@@ -1005,6 +1013,62 @@ public:
     return _impl->node_group_id;
   }
 
+  /// Subsequent submissions to this queue are recorded into graph
+  /// instead of being executed, until AdaptiveCpp_end_recording() is called.
+  void AdaptiveCpp_begin_recording(const AdaptiveCpp_command_graph &graph) {
+    std::lock_guard<std::mutex> lock{_impl->lock};
+    if(_impl->recording_graph)
+      throw exception{make_error_code(errc::invalid),
+                      "queue: Queue is already recording a command graph"};
+    _impl->recording_graph = graph._graph;
+    _impl->previous_recorded_submission = nullptr;
+  }
+
+  void AdaptiveCpp_end_recording() {
+    std::lock_guard<std::mutex> lock{_impl->lock};
+    if(!_impl->recording_graph)
+      throw exception{make_error_code(errc::invalid),
+                      "queue: Queue is not recording a command graph"};
+    _impl->recording_graph = nullptr;
+    _impl->previous_recorded_submission = nullptr;
+  }
+
+  bool AdaptiveCpp_is_recording() const {
+    std::lock_guard<std::mutex> lock{_impl->lock};
+    return _impl->recording_graph != nullptr;
+  }
+
+  /// Executes all operations of graph. The operations are ordered after
+  /// all operations that were previously submitted to this queue, following
+  /// the same rules as for operations submitted with get_wait_list() as
+  /// dependencies.
+  event
+  AdaptiveCpp_execute_graph(const AdaptiveCpp_executable_command_graph &graph) {
+    if(AdaptiveCpp_is_recording())
+      throw exception{make_error_code(errc::invalid),
+                      "queue: Command graphs cannot be executed while "
+                      "recording"};
+
+    rt::node_list_t external_dependencies;
+    for(const auto& evt : get_wait_list())
+      external_dependencies.push_back(detail::extract_rt_node(evt));
+
+    std::lock_guard<std::mutex> lock{_impl->lock};
+    rt::dag_node_ptr sink;
+    auto err = graph._graph->execute(_impl->default_hints,
+                                     external_dependencies, sink);
+    if(!err.is_success())
+      std::rethrow_exception(glue::throw_result(err));
+
+    if(!sink)
+      return event{};
+
+    if(is_in_order() && _impl->needs_in_order_emulation)
+      _impl->previous_submission = sink;
+
+    return event{sink, _impl->handler};
+  }
+
   rt::inorder_executor* AdaptiveCpp_inorder_executor() const {
     if(!_impl->dedicated_inorder_executor)
       return nullptr;
@@ -1037,8 +1101,12 @@ private:
 
   template <class Cgf>
   rt::dag_node_ptr execute_submission(Cgf cgf, handler &cgh) {
+    rt::dag_node_ptr &previous_submission =
+        _impl->recording_graph ? _impl->previous_recorded_submission
+                               : _impl->previous_submission;
+
     if (is_in_order() && _impl->needs_in_order_emulation) {
-      auto previous = _impl->previous_submission;
+      auto previous = previous_submission;
       if(previous)
         cgh.depends_on(event{previous, _impl->handler});
     }
@@ -1048,7 +1116,7 @@ private:
     rt::dag_node_ptr node = this->extract_dag_node(cgh);
     if (is_in_order()) {
       if(_impl->needs_in_order_emulation) {
-        _impl->previous_submission = node;
+        previous_submission = node;
       } else if(cgh.contains_non_instant_nodes()) {
         _impl->has_non_instant_operations.store(true, std::memory_order_relaxed);
         // If we have instant submission enabled, non-emulated in-order queue
@@ -26,6 +26,8 @@
 #include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/backend.hpp"
 #include "hipSYCL/runtime/allocator.hpp"
+#include "hipSYCL/runtime/runtime.hpp"
+#include "hipSYCL/runtime/usm_memory_pool.hpp"
 
 namespace hipsycl {
 namespace sycl {
@@ -249,6 +251,96 @@ inline void mem_advise(const void *ptr, std::size_t num_bytes, int advise,
   mem_advise(ptr, num_bytes, advise, q.get_context(), q.get_device());
 }
 
+// AdaptiveCpp stream-ordered memory pool extension
+
+namespace detail {
+
+inline rt::usm_memory_pool *get_usm_memory_pool(const device &dev) {
+  return dev.AdaptiveCpp_runtime()->usm_pools().get_pool(
+      detail::extract_rt_device(dev));
+}
+
+inline rt::usm_pool_stream_id get_usm_pool_stream(const queue &q) {
+  // Only in-order queues guarantee that later operations are ordered
+  // after earlier ones, which is required to reuse freed blocks
+  // without waiting for their last users.
+  if(q.is_in_order())
+    return q.AdaptiveCpp_hash_code();
+  return 0;
+}
+
+}
+
+class AdaptiveCpp_memory_pool {
+public:
+  explicit AdaptiveCpp_memory_pool(const device &dev)
+      : _dev{dev}, _pool{detail::get_usm_memory_pool(dev)} {}
+
+  explicit AdaptiveCpp_memory_pool(const queue &q)
+      : AdaptiveCpp_memory_pool{q.get_device()} {}
+
+  void trim(std::size_t min_bytes_to_keep = 0) {
+    _pool->trim(min_bytes_to_keep);
+  }
+
+  void set_release_threshold(std::size_t num_bytes) {
+    _pool->set_release_threshold(num_bytes);
+  }
+
+  std::size_t get_release_threshold() const {
+    return _pool->get_release_threshold();
+  }
+
+  std::size_t get_reserved_size() const {
+    return _pool->get_reserved_size();
+  }
+
+  std::size_t get_used_size() const {
+    return _pool->get_used_size();
+  }
+
+  device get_device() const {
+    return _dev;
+  }
+private:
+  device _dev;
+  rt::usm_memory_pool *_pool;
+};
+
+inline void *aligned_alloc_async(std::size_t alignment, std::size_t num_bytes,
+                                 const queue &q) {
+  return detail::get_usm_memory_pool(q.get_device())
+      ->allocate(alignment, num_bytes, detail::get_usm_pool_stream(q));
+}
+
+template <typename T>
+T *aligned_alloc_async(std::size_t alignment, std::size_t count,
+                       const queue &q) {
+  return static_cast<T *>(
+      aligned_alloc_async(alignment, count * sizeof(T), q));
+}
+
+inline void *malloc_async(std::size_t num_bytes, const queue &q) {
+  return aligned_alloc_async(0, num_bytes, q);
+}
+
+template <typename T>
+T *malloc_async(std::size_t count, const queue &q) {
+  return static_cast<T *>(malloc_async(count * sizeof(T), q));
+}
+
+inline void free_async(void *ptr, const queue &q) {
+  rt::node_list_t release_dependencies;
+  for(const event& e : queue{q}.get_wait_list())
+    release_dependencies.push_back(detail::extract_rt_node(e));
+
+  rt::result r = detail::get_usm_memory_pool(q.get_device())
+                     ->free(ptr, detail::get_usm_pool_stream(q),
+                            release_dependencies);
+  if(!r.is_success())
+    std::rethrow_exception(glue::throw_result(r));
+}
+
 // USM allocator
 template <typename T, usm::alloc AllocKind, std::size_t Alignment = 0>
 class usm_allocator {
@@ -12,6 +12,7 @@
 #include "hipSYCL/common/appdb.hpp"
 #include "hipSYCL/common/filesystem.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
+#include <algorithm>
 #include <fstream>
 #include <type_traits>
 
@@ -31,7 +32,7 @@ template <class ArrayT>
 void print_array(std::ostream &ostr, const std::string &name, const ArrayT &a,
                  const std::string &element_type_name, int indentation_level) {
   print_key_value_pair(ostr, name, "<array>", indentation_level);
-  for(int i = 0; i < a.size(); ++i) {
+  for(std::size_t i = 0; i < a.size(); ++i) {
     if constexpr(std::is_fundamental_v<typename ArrayT::value_type>)
       print_key_value_pair(ostr, std::to_string(i), a[i], indentation_level+1);
     else {
@@ -54,6 +55,20 @@ void kernel_arg_entry::dump(std::ostream& ostr, int indentation_level) const {
   print_array(ostr, "was_specialized", was_specialized, "bool", indentation_level);
 }
 
+void host_launch_candidate_statistics::dump(std::ostream &ostr,
+                                            int indentation_level) const {
+  print_key_value_pair(ostr, "num_samples", num_samples, indentation_level);
+  print_key_value_pair(ostr, "total_time_ns", total_time_ns, indentation_level);
+}
+
+void host_launch_tuning_entry::dump(std::ostream &ostr,
+                                    int indentation_level) const {
+  print_array(ostr, "candidates", candidates, "candidate_statistics",
+              indentation_level);
+  print_key_value_pair(ostr, "selected_candidate", selected_candidate,
+                       indentation_level);
+}
+
 void kernel_entry::dump(std::ostream& ostr, int indentation_level) const {
   print_key_value_pair(ostr, "num_registered_invocations",
                        num_registered_invocations, indentation_level);
@@ -62,6 +77,61 @@ void kernel_entry::dump(std::ostream& ostr, int indentation_level) const {
   print_array(ostr, "kernel_args", kernel_args, "arg_entry", indentation_level);
   print_key_value_pair(ostr, "first_invocation_run",
                        first_iads_invocation_run, indentation_level);
+  print_key_value_pair(ostr, "host_launch_tuning", "<map>", indentation_level);
+  for(const auto& entry : host_launch_tuning) {
+    print_key_value_pair(ostr, std::to_string(entry.first),
+                         "<host-launch-tuning-entry>", indentation_level + 1);
+    entry.second.dump(ostr, indentation_level + 2);
+  }
+  print_array(ostr, "loop_controlling_argument_indices",
+              loop_controlling_argument_indices, "int", indentation_level);
+  print_key_value_pair(ostr, "eager_specialization_values", "<map>",
+                       indentation_level);
+  for(const auto& entry : eager_specialization_values) {
+    print_array(ostr, std::to_string(entry.first), entry.second, "uint64",
+                indentation_level + 1);
+  }
+  print_key_value_pair(ostr, "num_pgo_training_launches",
+                       num_pgo_training_launches, indentation_level);
+  print_array(ostr, "pgo_branch_counters", pgo_branch_counters, "uint64",
+              indentation_level);
+  print_key_value_pair(ostr, "global_range", "<arg_entry>", indentation_level);
+  global_range.dump(ostr, indentation_level + 1);
+}
+
+void stdpar_sample_entry::merge(const stdpar_sample_entry& other) {
+  if(other.num_samples == 0)
+    return;
+  if(num_samples == 0) {
+    *this = other;
+    return;
+  }
+  num_samples += other.num_samples;
+  total_time_ns += other.total_time_ns;
+  min_time_ns = std::min(min_time_ns, other.min_time_ns);
+  max_time_ns = std::max(max_time_ns, other.max_time_ns);
+}
+
+void stdpar_sample_entry::dump(std::ostream &ostr,
+                               int indentation_level) const {
+  print_key_value_pair(ostr, "num_samples", num_samples, indentation_level);
+  print_key_value_pair(ostr, "total_time_ns", total_time_ns, indentation_level);
+  print_key_value_pair(ostr, "min_time_ns", min_time_ns, indentation_level);
+  print_key_value_pair(ostr, "max_time_ns", max_time_ns, indentation_level);
+}
+
+void stdpar_operation_entry::dump(std::ostream &ostr,
+                                  int indentation_level) const {
+  auto print_samples = [&](const std::string &name, const auto &samples) {
+    print_key_value_pair(ostr, name, "<map>", indentation_level);
+    for(const auto& entry : samples) {
+      print_key_value_pair(ostr, std::to_string(entry.first),
+                           "<stdpar-sample-entry>", indentation_level + 1);
+      entry.second.dump(ostr, indentation_level + 2);
+    }
+  };
+  print_samples("host_samples", host_samples);
+  print_samples("offload_samples", offload_samples);
 }
 
 void binary_entry::dump(std::ostream& ostr, int indentation_level) const {
@@ -94,6 +164,14 @@ void appdb_data::dump(std::ostream& ostr, int indentation_level) const {
     print_key_value_pair(ostr, binary_name, "<binary-entry>", indentation_level+1);
     entry.second.dump(ostr, indentation_level+2);
   }
+
+  print_key_value_pair(ostr, "stdpar_operations", "<map>", indentation_level);
+
+  for(const auto& entry : stdpar_operations) {
+    print_key_value_pair(ostr, std::to_string(entry.first),
+                         "<stdpar-operation-entry>", indentation_level + 1);
+    entry.second.dump(ostr, indentation_level + 2);
+  }
 }
 
 appdb::appdb(const std::string& db_path) 
@@ -90,9 +90,9 @@ static llvm::RegisterPass<SplitterAnnotationAnalysisLegacy>
     splitterAnnotationReg("splitter-annot-ana", "hipSYCL splitter annotation analysis pass",
                           true /* Only looks at CFG */, true /* Analysis Pass */);
 
-static void registerLoopSplitAtBarrierPasses(const llvm::PassManagerBuilder &,
+static void registerLoopSplitAtBarrierPasses(const llvm::PassManagerBuilder &Builder,
                                              llvm::legacy::PassManagerBase &PM) {
-  registerCBSPipelineLegacy(PM);
+  registerCBSPipelineLegacy(PM, Builder.OptLevel);
 }
 
 static llvm::RegisterStandardPasses
@@ -19,6 +19,7 @@
 #include <llvm/IR/Dominators.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/IntrinsicInst.h>
+#include <llvm/Support/Regex.h>
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
 #include <llvm/Transforms/Utils/Cloning.h>
 #include <llvm/Transforms/Utils/Local.h>
@@ -42,6 +43,35 @@ bool isBarrier(const llvm::Instruction *I, const SplitterAnnotationInfo &SAA) {
   return false;
 }
 
+// parses the range dimensionality from the mangled kernel name
+std::size_t getRangeDim(llvm::Function &F) {
+  auto FName = F.getName();
+  // todo: fix with MS mangling
+  llvm::Regex Rgx("iterate_nd_range_ompILi([1-3])E");
+  llvm::SmallVector<llvm::StringRef, 4> Matches;
+  if (Rgx.match(FName, &Matches))
+    return std::stoull(static_cast<std::string>(Matches[1]));
+
+  if (auto MD = F.getParent()->getNamedMetadata(SscpAnnotationsName)) {
+    for (auto OP : MD->operands()) {
+      if (OP->getNumOperands() == 3 &&
+          llvm::cast<llvm::MDString>(OP->getOperand(1))->getString() == SscpKernelDimensionName) {
+        if (&F == llvm::dyn_cast<llvm::Function>(
+                      llvm::cast<llvm::ValueAsMetadata>(OP->getOperand(0))->getValue())) {
+          auto ConstMD = llvm::cast<llvm::ConstantAsMetadata>(OP->getOperand(2))->getValue();
+          if (auto CI = llvm::dyn_cast<llvm::ConstantInt>(ConstMD))
+            return CI->getZExtValue();
+          if (auto ZI = llvm::dyn_cast<llvm::ConstantAggregateZero>(ConstMD))
+            return 0;
+          if (auto CS = llvm::dyn_cast<llvm::ConstantStruct>(ConstMD))
+            return llvm::cast<llvm::ConstantInt>(CS->getOperand(0))->getZExtValue();
+        }
+      }
+    }
+  }
+  llvm_unreachable("[SubCFG] Could not deduce kernel dimensionality!");
+}
+
 bool blockHasBarrier(const llvm::BasicBlock *BB,
                      const hipsycl::compiler::SplitterAnnotationInfo &SAA) {
   return std::any_of(BB->begin(), BB->end(), [&SAA](const auto &I) { return isBarrier(&I, SAA); });
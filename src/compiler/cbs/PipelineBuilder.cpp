@@ -17,10 +17,12 @@
 #include "hipSYCL/compiler/cbs/LoopSplitterInlining.hpp"
 #include "hipSYCL/compiler/cbs/LoopsParallelMarker.hpp"
 #include "hipSYCL/compiler/cbs/PHIsToAllocas.hpp"
+#include "hipSYCL/compiler/cbs/RedundantBarrierElimination.hpp"
 #include "hipSYCL/compiler/cbs/RemoveBarrierCalls.hpp"
 #include "hipSYCL/compiler/cbs/SimplifyKernel.hpp"
 #include "hipSYCL/compiler/cbs/SplitterAnnotationAnalysis.hpp"
 #include "hipSYCL/compiler/cbs/SubCfgFormation.hpp"
+#include "hipSYCL/compiler/cbs/WorkItemLoopInterchange.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/host/HostKernelWrapperPass.hpp"
 
 #include <llvm/IR/LegacyPassManager.h>
@@ -32,7 +34,7 @@
 namespace hipsycl::compiler {
 
 #if LLVM_VERSION_MAJOR < 16
-void registerCBSPipelineLegacy(llvm::legacy::PassManagerBase &PM) {
+void registerCBSPipelineLegacy(llvm::legacy::PassManagerBase &PM, unsigned OptLevel) {
   HIPSYCL_DEBUG_WARNING << "CBS pipeline might not result in peak performance with old PM\n";
   PM.add(new LoopSplitterInliningPassLegacy{});
 
@@ -44,6 +46,10 @@ void registerCBSPipelineLegacy(llvm::legacy::PassManagerBase &PM) {
 
   PM.add(new LoopSimplifyPassLegacy{});
 
+  if (OptLevel > 0) {
+    PM.add(new RedundantBarrierEliminationPassLegacy{});
+    PM.add(new WorkItemLoopInterchangePassLegacy{});
+  }
   PM.add(new CanonicalizeBarriersPassLegacy{});
   PM.add(new SubCfgFormationPassLegacy{});
 
@@ -89,6 +95,10 @@ void registerCBSPipeline(llvm::ModulePassManager &MPM, OptLevel Opt, bool IsSscp
 #endif
   FPM.addPass(llvm::LoopSimplifyPass{});
 
+  if (Opt != OptLevel::O0) {
+    FPM.addPass(RedundantBarrierEliminationPass{});
+    FPM.addPass(WorkItemLoopInterchangePass{});
+  }
   FPM.addPass(CanonicalizeBarriersPass{});
   if (IsSscp)
     FPM.addPass(KernelFlatteningPass{});
@@ -0,0 +1,415 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/cbs/RedundantBarrierElimination.hpp"
+
+#include "hipSYCL/compiler/cbs/IRUtils.hpp"
+#include "hipSYCL/compiler/cbs/Region.hpp"
+#include "hipSYCL/compiler/cbs/SplitterAnnotationAnalysis.hpp"
+#include "hipSYCL/compiler/cbs/UniformityAnalysis.hpp"
+#include "hipSYCL/compiler/cbs/VectorizationInfo.hpp"
+
+#include "hipSYCL/compiler/utils/LLVMUtils.hpp"
+
+#include "hipSYCL/common/debug.hpp"
+
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Analysis/AliasAnalysis.h>
+#include <llvm/Analysis/PostDominators.h>
+#include <llvm/Analysis/ValueTracking.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+
+#include <memory>
+
+namespace {
+using namespace hipsycl::compiler;
+
+// Limits the number of access pairs that are checked per barrier
+// to keep compile times in check for large kernels.
+constexpr std::size_t MaxAccessPairs = 1 << 14;
+// Limits the depth of address expressions that are compared
+constexpr int MaxExpressionDepth = 16;
+
+enum class BarrierClass {
+  // Orders accesses of different work items to the same memory
+  Required,
+  // One of the regions adjacent to the barrier does not access memory
+  // shared between work items.
+  NoSharedAccesses,
+  // Accesses before and after the barrier cannot conflict, e.g. because
+  // they only read, or because each work item only accesses its own element
+  // of a local memory tile.
+  NoConflicts
+};
+
+const char *getBarrierClassName(BarrierClass C) {
+  switch (C) {
+  case BarrierClass::Required:
+    return "required";
+  case BarrierClass::NoSharedAccesses:
+    return "no shared accesses";
+  case BarrierClass::NoConflicts:
+    return "no conflicting accesses";
+  }
+  return "";
+}
+
+// Loads of the work-item builtins, such as the local id. They are constant
+// for a work item, and the kernel never writes them.
+bool isWorkItemBuiltinLoad(const llvm::Value *V) {
+  if (auto *LI = llvm::dyn_cast<llvm::LoadInst>(V))
+    if (auto *GV = llvm::dyn_cast<llvm::GlobalVariable>(LI->getPointerOperand()))
+      return hipsycl::llvmutils::starts_with(GV->getName(), "__acpp_cbs_");
+  return false;
+}
+
+// Private memory is replicated for each work item by sub-CFG formation.
+bool isPrivateMemory(const llvm::Value *Ptr) {
+  return llvm::isa<llvm::AllocaInst>(llvm::getUnderlyingObject(Ptr));
+}
+
+// Distinct global variables, such as local memory variables, never overlap,
+// and neither do the copies of arguments passed by value. Other pointer
+// arguments may alias each other and global variables.
+bool areDistinctObjects(const llvm::Value *ObjA, const llvm::Value *ObjC) {
+  auto IsDistinctObject = [](const llvm::Value *Obj) {
+    if (llvm::isa<llvm::GlobalVariable>(Obj))
+      return true;
+    auto *Arg = llvm::dyn_cast<llvm::Argument>(Obj);
+    return Arg && Arg->hasByValAttr();
+  };
+  return ObjA != ObjC && IsDistinctObject(ObjA) && IsDistinctObject(ObjC);
+}
+
+struct MemoryAccess {
+  llvm::Instruction *I;
+  // nullptr if the accessed memory is unknown
+  llvm::Value *Ptr;
+  std::uint64_t Size;
+  bool IsWrite;
+};
+
+class BarrierClassifier {
+public:
+  BarrierClassifier(llvm::Function &F, llvm::LoopInfo &LI, llvm::DominatorTree &DT,
+                    llvm::PostDominatorTree &PDT, const SplitterAnnotationInfo &SAA)
+      : F_{F}, LI_{LI}, DT_{DT}, PDT_{PDT}, SAA_{SAA}, Dim_{utils::getRangeDim(F)} {}
+
+  BarrierClass classify(llvm::Instruction *Barrier) {
+    llvm::SmallVector<MemoryAccess, 16> Before;
+    llvm::SmallVector<MemoryAccess, 16> After;
+    collectAccesses(Barrier, false, Before);
+    collectAccesses(Barrier, true, After);
+
+    if (Before.empty() || After.empty())
+      return BarrierClass::NoSharedAccesses;
+    if (Before.size() * After.size() > MaxAccessPairs)
+      return BarrierClass::Required;
+
+    llvm::SmallVector<llvm::Loop *, 4> Loops;
+    for (auto *L = LI_.getLoopFor(Barrier->getParent()); L; L = L->getParentLoop())
+      Loops.push_back(L);
+
+    for (const auto &A : Before)
+      for (const auto &C : After)
+        if ((A.IsWrite || C.IsWrite) && mayConflict(A, C, Loops))
+          return BarrierClass::Required;
+    return BarrierClass::NoConflicts;
+  }
+
+private:
+  // Collects the accesses to shared memory that may be executed between Barrier
+  // and the previous (Forward = false) or next (Forward = true) barrier, kernel entry or exit.
+  void collectAccesses(llvm::Instruction *Barrier, bool Forward,
+                       llvm::SmallVectorImpl<MemoryAccess> &Accesses) {
+    llvm::SmallPtrSet<llvm::BasicBlock *, 16> Visited;
+    llvm::SmallVector<llvm::BasicBlock *, 16> Worklist;
+
+    // Returns whether the walk continues past the end of the block
+    auto VisitInstructions = [&](auto Begin, auto End) {
+      for (auto It = Begin; It != End; ++It) {
+        if (utils::isBarrier(&*It, SAA_))
+          return false;
+        addAccess(*It, Accesses);
+      }
+      return true;
+    };
+    auto PushNext = [&](llvm::BasicBlock *BB) {
+      if (Forward)
+        Worklist.append(llvm::succ_begin(BB), llvm::succ_end(BB));
+      else
+        Worklist.append(llvm::pred_begin(BB), llvm::pred_end(BB));
+    };
+
+    auto *BarrierBB = Barrier->getParent();
+    bool Continue = Forward ? VisitInstructions(std::next(Barrier->getIterator()), BarrierBB->end())
+                            : VisitInstructions(std::next(Barrier->getReverseIterator()),
+                                                BarrierBB->rend());
+    if (Continue)
+      PushNext(BarrierBB);
+
+    while (!Worklist.empty()) {
+      auto *BB = Worklist.pop_back_val();
+      if (!Visited.insert(BB).second)
+        continue;
+      Continue = Forward ? VisitInstructions(BB->begin(), BB->end())
+                         : VisitInstructions(BB->rbegin(), BB->rend());
+      if (Continue)
+        PushNext(BB);
+    }
+  }
+
+  void addAccess(llvm::Instruction &I, llvm::SmallVectorImpl<MemoryAccess> &Accesses) {
+    if (!I.mayReadOrWriteMemory() || isWorkItemBuiltinLoad(&I))
+      return;
+    if (auto *II = llvm::dyn_cast<llvm::IntrinsicInst>(&I); II && II->isAssumeLikeIntrinsic())
+      return;
+
+    const auto &DL = F_.getParent()->getDataLayout();
+    auto AddAccess = [&](llvm::Value *Ptr, llvm::Type *T, bool IsWrite) {
+      if (!isPrivateMemory(Ptr))
+        Accesses.push_back(MemoryAccess{&I, Ptr, DL.getTypeStoreSize(T), IsWrite});
+    };
+
+    if (auto *Load = llvm::dyn_cast<llvm::LoadInst>(&I))
+      AddAccess(Load->getPointerOperand(), Load->getType(), false);
+    else if (auto *Store = llvm::dyn_cast<llvm::StoreInst>(&I))
+      AddAccess(Store->getPointerOperand(), Store->getValueOperand()->getType(), true);
+    else if (auto *RMW = llvm::dyn_cast<llvm::AtomicRMWInst>(&I))
+      AddAccess(RMW->getPointerOperand(), RMW->getValOperand()->getType(), true);
+    else if (auto *CmpXchg = llvm::dyn_cast<llvm::AtomicCmpXchgInst>(&I))
+      AddAccess(CmpXchg->getPointerOperand(), CmpXchg->getNewValOperand()->getType(), true);
+    else {
+      // Calls that only access private memory through their arguments, e.g. memcpy
+      // between private objects, do not matter.
+      if (auto *CB = llvm::dyn_cast<llvm::CallBase>(&I); CB && CB->onlyAccessesArgMemory() &&
+                                                         llvm::all_of(CB->args(), [](auto &Arg) {
+                                                           return !Arg->getType()->isPointerTy() ||
+                                                                  isPrivateMemory(Arg);
+                                                         }))
+        return;
+      Accesses.push_back(MemoryAccess{&I, nullptr, 0, I.mayWriteToMemory()});
+    }
+  }
+
+  // Whether A, executed by one work item, and C, executed by another work item,
+  // may access the same memory.
+  bool mayConflict(const MemoryAccess &A, const MemoryAccess &C,
+                   llvm::ArrayRef<llvm::Loop *> Loops) {
+    if (!A.Ptr || !C.Ptr)
+      return true;
+
+    if (areDistinctObjects(llvm::getUnderlyingObject(A.Ptr), llvm::getUnderlyingObject(C.Ptr)))
+      return false;
+
+    return !accessSameWorkItemLocation(A, C, Loops);
+  }
+
+  // Whether A and C access the same location, which is distinct for each work item,
+  // e.g. tile[lid] in a 1D kernel.
+  bool accessSameWorkItemLocation(const MemoryAccess &A, const MemoryAccess &C,
+                                  llvm::ArrayRef<llvm::Loop *> Loops) {
+    // Uniformity analysis only tracks the innermost dimension, which does not
+    // identify work items in multi-dimensional groups.
+    if (Dim_ != 1)
+      return false;
+    if (!areEquivalent(A.Ptr, C.Ptr, Loops, MaxExpressionDepth))
+      return false;
+
+    llvm::SmallPtrSet<llvm::Value *, 16> Visited;
+    if (!isComputedFromImmutableValues(A.Ptr, Visited, MaxExpressionDepth))
+      return false;
+
+    const auto &VecInfo = getVectorizationInfo();
+    if (!VecInfo.hasKnownShape(*A.Ptr) || !VecInfo.hasKnownShape(*C.Ptr))
+      return false;
+    auto Shape = VecInfo.getVectorShape(*A.Ptr);
+    if (!Shape.hasStridedShape() || Shape != VecInfo.getVectorShape(*C.Ptr))
+      return false;
+
+    // Addresses of neighbouring work items differ by the stride
+    std::uint64_t Stride = Shape.getStride() < 0 ? -Shape.getStride() : Shape.getStride();
+    return Stride >= std::max(A.Size, C.Size);
+  }
+
+  // Whether X and Y compute the same value for a work item when executed
+  // on different sides of the barrier nested in Loops.
+  bool areEquivalent(llvm::Value *X, llvm::Value *Y, llvm::ArrayRef<llvm::Loop *> Loops,
+                     int Depth) {
+    if (X == Y) {
+      // A value redefined in a loop around the barrier may differ
+      // between the iterations that the accesses belong to, unless
+      // it is recomputed from values that do not.
+      auto *I = llvm::dyn_cast<llvm::Instruction>(X);
+      if (!I || isWorkItemBuiltinLoad(I) ||
+          llvm::none_of(Loops, [I](llvm::Loop *L) { return L->contains(I); }))
+        return true;
+    }
+    if (Depth == 0)
+      return false;
+
+    auto *IX = llvm::dyn_cast<llvm::Instruction>(X);
+    auto *IY = llvm::dyn_cast<llvm::Instruction>(Y);
+    if (!IX || !IY || !IX->isSameOperationAs(IY))
+      return false;
+    if (isWorkItemBuiltinLoad(IX))
+      return IX->getOperand(0) == IY->getOperand(0);
+    if (!llvm::isa<llvm::GetElementPtrInst, llvm::CastInst, llvm::BinaryOperator, llvm::CmpInst,
+                   llvm::SelectInst>(IX))
+      return false;
+
+    for (unsigned Op = 0; Op < IX->getNumOperands(); ++Op)
+      if (!areEquivalent(IX->getOperand(Op), IY->getOperand(Op), Loops, Depth - 1))
+        return false;
+    return true;
+  }
+
+  // Whether V only depends on arguments, constants and work-item builtins.
+  // Uniformity analysis considers loads from uniform addresses uniform, but
+  // other work items might modify the loaded memory once the barrier is gone.
+  bool isComputedFromImmutableValues(llvm::Value *V, llvm::SmallPtrSetImpl<llvm::Value *> &Visited,
+                                     int Depth) {
+    if (llvm::isa<llvm::Constant>(V) || llvm::isa<llvm::Argument>(V))
+      return true;
+    auto *I = llvm::dyn_cast<llvm::Instruction>(V);
+    if (!I)
+      return false;
+    if (!Visited.insert(V).second)
+      return true;
+    if (Depth == 0)
+      return false;
+
+    if (isWorkItemBuiltinLoad(I))
+      return true;
+    if (auto *Load = llvm::dyn_cast<llvm::LoadInst>(I)) {
+      // Kernel arguments passed in memory, e.g. captured values of the kernel lambda
+      auto *Arg = llvm::dyn_cast<llvm::Argument>(
+          llvm::getUnderlyingObject(Load->getPointerOperand()));
+      return Arg && (Arg->hasByValAttr() || Arg->onlyReadsMemory()) &&
+             isComputedFromImmutableValues(Load->getPointerOperand(), Visited, Depth - 1);
+    }
+    if (I->mayReadOrWriteMemory())
+      return false;
+
+    for (auto &Op : I->operands())
+      if (!isComputedFromImmutableValues(Op, Visited, Depth - 1))
+        return false;
+    return true;
+  }
+
+  const VectorizationInfo &getVectorizationInfo() {
+    if (!VecInfo_) {
+      llvm::SmallVector<llvm::BasicBlock *, 32> Blocks;
+      for (auto &BB : F_)
+        Blocks.push_back(&BB);
+      RegionImpl_ = std::make_unique<FunctionRegion>(F_, Blocks);
+      Region_ = std::make_unique<Region>(*RegionImpl_);
+      VecInfo_ = std::make_unique<VectorizationInfo>(F_, *Region_);
+
+      for (auto &BB : F_)
+        for (auto &I : BB)
+          if (auto *Load = llvm::dyn_cast<llvm::LoadInst>(&I);
+              Load && Load->getPointerOperand() ==
+                          F_.getParent()->getGlobalVariable(cbs::LocalIdGlobalNameX))
+            VecInfo_->setPinnedShape(*Load, VectorShape::cont());
+
+      VectorizationAnalysis VecAna{*VecInfo_, LI_, DT_, PDT_};
+      VecAna.analyze();
+    }
+    return *VecInfo_;
+  }
+
+  llvm::Function &F_;
+  llvm::LoopInfo &LI_;
+  llvm::DominatorTree &DT_;
+  llvm::PostDominatorTree &PDT_;
+  const SplitterAnnotationInfo &SAA_;
+  std::size_t Dim_;
+
+  std::unique_ptr<RegionImpl> RegionImpl_;
+  std::unique_ptr<Region> Region_;
+  std::unique_ptr<VectorizationInfo> VecInfo_;
+};
+
+bool eliminateRedundantBarriers(llvm::Function &F, llvm::LoopInfo &LI, llvm::DominatorTree &DT,
+                                llvm::PostDominatorTree &PDT, const SplitterAnnotationInfo &SAA) {
+  if (!SAA.isKernelFunc(&F) || !utils::hasBarriers(F, SAA) || utils::getRangeDim(F) == 0)
+    return false;
+
+  llvm::SmallVector<llvm::Instruction *, 8> Barriers;
+  for (auto &BB : F)
+    for (auto &I : BB)
+      if (utils::isBarrier(&I, SAA) && I.use_empty())
+        Barriers.push_back(&I);
+
+  // Barriers are removed one at a time, such that the regions of the
+  // remaining barriers grow accordingly.
+  BarrierClassifier Classifier{F, LI, DT, PDT, SAA};
+  bool Changed = false;
+  for (auto *Barrier : Barriers) {
+    auto Class = Classifier.classify(Barrier);
+    HIPSYCL_DEBUG_INFO << "[BarrierElimination] Barrier in " << Barrier->getParent()->getName()
+                       << " of " << F.getName() << ": " << getBarrierClassName(Class) << "\n";
+    if (Class != BarrierClass::Required) {
+      Barrier->eraseFromParent();
+      Changed = true;
+    }
+  }
+  return Changed;
+}
+
+} // namespace
+
+namespace hipsycl::compiler {
+char RedundantBarrierEliminationPassLegacy::ID = 0;
+
+void RedundantBarrierEliminationPassLegacy::getAnalysisUsage(llvm::AnalysisUsage &AU) const {
+  AU.addRequired<llvm::LoopInfoWrapperPass>();
+  AU.addRequired<llvm::DominatorTreeWrapperPass>();
+  AU.addRequired<llvm::PostDominatorTreeWrapperPass>();
+  AU.addRequired<SplitterAnnotationAnalysisLegacy>();
+  AU.addPreserved<SplitterAnnotationAnalysisLegacy>();
+  AU.setPreservesCFG();
+}
+
+bool RedundantBarrierEliminationPassLegacy::runOnFunction(llvm::Function &F) {
+  auto &SAA = getAnalysis<SplitterAnnotationAnalysisLegacy>().getAnnotationInfo();
+  if (!SAA.isKernelFunc(&F))
+    return false;
+
+  auto &LI = getAnalysis<llvm::LoopInfoWrapperPass>().getLoopInfo();
+  auto &DT = getAnalysis<llvm::DominatorTreeWrapperPass>().getDomTree();
+  auto &PDT = getAnalysis<llvm::PostDominatorTreeWrapperPass>().getPostDomTree();
+  return eliminateRedundantBarriers(F, LI, DT, PDT, SAA);
+}
+
+llvm::PreservedAnalyses RedundantBarrierEliminationPass::run(llvm::Function &F,
+                                                             llvm::FunctionAnalysisManager &AM) {
+  auto &MAM = AM.getResult<llvm::ModuleAnalysisManagerFunctionProxy>(F);
+  auto *SAA = MAM.getCachedResult<SplitterAnnotationAnalysis>(*F.getParent());
+  if (!SAA || !SAA->isKernelFunc(&F))
+    return llvm::PreservedAnalyses::all();
+
+  auto &LI = AM.getResult<llvm::LoopAnalysis>(F);
+  auto &DT = AM.getResult<llvm::DominatorTreeAnalysis>(F);
+  auto &PDT = AM.getResult<llvm::PostDominatorTreeAnalysis>(F);
+  if (!eliminateRedundantBarriers(F, LI, DT, PDT, *SAA))
+    return llvm::PreservedAnalyses::all();
+
+  llvm::PreservedAnalyses PA;
+  PA.preserveSet<llvm::CFGAnalyses>();
+  PA.preserve<SplitterAnnotationAnalysis>();
+  return PA;
+}
+} // namespace hipsycl::compiler
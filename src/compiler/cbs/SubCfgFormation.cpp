@@ -31,7 +31,6 @@
 #include <llvm/IR/Instruction.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/Verifier.h>
-#include <llvm/Support/Regex.h>
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
 #include <llvm/Transforms/Utils/Cloning.h>
 #include <llvm/Transforms/Utils/Local.h>
@@ -91,35 +90,6 @@ llvm::LoadInst *mergeGVLoadsInEntry(llvm::Function &F, llvm::StringRef VarName)
   return Load;
 }
 
-// parses the range dimensionality from the mangled kernel name
-std::size_t getRangeDim(llvm::Function &F) {
-  auto FName = F.getName();
-  // todo: fix with MS mangling
-  llvm::Regex Rgx("iterate_nd_range_ompILi([1-3])E");
-  llvm::SmallVector<llvm::StringRef, 4> Matches;
-  if (Rgx.match(FName, &Matches))
-    return std::stoull(static_cast<std::string>(Matches[1]));
-
-  if (auto MD = F.getParent()->getNamedMetadata(SscpAnnotationsName)) {
-    for (auto OP : MD->operands()) {
-      if (OP->getNumOperands() == 3 &&
-          llvm::cast<llvm::MDString>(OP->getOperand(1))->getString() == SscpKernelDimensionName) {
-        if (&F == llvm::dyn_cast<llvm::Function>(
-                      llvm::cast<llvm::ValueAsMetadata>(OP->getOperand(0))->getValue())) {
-          auto ConstMD = llvm::cast<llvm::ConstantAsMetadata>(OP->getOperand(2))->getValue();
-          if (auto CI = llvm::dyn_cast<llvm::ConstantInt>(ConstMD))
-            return CI->getZExtValue();
-          if (auto ZI = llvm::dyn_cast<llvm::ConstantAggregateZero>(ConstMD))
-            return 0;
-          if (auto CS = llvm::dyn_cast<llvm::ConstantStruct>(ConstMD))
-            return llvm::cast<llvm::ConstantInt>(CS->getOperand(0))->getZExtValue();
-        }
-      }
-    }
-  }
-  llvm_unreachable("[SubCFG] Could not deduce kernel dimensionality!");
-}
-
 // searches for llvm.var.annotation and returns the value that is annotated by it, as well the
 // annotation instruction
 std::pair<llvm::Value *, llvm::Instruction *>
@@ -1206,7 +1176,7 @@ void formSubCfgs(llvm::Function &F, llvm::LoopInfo &LI, llvm::DominatorTree &DT,
                  llvm::PostDominatorTree &PDT, const SplitterAnnotationInfo &SAA, bool IsSscp) {
   HIPSYCL_DEBUG_EXECUTE_VERBOSE(F.viewCFG();)
 
-  const std::size_t Dim = getRangeDim(F);
+  const std::size_t Dim = utils::getRangeDim(F);
   HIPSYCL_DEBUG_INFO << "[SubCFG] Kernel is " << Dim << "-dimensional\n";
 
   const auto LocalSize = getLocalSizeValues(F, Dim, IsSscp);
@@ -1330,7 +1300,7 @@ void createLoopsAroundKernel(llvm::Function &F, llvm::DominatorTree &DT, llvm::L
 
   moveAllocasToEntry(F, Blocks);
 
-  const auto Dim = getRangeDim(F);
+  const auto Dim = utils::getRangeDim(F);
 
   // insert dummy induction variable that can be easily identified and replaced later
   llvm::IRBuilder Builder{F.getEntryBlock().getTerminator()};
@@ -1371,7 +1341,7 @@ void SubCfgFormationPassLegacy::getAnalysisUsage(llvm::AnalysisUsage &AU) const
 bool SubCfgFormationPassLegacy::runOnFunction(llvm::Function &F) {
   auto &SAA = getAnalysis<SplitterAnnotationAnalysisLegacy>().getAnnotationInfo();
 
-  if (!SAA.isKernelFunc(&F) || getRangeDim(F) == 0)
+  if (!SAA.isKernelFunc(&F) || utils::getRangeDim(F) == 0)
     return false;
 
   HIPSYCL_DEBUG_INFO << "[SubCFG] Form SubCFGs in " << F.getName() << "\n";
@@ -1395,7 +1365,7 @@ llvm::PreservedAnalyses SubCfgFormationPass::run(llvm::Function &F,
   auto &MAM = AM.getResult<llvm::ModuleAnalysisManagerFunctionProxy>(F);
   auto *SAA = MAM.getCachedResult<SplitterAnnotationAnalysis>(*F.getParent());
 
-  if (!SAA || !SAA->isKernelFunc(&F) || getRangeDim(F) == 0)
+  if (!SAA || !SAA->isKernelFunc(&F) || utils::getRangeDim(F) == 0)
     return llvm::PreservedAnalyses::all();
 
   HIPSYCL_DEBUG_INFO << "[SubCFG] Form SubCFGs in " << F.getName() << "\n";
@@ -0,0 +1,229 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/cbs/WorkItemLoopInterchange.hpp"
+
+#include "hipSYCL/compiler/cbs/IRUtils.hpp"
+#include "hipSYCL/compiler/cbs/SplitterAnnotationAnalysis.hpp"
+
+#include "hipSYCL/compiler/utils/LLVMUtils.hpp"
+
+#include "hipSYCL/common/debug.hpp"
+
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Analysis/PostDominators.h>
+#include <llvm/Analysis/ValueTracking.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+
+namespace {
+using namespace hipsycl::compiler;
+
+// Limits the depth of the expressions that are checked for uniformity
+constexpr int MaxExpressionDepth = 16;
+
+// Loads of work-item builtins, such as the local id or the group id.
+const llvm::GlobalVariable *getWorkItemBuiltin(const llvm::Value *V) {
+  if (auto *LI = llvm::dyn_cast<llvm::LoadInst>(V))
+    if (auto *GV = llvm::dyn_cast<llvm::GlobalVariable>(LI->getPointerOperand());
+        GV && hipsycl::llvmutils::starts_with(GV->getName(), "__acpp_cbs_"))
+      return GV;
+  return nullptr;
+}
+
+class UniformLoopFinder {
+public:
+  UniformLoopFinder(llvm::LoopInfo &LI, llvm::PostDominatorTree &PDT) : LI_{LI}, PDT_{PDT} {}
+
+  // Whether L can be executed by all work items of a group in lockstep, i.e.
+  // whether placing barriers around and inside of L preserves the semantics.
+  bool isExecutedUniformly(llvm::Loop &L) {
+    auto *Preheader = L.getLoopPreheader();
+
+    // Branches that decide whether the loop is reached, including
+    // the exit conditions of the loops around it
+    llvm::SmallPtrSet<llvm::BasicBlock *, 16> Visited;
+    llvm::SmallVector<llvm::BasicBlock *, 16> Worklist{Preheader};
+    while (!Worklist.empty()) {
+      auto *BB = Worklist.pop_back_val();
+      if (!Visited.insert(BB).second)
+        continue;
+      if (!PDT_.dominates(Preheader, BB) && !hasGroupUniformSuccessor(BB))
+        return false;
+      Worklist.append(llvm::pred_begin(BB), llvm::pred_end(BB));
+    }
+
+    // Branches that decide the trip count
+    llvm::SmallVector<llvm::BasicBlock *, 4> ExitingBlocks;
+    L.getExitingBlocks(ExitingBlocks);
+    return llvm::all_of(ExitingBlocks,
+                        [this](llvm::BasicBlock *BB) { return hasGroupUniformSuccessor(BB); });
+  }
+
+private:
+  bool hasGroupUniformSuccessor(llvm::BasicBlock *BB) {
+    llvm::Value *Cond = nullptr;
+    auto *T = BB->getTerminator();
+    if (auto *Br = llvm::dyn_cast<llvm::BranchInst>(T)) {
+      if (Br->isUnconditional())
+        return true;
+      Cond = Br->getCondition();
+    } else if (auto *Switch = llvm::dyn_cast<llvm::SwitchInst>(T)) {
+      Cond = Switch->getCondition();
+    } else {
+      return false;
+    }
+    llvm::SmallPtrSet<llvm::Value *, 16> Visited;
+    return isGroupUniform(Cond, Visited, MaxExpressionDepth);
+  }
+
+  // Whether V is the same for all work items of a group. Unlike the uniformity
+  // analysis, this covers all dimensions of the group, and it only accepts loads
+  // from memory that the kernel does not write, such as the captured values of
+  // the kernel lambda.
+  bool isGroupUniform(llvm::Value *V, llvm::SmallPtrSetImpl<llvm::Value *> &Visited, int Depth) {
+    if (llvm::isa<llvm::Constant>(V) || llvm::isa<llvm::Argument>(V))
+      return true;
+    auto *I = llvm::dyn_cast<llvm::Instruction>(V);
+    if (!I)
+      return false;
+    if (!Visited.insert(V).second)
+      return true;
+    if (Depth == 0)
+      return false;
+
+    if (auto *GV = getWorkItemBuiltin(I))
+      return llvm::none_of(cbs::LocalIdGlobalNames,
+                           [GV](const char *Name) { return GV->getName() == Name; });
+    if (auto *Load = llvm::dyn_cast<llvm::LoadInst>(I)) {
+      auto *Arg = llvm::dyn_cast<llvm::Argument>(
+          llvm::getUnderlyingObject(Load->getPointerOperand()));
+      return Arg && (Arg->hasByValAttr() || Arg->onlyReadsMemory()) &&
+             isGroupUniform(Load->getPointerOperand(), Visited, Depth - 1);
+    }
+    if (I->mayReadOrWriteMemory())
+      return false;
+
+    // The value of a loop header PHI in a given iteration only depends on its
+    // incoming values, other PHIs also depend on the path taken to them.
+    if (auto *PHI = llvm::dyn_cast<llvm::PHINode>(I)) {
+      auto *L = LI_.getLoopFor(PHI->getParent());
+      if (!L || L->getHeader() != PHI->getParent() || !L->getLoopPreheader() ||
+          !L->getLoopLatch())
+        return false;
+    }
+
+    for (auto &Op : I->operands())
+      if (!isGroupUniform(Op, Visited, Depth - 1))
+        return false;
+    return true;
+  }
+
+  llvm::LoopInfo &LI_;
+  llvm::PostDominatorTree &PDT_;
+};
+
+// Innermost loops without calls that read memory shared between work items, e.g.
+// a loop over a local memory tile. Placing them outside of the work-item loop
+// turns accesses that are contiguous across work items into vectorizable ones.
+bool isInterchangeCandidate(const llvm::Loop &L) {
+  if (!L.isInnermost() || !L.getLoopPreheader() || !L.getLoopLatch() ||
+      !L.getUniqueExitBlock() || !L.hasDedicatedExits())
+    return false;
+
+  bool ReadsSharedMemory = false;
+  for (auto *BB : L.blocks())
+    for (auto &I : *BB) {
+      // This includes barriers
+      if (llvm::isa<llvm::CallBase>(I) && !llvm::isa<llvm::IntrinsicInst>(I))
+        return false;
+      if (auto *Load = llvm::dyn_cast<llvm::LoadInst>(&I))
+        ReadsSharedMemory |=
+            !getWorkItemBuiltin(Load) &&
+            !llvm::isa<llvm::AllocaInst>(llvm::getUnderlyingObject(Load->getPointerOperand()));
+    }
+  return ReadsSharedMemory;
+}
+
+bool interchangeWorkItemLoops(llvm::Function &F, llvm::LoopInfo &LI, llvm::PostDominatorTree &PDT,
+                              SplitterAnnotationInfo &SAA) {
+  // Kernels without barriers do not use sub-CFG formation, and their
+  // work-item loops are not worth the overhead of splitting.
+  if (!SAA.isKernelFunc(&F) || !utils::hasBarriers(F, SAA) || utils::getRangeDim(F) == 0)
+    return false;
+
+  UniformLoopFinder Finder{LI, PDT};
+  llvm::SmallVector<llvm::Loop *, 4> Loops;
+  for (auto *L : LI.getLoopsInPreorder())
+    if (isInterchangeCandidate(*L) && Finder.isExecutedUniformly(*L))
+      Loops.push_back(L);
+
+  // Barriers at the loop header and exit form a sub-CFG for the loop body,
+  // which places the work-item loop inside of it. The barriers before the
+  // branches of the latch and the exiting blocks keep these uniform branches
+  // out of that sub-CFG, such that the work-item loop does not branch.
+  for (auto *L : Loops) {
+    HIPSYCL_DEBUG_INFO << "[WorkItemLoopInterchange] Interchanging work-item loop with loop "
+                       << L->getHeader()->getName() << " of " << F.getName() << "\n";
+    llvm::SmallVector<llvm::BasicBlock *, 4> ExitingBlocks;
+    L->getExitingBlocks(ExitingBlocks);
+
+    utils::createBarrier(&*L->getHeader()->getFirstInsertionPt(), SAA);
+    for (auto *BB : ExitingBlocks)
+      utils::createBarrier(BB->getTerminator(), SAA);
+    utils::createBarrier(L->getLoopLatch()->getTerminator(), SAA);
+    utils::createBarrier(&*L->getUniqueExitBlock()->getFirstInsertionPt(), SAA);
+  }
+  return !Loops.empty();
+}
+
+} // namespace
+
+namespace hipsycl::compiler {
+char WorkItemLoopInterchangePassLegacy::ID = 0;
+
+void WorkItemLoopInterchangePassLegacy::getAnalysisUsage(llvm::AnalysisUsage &AU) const {
+  AU.addRequired<llvm::LoopInfoWrapperPass>();
+  AU.addRequired<llvm::PostDominatorTreeWrapperPass>();
+  AU.addRequired<SplitterAnnotationAnalysisLegacy>();
+  AU.addPreserved<SplitterAnnotationAnalysisLegacy>();
+  AU.setPreservesCFG();
+}
+
+bool WorkItemLoopInterchangePassLegacy::runOnFunction(llvm::Function &F) {
+  auto &SAA = getAnalysis<SplitterAnnotationAnalysisLegacy>().getAnnotationInfo();
+  if (!SAA.isKernelFunc(&F))
+    return false;
+
+  auto &LI = getAnalysis<llvm::LoopInfoWrapperPass>().getLoopInfo();
+  auto &PDT = getAnalysis<llvm::PostDominatorTreeWrapperPass>().getPostDomTree();
+  return interchangeWorkItemLoops(F, LI, PDT, SAA);
+}
+
+llvm::PreservedAnalyses WorkItemLoopInterchangePass::run(llvm::Function &F,
+                                                         llvm::FunctionAnalysisManager &AM) {
+  auto &MAM = AM.getResult<llvm::ModuleAnalysisManagerFunctionProxy>(F);
+  auto *SAA = MAM.getCachedResult<SplitterAnnotationAnalysis>(*F.getParent());
+  if (!SAA || !SAA->isKernelFunc(&F))
+    return llvm::PreservedAnalyses::all();
+
+  auto &LI = AM.getResult<llvm::LoopAnalysis>(F);
+  auto &PDT = AM.getResult<llvm::PostDominatorTreeAnalysis>(F);
+  if (!interchangeWorkItemLoops(F, LI, PDT, *SAA))
+    return llvm::PreservedAnalyses::all();
+
+  llvm::PreservedAnalyses PA;
+  PA.preserveSet<llvm::CFGAnalyses>();
+  PA.preserve<SplitterAnnotationAnalysis>();
+  return PA;
+}
+} // namespace hipsycl::compiler
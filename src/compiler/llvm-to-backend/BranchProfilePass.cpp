@@ -0,0 +1,126 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/llvm-to-backend/BranchProfilePass.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/MDBuilder.h>
+#include <llvm/IR/Module.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace hipsycl {
+namespace compiler {
+
+namespace {
+
+constexpr const char* CountersName = "__acpp_sscp_pgo_counters";
+constexpr const char* NumCountersName = "__acpp_sscp_pgo_num_counters";
+
+llvm::SmallVector<llvm::BranchInst *, 64> getConditionalBranches(llvm::Module &M) {
+  llvm::SmallVector<llvm::BranchInst *, 64> Branches;
+  for(auto& F : M) {
+    if(F.isDeclaration())
+      continue;
+    for(auto& BB : F) {
+      if(auto* Branch = llvm::dyn_cast_or_null<llvm::BranchInst>(BB.getTerminator()))
+        if(Branch->isConditional())
+          Branches.push_back(Branch);
+    }
+  }
+  return Branches;
+}
+
+}
+
+BranchProfileInstrumentationPass::BranchProfileInstrumentationPass(unsigned AS)
+    : CounterAddressSpace{AS} {}
+
+llvm::PreservedAnalyses
+BranchProfileInstrumentationPass::run(llvm::Module &M,
+                                      llvm::ModuleAnalysisManager &MAM) {
+  auto Branches = getConditionalBranches(M);
+  if(Branches.empty())
+    return llvm::PreservedAnalyses::all();
+
+  const uint64_t NumCounters = 2 * Branches.size();
+  llvm::Type* CounterT = llvm::Type::getInt64Ty(M.getContext());
+  llvm::ArrayType* CountersT = llvm::ArrayType::get(CounterT, NumCounters);
+
+  auto *Counters = new llvm::GlobalVariable(
+      M, CountersT, false, llvm::GlobalValue::ExternalLinkage,
+      llvm::ConstantAggregateZero::get(CountersT), CountersName, nullptr,
+      llvm::GlobalValue::NotThreadLocal, CounterAddressSpace);
+  Counters->setAlignment(llvm::Align{8});
+  new llvm::GlobalVariable(M, CounterT, true, llvm::GlobalValue::ExternalLinkage,
+                           llvm::ConstantInt::get(CounterT, NumCounters), NumCountersName,
+                           nullptr, llvm::GlobalValue::NotThreadLocal, CounterAddressSpace);
+
+  for(uint64_t i = 0; i < Branches.size(); ++i) {
+    llvm::IRBuilder<> Builder{Branches[i]};
+    llvm::Value *Index = Builder.CreateSelect(Branches[i]->getCondition(),
+                                              Builder.getInt64(2 * i), Builder.getInt64(2 * i + 1));
+    llvm::Value *Counter =
+        Builder.CreateInBoundsGEP(CountersT, Counters, {Builder.getInt64(0), Index});
+    Builder.CreateAtomicRMW(llvm::AtomicRMWInst::Add, Counter, Builder.getInt64(1),
+                            llvm::MaybeAlign{8}, llvm::AtomicOrdering::Monotonic);
+  }
+
+  HIPSYCL_DEBUG_INFO << "BranchProfileInstrumentationPass: Instrumented " << Branches.size()
+                     << " branches\n";
+  return llvm::PreservedAnalyses::none();
+}
+
+BranchProfileApplicationPass::BranchProfileApplicationPass(
+    const std::vector<uint64_t> &BranchCounters)
+    : Counters{BranchCounters} {}
+
+llvm::PreservedAnalyses
+BranchProfileApplicationPass::run(llvm::Module &M,
+                                  llvm::ModuleAnalysisManager &MAM) {
+  auto Branches = getConditionalBranches(M);
+  if(Counters.size() != 2 * Branches.size()) {
+    HIPSYCL_DEBUG_WARNING << "BranchProfileApplicationPass: Profile does not match module ("
+                          << Counters.size() << " counters for " << Branches.size()
+                          << " branches), ignoring profile\n";
+    return llvm::PreservedAnalyses::all();
+  }
+
+  llvm::MDBuilder MDB{M.getContext()};
+  std::size_t NumProfiledBranches = 0;
+  for(std::size_t i = 0; i < Branches.size(); ++i) {
+    uint64_t Taken = Counters[2 * i];
+    uint64_t NotTaken = Counters[2 * i + 1];
+    // Leave branches that were never executed to the static heuristics
+    if(Taken + NotTaken == 0)
+      continue;
+    ++NumProfiledBranches;
+
+    // Branch weights are 32 bit
+    uint64_t Scale = std::max(Taken, NotTaken) / std::numeric_limits<uint32_t>::max() + 1;
+    Branches[i]->setMetadata(
+        llvm::LLVMContext::MD_prof,
+        MDB.createBranchWeights(static_cast<uint32_t>(Taken / Scale),
+                                static_cast<uint32_t>(NotTaken / Scale)));
+  }
+
+  HIPSYCL_DEBUG_INFO << "BranchProfileApplicationPass: Applied profile to " << NumProfiledBranches
+                     << " of " << Branches.size() << " branches\n";
+  return llvm::PreservedAnalyses::none();
+}
+
+}
+}
@@ -19,54 +19,49 @@
 namespace hipsycl {
 namespace compiler {
 
-namespace {
+bool applyKnownBuiltinSize(llvm::Module &M, long long KnownSize,
+                           llvm::StringRef GetSizeBuiltinName,
+                           llvm::StringRef GetIdBuiltinName) {
 
-
-bool applyKnownGroupSize(llvm::Module &M, int KnownGroupSize,
-                         llvm::StringRef GetGroupSizeBuiltinName,
-                         llvm::StringRef GetLocalIdBuiltinName) {
-
-  // First create replacement functions for GetGroupSizeBuiltinName
-  // which directly return the known group size, and replace all
+  // First create replacement functions for GetSizeBuiltinName
+  // which directly return the known size, and replace all
   // uses.
-  if(auto* GetGroupSizeF = M.getFunction(GetGroupSizeBuiltinName)) {
-    std::string NewFunctionName = std::string{GetGroupSizeBuiltinName}+"_known_size";
+  if(auto* GetSizeF = M.getFunction(GetSizeBuiltinName)) {
+    std::string NewFunctionName = std::string{GetSizeBuiltinName}+"_known_size";
 
-    auto *NewGetGroupSizeF = llvm::dyn_cast<llvm::Function>(
-        M.getOrInsertFunction(NewFunctionName, GetGroupSizeF->getFunctionType(),
-                              GetGroupSizeF->getAttributes())
+    auto *NewGetSizeF = llvm::dyn_cast<llvm::Function>(
+        M.getOrInsertFunction(NewFunctionName, GetSizeF->getFunctionType(),
+                              GetSizeF->getAttributes())
             .getCallee());
-    if(!NewGetGroupSizeF)
+    if(!NewGetSizeF)
       return false;
 
-    if(!NewGetGroupSizeF->hasFnAttribute(llvm::Attribute::AlwaysInline))
-      NewGetGroupSizeF->addFnAttr(llvm::Attribute::AlwaysInline);
+    if(!NewGetSizeF->hasFnAttribute(llvm::Attribute::AlwaysInline))
+      NewGetSizeF->addFnAttr(llvm::Attribute::AlwaysInline);
 
     llvm::BasicBlock *BB =
-        llvm::BasicBlock::Create(M.getContext(), "", NewGetGroupSizeF);
+        llvm::BasicBlock::Create(M.getContext(), "", NewGetSizeF);
 
-    auto *ReturnedIntType = llvm::dyn_cast<llvm::IntegerType>(GetGroupSizeF->getReturnType());
+    auto *ReturnedIntType = llvm::dyn_cast<llvm::IntegerType>(GetSizeF->getReturnType());
     if(!ReturnedIntType)
       return false;
 
     llvm::Constant *ReturnedValue = llvm::ConstantInt::get(
-        M.getContext(), llvm::APInt(ReturnedIntType->getBitWidth(), KnownGroupSize));
+        M.getContext(), llvm::APInt(ReturnedIntType->getBitWidth(), KnownSize));
 
     llvm::ReturnInst::Create(M.getContext(), ReturnedValue, BB);
 
-    GetGroupSizeF->replaceNonMetadataUsesWith(NewGetGroupSizeF);
+    GetSizeF->replaceNonMetadataUsesWith(NewGetSizeF);
   }
 
-  // Insert __builtin_assume(0 <= local_id); __builtin_assume(local_id < group_size);
-  // for every call to GetLocalIdBuiltinName
-  if(!insertRangeAssumptionForBuiltinCalls(M, GetLocalIdBuiltinName, 0, KnownGroupSize))
+  // Insert __builtin_assume(0 <= id); __builtin_assume(id < size);
+  // for every call to GetIdBuiltinName
+  if(!insertRangeAssumptionForBuiltinCalls(M, GetIdBuiltinName, 0, KnownSize))
     return false;
 
   return true;
 }
 
-}
-
 KnownGroupSizeOptPass::KnownGroupSizeOptPass(int GroupSizeX, int GroupSizeY, int GroupSizeZ)
     : KnownGroupSizeX{GroupSizeX}, KnownGroupSizeY{GroupSizeY}, KnownGroupSizeZ{GroupSizeZ} {}
 
@@ -74,17 +69,17 @@ KnownGroupSizeOptPass::KnownGroupSizeOptPass(int GroupSizeX, int GroupSizeY, int
 llvm::PreservedAnalyses KnownGroupSizeOptPass::run(llvm::Module &M,
                                                         llvm::ModuleAnalysisManager &MAM) {
   if (KnownGroupSizeX > 0) {
-    applyKnownGroupSize(M, KnownGroupSizeX, "__acpp_sscp_get_local_size_x",
+    applyKnownBuiltinSize(M, KnownGroupSizeX, "__acpp_sscp_get_local_size_x",
                         "__acpp_sscp_get_local_id_x");
   }
 
   if (KnownGroupSizeY > 0) {
-    applyKnownGroupSize(M, KnownGroupSizeY, "__acpp_sscp_get_local_size_y",
+    applyKnownBuiltinSize(M, KnownGroupSizeY, "__acpp_sscp_get_local_size_y",
                         "__acpp_sscp_get_local_id_y");
   }
 
   if (KnownGroupSizeZ > 0) {
-    applyKnownGroupSize(M, KnownGroupSizeZ, "__acpp_sscp_get_local_size_z",
+    applyKnownBuiltinSize(M, KnownGroupSizeZ, "__acpp_sscp_get_local_size_z",
                         "__acpp_sscp_get_local_id_z");
   }
 
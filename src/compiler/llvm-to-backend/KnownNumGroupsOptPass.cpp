@@ -0,0 +1,44 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/llvm-to-backend/KnownNumGroupsOptPass.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/KnownGroupSizeOptPass.hpp"
+
+
+namespace hipsycl {
+namespace compiler {
+
+KnownNumGroupsOptPass::KnownNumGroupsOptPass(long long NumGroupsX, long long NumGroupsY,
+                                             long long NumGroupsZ)
+    : KnownNumGroupsX{NumGroupsX}, KnownNumGroupsY{NumGroupsY}, KnownNumGroupsZ{NumGroupsZ} {}
+
+
+llvm::PreservedAnalyses KnownNumGroupsOptPass::run(llvm::Module &M,
+                                                   llvm::ModuleAnalysisManager &MAM) {
+  if (KnownNumGroupsX > 0) {
+    applyKnownBuiltinSize(M, KnownNumGroupsX, "__acpp_sscp_get_num_groups_x",
+                          "__acpp_sscp_get_group_id_x");
+  }
+
+  if (KnownNumGroupsY > 0) {
+    applyKnownBuiltinSize(M, KnownNumGroupsY, "__acpp_sscp_get_num_groups_y",
+                          "__acpp_sscp_get_group_id_y");
+  }
+
+  if (KnownNumGroupsZ > 0) {
+    applyKnownBuiltinSize(M, KnownNumGroupsZ, "__acpp_sscp_get_num_groups_z",
+                          "__acpp_sscp_get_group_id_z");
+  }
+
+  return llvm::PreservedAnalyses::none();
+}
+
+}
+}
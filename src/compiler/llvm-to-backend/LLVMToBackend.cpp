@@ -10,10 +10,13 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/AddressSpaceInferencePass.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/BranchProfilePass.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/DeadArgumentEliminationPass.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/GlobalSizesFitInI32OptPass.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/GlobalInliningAttributorPass.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/LoopControllingArgumentsPass.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/KnownGroupSizeOptPass.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/KnownNumGroupsOptPass.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/LLVMToBackend.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/Utils.hpp"
 #include "hipSYCL/compiler/sscp/IRConstantReplacer.hpp"
@@ -27,6 +30,7 @@
 
 #include <llvm/Transforms/IPO/AlwaysInliner.h>
 #include <llvm/ADT/APFloat.h>
+#include <llvm/Analysis/ValueTracking.h>
 #include <llvm/IR/Attributes.h>
 #include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/DiagnosticInfo.h>
@@ -39,9 +43,14 @@
 #include <llvm/Linker/Linker.h>
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Support/Error.h>
+#include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Transforms/IPO/AlwaysInliner.h>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace hipsycl {
 namespace compiler {
@@ -64,6 +73,28 @@ bool linkBitcode(llvm::Module &M, std::unique_ptr<llvm::Module> OtherM,
   return true;
 }
 
+// Bitcode libraries (e.g. libkernel, libdevice) are not modified during
+// the lifetime of the process, so they only need to be read from disk once.
+// Parsed modules cannot be cached since they are bound to the LLVMContext
+// of a particular JIT invocation.
+const llvm::MemoryBuffer *getBitcodeLibraryBuffer(const std::string &BitcodeFile) {
+  static std::mutex Mutex;
+  static std::unordered_map<std::string, std::unique_ptr<llvm::MemoryBuffer>> Buffers;
+
+  std::lock_guard<std::mutex> Lock{Mutex};
+  auto It = Buffers.find(BitcodeFile);
+  if (It != Buffers.end())
+    return It->second.get();
+
+  auto F = llvm::MemoryBuffer::getFile(BitcodeFile);
+  if (F.getError())
+    return nullptr;
+
+  const llvm::MemoryBuffer *Result = F.get().get();
+  Buffers[BitcodeFile] = std::move(F.get());
+  return Result;
+}
+
 void setFastMathFunctionAttribs(llvm::Module& M) {
   auto forceAttr = [&](llvm::Function& F, llvm::StringRef Key, llvm::StringRef Value) {
     if(F.hasFnAttribute(Key)) {
@@ -86,6 +117,80 @@ void setFastMathFunctionAttribs(llvm::Module& M) {
   }
 }
 
+// Whether all memory accessed by F is reached through pointers that are based
+// on arguments, allocas or global variables. Otherwise, F may access memory of
+// an argument through pointers that do not originate from the argument, such
+// as pointers loaded from memory.
+bool accessesMemoryOnlyThroughKnownPointers(llvm::Function &F) {
+  auto IsKnownPointer = [](const llvm::Value *Ptr) {
+    llvm::SmallVector<const llvm::Value *, 4> Objects;
+    llvm::getUnderlyingObjects(Ptr, Objects, nullptr, 0);
+    for(const llvm::Value *O : Objects)
+      if(!llvm::isa<llvm::Argument>(O) && !llvm::isa<llvm::AllocaInst>(O) &&
+         !llvm::isa<llvm::GlobalVariable>(O))
+        return false;
+    return true;
+  };
+
+  for(auto& BB : F) {
+    for(auto& I : BB) {
+      if(llvm::isa<llvm::IntToPtrInst>(I))
+        return false;
+      if(auto* LI = llvm::dyn_cast<llvm::LoadInst>(&I)) {
+        if(LI->getType()->isPtrOrPtrVectorTy() || LI->getType()->isAggregateType())
+          return false;
+      }
+
+      if(const llvm::Value* Ptr = llvm::getLoadStorePointerOperand(&I)) {
+        if(!IsKnownPointer(Ptr))
+          return false;
+      } else if(auto* RMW = llvm::dyn_cast<llvm::AtomicRMWInst>(&I)) {
+        if(!IsKnownPointer(RMW->getPointerOperand()))
+          return false;
+      } else if(auto* CX = llvm::dyn_cast<llvm::AtomicCmpXchgInst>(&I)) {
+        if(!IsKnownPointer(CX->getPointerOperand()))
+          return false;
+      } else if(auto* CB = llvm::dyn_cast<llvm::CallBase>(&I)) {
+        for(const auto& Arg : CB->args())
+          if(Arg->getType()->isPtrOrPtrVectorTy() && !IsKnownPointer(Arg))
+            return false;
+        // Builtins only access memory through their pointer arguments. Other
+        // callees might access memory through pointers of unknown origin.
+        llvm::Function* Callee = CB->getCalledFunction();
+        if(!Callee)
+          return false;
+        if (!Callee->isIntrinsic() && !Callee->onlyAccessesArgMemory() &&
+            !Callee->doesNotAccessMemory() &&
+            !(Callee->isDeclaration() &&
+              llvmutils::starts_with(Callee->getName(), "__acpp_sscp_")))
+          return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Marks the arguments of F with the provided indices noalias, unless
+// F might access their memory through other pointers.
+void addNoAliasAttributes(llvm::Function &F, const std::vector<int> &ArgIndices) {
+  if(!accessesMemoryOnlyThroughKnownPointers(F)) {
+    HIPSYCL_DEBUG_INFO << "LLVMToBackend: Not marking arguments of " << F.getName()
+                       << " as noalias, since it accesses memory through pointers "
+                          "that do not originate from its arguments\n";
+    return;
+  }
+
+  for(int Index : ArgIndices) {
+    if(Index < 0 || static_cast<unsigned>(Index) >= F.arg_size())
+      continue;
+    llvm::Argument* A = F.getArg(Index);
+    if(A->getType()->isPointerTy() && !A->hasByValAttr()) {
+      HIPSYCL_DEBUG_INFO << "LLVMToBackend: Marking argument " << Index << " of "
+                         << F.getName() << " as noalias\n";
+      A->addAttr(llvm::Attribute::NoAlias);
+    }
+  }
+}
 
 class InstructionCleanupPass : public llvm::PassInfoMixin<InstructionCleanupPass> {
 public:
@@ -135,6 +240,12 @@ bool LLVMToBackendTranslator::setBuildFlag(const std::string &Flag) {
   } else if(Flag == "fast-math") {
     IsFastMath = true;
     return true;
+  } else if(Flag == "baseline-optimization") {
+    IsBaselineOptimization = true;
+    return true;
+  } else if(Flag == "pgo-instrumentation") {
+    IsProfileInstrumentation = true;
+    return true;
   }
 
   return applyBuildFlag(Flag);
@@ -152,8 +263,41 @@ bool LLVMToBackendTranslator::setBuildOption(const std::string &Option, const st
   } else if (Option == "known-group-size-z") {
     KnownGroupSizeZ = std::stoi(Value);
     return true;
+  } else if (Option == "known-num-groups-x") {
+    KnownNumGroupsX = std::stoll(Value);
+    return true;
+  } else if (Option == "known-num-groups-y") {
+    KnownNumGroupsY = std::stoll(Value);
+    return true;
+  } else if (Option == "known-num-groups-z") {
+    KnownNumGroupsZ = std::stoll(Value);
+    return true;
   } else if (Option == "known-local-mem-size") {
     KnownLocalMemSize = std::stoi(Value);
+  } else if (Option == "pgo-branch-profile") {
+    // Comma-separated list of branch counters
+    BranchProfile.clear();
+    std::size_t Pos = 0;
+    while(Pos < Value.size()) {
+      std::size_t End = Value.find(',', Pos);
+      if(End == std::string::npos)
+        End = Value.size();
+      BranchProfile.push_back(std::stoull(Value.substr(Pos, End - Pos)));
+      Pos = End + 1;
+    }
+    return true;
+  } else if (Option == "noalias-pointer-arguments") {
+    // Comma-separated list of argument indices
+    NoAliasPointerArguments.clear();
+    std::size_t Pos = 0;
+    while(Pos < Value.size()) {
+      std::size_t End = Value.find(',', Pos);
+      if(End == std::string::npos)
+        End = Value.size();
+      NoAliasPointerArguments.push_back(std::stoi(Value.substr(Pos, End - Pos)));
+      Pos = End + 1;
+    }
+    return true;
   }
 
   return applyBuildOption(Option, Value);
@@ -271,7 +415,9 @@ bool LLVMToBackendTranslator::prepareIR(llvm::Module &M) {
     KnownGroupSizeOptPass GroupSizeOptPass{KnownGroupSizeX, KnownGroupSizeY, KnownGroupSizeZ};
     GlobalSizesFitInI32OptPass SizesAsIntOptPass{GlobalSizesFitInInt, KnownGroupSizeX,
                                                  KnownGroupSizeY, KnownGroupSizeZ};
+    KnownNumGroupsOptPass NumGroupsOptPass{KnownNumGroupsX, KnownNumGroupsY, KnownNumGroupsZ};
     GroupSizeOptPass.run(M, MAM);
+    NumGroupsOptPass.run(M, MAM);
     SizesAsIntOptPass.run(M, MAM);
 
     // Before optimizing, make sure everything has internal linkage to
@@ -290,6 +436,23 @@ bool LLVMToBackendTranslator::prepareIR(llvm::Module &M) {
     InstructionCleanupPass ICP;
     ICP.run(M, MAM);
 
+    // This must happen before flavoring, since backends may wrap kernels. When
+    // the kernel is inlined into the wrapper, the attributes are preserved
+    // as alias scope metadata.
+    if(!NoAliasPointerArguments.empty()) {
+      for(const auto& KernelName : Kernels) {
+        if(auto* F = M.getFunction(KernelName))
+          addNoAliasAttributes(*F, NoAliasPointerArguments);
+      }
+    }
+
+    // Kernel arguments are still visible in their original form before flavoring,
+    // and loops are not yet transformed.
+    for(const auto& Entry : KernelsForLoopControllingArgumentAnalysis) {
+      LoopControllingArgumentsPass LCA{Entry.first, *Entry.second};
+      LCA.run(M, MAM);
+    }
+
     HIPSYCL_DEBUG_INFO << "LLVMToBackend: Adding backend-specific flavor to IR...\n";
     if(!this->toBackendFlavor(M, PH)) {
       HIPSYCL_DEBUG_INFO << "LLVMToBackend: Flavoring failed\n";
@@ -310,6 +473,15 @@ bool LLVMToBackendTranslator::prepareIR(llvm::Module &M) {
     utils::ProcessFunctionAnnotationPass PFA({"argument_used"});
     PFA.run(M, MAM);
 
+    if(IsProfileInstrumentation) {
+      BranchProfileInstrumentationPass BPI{
+          getAddressSpaceMap()[AddressSpace::GlobalVariableDefault]};
+      BPI.run(M, MAM);
+    } else if(!BranchProfile.empty()) {
+      BranchProfileApplicationPass BPA{BranchProfile};
+      BPA.run(M, MAM);
+    }
+
     MAM.clear(); 
 
     if(!optimizeFlavoredIR(M, PH)) {
@@ -374,8 +546,11 @@ bool LLVMToBackendTranslator::optimizeFlavoredIR(llvm::Module& M, PassHandler& P
       });
 #endif
 
-  llvm::ModulePassManager MPM =
-      PH.PassBuilder->buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3);
+  // Baseline (tier 0) kernels only run a lightweight pipeline to minimize
+  // JIT latency; the fully optimized variant is compiled later.
+  llvm::OptimizationLevel OptLevel = IsBaselineOptimization ? llvm::OptimizationLevel::O1
+                                                            : llvm::OptimizationLevel::O3;
+  llvm::ModulePassManager MPM = PH.PassBuilder->buildPerModuleDefaultPipeline(OptLevel);
   MPM.run(M, *PH.ModuleAnalysisManager);
 
   return true;
@@ -385,10 +560,34 @@ bool LLVMToBackendTranslator::linkBitcodeString(llvm::Module &M, const std::stri
                                                 const std::string &ForcedTriple,
                                                 const std::string &ForcedDataLayout,
                                                 bool LinkOnlyNeeded) {
-  std::unique_ptr<llvm::Module> OtherModule;
-  auto err = loadModuleFromString(Bitcode, M.getContext(), OtherModule);
+  return linkBitcodeBuffer(M, llvm::MemoryBufferRef{Bitcode, ""}, ForcedTriple, ForcedDataLayout,
+                           LinkOnlyNeeded);
+}
 
-  if (err) {
+bool LLVMToBackendTranslator::linkBitcodeFile(llvm::Module &M, const std::string &BitcodeFile,
+                                              const std::string &ForcedTriple,
+                                              const std::string &ForcedDataLayout,
+                                              bool LinkOnlyNeeded) {
+  const llvm::MemoryBuffer *Buffer = getBitcodeLibraryBuffer(BitcodeFile);
+  if(!Buffer) {
+    this->registerError("LLVMToBackend: Could not open file " + BitcodeFile);
+    return false;
+  }
+  HIPSYCL_DEBUG_INFO << "LLVMToBackend: Linking with bitcode file: " << BitcodeFile << "\n";
+  return linkBitcodeBuffer(M, Buffer->getMemBufferRef(), ForcedTriple, ForcedDataLayout,
+                           LinkOnlyNeeded);
+}
+
+bool LLVMToBackendTranslator::linkBitcodeBuffer(llvm::Module &M, llvm::MemoryBufferRef Bitcode,
+                                                const std::string &ForcedTriple,
+                                                const std::string &ForcedDataLayout,
+                                                bool LinkOnlyNeeded) {
+  // Load lazily: Function bodies are only materialized when the linker
+  // actually pulls them into M, so linking cost scales with the number of
+  // used symbols instead of the size of the library.
+  auto OtherModule = llvm::getLazyBitcodeModule(Bitcode, M.getContext());
+
+  if (auto err = OtherModule.takeError()) {
     this->registerError("LLVMToBackend: Could not load LLVM module");
     llvm::handleAllErrors(std::move(err), [&](llvm::ErrorInfoBase &EIB) {
       this->registerError(EIB.message());
@@ -400,7 +599,7 @@ bool LLVMToBackendTranslator::linkBitcodeString(llvm::Module &M, const std::stri
   if(LinkOnlyNeeded)
     F = llvm::Linker::LinkOnlyNeeded;
 
-  if(!linkBitcode(M, std::move(OtherModule), ForcedTriple, ForcedDataLayout, F)) {
+  if(!linkBitcode(M, std::move(OtherModule.get()), ForcedTriple, ForcedDataLayout, F)) {
     this->registerError("LLVMToBackend: Linking module failed");
     return false;
   }
@@ -408,20 +607,6 @@ bool LLVMToBackendTranslator::linkBitcodeString(llvm::Module &M, const std::stri
   return true;
 }
 
-bool LLVMToBackendTranslator::linkBitcodeFile(llvm::Module &M, const std::string &BitcodeFile,
-                                              const std::string &ForcedTriple,
-                                              const std::string &ForcedDataLayout,
-                                              bool LinkOnlyNeeded) {
-  auto F = llvm::MemoryBuffer::getFile(BitcodeFile);
-  if(auto Err = F.getError()) {
-    this->registerError("LLVMToBackend: Could not open file " + BitcodeFile);
-    return false;
-  }
-  HIPSYCL_DEBUG_INFO << "LLVMToBackend: Linking with bitcode file: " << BitcodeFile << "\n";
-  return linkBitcodeString(M, std::string{F.get()->getBuffer()}, ForcedTriple, ForcedDataLayout,
-                           LinkOnlyNeeded);
-}
-
 void LLVMToBackendTranslator::setS2IRConstant(const std::string &name, const void *ValueBuffer) {
   SpecializationApplicators[name] = [=](llvm::Module& M){
     S2IRConstant C = S2IRConstant::getFromConstantName(M, name);
@@ -650,6 +835,12 @@ LLVMToBackendTranslator::getDeadArgumentEliminationConfig() const {
   return FunctionsForDeadArgumentElimination;
 }
 
+void LLVMToBackendTranslator::enableLoopControllingArgumentAnalysis(
+    const std::string &KernelName, std::vector<int> *LoopControllingArgumentIndices) {
+  this->KernelsForLoopControllingArgumentAnalysis.push_back(
+      std::make_pair(KernelName, LoopControllingArgumentIndices));
+}
+
 void LLVMToBackendTranslator::setFailedIR(llvm::Module& M) {
   llvm::raw_string_ostream Stream{ErroringCode};
   llvm::WriteBitcodeToFile(M, Stream);
@@ -0,0 +1,214 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/llvm-to-backend/LoopControllingArgumentsPass.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/Analysis/ValueTracking.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/Module.h>
+
+#include <optional>
+#include <utility>
+
+namespace hipsycl {
+namespace compiler {
+
+namespace {
+
+// Bounds the work per argument for very large kernels
+constexpr std::size_t MaxTrackedValues = 512;
+
+// Follows the data flow of a kernel argument through arithmetic, comparisons
+// and private memory. This runs before the optimization pipeline, so values
+// are typically still passed through allocas, e.g. of the kernel lambda.
+class ArgumentFlowTracker {
+public:
+  ArgumentFlowTracker(llvm::Function &F, llvm::LoopInfo &LI)
+      : LI{LI}, DL{F.getParent()->getDataLayout()} {
+    for(auto& BB : F) {
+      for(auto& I : BB) {
+        if(auto* Load = llvm::dyn_cast<llvm::LoadInst>(&I))
+          Loads.push_back(Load);
+        else if(auto* Transfer = llvm::dyn_cast<llvm::MemTransferInst>(&I))
+          Transfers.push_back(Transfer);
+      }
+    }
+  }
+
+  bool controlsLoop(llvm::Argument *A) {
+    Worklist.clear();
+    Visited.clear();
+    Locations.clear();
+
+    addValue(A);
+    while(!Worklist.empty()) {
+      llvm::Value* V = Worklist.pop_back_val();
+
+      for(llvm::User* U : V->users()) {
+        auto* I = llvm::dyn_cast<llvm::Instruction>(U);
+        if(!I)
+          continue;
+
+        if(auto* Store = llvm::dyn_cast<llvm::StoreInst>(I)) {
+          if(Store->getValueOperand() == V)
+            addLocation(Store->getPointerOperand());
+        } else if(auto* Branch = llvm::dyn_cast<llvm::BranchInst>(I)) {
+          if(isLoopExiting(Branch))
+            return true;
+        } else if(auto* BinOp = llvm::dyn_cast<llvm::BinaryOperator>(I)) {
+          if(isStride(BinOp))
+            return true;
+          addValue(BinOp);
+        } else if (llvm::isa<llvm::CastInst>(I) || llvm::isa<llvm::CmpInst>(I) ||
+                   llvm::isa<llvm::SelectInst>(I) || llvm::isa<llvm::PHINode>(I)) {
+          addValue(I);
+        }
+      }
+    }
+    return false;
+  }
+
+private:
+  using MemoryLocation = std::pair<llvm::Value*, int64_t>;
+
+  void addValue(llvm::Value* V) {
+    if(Visited.size() < MaxTrackedValues && Visited.insert(V).second)
+      Worklist.push_back(V);
+  }
+
+  // Returns the alloca and the constant byte offset of a pointer into
+  // private memory.
+  std::optional<MemoryLocation> getPrivateLocation(llvm::Value* Ptr) const {
+    int64_t Offset = 0;
+    llvm::Value *Base = llvm::GetPointerBaseWithConstantOffset(Ptr, Offset, DL);
+    if(!llvm::isa<llvm::AllocaInst>(Base))
+      return {};
+    return std::make_pair(Base, Offset);
+  }
+
+  void addLocation(llvm::Value* Ptr) {
+    if(auto Location = getPrivateLocation(Ptr))
+      addLocation(*Location);
+  }
+
+  void addLocation(const MemoryLocation& Location) {
+    for(const auto& L : Locations)
+      if(L == Location)
+        return;
+    Locations.push_back(Location);
+
+    for(auto* Load : Loads) {
+      if(getPrivateLocation(Load->getPointerOperand()) == Location)
+        addValue(Load);
+    }
+    // Follow copies of the containing object, e.g. of the kernel lambda
+    for(auto* Transfer : Transfers) {
+      auto Source = getPrivateLocation(Transfer->getRawSource());
+      auto Dest = getPrivateLocation(Transfer->getRawDest());
+      auto* Length = llvm::dyn_cast<llvm::ConstantInt>(Transfer->getLength());
+      if(!Source || !Dest || !Length || Source->first != Location.first)
+        continue;
+      int64_t RelativeOffset = Location.second - Source->second;
+      if(RelativeOffset >= 0 && RelativeOffset < Length->getSExtValue())
+        addLocation(std::make_pair(Dest->first, Dest->second + RelativeOffset));
+    }
+  }
+
+  bool isLoopExiting(llvm::BranchInst* Branch) const {
+    if(!Branch->isConditional())
+      return false;
+    llvm::Loop* L = LI.getLoopFor(Branch->getParent());
+    return L && L->isLoopExiting(Branch->getParent());
+  }
+
+  // Whether the argument is used as scaling factor inside a loop, or as
+  // increment of a loop-carried value.
+  bool isStride(llvm::BinaryOperator* BinOp) const {
+    llvm::Loop* L = LI.getLoopFor(BinOp->getParent());
+    if(!L)
+      return false;
+
+    auto Opcode = BinOp->getOpcode();
+    if(Opcode == llvm::Instruction::Mul || Opcode == llvm::Instruction::Shl)
+      return true;
+    if(Opcode != llvm::Instruction::Add && Opcode != llvm::Instruction::Sub)
+      return false;
+
+    for(llvm::User* U : BinOp->users()) {
+      if(auto* Phi = llvm::dyn_cast<llvm::PHINode>(U)) {
+        if(Phi->getParent() == L->getHeader())
+          return true;
+      } else if(auto* Store = llvm::dyn_cast<llvm::StoreInst>(U)) {
+        auto Location = getPrivateLocation(Store->getPointerOperand());
+        if(!Location)
+          continue;
+        for(auto* Load : Loads) {
+          if (L->contains(Load) &&
+              getPrivateLocation(Load->getPointerOperand()) == Location)
+            return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  llvm::LoopInfo& LI;
+  const llvm::DataLayout& DL;
+  llvm::SmallVector<llvm::LoadInst*, 32> Loads;
+  llvm::SmallVector<llvm::MemTransferInst*, 8> Transfers;
+
+  llvm::SmallVector<llvm::Value*, 32> Worklist;
+  llvm::SmallPtrSet<llvm::Value*, 32> Visited;
+  llvm::SmallVector<MemoryLocation, 8> Locations;
+};
+
+}
+
+LoopControllingArgumentsPass::LoopControllingArgumentsPass(
+    const std::string &Kernel, std::vector<int> &ArgumentIndicesOut)
+    : KernelName{Kernel}, ArgumentIndices{ArgumentIndicesOut} {}
+
+llvm::PreservedAnalyses
+LoopControllingArgumentsPass::run(llvm::Module &M,
+                                  llvm::ModuleAnalysisManager &MAM) {
+  ArgumentIndices.clear();
+
+  llvm::Function* F = M.getFunction(KernelName);
+  if(!F || F->isDeclaration())
+    return llvm::PreservedAnalyses::all();
+
+  llvm::DominatorTree DT{*F};
+  llvm::LoopInfo LI{DT};
+  if(LI.empty())
+    return llvm::PreservedAnalyses::all();
+
+  ArgumentFlowTracker Tracker{*F, LI};
+  for(unsigned i = 0; i < F->arg_size(); ++i) {
+    llvm::Argument* A = F->getArg(i);
+    if(A->getType()->isIntegerTy() && A->getType()->getIntegerBitWidth() <= 64 &&
+       Tracker.controlsLoop(A)) {
+      HIPSYCL_DEBUG_INFO << "LoopControllingArgumentsPass: Argument " << i << " of kernel "
+                         << KernelName << " controls loops\n";
+      ArgumentIndices.push_back(static_cast<int>(i));
+    }
+  }
+
+  return llvm::PreservedAnalyses::all();
+}
+
+}
+}
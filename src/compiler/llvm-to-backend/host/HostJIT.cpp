@@ -0,0 +1,175 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/llvm-to-backend/host/LLVMToHostFactory.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <llvm/BinaryFormat/Magic.h>
+#include <llvm/Object/Archive.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace hipsycl {
+namespace compiler {
+
+namespace {
+
+/// Process-wide ORC JIT session into which host kernel objects are linked.
+/// Each object is placed into its own JITDylib, such that different
+/// configurations of the same kernel can coexist despite having the same
+/// symbol names.
+class HostJIT {
+public:
+  static HostJIT &get() {
+    // Intentionally never destroyed: Code objects referencing the JIT
+    // may be released during static destruction.
+    static HostJIT *JIT = new HostJIT{};
+    return *JIT;
+  }
+
+  void *load(const std::string &Object, std::string &ErrorOut) {
+    std::lock_guard<std::mutex> Lock{Mutex};
+    if (!JIT) {
+      ErrorOut = InitError;
+      return nullptr;
+    }
+
+    auto &ES = JIT->getExecutionSession();
+    auto JD = ES.createJITDylib("acpp-host-object-" + std::to_string(NextId++));
+    if (auto Err = JD.takeError()) {
+      ErrorOut = llvm::toString(std::move(Err));
+      return nullptr;
+    }
+
+    // Kernels may call into libc, libm and the AdaptiveCpp runtime
+    auto ProcessSymbols = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+        JIT->getDataLayout().getGlobalPrefix());
+    if (auto Err = ProcessSymbols.takeError()) {
+      ErrorOut = llvm::toString(std::move(Err));
+      llvm::consumeError(ES.removeJITDylib(*JD));
+      return nullptr;
+    }
+    JD->addGenerator(std::move(*ProcessSymbols));
+
+    if (auto Err = addObjects(*JD, Object)) {
+      ErrorOut = llvm::toString(std::move(Err));
+      llvm::consumeError(ES.removeJITDylib(*JD));
+      return nullptr;
+    }
+    return &(*JD);
+  }
+
+  void *lookup(void *Handle, const std::string &SymbolName) {
+    std::lock_guard<std::mutex> Lock{Mutex};
+    if (!JIT || !Handle)
+      return nullptr;
+
+    auto Symbol = JIT->lookup(*static_cast<llvm::orc::JITDylib *>(Handle), SymbolName);
+    if (auto Err = Symbol.takeError()) {
+      HIPSYCL_DEBUG_ERROR << "HostJIT: Could not look up symbol " << SymbolName << ": "
+                          << llvm::toString(std::move(Err)) << "\n";
+      return nullptr;
+    }
+#if LLVM_VERSION_MAJOR < 15
+    return reinterpret_cast<void *>(static_cast<uintptr_t>(Symbol->getAddress()));
+#else
+    return Symbol->toPtr<void *>();
+#endif
+  }
+
+  void unload(void *Handle) {
+    std::lock_guard<std::mutex> Lock{Mutex};
+    if (!JIT || !Handle)
+      return;
+    if (auto Err =
+            JIT->getExecutionSession().removeJITDylib(*static_cast<llvm::orc::JITDylib *>(Handle))) {
+      HIPSYCL_DEBUG_WARNING << "HostJIT: Could not unload object: "
+                            << llvm::toString(std::move(Err)) << "\n";
+    }
+  }
+
+private:
+  // Adds a single object, or all members of an archive of objects
+  // as generated for partitioned images.
+  llvm::Error addObjects(llvm::orc::JITDylib &JD, const std::string &Binary) {
+    llvm::MemoryBufferRef BinaryRef{Binary, JD.getName()};
+    if (llvm::identify_magic(Binary) != llvm::file_magic::archive)
+      return JIT->addObjectFile(JD, llvm::MemoryBuffer::getMemBufferCopy(Binary, JD.getName()));
+
+    auto Archive = llvm::object::Archive::create(BinaryRef);
+    if (!Archive)
+      return Archive.takeError();
+
+    llvm::Error Err = llvm::Error::success();
+    for (const auto &Child : (*Archive)->children(Err)) {
+      auto Member = Child.getMemoryBufferRef();
+      if (!Member) {
+        llvm::consumeError(std::move(Err));
+        return Member.takeError();
+      }
+      if (auto AddErr = JIT->addObjectFile(JD, llvm::MemoryBuffer::getMemBufferCopy(
+                                                   Member->getBuffer(), Member->getBufferIdentifier()))) {
+        llvm::consumeError(std::move(Err));
+        return AddErr;
+      }
+    }
+    return Err;
+  }
+
+  HostJIT() {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+
+    auto J = llvm::orc::LLJITBuilder().create();
+    if (auto Err = J.takeError())
+      InitError = "HostJIT: Could not create JIT session: " + llvm::toString(std::move(Err));
+    else
+      JIT = std::move(*J);
+  }
+
+  std::mutex Mutex;
+  std::unique_ptr<llvm::orc::LLJIT> JIT;
+  std::string InitError;
+  std::size_t NextId = 0;
+};
+
+} // namespace
+
+bool isRelocatableHostObject(const std::string &Binary) {
+  switch (llvm::identify_magic(Binary)) {
+  case llvm::file_magic::elf_relocatable:
+  case llvm::file_magic::macho_object:
+  case llvm::file_magic::coff_object:
+  case llvm::file_magic::archive:
+    return true;
+  default:
+    return false;
+  }
+}
+
+void *loadHostObject(const std::string &Object, std::string &ErrorOut) {
+  return HostJIT::get().load(Object, ErrorOut);
+}
+
+void *getHostObjectSymbol(void *Handle, const std::string &SymbolName) {
+  return HostJIT::get().lookup(Handle, SymbolName);
+}
+
+void unloadHostObject(void *Handle) { HostJIT::get().unload(Handle); }
+
+} // namespace compiler
+} // namespace hipsycl
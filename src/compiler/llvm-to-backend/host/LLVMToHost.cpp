@@ -21,6 +21,7 @@
 #include "hipSYCL/compiler/llvm-to-backend/AddressSpaceMap.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/Utils.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/host/HostKernelWrapperPass.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/host/LLVMToHostFactory.hpp"
 #include "hipSYCL/compiler/sscp/IRConstantReplacer.hpp"
 #include "hipSYCL/glue/llvm-sscp/s2_ir_constants.hpp"
 
@@ -31,6 +32,7 @@
 #include <llvm/IR/DataLayout.h>
 #include <llvm/IR/DebugInfo.h>
 #include <llvm/IR/GlobalValue.h>
+#include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Metadata.h>
 #include <llvm/IR/Module.h>
@@ -39,7 +41,13 @@
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Program.h>
+#include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/Utils/SplitModule.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Object/ArchiveWriter.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Target/TargetOptions.h>
 #if LLVM_VERSION_MAJOR < 16
 #include <llvm/ADT/Triple.h>
 #include <llvm/Support/Host.h>
@@ -47,12 +55,20 @@
 #include <llvm/TargetParser/Host.h>
 #include <llvm/TargetParser/Triple.h>
 #endif
+#if LLVM_VERSION_MAJOR < 17
+#include <llvm/MC/SubtargetFeature.h>
+#else
+#include <llvm/TargetParser/SubtargetFeature.h>
+#endif
 
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <system_error>
+#include <thread>
 #include <vector>
 
 namespace hipsycl {
@@ -110,6 +126,166 @@ bool LLVMToHostTranslator::toBackendFlavor(llvm::Module &M, PassHandler &PH) {
 
 bool LLVMToHostTranslator::translateToBackendFormat(llvm::Module &FlavoredModule,
                                                     std::string &out) {
+  if (emitObjectInProcess(FlavoredModule, out))
+    return true;
+
+  HIPSYCL_DEBUG_WARNING << "LLVMToHost: In-process code generation failed, falling back to "
+                           "external clang invocation\n";
+  return emitSharedLibraryWithClang(FlavoredModule, out);
+}
+
+namespace {
+
+// Runs the optimization pipeline for the target of TM (this can take target
+// information into account, e.g. for vectorization) and generates an object file.
+bool optimizeAndEmitObject(llvm::Module &M, llvm::TargetMachine &TM, bool IsBaselineOptimization,
+                           std::string &out) {
+  {
+    llvm::LoopAnalysisManager LAM;
+    llvm::FunctionAnalysisManager FAM;
+    llvm::CGSCCAnalysisManager CGAM;
+    llvm::ModuleAnalysisManager MAM;
+    llvm::PassBuilder PB{&TM};
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+    llvm::ModulePassManager MPM = PB.buildPerModuleDefaultPipeline(
+        IsBaselineOptimization ? llvm::OptimizationLevel::O1 : llvm::OptimizationLevel::O3);
+    MPM.run(M, MAM);
+  }
+
+  llvm::SmallVector<char, 0> ObjectBuffer;
+  llvm::raw_svector_ostream ObjectStream{ObjectBuffer};
+  llvm::legacy::PassManager CodegenPM;
+  if (TM.addPassesToEmitFile(CodegenPM, ObjectStream, nullptr,
+#if LLVM_VERSION_MAJOR < 18
+                             llvm::CGFT_ObjectFile)) {
+#else
+                             llvm::CodeGenFileType::ObjectFile)) {
+#endif
+    HIPSYCL_DEBUG_WARNING << "LLVMToHost: Target does not support object file emission\n";
+    return false;
+  }
+  CodegenPM.run(M);
+
+  out.assign(ObjectBuffer.begin(), ObjectBuffer.end());
+  return true;
+}
+
+} // namespace
+
+bool LLVMToHostTranslator::emitObjectInProcess(llvm::Module &FlavoredModule, std::string &out) {
+  static std::once_flag TargetInitialized;
+  std::call_once(TargetInitialized, []() {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+  });
+
+  const std::string Triple = llvm::sys::getProcessTriple();
+  std::string Error;
+  const llvm::Target *Target = llvm::TargetRegistry::lookupTarget(Triple, Error);
+  if (!Target) {
+    HIPSYCL_DEBUG_WARNING << "LLVMToHost: Could not find host target: " << Error << "\n";
+    return false;
+  }
+
+  const std::string CPU = TargetCPU.empty() ? getHostTargetCPU() : TargetCPU;
+  const std::string Features = TargetFeatures.empty() ? getHostTargetFeatures() : TargetFeatures;
+
+  auto createTargetMachine = [&]() {
+    return std::unique_ptr<llvm::TargetMachine>{Target->createTargetMachine(
+        Triple, CPU, Features, llvm::TargetOptions{}, llvm::Reloc::PIC_, {},
+#if LLVM_VERSION_MAJOR < 18
+        IsBaselineOptimization ? llvm::CodeGenOpt::Less : llvm::CodeGenOpt::Aggressive)};
+#else
+        IsBaselineOptimization ? llvm::CodeGenOptLevel::Less : llvm::CodeGenOptLevel::Aggressive)};
+#endif
+  };
+
+  std::unique_ptr<llvm::TargetMachine> TM = createTargetMachine();
+  if (!TM) {
+    HIPSYCL_DEBUG_WARNING << "LLVMToHost: Could not create target machine\n";
+    return false;
+  }
+
+  FlavoredModule.setTargetTriple(Triple);
+  FlavoredModule.setDataLayout(TM->createDataLayout());
+
+  const unsigned NumPartitions = std::min(
+      static_cast<unsigned>(KernelNames.size()), std::max(1u, std::thread::hardware_concurrency()));
+  if (NumPartitions <= 1)
+    return optimizeAndEmitObject(FlavoredModule, *TM, IsBaselineOptimization, out);
+
+  // Images with many kernels: Split the module and optimize and generate code
+  // for the partitions concurrently. Partitions are serialized, since each thread
+  // needs its own LLVMContext.
+  std::vector<std::string> PartitionBitcode;
+  llvm::SplitModule(FlavoredModule, NumPartitions, [&](std::unique_ptr<llvm::Module> Partition) {
+    std::string Bitcode;
+    llvm::raw_string_ostream BitcodeStream{Bitcode};
+    llvm::WriteBitcodeToFile(*Partition, BitcodeStream);
+    BitcodeStream.flush();
+    PartitionBitcode.push_back(std::move(Bitcode));
+  });
+
+  HIPSYCL_DEBUG_INFO << "LLVMToHost: Generating code for " << KernelNames.size()
+                     << " kernels in " << PartitionBitcode.size() << " parallel partitions\n";
+
+  std::vector<std::string> PartitionObjects(PartitionBitcode.size());
+  std::vector<std::string> PartitionErrors(PartitionBitcode.size());
+  std::vector<std::thread> Workers;
+  for (std::size_t i = 0; i < PartitionBitcode.size(); ++i) {
+    Workers.emplace_back([&, i]() {
+      llvm::LLVMContext Ctx;
+      std::unique_ptr<llvm::Module> Partition;
+      if (auto Err = loadModuleFromString(PartitionBitcode[i], Ctx, Partition)) {
+        PartitionErrors[i] = llvm::toString(std::move(Err));
+        return;
+      }
+      std::unique_ptr<llvm::TargetMachine> PartitionTM = createTargetMachine();
+      if (!PartitionTM ||
+          !optimizeAndEmitObject(*Partition, *PartitionTM, IsBaselineOptimization,
+                                 PartitionObjects[i]))
+        PartitionErrors[i] = "code generation failed";
+    });
+  }
+  for (auto &W : Workers)
+    W.join();
+
+  std::vector<llvm::NewArchiveMember> Members;
+  for (std::size_t i = 0; i < PartitionObjects.size(); ++i) {
+    if (!PartitionErrors[i].empty()) {
+      HIPSYCL_DEBUG_WARNING << "LLVMToHost: Could not compile partition " << i << ": "
+                            << PartitionErrors[i] << "\n";
+      return false;
+    }
+    Members.emplace_back(llvm::MemoryBufferRef{PartitionObjects[i],
+                                               "partition" + std::to_string(i) + ".o"});
+  }
+
+  // The partitions are bundled into an archive, whose members are all linked
+  // by the JIT.
+  auto Archive = llvm::writeArchiveToBuffer(Members,
+#if LLVM_VERSION_MAJOR < 18
+                                            false,
+#else
+                                            llvm::SymtabWritingMode::NoSymtab,
+#endif
+                                            llvm::object::Archive::K_GNU, true, false);
+  if (auto Err = Archive.takeError()) {
+    HIPSYCL_DEBUG_WARNING << "LLVMToHost: Could not create archive of partitions: "
+                          << llvm::toString(std::move(Err)) << "\n";
+    return false;
+  }
+  out = (*Archive)->getBuffer().str();
+  return true;
+}
+
+bool LLVMToHostTranslator::emitSharedLibraryWithClang(llvm::Module &FlavoredModule,
+                                                      std::string &out) {
   auto InputFile = llvm::sys::fs::TempFile::create("acpp-sscp-host-%%%%%%.bc");
   auto OutputFile = llvm::sys::fs::TempFile::create("acpp-sscp-host-%%%%%%.so");
 
@@ -141,10 +317,16 @@ bool LLVMToHostTranslator::translateToBackendFormat(llvm::Module &FlavoredModule
   InputStream.flush();
 
   const std::string ClangPath = HIPSYCL_CLANG_PATH;
-  const std::string CpuFlag = HIPSYCL_HOST_CPU_FLAG;
+  std::string CpuFlag = HIPSYCL_HOST_CPU_FLAG;
+  // Replace e.g. -march=native by the requested CPU, which may differ from
+  // the one that was targeted when AdaptiveCpp was built.
+  const std::string NativeSuffix = "=native";
+  if (!TargetCPU.empty() && CpuFlag.size() > NativeSuffix.size() &&
+      CpuFlag.compare(CpuFlag.size() - NativeSuffix.size(), NativeSuffix.size(), NativeSuffix) == 0)
+    CpuFlag = CpuFlag.substr(0, CpuFlag.size() - NativeSuffix.size() + 1) + TargetCPU;
 
   llvm::SmallVector<llvm::StringRef, 16> Invocation{ClangPath,
-                                                    "-O3",
+                                                    IsBaselineOptimization ? "-O1" : "-O3",
                                                     CpuFlag,
                                                     "-x",
                                                     "ir",
@@ -182,6 +364,16 @@ bool LLVMToHostTranslator::translateToBackendFormat(llvm::Module &FlavoredModule
 }
 
 bool LLVMToHostTranslator::applyBuildOption(const std::string &Option, const std::string &Value) {
+  if (Option == "host-target-cpu") {
+    TargetCPU = Value;
+    return true;
+  } else if (Option == "host-target-features") {
+    TargetFeatures = Value;
+    return true;
+  } else if (Option == "host-target-id") {
+    // Only distinguishes binaries for different CPUs
+    return true;
+  }
   return false;
 }
 
@@ -212,6 +404,27 @@ createLLVMToHostTranslator(const std::vector<std::string> &KernelNames) {
   return std::make_unique<LLVMToHostTranslator>(KernelNames);
 }
 
+std::string getHostTargetCPU() { return llvm::sys::getHostCPUName().str(); }
+
+std::string getHostTargetFeatures() {
+#if LLVM_VERSION_MAJOR < 19
+  llvm::StringMap<bool> HostFeatures;
+  llvm::sys::getHostCPUFeatures(HostFeatures);
+#else
+  llvm::StringMap<bool> HostFeatures = llvm::sys::getHostCPUFeatures();
+#endif
+  // Sort, since the result contributes to kernel configuration ids
+  std::vector<std::string> SortedFeatures;
+  for (const auto &Feature : HostFeatures)
+    SortedFeatures.push_back(Feature.first().str());
+  std::sort(SortedFeatures.begin(), SortedFeatures.end());
+
+  llvm::SubtargetFeatures Features;
+  for (const auto &Feature : SortedFeatures)
+    Features.AddFeature(Feature, HostFeatures.lookup(Feature));
+  return Features.getString();
+}
+
 void LLVMToHostTranslator::migrateKernelProperties(llvm::Function *From, llvm::Function *To) {
   assert(false && "migrateKernelProperties is unsupport for LLVMToHost");
 }
@@ -15,8 +15,14 @@
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
 #include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/allocator.hpp"
+#include "hipSYCL/common/small_vector.hpp"
 #include "hipSYCL/common/filesystem.hpp"
+#include <algorithm>
+#include <cstring>
 #include <limits>
+#include <mutex>
+#include <unordered_map>
 
 
 namespace hipsycl {
@@ -33,6 +39,44 @@ void access_appdb(common::db::appdb& db, bool needs_write_access, F&& handler) {
   }
 }
 
+// Once training has finished, the branch profile of a binary does not change
+// anymore. The profile and the id of the resulting binary are then kept in
+// memory, such that subsequent launches neither lock the appdb nor rebuild
+// and rehash the profile.
+class finished_pgo_profiles {
+public:
+  struct entry {
+    std::string profile;
+    kernel_configuration::id_type binary_id;
+  };
+
+  static finished_pgo_profiles& get() {
+    static finished_pgo_profiles profiles;
+    return profiles;
+  }
+
+  // Entries are never removed, so the result remains valid.
+  const entry *find(const kernel_configuration::id_type &training_id) const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto it = _entries.find(training_id);
+    if(it == _entries.end())
+      return nullptr;
+    return &(it->second);
+  }
+
+  void insert(const kernel_configuration::id_type &training_id,
+              const std::string &profile,
+              const kernel_configuration::id_type &binary_id) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _entries.emplace(training_id, entry{profile, binary_id});
+  }
+
+private:
+  mutable std::mutex _mutex;
+  std::unordered_map<kernel_configuration::id_type, entry, kernel_id_hash>
+      _entries;
+};
+
 bool has_annotation(const hcf_kernel_info *info, int param_index,
                     hcf_kernel_info::annotation_type annotation) {
   for(auto a : info->get_known_annotations(param_index)) {
@@ -42,14 +86,14 @@ bool has_annotation(const hcf_kernel_info *info, int param_index,
   return false;
 }
 
-// Estimates whether kernel arguments might be invariant. This also updates
-// the statistics in the appdb, so if this function returns true,
-// a specialization should be carried out by the calling code in order
-// to ensure consistency of the appdb with what is actually happening.
-bool is_likely_invariant_argument(common::db::kernel_entry &kernel_entry,
-                                  int param_index, std::size_t application_run,
-                                  uint64_t current_value) {
-  auto& args = kernel_entry.kernel_args;
+// Estimates whether a value, e.g. of a kernel argument, might be invariant.
+// This also updates the value statistics in the appdb, so if this function
+// returns true, a specialization should be carried out by the calling code
+// in order to ensure consistency of the appdb with what is actually happening.
+bool is_likely_invariant_value(common::db::kernel_entry &kernel_entry,
+                               common::db::kernel_arg_entry &statistics,
+                               std::size_t application_run,
+                               uint64_t current_value) {
 
   const double relative_specialization_threshold =
       application::get_settings().get<setting::jitopt_iads_relative_threshold>();
@@ -62,10 +106,10 @@ bool is_likely_invariant_argument(common::db::kernel_entry &kernel_entry,
   int empty_slot = -1;
 
   for(int i = 0; i < common::db::kernel_arg_entry::max_tracked_values; ++i) {
-    // How many times the current kernel parameter was set to
-    // args[param_index].common_values[i]
+    // How many times the value was equal to
+    // statistics.common_values[i]
 
-    auto& arg_statistics = args[param_index].common_values[i];
+    auto& arg_statistics = statistics.common_values[i];
     uint64_t& arg_value_count = arg_statistics.count;
     // Is the argument the same as an argument from a previous submission that we
     // are tracking as commonly used?
@@ -74,7 +118,7 @@ bool is_likely_invariant_argument(common::db::kernel_entry &kernel_entry,
       ++arg_value_count;
       arg_statistics.last_used = kernel_entry.num_registered_invocations;
 
-      bool& is_already_specialized = args[param_index].was_specialized[i];
+      bool& is_already_specialized = statistics.was_specialized[i];
       // If we already have specialized in the past, continue to specialize.
       // This prevents performance regressions if the first the value is specialized,
       // then not used for a long while and we are now seeing it again.
@@ -106,8 +150,8 @@ bool is_likely_invariant_argument(common::db::kernel_entry &kernel_entry,
     new_arg_entry.value = current_value;
     new_arg_entry.count = 1;
     new_arg_entry.last_used = kernel_entry.num_registered_invocations;
-    args[param_index].common_values[slot_index] = new_arg_entry;
-    args[param_index].was_specialized[slot_index] = false;
+    statistics.common_values[slot_index] = new_arg_entry;
+    statistics.was_specialized[slot_index] = false;
   };
 
   // If we arrive here, we are dealing with a value that we have
@@ -122,8 +166,8 @@ bool is_likely_invariant_argument(common::db::kernel_entry &kernel_entry,
     uint64_t eviction_candidate_last_used_time = std::numeric_limits<uint64_t>::max();
 
     for(int i = 0; i < common::db::kernel_arg_entry::max_tracked_values; ++i) {
-      auto& arg_statistics = args[param_index].common_values[i];
-      auto& was_specialized = args[param_index].was_specialized[i];
+      auto& arg_statistics = statistics.common_values[i];
+      auto& was_specialized = statistics.was_specialized[i];
 
       if(arg_statistics.last_used < eviction_candidate_last_used_time) {
 
@@ -151,6 +195,76 @@ bool is_likely_invariant_argument(common::db::kernel_entry &kernel_entry,
 
   return false;
 }
+
+// Loop-controlling arguments are only specialized eagerly for values of at
+// most this magnitude. Larger trip counts gain little from specialization.
+constexpr int64_t max_eager_specialization_magnitude = 1024;
+
+int64_t as_signed_integer(uint64_t value, std::size_t size) {
+  if(size == 0 || size >= sizeof(uint64_t))
+    return static_cast<int64_t>(value);
+  unsigned shift = 64 - size * 8;
+  return static_cast<int64_t>(value << shift) >> shift;
+}
+
+// Decides whether a loop-controlling argument should be specialized for its
+// current value without waiting for invariant argument detection. Each
+// distinct value results in a separate binary, so the number of eagerly
+// specialized values is bounded per kernel. Like is_likely_invariant_value(),
+// this updates the appdb and a specialization should be carried out if
+// it returns true.
+bool is_eager_specialization_candidate(common::db::kernel_entry &kernel_entry,
+                                       int param_index, uint64_t current_value,
+                                       std::size_t arg_size) {
+  const std::size_t max_variants =
+      application::get_settings()
+          .get<setting::jitopt_eager_specialization_max_variants>();
+  if(max_variants == 0)
+    return false;
+
+  int64_t signed_value = as_signed_integer(current_value, arg_size);
+  if (signed_value < -max_eager_specialization_magnitude ||
+      signed_value > max_eager_specialization_magnitude)
+    return false;
+
+  auto& values = kernel_entry.eager_specialization_values[param_index];
+  if(std::find(values.begin(), values.end(), current_value) != values.end())
+    return true;
+
+  std::size_t num_specialized_values = 0;
+  for(const auto& entry : kernel_entry.eager_specialization_values)
+    num_specialized_values += entry.second.size();
+  if(num_specialized_values >= max_variants)
+    return false;
+
+  values.push_back(current_value);
+  return true;
+}
+
+// Identifies a number of work groups in the statistics of
+// is_likely_invariant_value()
+uint64_t get_global_range_key(const range<3> &num_groups) {
+  uint64_t key = 0;
+  for(int i = 0; i < 3; ++i)
+    key = key * 0x100000001b3ull ^ static_cast<uint64_t>(num_groups[i]);
+  return key;
+}
+
+// Candidates for host launch tuning. Candidates are referenced by their index
+// in the appdb, so new candidates must only be appended.
+const host_launch_configuration host_launch_candidates[] = {
+    {0, true}, {1, true}, {4, true}, {16, true}, {0, false}, {1, false}};
+
+constexpr std::size_t num_host_launch_candidates =
+    sizeof(host_launch_candidates) / sizeof(host_launch_configuration);
+
+bool is_applicable(const host_launch_configuration &config,
+                   const range<3> &num_groups) {
+  // Distributing rows only makes sense if there are multiple rows
+  if(!config.flatten)
+    return num_groups[1] * num_groups[2] > 1;
+  return true;
+}
 }
 
 kernel_adaptivity_engine::kernel_adaptivity_engine(
@@ -225,6 +339,8 @@ kernel_adaptivity_engine::finalize_binary_configuration(
   
   if(_adaptivity_level > 1) {
     auto base_id = config.generate_id();
+    _base_config_id = base_id;
+    _has_base_config_id = true;
     
     // Automatic application of specialization constants by detecting
     // invariant kernel arguments
@@ -242,20 +358,46 @@ kernel_adaptivity_engine::finalize_binary_configuration(
       if(kernel_entry.kernel_args.size() != num_kernel_args)
         kernel_entry.kernel_args.resize(num_kernel_args);
 
+      // Arguments controlling loops, as detected by previous JIT compilations
+      std::vector<int> loop_controlling_args;
+      auto analysis_it = data.kernels.find(
+          glue::jit::get_kernel_analysis_id(_hcf, _kernel_name));
+      if(analysis_it != data.kernels.end())
+        loop_controlling_args =
+            analysis_it->second.loop_controlling_argument_indices;
+
+      auto is_loop_controlling_arg = [&](int i) {
+        return std::find(loop_controlling_args.begin(),
+                         loop_controlling_args.end(),
+                         i) != loop_controlling_args.end();
+      };
+
       auto process_kernel_arg = [&](int i) {
         uint64_t arg_value = 0;
-        std::memcpy(&arg_value, _arg_mapper.get_mapped_args()[i],
-                    _kernel_info->get_argument_size(i));
+        std::size_t arg_size = _kernel_info->get_argument_size(i);
+        std::memcpy(&arg_value, _arg_mapper.get_mapped_args()[i], arg_size);
+        bool is_specializable =
+            _kernel_info->get_argument_type(i) !=
+                hcf_kernel_info::argument_type::pointer &&
+            !has_annotation(_kernel_info, i,
+                            hcf_kernel_info::annotation_type::specialized);
         if (_kernel_info->get_argument_type(i) !=
                 hcf_kernel_info::argument_type::pointer &&
-            is_likely_invariant_argument(kernel_entry, i, data.content_version,
-                                         arg_value) &&
+            is_likely_invariant_value(kernel_entry, kernel_entry.kernel_args[i],
+                                      data.content_version, arg_value) &&
             !has_annotation(_kernel_info, i,
                             hcf_kernel_info::annotation_type::specialized)) {
           HIPSYCL_DEBUG_INFO << "adaptivity_engine: Kernel argument " << i
                              << " is invariant or common, specializing."
                              << std::endl;
           config.set_specialized_kernel_argument(i, arg_value);
+        } else if (is_specializable && is_loop_controlling_arg(i) &&
+                   is_eager_specialization_candidate(kernel_entry, i,
+                                                     arg_value, arg_size)) {
+          HIPSYCL_DEBUG_INFO << "adaptivity_engine: Kernel argument " << i
+                             << " controls loops, specializing eagerly."
+                             << std::endl;
+          config.set_specialized_kernel_argument(i, arg_value);
         } else {
           HIPSYCL_DEBUG_INFO << "adaptivity_engine: Not specializing kernel argument " << i
                              << std::endl;
@@ -271,6 +413,24 @@ kernel_adaptivity_engine::finalize_binary_configuration(
           process_kernel_arg(i);
         }
       }
+
+      // Like invariant kernel arguments, bake the global range into the
+      // binary if it is repeated across launches. The group size is
+      // already known, so it is sufficient to specialize the number of groups.
+      if(application::get_settings().get<setting::jitopt_known_global_range>() &&
+         is_likely_invariant_value(kernel_entry, kernel_entry.global_range,
+                                   data.content_version,
+                                   get_global_range_key(_num_groups))) {
+        HIPSYCL_DEBUG_INFO << "adaptivity_engine: Global range is invariant or "
+                              "common, specializing."
+                           << std::endl;
+        config.set_build_option(kernel_build_option::known_num_groups_x,
+                                _num_groups[0]);
+        config.set_build_option(kernel_build_option::known_num_groups_y,
+                                _num_groups[1]);
+        config.set_build_option(kernel_build_option::known_num_groups_z,
+                                _num_groups[2]);
+      }
     });
   }
 
@@ -288,5 +448,258 @@ std::string kernel_adaptivity_engine::select_image_and_kernels(
     return glue::jit::select_image(_kernel_info, kernel_names_out);
   }
 }
+
+host_launch_configuration
+kernel_adaptivity_engine::select_host_launch_configuration() const {
+  if(!is_host_launch_tuning_enabled())
+    return host_launch_configuration{};
+
+  uint64_t bucket = get_problem_size_bucket();
+  auto& appdb = common::filesystem::persistent_storage::get().get_this_app_db();
+  return appdb.read_access([&](const common::db::appdb_data& data) {
+    const common::db::host_launch_tuning_entry* entry = nullptr;
+    auto kernel_it = data.kernels.find(_base_config_id);
+    if(kernel_it != data.kernels.end()) {
+      auto it = kernel_it->second.host_launch_tuning.find(bucket);
+      if(it != kernel_it->second.host_launch_tuning.end())
+        entry = &(it->second);
+    }
+
+    if (entry && entry->selected_candidate < num_host_launch_candidates)
+      return host_launch_candidates[entry->selected_candidate];
+
+    // Measure the applicable candidate with the fewest samples, such that
+    // the measurements of the candidates are interleaved and affected
+    // by changing system conditions in the same way.
+    std::size_t next_candidate = num_host_launch_candidates;
+    uint64_t min_samples = std::numeric_limits<uint64_t>::max();
+    for(std::size_t i = 0; i < num_host_launch_candidates; ++i) {
+      if(!is_applicable(host_launch_candidates[i], _num_groups))
+        continue;
+      uint64_t num_samples = 0;
+      if(entry && i < entry->candidates.size())
+        num_samples = entry->candidates[i].num_samples;
+      if(num_samples < min_samples) {
+        min_samples = num_samples;
+        next_candidate = i;
+      }
+    }
+
+    if(next_candidate == num_host_launch_candidates)
+      return host_launch_configuration{};
+
+    host_launch_configuration result = host_launch_candidates[next_candidate];
+    result.candidate = static_cast<int>(next_candidate);
+    return result;
+  });
+}
+
+void kernel_adaptivity_engine::register_host_launch_timing(
+    const host_launch_configuration &config, uint64_t time_ns) const {
+  if (config.candidate < 0 ||
+      static_cast<std::size_t>(config.candidate) >=
+          num_host_launch_candidates ||
+      !is_host_launch_tuning_enabled())
+    return;
+
+  const std::size_t required_samples = application::get_settings()
+      .get<setting::jitopt_host_launch_tuning_samples>();
+  uint64_t bucket = get_problem_size_bucket();
+
+  auto& appdb = common::filesystem::persistent_storage::get().get_this_app_db();
+  appdb.read_write_access([&](common::db::appdb_data& data){
+    auto& entry = data.kernels[_base_config_id].host_launch_tuning[bucket];
+    if(entry.selected_candidate != common::db::host_launch_tuning_entry::no_selection)
+      return;
+
+    if(entry.candidates.empty()) {
+      entry.candidates.resize(num_host_launch_candidates);
+      // The first launch of a kernel for a problem size is typically
+      // dominated by one-time costs such as page faults when memory is
+      // first touched, so it is not representative of the candidate.
+      return;
+    }
+    if(entry.candidates.size() < num_host_launch_candidates)
+      entry.candidates.resize(num_host_launch_candidates);
+
+    auto& stats = entry.candidates[config.candidate];
+    ++stats.num_samples;
+    stats.total_time_ns += time_ns;
+
+    std::size_t best_candidate = num_host_launch_candidates;
+    double best_time = std::numeric_limits<double>::max();
+    for(std::size_t i = 0; i < num_host_launch_candidates; ++i) {
+      if(!is_applicable(host_launch_candidates[i], _num_groups))
+        continue;
+      const auto& candidate_stats = entry.candidates[i];
+      if(candidate_stats.num_samples < required_samples)
+        return;
+      double mean_time = static_cast<double>(candidate_stats.total_time_ns) /
+                         candidate_stats.num_samples;
+      if(mean_time < best_time) {
+        best_time = mean_time;
+        best_candidate = i;
+      }
+    }
+
+    if(best_candidate != num_host_launch_candidates) {
+      entry.selected_candidate = best_candidate;
+      HIPSYCL_DEBUG_INFO << "adaptivity_engine: Selected host launch "
+                            "configuration "
+                         << best_candidate << " (groups per chunk: "
+                         << host_launch_candidates[best_candidate].groups_per_chunk
+                         << ", flatten: "
+                         << host_launch_candidates[best_candidate].flatten
+                         << ") for kernel " << _kernel_name
+                         << ", problem size bucket " << bucket << std::endl;
+    }
+  });
+}
+
+kernel_configuration::id_type kernel_adaptivity_engine::select_noalias_variant(
+    kernel_configuration &config, kernel_configuration::id_type binary_id,
+    const backend_allocator *allocator) const {
+  if (_adaptivity_level < 1 || !allocator ||
+      !application::get_settings().get<setting::jitopt_noalias_inference>())
+    return binary_id;
+
+  // Pointer arguments and the base addresses of the allocations they point into
+  common::auto_small_vector<std::pair<std::size_t, const void*>> allocations;
+  for(std::size_t i = 0; i < _kernel_info->get_num_parameters(); ++i) {
+    if (_kernel_info->get_argument_type(i) !=
+            hcf_kernel_info::argument_type::pointer ||
+        _kernel_info->get_argument_size(i) != sizeof(void *))
+      continue;
+
+    void* ptr = nullptr;
+    std::memcpy(&ptr, _arg_mapper.get_mapped_args()[i], sizeof(void *));
+    if(!ptr)
+      continue;
+
+    const void* base = nullptr;
+    std::size_t size = 0;
+    // A pointer into unknown memory might alias any other argument
+    if(!allocator->query_allocation_range(ptr, base, size).is_success())
+      return binary_id;
+    allocations.push_back(std::make_pair(i, base));
+  }
+
+  // Allocations do not overlap, so an argument pointing into an allocation
+  // that no other argument points into cannot alias the other arguments.
+  std::string noalias_args;
+  for(const auto& arg : allocations) {
+    auto num_args_in_allocation =
+        std::count_if(allocations.begin(), allocations.end(),
+                      [&](const auto &other) { return other.second == arg.second; });
+    if(num_args_in_allocation == 1) {
+      if(!noalias_args.empty())
+        noalias_args += ",";
+      noalias_args += std::to_string(arg.first);
+    }
+  }
+
+  if(noalias_args.empty())
+    return binary_id;
+
+  HIPSYCL_DEBUG_INFO << "adaptivity_engine: Pointer arguments " << noalias_args
+                     << " point into distinct allocations" << std::endl;
+  config.set_build_option(kernel_build_option::noalias_pointer_arguments,
+                          noalias_args);
+  return config.generate_id();
+}
+
+kernel_configuration::id_type kernel_adaptivity_engine::select_pgo_variant(
+    kernel_configuration &config, kernel_configuration::id_type binary_id) {
+  const std::size_t num_training_launches = application::get_settings()
+      .get<setting::jitopt_pgo_training_launches>();
+  if(_adaptivity_level < 2 || num_training_launches == 0)
+    return binary_id;
+
+  if(const auto *finished = finished_pgo_profiles::get().find(binary_id)) {
+    if(!finished->profile.empty())
+      config.set_build_option(kernel_build_option::pgo_branch_profile,
+                              finished->profile);
+    return finished->binary_id;
+  }
+
+  _pgo_profile_id = binary_id;
+  std::string profile;
+  auto& appdb = common::filesystem::persistent_storage::get().get_this_app_db();
+  appdb.read_write_access([&](common::db::appdb_data& data){
+    auto& entry = data.kernels[binary_id];
+    if(entry.num_pgo_training_launches < num_training_launches) {
+      ++entry.num_pgo_training_launches;
+      _is_pgo_training_launch = true;
+      return;
+    }
+    for(std::size_t i = 0; i < entry.pgo_branch_counters.size(); ++i) {
+      if(i > 0)
+        profile += ",";
+      profile += std::to_string(entry.pgo_branch_counters[i]);
+    }
+  });
+
+  if(_is_pgo_training_launch) {
+    HIPSYCL_DEBUG_INFO << "adaptivity_engine: Collecting branch profile"
+                       << std::endl;
+    config.set_build_flag(kernel_build_flag::pgo_instrumentation);
+    return config.generate_id();
+  }
+
+  auto profiled_binary_id = binary_id;
+  if(!profile.empty()) {
+    config.set_build_option(kernel_build_option::pgo_branch_profile, profile);
+    profiled_binary_id = config.generate_id();
+  }
+  finished_pgo_profiles::get().insert(binary_id, profile, profiled_binary_id);
+  return profiled_binary_id;
+}
+
+bool kernel_adaptivity_engine::is_pgo_training_launch() const {
+  return _is_pgo_training_launch;
+}
+
+void kernel_adaptivity_engine::register_pgo_branch_counters(
+    const std::vector<uint64_t> &counters) const {
+  if(!_is_pgo_training_launch || counters.empty())
+    return;
+
+  auto& appdb = common::filesystem::persistent_storage::get().get_this_app_db();
+  appdb.read_write_access([&](common::db::appdb_data& data){
+    auto& profile = data.kernels[_pgo_profile_id].pgo_branch_counters;
+    // A profile from a differently instrumented binary cannot be merged
+    if(profile.size() != counters.size())
+      profile.assign(counters.size(), 0);
+    for(std::size_t i = 0; i < counters.size(); ++i)
+      profile[i] += counters[i];
+  });
+}
+
+bool kernel_adaptivity_engine::is_host_launch_tuning_enabled() const {
+  return _has_base_config_id && _adaptivity_level > 1 &&
+         application::get_settings()
+                 .get<setting::jitopt_host_launch_tuning_samples>() > 0;
+}
+
+bool kernel_adaptivity_engine::is_tiered_compilation_enabled() const {
+  return application::get_settings().get<setting::jitopt_tiered_compilation>();
+}
+
+std::size_t kernel_adaptivity_engine::get_tier_up_threshold() const {
+  return application::get_settings().get<setting::jitopt_tier_up_threshold>();
+}
+
+uint64_t kernel_adaptivity_engine::get_problem_size_bucket() const {
+  // Problem sizes that differ by less than a factor of two are expected
+  // to favor the same configuration.
+  uint64_t num_groups = _num_groups.size();
+  uint64_t bucket = 0;
+  while(num_groups > 1) {
+    num_groups >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+}
 }
-}
\ No newline at end of file
@@ -0,0 +1,321 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/command_graph.hpp"
+#include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/executor.hpp"
+#include "hipSYCL/runtime/multi_queue_executor.hpp"
+#include "hipSYCL/runtime/operations.hpp"
+#include "hipSYCL/runtime/runtime.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <tuple>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+backend_executor *select_executor(runtime *rt, const execution_hints &hints,
+                                  operation *op, device_id &dev) {
+  backend_executor* user_preferred_executor = nullptr;
+  if(hints.has_hint<hints::prefer_executor>())
+    user_preferred_executor =
+        hints.get_hint<hints::prefer_executor>()->get_executor();
+
+  backend_id preferred_backend;
+  device_id preferred_device;
+  if(op->has_preferred_backend(preferred_backend, preferred_device)) {
+    dev = preferred_device;
+    if (user_preferred_executor &&
+        user_preferred_executor->can_execute_on_device(preferred_device))
+      return user_preferred_executor;
+    return rt->backends().get(preferred_backend)->get_executor(preferred_device);
+  }
+
+  if(user_preferred_executor &&
+      user_preferred_executor->can_execute_on_device(dev))
+    return user_preferred_executor;
+  return rt->backends().get(dev.get_backend())->get_executor(dev);
+}
+
+}
+
+command_graph::command_graph(runtime* rt)
+: _rt{rt} {}
+
+result command_graph::record(std::unique_ptr<operation> op,
+                             const node_list_t &requirements,
+                             const execution_hints &hints,
+                             dag_node_ptr &node_out) {
+  if(!hints.has_hint<hints::bind_to_device>()) {
+    return make_error(
+        __acpp_here(),
+        error_info{"command_graph: Only operations bound to a device can be "
+                   "recorded",
+                   error_type::feature_not_supported});
+  }
+  if(op->is_requirement()) {
+    return make_error(
+        __acpp_here(),
+        error_info{"command_graph: Recording memory requirements is "
+                   "unsupported",
+                   error_type::feature_not_supported});
+  }
+
+  if(!op->can_clone()) {
+    return make_error(
+        __acpp_here(),
+        error_info{"command_graph: Operation cannot be replayed",
+                   error_type::feature_not_supported});
+  }
+
+  execution_hints node_hints = hints;
+  // Executions only return the completion of the entire graph, so
+  // instrumentation results of individual operations cannot be queried.
+  node_hints.clear_hint<hints::request_instrumentation_submission_timestamp>();
+  node_hints.clear_hint<hints::request_instrumentation_start_timestamp>();
+  node_hints.clear_hint<hints::request_instrumentation_finish_timestamp>();
+  node_hints.clear_hint<hints::instant_execution>();
+
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  recorded_node recorded;
+  for(const auto& req : requirements) {
+    auto it = std::find_if(
+        _nodes.begin(), _nodes.end(),
+        [&](const recorded_node &n) { return n.node == req; });
+    if(it != _nodes.end()) {
+      std::size_t index = std::distance(_nodes.begin(), it);
+      if (std::find(recorded.dependencies.begin(), recorded.dependencies.end(),
+                    index) == recorded.dependencies.end())
+        recorded.dependencies.push_back(index);
+    } else {
+      HIPSYCL_DEBUG_INFO << "command_graph: Dropping dependency on node "
+                         << req.get() << " which is not part of the graph"
+                         << std::endl;
+    }
+  }
+
+  recorded.op = std::move(op);
+  recorded.node = std::make_shared<dag_node>(node_hints, node_list_t{},
+                                             recorded.op, _rt);
+  // Recorded nodes are never executed themselves. Marking them as virtually
+  // submitted ensures that waiting on them does not block.
+  recorded.node->mark_virtually_submitted();
+  node_out = recorded.node;
+  _nodes.push_back(std::move(recorded));
+
+  return make_success();
+}
+
+std::size_t command_graph::get_num_nodes() const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _nodes.size();
+}
+
+result command_graph::instantiate(
+    std::shared_ptr<executable_command_graph> &out) const {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  auto graph = std::shared_ptr<executable_command_graph>{
+      new executable_command_graph{_rt}};
+
+  // Next lane to use for each (executor, device, lane range) when no better
+  // choice is available
+  std::map<std::tuple<backend_executor *, int, std::size_t>, std::size_t>
+      round_robin_counters;
+  std::vector<std::size_t> assigned_lanes;
+  std::vector<bool> has_dependents(_nodes.size(), false);
+
+  for(const auto& recorded : _nodes) {
+    executable_command_graph::executable_node node;
+    // Executable graphs do not share operations with the recorded graph
+    // or with each other, such that set_kernel_args() only affects
+    // one of them.
+    node.op = recorded.op->clone();
+    node.recorded_node = recorded.node;
+    node.hints = recorded.node->get_execution_hints();
+    node.dev = node.hints.get_hint<hints::bind_to_device>()->get_device_id();
+    node.executor = select_executor(_rt, node.hints, node.op.get(), node.dev);
+    node.lane_executor = node.executor;
+    node.dependencies = recorded.dependencies;
+    node.is_root = recorded.dependencies.empty();
+
+    for(std::size_t dep : recorded.dependencies)
+      has_dependents[dep] = true;
+
+    std::size_t lane = 0;
+    if(auto *mqe = dynamic_cast<multi_queue_executor *>(node.executor)) {
+      backend_execution_lane_range range =
+          node.op->is_data_transfer()
+              ? mqe->get_memcpy_execution_lane_range(node.dev)
+              : mqe->get_kernel_execution_lane_range(node.dev);
+
+      bool is_assigned = false;
+      if(node.hints.has_hint<hints::prefer_execution_lane>()) {
+        std::size_t preferred =
+            node.hints.get_hint<hints::prefer_execution_lane>()->get_lane_id();
+        lane = range.begin + preferred % range.num_lanes;
+        is_assigned = true;
+      } else {
+        // Continuing in the lane of a dependency avoids synchronization
+        // between lanes.
+        for(std::size_t dep : node.dependencies) {
+          const auto& dep_node = graph->_nodes[dep];
+          std::size_t dep_lane = assigned_lanes[dep];
+          if (dep_node.executor == node.executor && dep_node.dev == node.dev &&
+              dep_lane >= range.begin &&
+              dep_lane < range.begin + range.num_lanes) {
+            lane = dep_lane;
+            is_assigned = true;
+            break;
+          }
+        }
+      }
+      if(!is_assigned) {
+        std::size_t &counter = round_robin_counters[std::make_tuple(
+            node.executor, node.dev.get_id(), range.begin)];
+        lane = range.begin + (counter++) % range.num_lanes;
+      }
+      node.lane_executor = mqe->get_lane_executor(node.dev, lane);
+    }
+    assigned_lanes.push_back(lane);
+    graph->_nodes.push_back(std::move(node));
+  }
+
+  // Ensure that the last node completes after all other nodes without
+  // dependents, such that it can represent the completion of the
+  // entire graph.
+  if(!graph->_nodes.empty()) {
+    auto& last = graph->_nodes.back();
+    for(std::size_t i = 0; i + 1 < graph->_nodes.size(); ++i) {
+      if(!has_dependents[i])
+        last.dependencies.push_back(i);
+    }
+  }
+
+  out = graph;
+  return make_success();
+}
+
+executable_command_graph::executable_command_graph(runtime* rt)
+: _rt{rt} {}
+
+result
+executable_command_graph::execute(const execution_hints &submission_hints,
+                                  const node_list_t &external_dependencies,
+                                  dag_node_ptr &sink_out) {
+  // Replay nodes must be able to synchronize with external dependencies,
+  // so these must have been submitted.
+  for(const auto& dep : external_dependencies) {
+    if(!dep->is_submitted()) {
+      _rt->dag().flush_sync();
+      break;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  std::vector<dag_node_ptr> replay_nodes;
+  replay_nodes.reserve(_nodes.size());
+
+  for(const auto& node : _nodes) {
+    node_list_t reqs;
+    if(node.is_root)
+      reqs = external_dependencies;
+    for(std::size_t dep : node.dependencies)
+      reqs.push_back(replay_nodes[dep]);
+
+    execution_hints hints = node.hints;
+    if(submission_hints.has_hint<hints::node_group>())
+      hints.set_hint(hints::node_group{
+          submission_hints.get_hint<hints::node_group>()->get_id()});
+    hints.set_hint(hints::instant_execution{});
+
+    const std::shared_ptr<operation>& op = node.op;
+    auto replay_node = std::make_shared<dag_node>(hints, reqs, op, _rt);
+    replay_node->assign_to_device(node.dev);
+    replay_node->assign_to_executor(node.executor);
+
+    reqs.erase(std::remove_if(
+                   reqs.begin(), reqs.end(),
+                   [](const dag_node_ptr &r) { return r->is_known_complete(); }),
+               reqs.end());
+
+    node.lane_executor->submit_directly(replay_node, op.get(), reqs);
+    op->get_instrumentations().mark_set_complete();
+
+    if(replay_node->is_cancelled()) {
+      // Operations submitted so far will still run, so they need to be
+      // known to the runtime to be waited for.
+      for(const auto& submitted : replay_nodes)
+        _rt->dag().register_submitted_ops(submitted);
+      return make_error(
+          __acpp_here(),
+          error_info{"executable_command_graph: Submission of replayed "
+                     "operation failed"});
+    }
+    replay_nodes.push_back(replay_node);
+  }
+
+  if(!replay_nodes.empty()) {
+    sink_out = replay_nodes.back();
+    _rt->dag().register_submitted_ops(sink_out);
+  }
+  return make_success();
+}
+
+result executable_command_graph::set_kernel_args(
+    const dag_node_ptr &recorded_node, const char *kernel_name,
+    const void *data, std::size_t size) {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  auto it = std::find_if(_nodes.begin(), _nodes.end(),
+                         [&](const executable_node &n) {
+                           return n.recorded_node == recorded_node;
+                         });
+  if(it == _nodes.end()) {
+    return make_error(
+        __acpp_here(),
+        error_info{"executable_command_graph: Node is not part of the graph",
+                   error_type::invalid_parameter_error});
+  }
+
+  auto *kernel_op = dynamic_cast<kernel_operation *>(it->op.get());
+  if (!kernel_op ||
+      std::strcmp(kernel_op->get_global_kernel_name(), kernel_name) != 0) {
+    return make_error(
+        __acpp_here(),
+        error_info{"executable_command_graph: Node is not an instance of the "
+                   "given kernel",
+                   error_type::invalid_parameter_error});
+  }
+
+  // Submitted executions keep referencing the operation until they are
+  // destroyed. Only copy it if such executions exist, since they might
+  // still be in flight.
+  if(it->op.use_count() > 1) {
+    it->op = kernel_op->clone();
+    kernel_op = static_cast<kernel_operation *>(it->op.get());
+  }
+  return kernel_op->get_launcher().update_sscp_kernel_args(
+      it->dev.get_backend(), data, size);
+}
+
+std::size_t executable_command_graph::get_num_nodes() const {
+  return _nodes.size();
+}
+
+}
+}
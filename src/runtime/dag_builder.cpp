@@ -29,89 +29,26 @@ namespace rt {
 
 namespace {
 
-// Attempts to find x in node's dependency graph
-bool find_dependency(const dag_node_ptr &node, const dag_node_ptr& x,
-                                    int max_num_levels = 2) {
-  if(max_num_levels <= 0)
-    return false;
-
-  for(auto& req : node->get_requirements()) {
-    if(auto req_locked = req.lock()) {
-      if(req_locked == x)
-        return true;
-    
-      if(find_dependency(req_locked, x, max_num_levels - 1))
-        return true;
-    }
-  }
-
-  return false;
-}
-
 // Add this node to the data users of the memory region of the specified
 // requirement
 void add_to_data_users(dag_node_ptr node, memory_requirement *mem_req) {
   assert(mem_req);
   if (mem_req->is_buffer_requirement()) {
-
-    auto &data_users = cast<buffer_memory_requirement>(mem_req)
-                           ->get_data_region()
-                           ->get_users();
-    // This lambda is used to check whether an existing user
-    // should be overwritten by the new user. This is an important
-    // optimization: We KNOW that the new user is going to have
-    // dependencies on conflicting accesses, so we can just
-    // replace the tracking of those older accesses with the new one.
-    auto replaces_user = [&](const data_user& user) -> bool {
-      // Check if accessed range of new user is larger or equal.
-      // If its range does not encompass all the range of the existing
-      // user, we cannot remove the existing user.
-      for(int i = 0; i < 3; ++i) {
-        auto offset = mem_req->get_access_offset3d();
-        auto range = mem_req->get_access_range3d();
-
-        if (offset[i] > user.offset[i])
-          return false;
-        if (offset[i] + range[i] < user.offset[i] + user.range[i])
-          return false;
-      }
-
-      bool new_user_writes = mem_req->get_access_mode() != sycl::access_mode::read;
-      bool old_user_writes = user.mode != sycl::access_mode::read;
-
-      // Write accesses always create strong dependencies, so we can
-      // safely replace the old user in any case
-      if(new_user_writes) {
-        return true;
-      }
-      // A read-only access is weaker than a write-access, so we can
-      // only replace if the other user is also a read-only access.
-      else if(!old_user_writes){
-        auto user_locked = user.user.lock();
-        // If user does not exist anymore, it can be replaced.
-        if(!user_locked)
-          return true;
-        // Replacement is only correct if the old user is part of the dependency chain
-        // of the new user, since two read accesses otherwise might not have a dependency.
-        if(find_dependency(node, user_locked)) {
-          return true;
-        }
-      }
-
-      return false;
-    };
+    auto *buff_req = cast<buffer_memory_requirement>(mem_req);
+    auto &data_users = buff_req->get_data_region()->get_users();
 
     // We need to add the user unconditionally, whether the user
     // is already registered or not. This is to cover the case
     // where we have multiple requirements (potentially with different access
     // modes or ranges) on the same operation.
     // This cannot introduce duplicate dependency edges in the DAG because
-    // dag_node::add_requirement() only inserts requirements to nodes
+    // dag_node::add_direct_requirement() only inserts requirements to nodes
     // that are not listed yet as requirement. 
     data_users.add_user(
         node, mem_req->get_access_mode(), mem_req->get_access_target(),
         mem_req->get_access_offset3d(), mem_req->get_access_range3d(),
-        replaces_user);
+        buff_req->get_data_region()->get_page_range(
+            mem_req->get_access_offset3d(), mem_req->get_access_range3d()));
   
   } else
     assert(false && "dag: Image requirements are not yet implemented");
@@ -166,15 +103,18 @@ dag_node_ptr dag_builder::build_node(std::unique_ptr<operation> op,
           data_user_tracker &user_tracker =
               buff_req->get_data_region()->get_users();
 
-          user_tracker.for_each_user([&](data_user &user) {
-            auto user_ptr = user.user.lock();
-            if(user_ptr && is_conflicting_access(mem_req, user))
-            {
-              // No reason to take a dependency into account that is alreay completed
-              if(!user_ptr->is_known_complete())
-                req_node->add_requirement(user_ptr);
-            }
-          });
+          auto pages = buff_req->get_data_region()->get_page_range(
+              mem_req->get_access_offset3d(), mem_req->get_access_range3d());
+          // The tracker only reports users that are not ordered through
+          // other reported users, so no redundant edges need to be pruned.
+          user_tracker.for_each_conflicting_user(
+              mem_req->get_access_mode(), pages, [&](data_user &user) {
+                auto user_ptr = user.user.lock();
+                // No reason to take a dependency into account that is alreay
+                // completed
+                if(user_ptr && !user_ptr->is_known_complete())
+                  req_node->add_direct_requirement(user_ptr);
+              });
         }
       }
     }
@@ -260,17 +200,6 @@ dag dag_builder::finish_and_reset()
   return final_dag;
 }
 
-bool dag_builder::is_conflicting_access(
-    const memory_requirement* mem_req, const data_user& user) const
-{
-  if (mem_req->get_access_mode() == sycl::access::mode::read &&
-      user.mode == sycl::access::mode::read)
-    return false;
-
-  // Checks if the page ranges do not intersect
-  return mem_req->intersects_with(user);
-}
-
 std::size_t dag_builder::get_current_dag_size() const
 {
   std::lock_guard<std::mutex> lock{_mutex};
@@ -23,7 +23,7 @@ namespace rt {
 
 dag_node::dag_node(const execution_hints &hints,
                    const node_list_t &requirements,
-                   std::unique_ptr<operation> op,
+                   std::shared_ptr<operation> op,
                    runtime* rt)
     : _hints{hints},
       _assigned_executor{nullptr}, _event{nullptr}, _operation{std::move(op)},
@@ -218,6 +218,17 @@ void dag_node::add_requirement(dag_node_ptr requirement)
   _requirements.push_back(requirement);
 }
 
+void dag_node::add_direct_requirement(dag_node_ptr requirement)
+{
+  // Compare ownership instead of locking every weak_ptr, since nodes may
+  // receive many requirements this way.
+  for (const auto& req : _requirements) {
+    if (!req.owner_before(requirement) && !requirement.owner_before(req))
+      return;
+  }
+  _requirements.push_back(requirement);
+}
+
 operation *dag_node::get_operation() const { return _operation.get(); }
 
 const weak_node_list_t &dag_node::get_requirements() const
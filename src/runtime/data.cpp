@@ -19,25 +19,26 @@ namespace hipsycl {
 namespace rt {
 
 data_user_tracker::data_user_tracker(const data_user_tracker& other){
-  _users = other._users;
+  _epochs = other._epochs;
+  _num_accesses = other._num_accesses;
 }
 
 data_user_tracker::data_user_tracker(data_user_tracker&& other)
-: _users{std::move(other._users)}
-{
-  _users = other._users;
-}
+: _epochs{std::move(other._epochs)}, _num_accesses{other._num_accesses}
+{}
 
 data_user_tracker& 
 data_user_tracker::operator=(data_user_tracker other){
-  _users = other._users;
+  _epochs = other._epochs;
+  _num_accesses = other._num_accesses;
   return *this;
 }
 
 
 data_user_tracker& 
 data_user_tracker::operator=(data_user_tracker&& other){
-  _users = std::move(other._users);
+  _epochs = std::move(other._epochs);
+  _num_accesses = other._num_accesses;
   return *this;
 }
 
@@ -45,29 +46,127 @@ const std::vector<data_user>
 data_user_tracker::get_users() const
 { 
   std::lock_guard<std::mutex> lock{_lock};
-  return _users;
+  std::vector<data_user> users;
+  for(const auto& epoch : _epochs) {
+    if(epoch.has_writer)
+      users.push_back(epoch.last_writer);
+    users.insert(users.end(), epoch.readers.begin(), epoch.readers.end());
+  }
+  return users;
 }
 
 
 bool data_user_tracker::has_user(dag_node_ptr user) const
 {
   std::lock_guard<std::mutex> lock{_lock};
-  return std::find_if(_users.begin(), _users.end(), [user](const data_user &u) {
-           return u.user.lock() == user;
-         }) != _users.end();
+  auto is_user = [&](const data_user &u) { return u.user.lock() == user; };
+
+  for(const auto& epoch : _epochs) {
+    if(epoch.has_writer && is_user(epoch.last_writer))
+      return true;
+    if (std::find_if(epoch.readers.begin(), epoch.readers.end(), is_user) !=
+        epoch.readers.end())
+      return true;
+  }
+  return false;
 }
 
 void data_user_tracker::release_dead_users()
 {
   std::lock_guard<std::mutex> lock{_lock};
-  _users.erase(std::remove_if(_users.begin(), _users.end(),
-                              [](const data_user &user) -> bool {
-                                auto u = user.user.lock();
-                                if (!u)
-                                  return true;
-                                return u->is_known_complete();
-                              }),
-               _users.end());
+  auto is_dead = [](const data_user &user) -> bool {
+    auto u = user.user.lock();
+    if (!u)
+      return true;
+    return u->is_known_complete();
+  };
+
+  for(auto& epoch : _epochs) {
+    if(epoch.has_writer && is_dead(epoch.last_writer))
+      epoch.has_writer = false;
+    epoch.readers.erase(
+        std::remove_if(epoch.readers.begin(), epoch.readers.end(), is_dead),
+        epoch.readers.end());
+  }
+  _epochs.erase(std::remove_if(_epochs.begin(), _epochs.end(),
+                               [](const access_epoch &epoch) {
+                                 return !epoch.has_writer &&
+                                        epoch.readers.empty();
+                               }),
+                _epochs.end());
+}
+
+void data_user_tracker::add_user(dag_node_ptr user, sycl::access::mode mode,
+                                 sycl::access::target target, id<3> offset,
+                                 range<3> range, const page_range &pages) {
+  std::lock_guard<std::mutex> lock{_lock};
+
+  data_user new_user{std::weak_ptr<dag_node>(user), mode, target, offset, range};
+  std::size_t access = ++_num_accesses;
+
+  if(mode != sycl::access::mode::read) {
+    // The new writer is ordered after all users of page ranges that it
+    // covers entirely, so these no longer need to be tracked.
+    _epochs.erase(std::remove_if(_epochs.begin(), _epochs.end(),
+                                 [&](const access_epoch &epoch) {
+                                   return page_range_contains(pages,
+                                                              epoch.pages);
+                                 }),
+                  _epochs.end());
+
+    access_epoch epoch;
+    epoch.pages = pages;
+    epoch.has_writer = true;
+    epoch.last_writer = new_user;
+    epoch.writer_access = access;
+    epoch.last_access = access;
+    _epochs.push_back(std::move(epoch));
+  } else {
+    auto it = std::find_if(_epochs.begin(), _epochs.end(),
+                           [&](const access_epoch &epoch) {
+                             return epoch.pages == pages;
+                           });
+    if(it == _epochs.end()) {
+      access_epoch epoch;
+      epoch.pages = pages;
+      _epochs.push_back(std::move(epoch));
+    } else {
+      // Keep the page ranges ordered by their most recent access
+      std::rotate(it, it + 1, _epochs.end());
+    }
+    auto& epoch = _epochs.back();
+    epoch.last_access = access;
+    // The same operation may read the same range through
+    // multiple requirements.
+    if(epoch.readers.empty() || epoch.readers.back().user.lock() != user)
+      epoch.readers.push_back(new_user);
+  }
+}
+
+bool data_user_tracker::page_ranges_intersect(const page_range &a,
+                                              const page_range &b) {
+  for(int dim = 0; dim < 3; ++dim) {
+    auto begin1 = a.first[dim];
+    auto end1 = begin1 + a.second[dim];
+    auto begin2 = b.first[dim];
+    auto end2 = begin2 + b.second[dim];
+
+    if(!(begin1 < end2 && begin2 < end1))
+      return false;
+  }
+  return true;
+}
+
+bool data_user_tracker::page_range_contains(const page_range &outer,
+                                            const page_range &inner) {
+  for(int dim = 0; dim < 3; ++dim) {
+    if(inner.first[dim] < outer.first[dim])
+      return false;
+    if (inner.first[dim] + inner.second[dim] >
+        outer.first[dim] + outer.second[dim])
+      return false;
+  }
+  return true;
 }
 
 range_store::range_store(range<3> size)
@@ -618,36 +618,43 @@ result hip_queue::submit_sscp_kernel_from_code_object(
                           target_arch_name);
 
   auto binary_configuration_id = adaptivity_engine.finalize_binary_configuration(_config);
-  auto code_object_configuration_id = binary_configuration_id;
-  kernel_configuration::extend_hash(
-      code_object_configuration_id,
-      kernel_base_config_parameter::runtime_device, device);
 
   auto get_image_and_kernel_names =
       [&](std::vector<std::string> &contained_kernels) -> std::string {
     return adaptivity_engine.select_image_and_kernels(&contained_kernels);
   };
 
-  auto jit_compiler = [&](std::string& compiled_image) -> bool {
-    
+  auto make_jit_compiler = [&](const kernel_configuration &config,
+                               kernel_configuration::id_type binary_id) {
     std::vector<std::string> kernel_names;
     std::string selected_image_name = get_image_and_kernel_names(kernel_names);
 
-    // Construct amdgpu translator to compile the specified kernels
-    std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
-      compiler::createLLVMToAmdgpuTranslator(kernel_names);
-
-    // Lower kernels
-    rt::result err;
-    if(kernel_names.size() == 1) {
-      err = glue::jit::dead_argument_elimination::compile_kernel(
-          translator.get(), hcf_object, selected_image_name, _config,
-          binary_configuration_id, compiled_image);
-    } else {
-      err = glue::jit::compile(translator.get(),
-        hcf_object, selected_image_name, _config, compiled_image);
-    }
-    
+    return [=](std::string &compiled_image) -> result {
+      // Construct amdgpu translator to compile the specified kernels
+      std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
+        compiler::createLLVMToAmdgpuTranslator(kernel_names);
+
+      // Lower kernels
+      if(kernel_names.size() == 1) {
+        return glue::jit::dead_argument_elimination::compile_kernel(
+            translator.get(), hcf_object, selected_image_name, config,
+            binary_id, compiled_image);
+      }
+      return glue::jit::compile(translator.get(),
+        hcf_object, selected_image_name, config, compiled_image);
+    };
+  };
+
+  binary_configuration_id = adaptivity_engine.select_compilation_tier(
+      _config, binary_configuration_id, make_jit_compiler, *_kernel_cache);
+  auto code_object_configuration_id = binary_configuration_id;
+  kernel_configuration::extend_hash(
+      code_object_configuration_id,
+      kernel_base_config_parameter::runtime_device, device);
+
+  auto jit_compiler = [&](std::string& compiled_image) -> bool {
+    auto err = make_jit_compiler(_config, binary_configuration_id)(compiled_image);
+
     if(!err.is_success()) {
       register_error(err);
       return false;
@@ -14,6 +14,7 @@
 #include "hipSYCL/common/hcf_container.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/generic/async_worker.hpp"
 #include <algorithm>
 #include <cstddef>
 #include <fstream>
@@ -423,12 +424,93 @@ std::shared_ptr<kernel_cache> kernel_cache::get() {
   return c;
 }
 
+kernel_cache::~kernel_cache() = default;
+
 void kernel_cache::unload() {
+  std::unique_ptr<worker_thread> background_worker;
+  {
+    std::lock_guard<std::mutex> lock{_background_mutex};
+    background_worker = std::move(_background_worker);
+  }
+  // Destroying the worker waits for pending background compilations
+  background_worker.reset();
+
   std::lock_guard<std::mutex> lock{_mutex};
 
   _code_objects.clear();
 }
 
+void kernel_cache::compile_in_background(code_object_id id_of_binary,
+                                         background_jit_compiler jit_compile) {
+  std::lock_guard<std::mutex> lock{_background_mutex};
+  if(!_scheduled_background_compilations.insert(id_of_binary).second)
+    return;
+
+  HIPSYCL_DEBUG_INFO << "kernel_cache: Scheduling background compilation for id "
+                     << kernel_configuration::to_string(id_of_binary) << std::endl;
+
+  if(!_background_worker)
+    _background_worker = std::make_unique<worker_thread>();
+
+  (*_background_worker)([this, id_of_binary, jit_compile = std::move(jit_compile)]() {
+    std::string compiled_binary;
+    result err = jit_compile(compiled_binary);
+    if(!err.is_success()) {
+      // Not fatal - the kernel can continue using the binary it already has.
+      HIPSYCL_DEBUG_WARNING << "kernel_cache: Background compilation failed for id "
+                            << kernel_configuration::to_string(id_of_binary) << ": "
+                            << err.what() << std::endl;
+      return;
+    }
+    persistent_cache_store(id_of_binary, compiled_binary);
+
+    HIPSYCL_DEBUG_INFO << "kernel_cache: Background compilation finished for id "
+                       << kernel_configuration::to_string(id_of_binary) << std::endl;
+
+    std::lock_guard<std::mutex> lock{_background_mutex};
+    _background_binaries[id_of_binary] = std::move(compiled_binary);
+  });
+}
+
+bool kernel_cache::is_binary_available(code_object_id id_of_binary) const {
+  {
+    std::lock_guard<std::mutex> lock{_background_mutex};
+    if(_available_binaries.contains(id_of_binary) ||
+       _background_binaries.contains(id_of_binary))
+      return true;
+  }
+
+  bool is_in_persistent_cache = common::filesystem::persistent_storage::get()
+      .get_this_app_db()
+      .read_access([&](const common::db::appdb_data &appdb) {
+        return appdb.binaries.find(id_of_binary) != appdb.binaries.end();
+      });
+
+  if(is_in_persistent_cache) {
+    std::lock_guard<std::mutex> lock{_background_mutex};
+    _available_binaries.insert(id_of_binary);
+  }
+  return is_in_persistent_cache;
+}
+
+std::size_t kernel_cache::register_invocation(code_object_id id_of_binary) {
+  std::lock_guard<std::mutex> lock{_background_mutex};
+  return ++_invocation_counts[id_of_binary];
+}
+
+bool kernel_cache::background_binary_lookup(code_object_id id_of_binary,
+                                            std::string &out) const {
+  std::lock_guard<std::mutex> lock{_background_mutex};
+  auto it = _background_binaries.find(id_of_binary);
+  if(it == _background_binaries.end())
+    return false;
+
+  HIPSYCL_DEBUG_INFO << "kernel_cache: Using binary from background compilation for id "
+                     << kernel_configuration::to_string(id_of_binary) << std::endl;
+  out = it->second;
+  return true;
+}
+
 const code_object* kernel_cache::get_code_object(code_object_id id) const {
   std::lock_guard<std::mutex> lock{_mutex};
   return get_code_object_impl(id);
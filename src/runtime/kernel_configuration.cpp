@@ -22,17 +22,27 @@ public:
       {"known-group-size-y", kernel_build_option::known_group_size_y},
       {"known-group-size-z", kernel_build_option::known_group_size_z},
       {"known-local-mem-size", kernel_build_option::known_local_mem_size},
+      {"known-num-groups-x", kernel_build_option::known_num_groups_x},
+      {"known-num-groups-y", kernel_build_option::known_num_groups_y},
+      {"known-num-groups-z", kernel_build_option::known_num_groups_z},
+      {"pgo-branch-profile", kernel_build_option::pgo_branch_profile},
+      {"noalias-pointer-arguments", kernel_build_option::noalias_pointer_arguments},
       {"ptx-version", kernel_build_option::ptx_version},
       {"ptx-target-device", kernel_build_option::ptx_target_device},
       {"amdgpu-target-device", kernel_build_option::amdgpu_target_device},
       {"rocm-device-libs-path", kernel_build_option::amdgpu_rocm_device_libs_path},
       {"rocm-path", kernel_build_option::amdgpu_rocm_path},
-      {"spirv-dynamic-local-mem-allocation-size", kernel_build_option::spirv_dynamic_local_mem_allocation_size}
+      {"spirv-dynamic-local-mem-allocation-size", kernel_build_option::spirv_dynamic_local_mem_allocation_size},
+      {"host-target-cpu", kernel_build_option::host_target_cpu},
+      {"host-target-features", kernel_build_option::host_target_features},
+      {"host-target-id", kernel_build_option::host_target_id}
     };
 
     _flags = {
       {"global-sizes-fit-in-int", kernel_build_flag::global_sizes_fit_in_int},
       {"fast-math", kernel_build_flag::fast_math},
+      {"baseline-optimization", kernel_build_flag::baseline_optimization},
+      {"pgo-instrumentation", kernel_build_flag::pgo_instrumentation},
       {"ptx-ftz", kernel_build_flag::ptx_ftz},
       {"ptx-approx-div", kernel_build_flag::ptx_approx_div},
       {"ptx-approx-sqrt", kernel_build_flag::ptx_approx_sqrt},
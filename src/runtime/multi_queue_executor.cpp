@@ -28,10 +28,22 @@ namespace rt {
 
 namespace {
 
+// Operation costs mostly depend on the transfer or launch size, so these
+// are grouped by powers of two of the size.
+std::size_t size_class(std::size_t num_bytes) {
+  std::size_t result = 0;
+  while(num_bytes > 1) {
+    num_bytes >>= 1;
+    ++result;
+  }
+  return result;
+}
+
 std::size_t determine_target_lane(const dag_node_ptr& node,
                                   const node_list_t& nonvirtual_reqs,
                                   const multi_queue_executor* executor,
                                   const moving_statistics& device_submission_statistics,
+                                  const lane_occupancy_tracker& occupancy,
                                   backend_execution_lane_range lane_range) {
   if(lane_range.num_lanes <= 1) {
     return lane_range.begin;
@@ -45,29 +57,37 @@ std::size_t determine_target_lane(const dag_node_ptr& node,
   }
 
   common::small_vector<int, 8> synchronization_cost(lane_range.num_lanes);
+  // The operation cannot start before all of its requirements have
+  // completed, no matter which lane it is submitted to.
+  double requirements_ready = 0.0;
 
   for(auto& req : nonvirtual_reqs){
     assert(req);
     assert(req->is_submitted());
 
     std::size_t lane_id = 0;
-    if(executor->find_assigned_lane_index(req, lane_id)) {
+    // Don't consider the event if we already know that it is complete
+    if(!req->is_known_complete() &&
+        executor->find_assigned_lane_index(req, lane_id)) {
+      requirements_ready = std::max(
+          requirements_ready, occupancy.get_expected_completion(lane_id, req));
+
       if (lane_id >= lane_range.begin &&
           lane_id < lane_range.begin + lane_range.num_lanes) {
-        
         std::size_t relative_lane_id = lane_id - lane_range.begin;
-        // Don't consider the event if we already know that it is complete
-        if(!req->is_known_complete()) {
-          ++synchronization_cost[relative_lane_id];
-        }
+        ++synchronization_cost[relative_lane_id];
       }
     }
   }
-  // Select the lane that would have the *highest* synchronization cost,
-  // because by scheduling to this lane all synchronization becomes noops!
-  // If there are multiple lanes with same synchronization cost,
-  // use the one with lower recent utilization
+  // Select the lane on which the operation is expected to start (and
+  // therefore complete) first. Submitting behind long-running operations
+  // in a lane delays the operation, even if it has no dependency on them.
+  // If multiple lanes are expected to be ready at the same time, select the
+  // one with the *highest* synchronization cost, because by scheduling to
+  // this lane all synchronization becomes noops! If there are still
+  // multiple candidates, use the one with lower recent utilization.
   auto lane_usage = device_submission_statistics.build_decaying_bins();
+  double min_start = std::numeric_limits<double>::max();
   int max_sync_cost = 0;
   double min_usage = std::numeric_limits<double>::max();
   std::size_t current_best_lane = lane_range.begin;
@@ -75,17 +95,25 @@ std::size_t determine_target_lane(const dag_node_ptr& node,
   for (std::size_t i = lane_range.begin;
        i < lane_range.begin + lane_range.num_lanes; ++i) {
 
+    double start =
+        std::max(requirements_ready, occupancy.get_expected_backlog(i));
     int sync_cost = synchronization_cost[i-lane_range.begin];
 
-    if(sync_cost > max_sync_cost) {
-      max_sync_cost = synchronization_cost[i-lane_range.begin];
-      current_best_lane = i;
+    bool is_better = false;
+    if(start < min_start) {
+      is_better = true;
+    } else if(start == min_start) {
+      if(sync_cost > max_sync_cost)
+        is_better = true;
+      else if(sync_cost == max_sync_cost && lane_usage[i] < min_usage)
+        is_better = true;
+    }
+
+    if(is_better) {
+      min_start = start;
+      max_sync_cost = sync_cost;
       min_usage = lane_usage[i];
-    } else if(sync_cost == max_sync_cost) {
-      if(lane_usage[i] < min_usage) {
-        min_usage = lane_usage[i];
-        current_best_lane = i;
-      }
+      current_best_lane = i;
     }
   }
 
@@ -96,6 +124,174 @@ std::size_t determine_target_lane(const dag_node_ptr& node,
 
 } // anonymous namespace
 
+lane_occupancy_tracker::lane_occupancy_tracker(std::size_t num_lanes,
+                                               std::size_t sample_interval)
+    : _lanes(num_lanes), _sample_interval{sample_interval} {}
+
+lane_occupancy_tracker::cost_key
+lane_occupancy_tracker::get_cost_key(operation *op) {
+  if(auto* kernel_op = dynamic_cast<kernel_operation*>(op))
+    return cost_key{
+        reinterpret_cast<std::uintptr_t>(kernel_op->get_global_kernel_name()),
+        size_class(kernel_op->get_launcher().get_global_size()) << 2};
+  else if(auto* memcpy_op = dynamic_cast<memcpy_operation*>(op))
+    return cost_key{
+        0, (size_class(memcpy_op->get_num_transferred_bytes()) << 2) | 1};
+  else if(auto* memset_op = dynamic_cast<memset_operation*>(op))
+    return cost_key{0, (size_class(memset_op->get_num_bytes()) << 2) | 2};
+  return cost_key{0, 3};
+}
+
+double lane_occupancy_tracker::estimate_cost(operation *op) const {
+  auto it = _costs.find(get_cost_key(op));
+  if(it != _costs.end() && it->second.num_samples > 0)
+    return it->second.mean_ns;
+
+  // Without measurements, assume the average cost of all measured
+  // operations. If there are none, all operations are assumed to have
+  // the same cost, and lanes are compared by their number of outstanding
+  // operations.
+  if(_num_measured_costs > 0)
+    return _total_measured_cost / _num_measured_costs;
+  return 1.0;
+}
+
+bool lane_occupancy_tracker::should_sample(operation *op) {
+  cost_estimate& c = _costs[get_cost_key(op)];
+  std::size_t submission = c.num_submissions++;
+
+  if(_sample_interval == 0)
+    return false;
+  // Measure the first submissions so that new kernels are quickly
+  // represented accurately.
+  constexpr std::size_t num_initial_samples = 2;
+  return submission < num_initial_samples ||
+         submission % _sample_interval == 0;
+}
+
+void lane_occupancy_tracker::insert(std::size_t lane, const dag_node_ptr &node,
+                                    operation *op) {
+  assert(lane < _lanes.size());
+  auto& l = _lanes[lane];
+  l.inserted_cost += estimate_cost(op);
+  l.submissions.push_back(
+      submission{node, node.get(), get_cost_key(op), l.inserted_cost});
+  l.expected_ends[node.get()] = l.inserted_cost;
+}
+
+void lane_occupancy_tracker::update(std::size_t lane, inorder_queue *q) {
+  assert(lane < _lanes.size());
+
+  _pending_samples.erase(
+      std::remove_if(_pending_samples.begin(), _pending_samples.end(),
+                     [this](const submission &s) { return learn(s); }),
+      _pending_samples.end());
+
+  auto& l = _lanes[lane];
+  if(l.submissions.empty())
+    return;
+
+  // If the queue has no outstanding work, we do not need to query
+  // the individual submissions.
+  inorder_queue_status status;
+  bool is_idle = q->query_status(status).is_success() && status.is_complete();
+
+  while(!l.submissions.empty()) {
+    const submission& s = l.submissions.front();
+    auto node = s.node.lock();
+    // Lanes are in-order, so once we encounter an incomplete
+    // submission, all subsequent submissions are incomplete as well.
+    if(!is_idle && node && !node->is_complete())
+      break;
+    if(node && !learn(s)) {
+      // Bound the number of retained samples in case timestamps of
+      // some submissions never become available.
+      constexpr std::size_t max_pending_samples = 64;
+      if(_pending_samples.size() >= max_pending_samples)
+        _pending_samples.erase(_pending_samples.begin());
+      _pending_samples.push_back(s);
+    }
+    retire(l, s);
+    l.submissions.pop_front();
+  }
+
+  // Start over from zero, such that the running sums do not lose
+  // precision over time.
+  if(l.submissions.empty()) {
+    l.inserted_cost = 0.0;
+    l.retired_cost = 0.0;
+  }
+}
+
+double lane_occupancy_tracker::get_expected_backlog(std::size_t lane) const {
+  assert(lane < _lanes.size());
+  return _lanes[lane].inserted_cost - _lanes[lane].retired_cost;
+}
+
+double
+lane_occupancy_tracker::get_expected_completion(std::size_t lane,
+                                                const dag_node_ptr &node) const {
+  if(lane >= _lanes.size())
+    return 0.0;
+
+  const auto& l = _lanes[lane];
+  auto it = l.expected_ends.find(node.get());
+  if(it == l.expected_ends.end())
+    return 0.0;
+  return it->second - l.retired_cost;
+}
+
+void lane_occupancy_tracker::retire(lane &l, const submission &s) {
+  l.retired_cost = s.expected_end;
+  // The address may have been reused by a newer submission if the
+  // node was destroyed in the meantime.
+  auto it = l.expected_ends.find(s.node_address);
+  if(it != l.expected_ends.end() && it->second == s.expected_end)
+    l.expected_ends.erase(it);
+}
+
+bool lane_occupancy_tracker::learn(const submission &s) {
+  auto node = s.node.lock();
+  if(!node || node->is_cancelled())
+    return true;
+
+  const execution_hints& hints = node->get_execution_hints();
+  if(!hints.has_hint<hints::request_instrumentation_start_timestamp>() ||
+     !hints.has_hint<hints::request_instrumentation_finish_timestamp>())
+    return true;
+
+  operation* op = node->get_operation();
+  auto start =
+      op->get_instrumentations()
+          .get_if_available<instrumentations::execution_start_timestamp>();
+  auto finish =
+      op->get_instrumentations()
+          .get_if_available<instrumentations::execution_finish_timestamp>();
+  if(!start || !finish)
+    return false;
+
+  double duration_ns =
+      static_cast<double>(profiler_clock::ns_ticks(finish->get_time_point())) -
+      static_cast<double>(profiler_clock::ns_ticks(start->get_time_point()));
+  if(duration_ns < 0.0)
+    return true;
+
+  cost_estimate& c = _costs[s.key];
+  // Exponential moving average, such that the estimate adapts if the
+  // cost of a kernel changes over time.
+  constexpr double weight = 0.25;
+  double previous_mean = c.mean_ns;
+  if(c.num_samples == 0) {
+    c.mean_ns = duration_ns;
+    ++_num_measured_costs;
+  } else {
+    c.mean_ns = (1.0 - weight) * c.mean_ns + weight * duration_ns;
+  }
+  _total_measured_cost += c.mean_ns - previous_mean;
+  ++c.num_samples;
+  return true;
+}
+
 multi_queue_executor::multi_queue_executor(
     const backend &b, queue_factory_function queue_factory)
     : _backend{b.get_unique_backend_id()} {
@@ -141,6 +337,10 @@ multi_queue_executor::multi_queue_executor(
         max_statistics_size,
         _device_data[dev].executors_size(),
         static_cast<std::size_t>(1e9 * statistics_decay_time_sec)};
+    _device_data[dev].occupancy = lane_occupancy_tracker{
+        _device_data[dev].executors_size(),
+        application::get_settings()
+            .get<setting::mqe_lane_timing_sample_interval>()};
   }
 
   HIPSYCL_DEBUG_INFO << "multi_queue_executor: Spawned for backend "
@@ -200,23 +400,34 @@ void multi_queue_executor::submit_directly(
     return;
 
   std::size_t op_target_lane;
+  per_device_data& data = _device_data[node->get_assigned_device().get_id()];
+  {
+    std::lock_guard<std::mutex> lock{data.occupancy_lock};
+
+    for(std::size_t i = 0; i < data.executors_size(); ++i)
+      data.occupancy.update(i, data.executors_at(i)->get_queue());
+
+    if (op->is_data_transfer()) {
+      op_target_lane = determine_target_lane(
+          node, reqs, this, data.submission_statistics, data.occupancy,
+          data.memcpy_lanes);
+    } else {
+      op_target_lane = determine_target_lane(
+          node, reqs, this, data.submission_statistics, data.occupancy,
+          data.kernel_lanes);
+    }
+    data.submission_statistics.insert(op_target_lane);
 
-  if (op->is_data_transfer()) {
-    op_target_lane = determine_target_lane(
-        node, reqs, this,
-        _device_data[node->get_assigned_device().get_id()].submission_statistics,
-        _device_data[node->get_assigned_device().get_id()].memcpy_lanes);
-  } else {
-    op_target_lane = determine_target_lane(
-        node, reqs, this,
-        _device_data[node->get_assigned_device().get_id()].submission_statistics,
-        _device_data[node->get_assigned_device().get_id()].kernel_lanes);
+    if(data.occupancy.should_sample(op)) {
+      node->get_execution_hints().set_hint(
+          hints::request_instrumentation_start_timestamp{});
+      node->get_execution_hints().set_hint(
+          hints::request_instrumentation_finish_timestamp{});
+    }
+    data.occupancy.insert(op_target_lane, node, op);
   }
-  _device_data[node->get_assigned_device().get_id()]
-      .submission_statistics.insert(op_target_lane);
   
-  inorder_executor* executor = _device_data[node->get_assigned_device().get_id()]
-      .executors_at(op_target_lane);
+  inorder_executor* executor = data.executors_at(op_target_lane);
 
   HIPSYCL_DEBUG_INFO
       << "multi_queue_executor: Dispatching to lane " << op_target_lane << ": "
@@ -248,11 +459,16 @@ bool multi_queue_executor::find_assigned_lane_index(
   if(!node->is_submitted())
     return false;
 
+  if(node->get_assigned_device().get_backend() != _backend)
+    return false;
+
   std::size_t dev_id = node->get_assigned_device().get_id();
   std::size_t lane_id = 0;
 
+  // Nodes submitted through this executor are assigned to this executor,
+  // not to the inorder_executor of the lane, so compare the lanes instead.
   for(const auto& executor : _device_data[dev_id].executors) {
-    if(executor->is_submitted_by_me(node)) {
+    if(node->get_assigned_execution_lane() == executor->get_queue()) {
       index_out = lane_id;
       return true;
     }
@@ -262,5 +478,13 @@ bool multi_queue_executor::find_assigned_lane_index(
 
   return false;
 }
+
+inorder_executor *
+multi_queue_executor::get_lane_executor(device_id dev, std::size_t lane) const {
+  assert(dev.get_id() < _device_data.size());
+  assert(lane < _device_data[dev.get_id()].executors.size());
+  return _device_data[dev.get_id()].executors[lane];
+}
+
 }
 }
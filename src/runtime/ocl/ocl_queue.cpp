@@ -491,6 +491,35 @@ result ocl_queue::submit_sscp_kernel_from_code_object(
   // config.set_build_flag(kernel_build_flag::spirv_enable_intel_llvm_spirv_options);
 
   auto binary_configuration_id = adaptivity_engine.finalize_binary_configuration(_config);
+
+  auto get_image_and_kernel_names =
+      [&](std::vector<std::string> &contained_kernels) -> std::string {
+    return adaptivity_engine.select_image_and_kernels(&contained_kernels);
+  };
+
+  auto make_jit_compiler = [&](const kernel_configuration &config,
+                               kernel_configuration::id_type binary_id) {
+    std::vector<std::string> kernel_names;
+    std::string selected_image_name = get_image_and_kernel_names(kernel_names);
+
+    return [=](std::string &compiled_image) -> result {
+      // Construct SPIR-V translator to compile the specified kernels
+      std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
+        compiler::createLLVMToSpirvTranslator(kernel_names);
+
+      // Lower kernels to SPIR-V
+      if(kernel_names.size() == 1) {
+        return glue::jit::dead_argument_elimination::compile_kernel(
+            translator.get(), hcf_object, selected_image_name, config,
+            binary_id, compiled_image);
+      }
+      return glue::jit::compile(translator.get(),
+        hcf_object, selected_image_name, config, compiled_image);
+    };
+  };
+
+  binary_configuration_id = adaptivity_engine.select_compilation_tier(
+      _config, binary_configuration_id, make_jit_compiler, *_kernel_cache);
   auto code_object_configuration_id = binary_configuration_id;
   kernel_configuration::extend_hash(
       code_object_configuration_id,
@@ -499,30 +528,9 @@ result ocl_queue::submit_sscp_kernel_from_code_object(
       code_object_configuration_id,
       kernel_base_config_parameter::runtime_context, ctx.get());
 
- 
-
-  
   auto jit_compiler = [&](std::string& compiled_image) -> bool {
-    
-    std::vector<std::string> kernel_names;
-    std::string selected_image_name =
-        adaptivity_engine.select_image_and_kernels(&kernel_names);
+    auto err = make_jit_compiler(_config, binary_configuration_id)(compiled_image);
 
-    // Construct SPIR-V translator to compile the specified kernels
-    std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
-      std::move(compiler::createLLVMToSpirvTranslator(kernel_names));
-    
-    // Lower kernels to SPIR-V
-    rt::result err;
-    if(kernel_names.size() == 1) {
-      err = glue::jit::dead_argument_elimination::compile_kernel(
-          translator.get(), hcf_object, selected_image_name, _config,
-          binary_configuration_id, compiled_image);
-    } else {
-      err = glue::jit::compile(translator.get(),
-        hcf_object, selected_image_name, _config, compiled_image);
-    }
-    
     if(!err.is_success()) {
       register_error(err);
       return false;
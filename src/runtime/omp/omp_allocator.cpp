@@ -10,6 +10,7 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #include <cstdlib>
 
+#include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/omp/omp_allocator.hpp"
@@ -19,9 +20,13 @@ namespace hipsycl {
 namespace rt {
 
 omp_allocator::omp_allocator(const device_id &my_device)
-    : _my_device{my_device} {}
+    : _my_device{my_device},
+      _track_allocations{application::get_settings()
+                             .get<setting::jitopt_noalias_inference>()} {}
 
-void *omp_allocator::allocate(size_t min_alignment, size_t size_bytes) {
+namespace {
+
+void *allocate_host_memory(size_t min_alignment, size_t size_bytes) {
 #if !defined(_WIN32)
   // posix requires alignment to be a multiple of sizeof(void*)
   if (min_alignment < sizeof(void*))
@@ -50,12 +55,27 @@ void *omp_allocator::allocate(size_t min_alignment, size_t size_bytes) {
 #endif
 }
 
+}
+
+void *omp_allocator::allocate(size_t min_alignment, size_t size_bytes) {
+  void *mem = allocate_host_memory(min_alignment, size_bytes);
+  if(_track_allocations && mem && size_bytes > 0) {
+    std::lock_guard<std::mutex> lock{_allocation_mutex};
+    _allocations[reinterpret_cast<std::uintptr_t>(mem)] = size_bytes;
+  }
+  return mem;
+}
+
 void *omp_allocator::allocate_optimized_host(size_t min_alignment,
                                              size_t bytes) {
   return this->allocate(min_alignment, bytes);
 };
 
 void omp_allocator::free(void *mem) {
+  if(_track_allocations) {
+    std::lock_guard<std::mutex> lock{_allocation_mutex};
+    _allocations.erase(reinterpret_cast<std::uintptr_t>(mem));
+  }
 #if !defined(_WIN32)
   std::free(mem);
 #else
@@ -85,6 +105,30 @@ result omp_allocator::query_pointer(const void *ptr, pointer_info &out) const {
   return make_success();
 }
 
+result omp_allocator::query_allocation_range(const void *ptr,
+                                             const void *&base_out,
+                                             std::size_t &size_out) const {
+  if(!_track_allocations)
+    return backend_allocator::query_allocation_range(ptr, base_out, size_out);
+
+  auto address = reinterpret_cast<std::uintptr_t>(ptr);
+
+  std::lock_guard<std::mutex> lock{_allocation_mutex};
+  auto it = _allocations.upper_bound(address);
+  if(it != _allocations.begin()) {
+    --it;
+    if(address < it->first + it->second) {
+      base_out = reinterpret_cast<const void *>(it->first);
+      size_out = it->second;
+      return make_success();
+    }
+  }
+  return make_error(__acpp_here(),
+                    error_info{"omp_allocator: Pointer does not belong to a "
+                               "known allocation",
+                               error_type::invalid_parameter_error});
+}
+
 result omp_allocator::mem_advise(const void *addr, std::size_t num_bytes,
                                  int advise) const {
   HIPSYCL_DEBUG_WARNING << "omp_allocator: Ignoring mem_advise() hint"
@@ -21,6 +21,7 @@
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/common/filesystem.hpp"
 #include "hipSYCL/common/hcf_container.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/host/LLVMToHostFactory.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/dylib_loader.hpp"
@@ -63,11 +64,18 @@ omp_sscp_executable_object::omp_sscp_executable_object(
     const std::vector<std::string> &kernel_names,
     const kernel_configuration &config)
     : _hcf{hcf_source}, _id{config.generate_id()}, _module{nullptr},
+      _is_jit_linked{false},
       _kernel_cache_path(kernel_cache::get_persistent_cache_file(_id) + ".so") {
   _build_result = build(binary, kernel_names);
 }
 
 omp_sscp_executable_object::~omp_sscp_executable_object() {
+  if (_is_jit_linked) {
+    if (_module)
+      compiler::unloadHostObject(_module);
+    return;
+  }
+
   if (_module)
     detail::close_library(_module, "omp_sscp_executable");
   if(!common::filesystem::remove(_kernel_cache_path)) {
@@ -115,15 +123,26 @@ result omp_sscp_executable_object::build(
   if (_module != nullptr)
     return make_success();
 
-  if (auto result = make_shared_library_from_blob(_module, source, _kernel_cache_path);
-      !result.is_success())
+  // Relocatable objects are produced by in-process code generation and are
+  // linked directly into the process, without going through the file system.
+  _is_jit_linked = compiler::isRelocatableHostObject(source);
+  if (_is_jit_linked) {
+    std::string error;
+    _module = compiler::loadHostObject(source, error);
+    if (!_module)
+      return make_error(__acpp_here(),
+                        error_info{"omp_sscp_executable_object: could not link "
+                                   "kernel object: " + error});
+  } else if (auto result = make_shared_library_from_blob(
+                 _module, source, _kernel_cache_path);
+             !result.is_success()) {
     return result;
+  }
 
   _kernel_names = kernel_names;
   // find all kernel symbols
   for (const auto &kernel_name : _kernel_names) {
-    if (auto kernel = (omp_sscp_kernel *)detail::get_symbol_from_library(
-            _module, kernel_name, "omp_sscp_exectuable_object")) {
+    if (auto kernel = (omp_sscp_kernel *)get_symbol(kernel_name)) {
       _kernels.emplace(kernel_name, kernel);
     } else {
       return make_error(__acpp_here(),
@@ -143,6 +162,27 @@ bool omp_sscp_executable_object::contains(
   return false;
 }
 
+void *omp_sscp_executable_object::get_symbol(
+    const std::string &symbol_name) const {
+  return _is_jit_linked
+             ? compiler::getHostObjectSymbol(_module, symbol_name)
+             : detail::get_symbol_from_library(_module, symbol_name,
+                                               "omp_sscp_exectuable_object");
+}
+
+std::vector<uint64_t> omp_sscp_executable_object::take_pgo_branch_counters() const {
+  // These symbols are emitted by the BranchProfileInstrumentationPass
+  auto *num_counters =
+      static_cast<const uint64_t *>(get_symbol("__acpp_sscp_pgo_num_counters"));
+  auto *counters = static_cast<uint64_t *>(get_symbol("__acpp_sscp_pgo_counters"));
+  if (!num_counters || !counters)
+    return {};
+
+  std::vector<uint64_t> result(counters, counters + *num_counters);
+  std::fill(counters, counters + *num_counters, 0);
+  return result;
+}
+
 omp_sscp_executable_object::omp_sscp_kernel *
 omp_sscp_executable_object::get_kernel(std::string_view backend_kernel_name) const {
   auto it = _kernels.find(backend_kernel_name);
@@ -20,6 +20,7 @@
 #include "hipSYCL/runtime/inorder_queue.hpp"
 #include "hipSYCL/runtime/instrumentation.hpp"
 #include "hipSYCL/runtime/kernel_launcher.hpp"
+#include "hipSYCL/runtime/omp/omp_backend.hpp"
 #include "hipSYCL/runtime/omp/omp_event.hpp"
 #include "hipSYCL/runtime/operations.hpp"
 #include "hipSYCL/runtime/queue_completion_event.hpp"
@@ -32,6 +33,7 @@
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
 #include "hipSYCL/runtime/adaptivity_engine.hpp"
 #include "hipSYCL/runtime/omp/omp_code_object.hpp"
+#include "hipSYCL/common/stable_running_hash.hpp"
 
 #ifndef WIN32
 #include <unistd.h>
@@ -90,6 +92,10 @@ public:
 
   virtual void wait() const override { _signal.wait(); }
 
+  virtual bool is_available() const override {
+    return _signal.has_signalled();
+  }
+
 private:
   // This should only be called once by the instrumentation_task_guard
   void record_time() {
@@ -175,6 +181,32 @@ private:
 
 #ifdef HIPSYCL_WITH_SSCP_COMPILER
 
+// The microarchitecture of the executing CPU, which is queried only once
+// since the feature string can be long.
+struct host_target {
+  std::string cpu;
+  std::string features;
+  // Identifies cpu and features in kernel configuration ids
+  uint64_t id;
+
+  static const host_target& get() {
+    static const host_target target = [] {
+      host_target t;
+      t.cpu = compiler::getHostTargetCPU();
+      t.features = compiler::getHostTargetFeatures();
+
+      common::stable_running_hash hash;
+      std::size_t cpu_size = t.cpu.size();
+      hash(&cpu_size, sizeof(cpu_size));
+      hash(t.cpu.data(), t.cpu.size());
+      hash(t.features.data(), t.features.size());
+      t.id = hash.get_current_hash();
+      return t;
+    }();
+    return target;
+  }
+};
+
 std::size_t get_page_size() {
 #ifndef WIN32
   return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
@@ -189,7 +221,8 @@ result
 launch_kernel_from_so(omp_sscp_executable_object::omp_sscp_kernel *kernel,
                       const rt::range<3> &num_groups,
                       const rt::range<3> &local_size, unsigned shared_memory,
-                      void **kernel_args) {
+                      void **kernel_args,
+                      const host_launch_configuration &launch_config) {
   if (num_groups.size() == 1 && shared_memory == 0) {
     omp_sscp_executable_object::work_group_info info{
         num_groups, rt::id<3>{0, 0, 0}, local_size, nullptr};
@@ -218,16 +251,59 @@ launch_kernel_from_so(omp_sscp_executable_object::omp_sscp_kernel *kernel,
         next_multiple_of(reinterpret_cast<std::uint64_t>(local_memory.data()),
                          local_mem_alignment));
 
+    auto run_group = [&](std::size_t i, std::size_t j, std::size_t k) {
+      omp_sscp_executable_object::work_group_info info{
+          num_groups, rt::id<3>{i, j, k}, local_size, aligned_local_memory};
+      kernel(&info, kernel_args);
+    };
+
+    const std::size_t groups_per_chunk = launch_config.groups_per_chunk;
+
+    if(launch_config.flatten) {
+      const std::size_t total_num_groups = num_groups.size();
+      auto run_linear_group = [&](std::size_t linear_id) {
+        std::size_t i = linear_id % num_groups.get(0);
+        std::size_t j = (linear_id / num_groups.get(0)) % num_groups.get(1);
+        std::size_t k = linear_id / (num_groups.get(0) * num_groups.get(1));
+        run_group(i, j, k);
+      };
+
+      if(groups_per_chunk == 0) {
 #ifdef _OPENMP
-#pragma omp for collapse(3)
+#pragma omp for schedule(static)
 #endif
-    for (int k = 0; k < num_groups.get(2); ++k) {
-      for (std::size_t j = 0; j < num_groups.get(1); ++j) {
-        for (std::size_t i = 0; i < num_groups.get(0); ++i) {
-          omp_sscp_executable_object::work_group_info info{
-              num_groups, rt::id < 3 > {i, j, std::size_t(k)}, local_size, aligned_local_memory };
-          kernel(&info, kernel_args);
-        }
+        for(std::size_t g = 0; g < total_num_groups; ++g)
+          run_linear_group(g);
+      } else {
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, groups_per_chunk)
+#endif
+        for(std::size_t g = 0; g < total_num_groups; ++g)
+          run_linear_group(g);
+      }
+    } else {
+      // Distribute rows of work groups, such that consecutive work groups
+      // along dimension 0 are processed by the same thread.
+      const std::size_t num_rows = num_groups.get(1) * num_groups.get(2);
+      auto run_row = [&](std::size_t row) {
+        std::size_t j = row % num_groups.get(1);
+        std::size_t k = row / num_groups.get(1);
+        for(std::size_t i = 0; i < num_groups.get(0); ++i)
+          run_group(i, j, k);
+      };
+
+      if(groups_per_chunk == 0) {
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for(std::size_t row = 0; row < num_rows; ++row)
+          run_row(row);
+      } else {
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, groups_per_chunk)
+#endif
+        for(std::size_t row = 0; row < num_rows; ++row)
+          run_row(row);
       }
     }
   }
@@ -236,8 +312,8 @@ launch_kernel_from_so(omp_sscp_executable_object::omp_sscp_kernel *kernel,
 #endif
 } // namespace
 
-omp_queue::omp_queue(backend_id id)
-    : _backend_id(id), _sscp_code_object_invoker{this},
+omp_queue::omp_queue(omp_backend *be, backend_id id)
+    : _backend{be}, _backend_id(id), _sscp_code_object_invoker{this},
       _kernel_cache{kernel_cache::get()} {}
 
 omp_queue::~omp_queue() { _worker.halt(); }
@@ -422,28 +498,54 @@ result omp_queue::submit_sscp_kernel_from_code_object(
   _config.append_base_configuration(
       kernel_base_config_parameter::hcf_object_id, hcf_object);
 
+  // Target the microarchitecture of the executing CPU. As part of the
+  // configuration id, this ensures that binaries from the persistent cache
+  // are only reused on matching CPUs. The CPU name and features themselves
+  // are only passed on when JIT-compiling.
+  _config.set_build_option(kernel_build_option::host_target_id,
+                           host_target::get().id);
+
   auto binary_configuration_id =
       adaptivity_engine.finalize_binary_configuration(_config);
-  auto code_object_configuration_id = binary_configuration_id;
 
   auto get_image_and_kernel_names =
       [&](std::vector<std::string> &contained_kernels) -> std::string {
     return adaptivity_engine.select_image_and_kernels(&contained_kernels);
   };
 
-  auto jit_compiler = [&](std::string &compiled_image) -> bool {
-    const common::hcf_container *hcf = rt::hcf_cache::get().get_hcf(hcf_object);
-
+  auto make_jit_compiler = [&](const kernel_configuration &config,
+                               kernel_configuration::id_type binary_id) {
     std::vector<std::string> kernel_names;
     std::string selected_image_name = get_image_and_kernel_names(kernel_names);
 
-    // Construct Host translator to compile the specified kernels
-    std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
-        compiler::createLLVMToHostTranslator(kernel_names);
+    return [=](std::string &compiled_image) -> result {
+      // Construct Host translator to compile the specified kernels
+      std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
+          compiler::createLLVMToHostTranslator(kernel_names);
+
+      kernel_configuration host_config = config;
+      host_config.set_build_option(kernel_build_option::host_target_cpu,
+                                   host_target::get().cpu);
+      host_config.set_build_option(kernel_build_option::host_target_features,
+                                   host_target::get().features);
+
+      // Lower kernels to binary
+      return glue::jit::compile(translator.get(), hcf_object,
+                                selected_image_name, host_config,
+                                compiled_image);
+    };
+  };
 
-    // Lower kernels to binary
-    auto err = glue::jit::compile(translator.get(), hcf, selected_image_name,
-                                  _config, compiled_image);
+  binary_configuration_id = adaptivity_engine.select_noalias_variant(
+      _config, binary_configuration_id, _backend->get_allocator(get_device()));
+  binary_configuration_id =
+      adaptivity_engine.select_pgo_variant(_config, binary_configuration_id);
+  binary_configuration_id = adaptivity_engine.select_compilation_tier(
+      _config, binary_configuration_id, make_jit_compiler, *_kernel_cache);
+  auto code_object_configuration_id = binary_configuration_id;
+
+  auto jit_compiler = [&](std::string &compiled_image) -> bool {
+    auto err = make_jit_compiler(_config, binary_configuration_id)(compiled_image);
 
     if (!err.is_success()) {
       register_error(err);
@@ -483,12 +585,31 @@ result omp_queue::submit_sscp_kernel_from_code_object(
                       error_info{"omp_queue: Code object construction failed"});
   }
 
-  auto kernel =
-      static_cast<const omp_sscp_executable_object *>(obj)->get_kernel(
-          kernel_name);
+  auto exec_obj = static_cast<const omp_sscp_executable_object *>(obj);
+  auto kernel = exec_obj->get_kernel(kernel_name);
+
+  host_launch_configuration launch_config =
+      adaptivity_engine.select_host_launch_configuration();
+
+  result err = make_success();
+  if(launch_config.candidate < 0) {
+    err = launch_kernel_from_so(kernel, num_groups, group_size, local_mem_size,
+                                _arg_mapper.get_mapped_args(), launch_config);
+  } else {
+    auto start = profiler_clock::now();
+    err = launch_kernel_from_so(kernel, num_groups, group_size, local_mem_size,
+                                _arg_mapper.get_mapped_args(), launch_config);
+    auto stop = profiler_clock::now();
+    if(err.is_success())
+      adaptivity_engine.register_host_launch_timing(
+          launch_config,
+          profiler_clock::ns_ticks(stop) - profiler_clock::ns_ticks(start));
+  }
 
-  return launch_kernel_from_so(kernel, num_groups, group_size, local_mem_size,
-                               _arg_mapper.get_mapped_args());
+  if(err.is_success() && adaptivity_engine.is_pgo_training_launch())
+    adaptivity_engine.register_pgo_branch_counters(
+        exec_obj->take_pgo_branch_counters());
+  return err;
 
 #else
   return make_error(
@@ -40,6 +40,17 @@ kernel_operation::kernel_operation(
   }
 }
 
+kernel_operation::kernel_operation(const char *kernel_name,
+                                   kernel_launcher &&launcher,
+                                   const node_list_t &requirements)
+    : _kernel_name{kernel_name}, _launcher{std::move(launcher)},
+      _requirements{requirements} {}
+
+std::unique_ptr<operation> kernel_operation::clone() const {
+  return std::unique_ptr<operation>{
+      new kernel_operation{_kernel_name, _launcher.clone(), _requirements}};
+}
+
 kernel_launcher& 
 kernel_operation::get_launcher()
 { return _launcher; }
@@ -158,5 +169,9 @@ const memory_location& memcpy_operation::dest() const { return _dest; }
 
 bool memcpy_operation::is_data_transfer() const { return true; }
 
+std::unique_ptr<operation> memcpy_operation::clone() const {
+  return std::make_unique<memcpy_operation>(_source, _dest, _num_elements);
+}
+
 }
 }
@@ -15,7 +15,7 @@ namespace hipsycl {
 namespace rt {
 
 runtime::runtime()
-: _dag_manager{this}
+: _usm_pools{&_backends}, _dag_manager{this}
 {
   HIPSYCL_DEBUG_INFO << "runtime: ******* rt launch initiated ********"
                       << std::endl;
@@ -0,0 +1,245 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/usm_memory_pool.hpp"
+#include "hipSYCL/runtime/allocator.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+// All blocks are multiples of this size, such that blocks freed for
+// slightly different request sizes can serve each other.
+constexpr std::size_t allocation_granularity = 512;
+
+std::size_t round_up(std::size_t x, std::size_t multiple) {
+  return ((x + multiple - 1) / multiple) * multiple;
+}
+
+bool is_aligned(const void* ptr, std::size_t alignment) {
+  if(alignment == 0)
+    return true;
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+}
+
+usm_memory_pool::usm_memory_pool(device_id dev, backend_allocator *alloc,
+                                 std::size_t release_threshold)
+    : _dev{dev}, _allocator{alloc}, _release_threshold{release_threshold} {}
+
+usm_memory_pool::~usm_memory_pool() {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  for(auto& b : _free_blocks) {
+    for(auto& dep : b.second.release_dependencies)
+      dep->wait();
+    _allocator->free(b.second.ptr);
+  }
+  _free_blocks.clear();
+
+  if(!_live_blocks.empty()) {
+    HIPSYCL_DEBUG_WARNING << "usm_memory_pool: " << _live_blocks.size()
+                          << " pool allocation(s) were never freed, releasing "
+                             "them at pool destruction"
+                          << std::endl;
+    for(auto& b : _live_blocks)
+      _allocator->free(b.first);
+    _live_blocks.clear();
+  }
+}
+
+void *usm_memory_pool::allocate(std::size_t min_alignment,
+                                std::size_t size_bytes,
+                                usm_pool_stream_id stream) {
+  std::size_t alignment = std::max(min_alignment, allocation_granularity);
+  std::size_t block_size = round_up(std::max(size_bytes, std::size_t{1}),
+                                    alignment);
+
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  // Only consider blocks that do not waste more than half of their size,
+  // so that large blocks remain available for large requests.
+  for (auto it = _free_blocks.lower_bound(block_size);
+       it != _free_blocks.end() && it->first <= 2 * block_size; ++it) {
+    if(is_aligned(it->second.ptr, min_alignment) &&
+        is_reusable(it->second, stream)) {
+      void* ptr = it->second.ptr;
+      _cached_bytes -= it->first;
+      _live_blocks[ptr] = it->first;
+      _free_blocks.erase(it);
+      return ptr;
+    }
+  }
+
+  void* ptr = _allocator->allocate(alignment, block_size);
+  if(!ptr && !_free_blocks.empty()) {
+    HIPSYCL_DEBUG_INFO << "usm_memory_pool: Backend allocation failed, "
+                          "releasing cached blocks and retrying"
+                       << std::endl;
+    release_completed_blocks(0);
+    ptr = _allocator->allocate(alignment, block_size);
+  }
+  if(!ptr)
+    return nullptr;
+
+  _reserved_bytes += block_size;
+  _live_blocks[ptr] = block_size;
+  return ptr;
+}
+
+result usm_memory_pool::free(void *ptr, usm_pool_stream_id stream,
+                             const node_list_t &release_dependencies) {
+  if(!ptr)
+    return make_success();
+
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  auto it = _live_blocks.find(ptr);
+  if(it == _live_blocks.end()) {
+    return make_error(
+        __acpp_here(),
+        error_info{"usm_memory_pool: Attempted to free pointer that was not "
+                   "allocated from this pool",
+                   error_type::invalid_parameter_error});
+  }
+
+  block b{ptr, it->second, stream, {}};
+  for(const auto& dep : release_dependencies)
+    if(dep && !dep->is_known_complete())
+      b.release_dependencies.push_back(dep);
+
+  _live_blocks.erase(it);
+  _cached_bytes += b.size;
+  _free_blocks.emplace(b.size, std::move(b));
+
+  if(_cached_bytes > _release_threshold)
+    release_completed_blocks(_release_threshold);
+
+  return make_success();
+}
+
+void usm_memory_pool::trim(std::size_t min_bytes_to_keep) {
+  std::vector<block> blocks_to_release;
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+
+    // Release largest blocks first to hit the target with few backend frees
+    for (auto it = _free_blocks.end();
+         it != _free_blocks.begin() && _cached_bytes > min_bytes_to_keep;) {
+      --it;
+      _cached_bytes -= it->first;
+      _reserved_bytes -= it->first;
+      blocks_to_release.push_back(std::move(it->second));
+      it = _free_blocks.erase(it);
+    }
+  }
+
+  // Blocks may still be in use by outstanding operations. Waiting for them
+  // must not block allocations and frees of other threads.
+  for(auto& b : blocks_to_release) {
+    for(auto& dep : b.release_dependencies)
+      dep->wait();
+    _allocator->free(b.ptr);
+  }
+}
+
+void usm_memory_pool::set_release_threshold(std::size_t bytes) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  _release_threshold = bytes;
+  if(_cached_bytes > _release_threshold)
+    release_completed_blocks(_release_threshold);
+}
+
+std::size_t usm_memory_pool::get_release_threshold() const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _release_threshold;
+}
+
+std::size_t usm_memory_pool::get_reserved_size() const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _reserved_bytes;
+}
+
+std::size_t usm_memory_pool::get_used_size() const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _reserved_bytes - _cached_bytes;
+}
+
+bool usm_memory_pool::owns(const void *ptr) const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _live_blocks.find(const_cast<void *>(ptr)) != _live_blocks.end();
+}
+
+device_id usm_memory_pool::get_device() const {
+  return _dev;
+}
+
+bool usm_memory_pool::is_reusable(block &b, usm_pool_stream_id stream) const {
+  if(stream != 0 && b.stream == stream)
+    return true;
+
+  for(const auto& dep : b.release_dependencies)
+    if(!dep->is_complete())
+      return false;
+
+  // Once all dependencies have completed, the block is no longer
+  // bound to its stream.
+  b.release_dependencies.clear();
+  b.stream = 0;
+  return true;
+}
+
+void usm_memory_pool::release_completed_blocks(std::size_t max_cached_bytes) {
+  for (auto it = _free_blocks.end();
+       it != _free_blocks.begin() && _cached_bytes > max_cached_bytes;) {
+    --it;
+    if(is_reusable(it->second, 0))
+      it = release_block(it);
+  }
+}
+
+usm_memory_pool::free_list_t::iterator
+usm_memory_pool::release_block(free_list_t::iterator it) {
+  _allocator->free(it->second.ptr);
+  _cached_bytes -= it->first;
+  _reserved_bytes -= it->first;
+  return _free_blocks.erase(it);
+}
+
+usm_memory_pool_manager::usm_memory_pool_manager(backend_manager *backends)
+    : _backends{backends} {}
+
+usm_memory_pool *usm_memory_pool_manager::get_pool(device_id dev) {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  for(auto& pool : _pools)
+    if(pool->get_device() == dev)
+      return pool.get();
+
+  backend_allocator *alloc =
+      _backends->get(dev.get_backend())->get_allocator(dev);
+  std::size_t threshold = application::get_settings()
+                              .get<setting::usm_pool_release_threshold>();
+
+  _pools.emplace_back(std::make_unique<usm_memory_pool>(dev, alloc, threshold));
+  return _pools.back().get();
+}
+
+}
+}
@@ -0,0 +1,113 @@
+// RUN: env ACPP_DEBUG_LEVEL=3 %acpp %s -o %t --acpp-targets=omp --acpp-use-accelerated-cpu 2>&1 | FileCheck %s --check-prefix=O0
+// RUN: %t | FileCheck %s
+// RUN: env ACPP_DEBUG_LEVEL=3 %acpp %s -o %t --acpp-targets=omp --acpp-use-accelerated-cpu -O 2>&1 | FileCheck %s --check-prefix=BARRIERS
+// RUN: %t | FileCheck %s
+
+#include <iostream>
+
+#include <CL/sycl.hpp>
+
+// O0-NOT: [BarrierElimination]
+
+namespace s = cl::sycl;
+
+constexpr size_t local_size = 64;
+constexpr size_t global_size = 256;
+
+using read_accessor = s::accessor<int, 1, s::access::mode::read>;
+using write_accessor = s::accessor<int, 1, s::access::mode::discard_write>;
+using local_accessor = s::accessor<int, 1, s::access::mode::read_write, s::access::target::local>;
+
+// Nothing is accessed after the barrier.
+// BARRIERS-DAG: [BarrierElimination] Barrier in {{.*}} of {{.*}}trailing_barrier{{.*}}: no shared accesses
+struct trailing_barrier {
+  s::accessor<int, 1, s::access::mode::read_write> data;
+
+  void operator()(s::nd_item<1> item) const {
+    data[item.get_global_id(0)] += 1;
+    item.barrier();
+  }
+};
+
+// The first barrier only separates reads. The second one orders them
+// before the writes, which may alias the data that is read.
+// BARRIERS-DAG: [BarrierElimination] Barrier in {{.*}} of {{.*}}read_only_region{{.*}}: no conflicting accesses
+// BARRIERS-DAG: [BarrierElimination] Barrier in {{.*}} of {{.*}}read_only_region{{.*}}: required
+struct read_only_region {
+  read_accessor in;
+  write_accessor out;
+
+  void operator()(s::nd_item<1> item) const {
+    const auto gid = item.get_global_id(0);
+    const int x = in[gid];
+    item.barrier();
+    const int y = in[(gid + 1) % global_size];
+    item.barrier();
+    out[gid] = x + y;
+  }
+};
+
+// Work items read local memory written by their neighbour.
+// BARRIERS-DAG: [BarrierElimination] Barrier in {{.*}} of {{.*}}neighbour_exchange{{.*}}: required
+struct neighbour_exchange {
+  read_accessor in;
+  write_accessor out;
+  local_accessor scratch;
+
+  void operator()(s::nd_item<1> item) const {
+    const auto lid = item.get_local_id(0);
+    scratch[lid] = in[item.get_global_id(0)];
+    item.barrier();
+    out[item.get_global_id(0)] = scratch[(lid + 1) % local_size];
+  }
+};
+
+int main() {
+  s::queue queue;
+
+  std::vector<int> data(global_size);
+  std::vector<int> in(global_size);
+  std::vector<int> sums(global_size);
+  std::vector<int> exchanged(global_size);
+  for (size_t i = 0; i < global_size; ++i) {
+    data[i] = static_cast<int>(i);
+    in[i] = static_cast<int>(i);
+  }
+
+  {
+    s::buffer<int, 1> data_buf{data.data(), data.size()};
+    s::buffer<int, 1> in_buf{in.data(), in.size()};
+    s::buffer<int, 1> sums_buf{sums.data(), sums.size()};
+    s::buffer<int, 1> exchanged_buf{exchanged.data(), exchanged.size()};
+    const s::nd_range<1> range{global_size, local_size};
+
+    queue.submit([&](s::handler &cgh) {
+      cgh.parallel_for(range, trailing_barrier{data_buf.get_access<s::access::mode::read_write>(cgh)});
+    });
+    queue.submit([&](s::handler &cgh) {
+      cgh.parallel_for(range, read_only_region{in_buf.get_access<s::access::mode::read>(cgh),
+                                               sums_buf.get_access<s::access::mode::discard_write>(cgh)});
+    });
+    queue.submit([&](s::handler &cgh) {
+      cgh.parallel_for(range,
+                       neighbour_exchange{in_buf.get_access<s::access::mode::read>(cgh),
+                                          exchanged_buf.get_access<s::access::mode::discard_write>(cgh),
+                                          local_accessor{local_size, cgh}});
+    });
+  }
+
+  // CHECK: 1
+  // CHECK: 256
+  // CHECK: 1
+  // CHECK: 509
+  // CHECK: 1
+  // CHECK: 0
+  // CHECK: 65
+  std::cout << data[0] << "\n";
+  std::cout << data[global_size - 1] << "\n";
+  std::cout << sums[0] << "\n";
+  std::cout << sums[global_size - 2] << "\n";
+  std::cout << exchanged[0] << "\n";
+  std::cout << exchanged[local_size - 1] << "\n";
+  std::cout << exchanged[local_size] << "\n";
+}
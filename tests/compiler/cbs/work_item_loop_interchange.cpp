@@ -0,0 +1,90 @@
+// RUN: env ACPP_DEBUG_LEVEL=3 %acpp %s -o %t --acpp-targets=omp --acpp-use-accelerated-cpu 2>&1 | FileCheck %s --check-prefix=O0
+// RUN: %t | FileCheck %s
+// RUN: env ACPP_DEBUG_LEVEL=3 %acpp %s -o %t --acpp-targets=omp --acpp-use-accelerated-cpu -O 2>&1 | FileCheck %s --check-prefix=INTERCHANGE
+// RUN: %t | FileCheck %s
+
+#include <iostream>
+
+#include <CL/sycl.hpp>
+
+// O0-NOT: [WorkItemLoopInterchange]
+
+namespace s = cl::sycl;
+
+constexpr size_t n = 64;
+constexpr size_t tile_size = 16;
+
+using local_accessor = s::accessor<float, 2, s::access::mode::read_write, s::access::target::local>;
+
+// The loop over the local memory tiles is executed by all work items, so
+// the work-item loop is placed inside of it. The loop around it contains
+// barriers already.
+// INTERCHANGE: [WorkItemLoopInterchange] Interchanging work-item loop with loop {{.*}} of {{.*}}tiled_matmul
+// INTERCHANGE-NOT: [WorkItemLoopInterchange]
+struct tiled_matmul {
+  s::accessor<float, 2, s::access::mode::read> a;
+  s::accessor<float, 2, s::access::mode::read> b;
+  s::accessor<float, 2, s::access::mode::discard_write> c;
+  local_accessor tile_a;
+  local_accessor tile_b;
+
+  void operator()(s::nd_item<2> item) const {
+    const auto row = item.get_global_id(0);
+    const auto col = item.get_global_id(1);
+    const auto local_row = item.get_local_id(0);
+    const auto local_col = item.get_local_id(1);
+
+    float sum = 0;
+    for (size_t t = 0; t < n / tile_size; ++t) {
+      tile_a[local_row][local_col] = a[row][t * tile_size + local_col];
+      tile_b[local_row][local_col] = b[t * tile_size + local_row][col];
+      item.barrier();
+
+      for (size_t k = 0; k < tile_size; ++k)
+        sum += tile_a[local_row][k] * tile_b[k][local_col];
+      item.barrier();
+    }
+    c[row][col] = sum;
+  }
+};
+
+int main() {
+  s::queue queue;
+
+  std::vector<float> a(n * n);
+  std::vector<float> b(n * n);
+  std::vector<float> c(n * n);
+  for (size_t i = 0; i < n; ++i)
+    for (size_t j = 0; j < n; ++j) {
+      a[i * n + j] = static_cast<float>((i + j) % 3);
+      b[i * n + j] = static_cast<float>((i * j) % 5);
+    }
+
+  {
+    s::buffer<float, 2> a_buf{a.data(), s::range<2>{n, n}};
+    s::buffer<float, 2> b_buf{b.data(), s::range<2>{n, n}};
+    s::buffer<float, 2> c_buf{c.data(), s::range<2>{n, n}};
+
+    queue.submit([&](s::handler &cgh) {
+      cgh.parallel_for(s::nd_range<2>{{n, n}, {tile_size, tile_size}},
+                       tiled_matmul{a_buf.get_access<s::access::mode::read>(cgh),
+                                    b_buf.get_access<s::access::mode::read>(cgh),
+                                    c_buf.get_access<s::access::mode::discard_write>(cgh),
+                                    local_accessor{s::range<2>{tile_size, tile_size}, cgh},
+                                    local_accessor{s::range<2>{tile_size, tile_size}, cgh}});
+    });
+  }
+
+  size_t num_errors = 0;
+  for (size_t i = 0; i < n; ++i)
+    for (size_t j = 0; j < n; ++j) {
+      float expected = 0;
+      for (size_t k = 0; k < n; ++k)
+        expected += a[i * n + k] * b[k * n + j];
+      if (c[i * n + j] != expected)
+        ++num_errors;
+    }
+
+  // CHECK: errors: 0
+  std::cout << "errors: " << num_errors << "\n";
+}
@@ -0,0 +1,41 @@
+// RUN: %acpp %s -o %t --acpp-targets=generic
+// RUN: rm -rf %t.appdb
+// RUN: env ACPP_APPDB_DIR=%t.appdb ACPP_VISIBILITY_MASK=omp ACPP_ADAPTIVITY_LEVEL=2 ACPP_JITOPT_PGO_TRAINING_LAUNCHES=2 ACPP_DEBUG_LEVEL=3 %t | FileCheck %s
+
+#include <iostream>
+#include <sycl/sycl.hpp>
+#include "common.hpp"
+
+int main() {
+  sycl::queue q = get_queue();
+
+  constexpr std::size_t size = 64;
+  int* data = sycl::malloc_shared<int>(size, q);
+  for(std::size_t i = 0; i < size; ++i)
+    data[i] = static_cast<int>(i);
+
+  // The training launches use an instrumented binary, later launches
+  // use a binary that is optimized with the collected profile.
+  // CHECK: adaptivity_engine: Collecting branch profile
+  // CHECK: BranchProfileInstrumentationPass: Instrumented {{[1-9][0-9]*}} branches
+  // CHECK: adaptivity_engine: Collecting branch profile
+  // CHECK-NOT: Profile does not match module
+  // CHECK: LLVMToBackend: Using build option: pgo-branch-profile=
+  // CHECK: BranchProfileApplicationPass: Applied profile to {{[1-9][0-9]*}} of {{[1-9][0-9]*}} branches
+  for(int launch = 0; launch < 4; ++launch) {
+    q.parallel_for(sycl::range{size}, [=](sycl::id<1> idx) {
+      if(idx[0] % 4 == 0)
+        data[idx] += 2;
+      else
+        data[idx] += 1;
+    }).wait();
+  }
+
+  int sum = 0;
+  for(std::size_t i = 0; i < size; ++i)
+    sum += data[i];
+  // CHECK: 2336
+  std::cout << sum << std::endl;
+
+  sycl::free(data, q);
+}
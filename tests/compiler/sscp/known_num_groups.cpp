@@ -0,0 +1,39 @@
+// RUN: %acpp %s -o %t --acpp-targets=generic
+// RUN: rm -rf %t.appdb
+// RUN: env ACPP_APPDB_DIR=%t.appdb ACPP_ADAPTIVITY_LEVEL=2 ACPP_JITOPT_IADS_RELATIVE_THRESHOLD_MIN_DATA=2 ACPP_DEBUG_LEVEL=3 %t | FileCheck %s
+
+#include <iostream>
+#include <sycl/sycl.hpp>
+#include "common.hpp"
+
+int main() {
+  sycl::queue q = get_queue();
+
+  constexpr std::size_t num_groups = 4;
+  constexpr std::size_t local_size = 32;
+  std::size_t* data = sycl::malloc_shared<std::size_t>(num_groups, q);
+
+  // Once the global range has been observed to be invariant, it is
+  // baked into the binary.
+  // CHECK: adaptivity_engine: Global range is invariant or common, specializing.
+  // CHECK: LLVMToBackend: Using build option: known-num-groups-x=4
+  // CHECK: LLVMToBackend: Using build option: known-num-groups-y=1
+  // CHECK: LLVMToBackend: Using build option: known-num-groups-z=1
+  for(int launch = 0; launch < 5; ++launch) {
+    q.parallel_for(sycl::nd_range<1>{num_groups * local_size, local_size},
+                   [=](sycl::nd_item<1> item) {
+                     if(item.get_local_id(0) == 0)
+                       data[item.get_group(0)] =
+                           100 * item.get_group_range(0) + item.get_group(0);
+                   }).wait();
+  }
+
+  // CHECK: 400
+  // CHECK: 401
+  // CHECK: 402
+  // CHECK: 403
+  for(std::size_t i = 0; i < num_groups; ++i)
+    std::cout << data[i] << std::endl;
+
+  sycl::free(data, q);
+}
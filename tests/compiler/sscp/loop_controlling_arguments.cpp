@@ -0,0 +1,36 @@
+// RUN: %acpp %s -o %t --acpp-targets=generic
+// RUN: rm -rf %t.appdb
+// RUN: env ACPP_APPDB_DIR=%t.appdb ACPP_ADAPTIVITY_LEVEL=2 ACPP_DEBUG_LEVEL=3 %t | FileCheck %s
+
+#include <iostream>
+#include <sycl/sycl.hpp>
+#include "common.hpp"
+
+int main() {
+  sycl::queue q = get_queue();
+
+  constexpr std::size_t size = 64;
+  int* data = sycl::malloc_shared<int>(size, q);
+
+  // The first compilation detects that num_iterations controls the loop,
+  // subsequent launches then specialize it without waiting for
+  // invariant argument detection.
+  // CHECK: LoopControllingArgumentsPass: Argument {{[0-9]+}} of kernel {{.*}} controls loops
+  // CHECK: adaptivity_engine: Kernel argument {{[0-9]+}} controls loops, specializing eagerly.
+  for(int launch = 0; launch < 3; ++launch) {
+    int num_iterations = 8;
+    q.parallel_for(sycl::range{size}, [=](sycl::id<1> idx) {
+      int sum = 0;
+      for(int i = 0; i < num_iterations; ++i)
+        sum += static_cast<int>(idx[0]) + i;
+      data[idx] = sum;
+    }).wait();
+  }
+
+  // CHECK: 28
+  std::cout << data[0] << std::endl;
+  // CHECK: 532
+  std::cout << data[size - 1] << std::endl;
+
+  sycl::free(data, q);
+}
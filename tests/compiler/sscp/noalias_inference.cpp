@@ -0,0 +1,57 @@
+// RUN: %acpp %s -o %t --acpp-targets=generic
+// RUN: rm -rf %t.appdb
+// RUN: env ACPP_APPDB_DIR=%t.appdb ACPP_VISIBILITY_MASK=omp ACPP_JITOPT_NOALIAS_INFERENCE=1 ACPP_DEBUG_LEVEL=3 %t | FileCheck %s
+
+#include <iostream>
+#include <sycl/sycl.hpp>
+#include "common.hpp"
+
+int main() {
+  sycl::queue q = get_queue();
+
+  constexpr std::size_t size = 64;
+  int* a = sycl::malloc_shared<int>(size, q);
+  int* b = sycl::malloc_shared<int>(size, q);
+  int** indirect = sycl::malloc_shared<int*>(1, q);
+  for(std::size_t i = 0; i < size; ++i) {
+    a[i] = 0;
+    b[i] = static_cast<int>(i);
+  }
+
+  // Arguments pointing into distinct allocations are marked noalias.
+  // CHECK: adaptivity_engine: Pointer arguments {{[0-9]+}},{{[0-9]+}} point into distinct allocations
+  // CHECK: LLVMToBackend: Marking argument {{[0-9]+}} of {{.*}} as noalias
+  // CHECK: LLVMToBackend: Marking argument {{[0-9]+}} of {{.*}} as noalias
+  q.parallel_for(sycl::range{size}, [=](sycl::id<1> idx) {
+    a[idx] = b[idx] + 1;
+  }).wait();
+  // CHECK: 64
+  std::cout << a[size - 1] << std::endl;
+
+  // The arguments point into distinct allocations, but a pointer stored in
+  // USM aliases the first one. The compiler must not mark any of them.
+  *indirect = a;
+  // CHECK: adaptivity_engine: Pointer arguments {{[0-9]+}},{{[0-9]+}} point into distinct allocations
+  // CHECK-NOT: LLVMToBackend: Marking argument
+  // CHECK: LLVMToBackend: Not marking arguments of {{.*}} as noalias
+  q.parallel_for(sycl::range{size}, [=](sycl::id<1> idx) {
+    a[idx] = 1;
+    (*indirect)[idx] += 1;
+    a[idx] *= 3;
+  }).wait();
+  // CHECK: 6
+  std::cout << a[0] << std::endl;
+
+  // Arguments pointing into the same allocation are not marked.
+  // CHECK-NOT: LLVMToBackend: Marking argument
+  int* a_upper = a + size / 2;
+  q.parallel_for(sycl::range{size / 2}, [=](sycl::id<1> idx) {
+    a_upper[idx] = a[idx] + 1;
+  }).wait();
+  // CHECK: 7
+  std::cout << a[size / 2] << std::endl;
+
+  sycl::free(indirect, q);
+  sycl::free(b, q);
+  sycl::free(a, q);
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <execution>
+#include <pstl/glue_execution_defs.h>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_FIXTURE_TEST_SUITE(pstl_adjacent_find, enable_unified_shared_memory)
+
+template <class Policy, class Generator>
+void test_adjacent_find(Policy&& pol, std::size_t problem_size, Generator gen) {
+  std::vector<int> data(problem_size);
+  for(int i = 0; i < problem_size; ++i)
+    data[i] = gen(i);
+
+  auto p = [](int a, int b){ return a > b; };
+
+  BOOST_CHECK(std::adjacent_find(pol, data.begin(), data.end()) ==
+              std::adjacent_find(data.begin(), data.end()));
+  BOOST_CHECK(std::adjacent_find(pol, data.begin(), data.end(), p) ==
+              std::adjacent_find(data.begin(), data.end(), p));
+}
+
+
+template<class Policy>
+void empty_tests(Policy&& pol) {
+  test_adjacent_find(pol, 0, [](int i){return i;});
+}
+
+template<class Policy>
+void single_element_tests(Policy&& pol) {
+  test_adjacent_find(pol, 1, [](int i){return i;});
+}
+
+template<class Policy>
+void medium_size_tests(Policy&& pol) {
+  test_adjacent_find(pol, 1000, [](int i){return i;});
+  test_adjacent_find(pol, 1000, [](int i){return i / 2;});
+  test_adjacent_find(pol, 1000, [](int i){return i < 700 ? i : 1400 - i;});
+  test_adjacent_find(pol, 1000, [](int i){return i == 999 ? 998 : i;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_empty) {
+  empty_tests(std::execution::par_unseq);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_single_element) {
+  single_element_tests(std::execution::par_unseq);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_medium_size) {
+  medium_size_tests(std::execution::par_unseq);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(par_empty) {
+  empty_tests(std::execution::par);
+}
+
+BOOST_AUTO_TEST_CASE(par_single_element) {
+  single_element_tests(std::execution::par);
+}
+
+BOOST_AUTO_TEST_CASE(par_medium_size) {
+  medium_size_tests(std::execution::par);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
+
@@ -0,0 +1,108 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <execution>
+#include <pstl/glue_execution_defs.h>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_FIXTURE_TEST_SUITE(pstl_lexicographical_compare,
+                         enable_unified_shared_memory)
+
+template <class Policy, class Generator1, class Generator2>
+void test_lexicographical_compare(Policy&& pol, std::size_t size1,
+                                  std::size_t size2, Generator1 gen1,
+                                  Generator2 gen2) {
+  std::vector<int> data1(size1);
+  std::vector<int> data2(size2);
+  for(int i = 0; i < size1; ++i)
+    data1[i] = gen1(i);
+  for(int i = 0; i < size2; ++i)
+    data2[i] = gen2(i);
+
+  auto comp = [](int a, int b){ return a > b; };
+
+  BOOST_CHECK(std::lexicographical_compare(pol, data1.begin(), data1.end(),
+                                           data2.begin(), data2.end()) ==
+              std::lexicographical_compare(data1.begin(), data1.end(),
+                                           data2.begin(), data2.end()));
+  BOOST_CHECK(
+      std::lexicographical_compare(pol, data1.begin(), data1.end(),
+                                   data2.begin(), data2.end(), comp) ==
+      std::lexicographical_compare(data1.begin(), data1.end(), data2.begin(),
+                                   data2.end(), comp));
+}
+
+
+template<class Policy>
+void empty_tests(Policy&& pol) {
+  auto gen = [](int i){return i;};
+  test_lexicographical_compare(pol, 0, 0, gen, gen);
+  test_lexicographical_compare(pol, 0, 1, gen, gen);
+  test_lexicographical_compare(pol, 1, 0, gen, gen);
+}
+
+template<class Policy>
+void single_element_tests(Policy&& pol) {
+  test_lexicographical_compare(pol, 1, 1, [](int i){return i;},
+                               [](int i){return i;});
+  test_lexicographical_compare(pol, 1, 1, [](int i){return i;},
+                               [](int i){return i + 1;});
+  test_lexicographical_compare(pol, 1, 1, [](int i){return i + 1;},
+                               [](int i){return i;});
+}
+
+template<class Policy>
+void medium_size_tests(Policy&& pol) {
+  auto gen = [](int i){return i;};
+  test_lexicographical_compare(pol, 1000, 1000, gen, gen);
+  test_lexicographical_compare(pol, 1000, 999, gen, gen);
+  test_lexicographical_compare(pol, 999, 1000, gen, gen);
+  test_lexicographical_compare(pol, 1000, 1000, gen,
+                               [](int i){return i == 600 ? -1 : i;});
+  test_lexicographical_compare(pol, 1000, 1000,
+                               [](int i){return i == 600 ? -1 : i;}, gen);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_empty) {
+  empty_tests(std::execution::par_unseq);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_single_element) {
+  single_element_tests(std::execution::par_unseq);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_medium_size) {
+  medium_size_tests(std::execution::par_unseq);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(par_empty) {
+  empty_tests(std::execution::par);
+}
+
+BOOST_AUTO_TEST_CASE(par_single_element) {
+  single_element_tests(std::execution::par);
+}
+
+BOOST_AUTO_TEST_CASE(par_medium_size) {
+  medium_size_tests(std::execution::par);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
+
@@ -0,0 +1,159 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include <hipSYCL/std/stdpar/detail/sycl_glue.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_AUTO_TEST_SUITE(pstl_memory_pool)
+
+using hipsycl::stdpar::memory_pool;
+
+constexpr std::size_t pool_size = 16 * 1024 * 1024;
+constexpr std::size_t object_size = memory_pool::max_small_object_size;
+constexpr std::size_t objects_per_slab = memory_pool::slab_size / object_size;
+constexpr std::size_t num_slabs = 3;
+
+std::vector<char*> claimed_slabs;
+std::vector<char*> released_slabs;
+
+void on_slab_claimed(void* slab, std::size_t size) {
+  BOOST_CHECK_EQUAL(size, memory_pool::slab_size);
+  claimed_slabs.push_back(static_cast<char*>(slab));
+}
+
+void on_slab_released(void* slab, std::size_t size) {
+  BOOST_CHECK_EQUAL(size, memory_pool::slab_size);
+  released_slabs.push_back(static_cast<char*>(slab));
+}
+
+// Each thread caches small objects of the first pool it uses,
+// so every test needs to use the pool from fresh threads.
+template<class F>
+void run_in_thread(F f) {
+  std::thread t{f};
+  t.join();
+}
+
+struct pool_fixture {
+  pool_fixture()
+  : pool{pool_size, memory_pool::huge_page_mode::none, false,
+         &on_slab_claimed, &on_slab_released} {
+    claimed_slabs.clear();
+    released_slabs.clear();
+  }
+
+  memory_pool pool;
+};
+
+char* find_slab(char* ptr) {
+  for(char* slab : claimed_slabs)
+    if(ptr >= slab && ptr < slab + memory_pool::slab_size)
+      return slab;
+  return nullptr;
+}
+
+BOOST_FIXTURE_TEST_CASE(slab_boundaries, pool_fixture) {
+  run_in_thread([&](){
+    std::vector<char*> objects;
+    for(std::size_t i = 0; i < num_slabs * objects_per_slab; ++i) {
+      char* ptr = static_cast<char*>(pool.claim_small(object_size));
+      BOOST_REQUIRE(ptr);
+      BOOST_CHECK(pool.is_small_object(ptr));
+      objects.push_back(ptr);
+    }
+    BOOST_CHECK_EQUAL(claimed_slabs.size(), num_slabs);
+
+    std::sort(objects.begin(), objects.end());
+    for(std::size_t i = 0; i < objects.size(); ++i) {
+      char* slab = find_slab(objects[i]);
+      BOOST_REQUIRE(slab);
+      BOOST_CHECK((objects[i] - slab) % object_size == 0);
+      BOOST_CHECK(objects[i] + object_size <= slab + memory_pool::slab_size);
+      if(i > 0)
+        BOOST_CHECK(objects[i] >= objects[i - 1] + object_size);
+    }
+
+    for(char* ptr : objects)
+      pool.release_small(ptr);
+  });
+  // All objects are back in the pool after the thread has exited, and the
+  // slabs are fully carved up, so none of them needs to be kept.
+  BOOST_CHECK_EQUAL(released_slabs.size(), num_slabs);
+  for(char* slab : released_slabs)
+    BOOST_CHECK(!pool.is_small_object(slab));
+}
+
+BOOST_FIXTURE_TEST_CASE(reuse, pool_fixture) {
+  std::unordered_set<char*> first_objects;
+  run_in_thread([&](){
+    std::vector<char*> objects;
+    for(std::size_t i = 0; i < objects_per_slab + 1; ++i)
+      objects.push_back(static_cast<char*>(pool.claim_small(object_size)));
+    first_objects.insert(objects.begin(), objects.end());
+    BOOST_CHECK_EQUAL(first_objects.size(), objects.size());
+    BOOST_CHECK_EQUAL(claimed_slabs.size(), 2);
+
+    for(char* ptr : objects)
+      pool.release_small(ptr);
+    // Objects of other sizes in the same size class reuse the freed objects
+    for(std::size_t i = 0; i < objects.size(); ++i) {
+      objects[i] = static_cast<char*>(pool.claim_small(object_size - 1));
+      BOOST_CHECK(find_slab(objects[i]));
+    }
+    BOOST_CHECK_EQUAL(claimed_slabs.size(), 2);
+    BOOST_CHECK(released_slabs.empty());
+
+    for(char* ptr : objects)
+      pool.release_small(ptr);
+  });
+  // The slab that new objects are carved from remains
+  BOOST_REQUIRE_EQUAL(released_slabs.size(), 1);
+  BOOST_CHECK(released_slabs[0] == claimed_slabs.front());
+
+  // Objects can be reused by other threads
+  run_in_thread([&](){
+    char* ptr = static_cast<char*>(pool.claim_small(object_size));
+    BOOST_CHECK(find_slab(ptr) == claimed_slabs.back());
+    pool.release_small(ptr);
+  });
+  BOOST_CHECK_EQUAL(claimed_slabs.size(), 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(release_from_other_thread, pool_fixture) {
+  std::vector<char*> objects;
+  run_in_thread([&](){
+    for(std::size_t i = 0; i < 2 * objects_per_slab; ++i)
+      objects.push_back(static_cast<char*>(pool.claim_small(object_size)));
+  });
+  BOOST_CHECK(released_slabs.empty());
+
+  run_in_thread([&](){
+    for(char* ptr : objects)
+      pool.release_small(ptr);
+  });
+  BOOST_CHECK_EQUAL(released_slabs.size(), 2);
+
+  // The memory of the slabs is available for page-granular allocations again
+  void* ptr = pool.claim(pool_size / 2);
+  BOOST_CHECK(ptr);
+  BOOST_CHECK(!pool.is_small_object(ptr));
+  pool.release(ptr, pool_size / 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <execution>
+#include <pstl/glue_execution_defs.h>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_FIXTURE_TEST_SUITE(pstl_minmax_element, enable_unified_shared_memory)
+
+template <class Policy, class Generator>
+void test_minmax_element(Policy&& pol, std::size_t problem_size, Generator gen) {
+  std::vector<int> data(problem_size);
+  for(int i = 0; i < problem_size; ++i)
+    data[i] = gen(i);
+
+  auto comp = [](int a, int b){ return a > b; };
+
+  BOOST_CHECK(std::min_element(pol, data.begin(), data.end()) ==
+              std::min_element(data.begin(), data.end()));
+  BOOST_CHECK(std::min_element(pol, data.begin(), data.end(), comp) ==
+              std::min_element(data.begin(), data.end(), comp));
+  BOOST_CHECK(std::max_element(pol, data.begin(), data.end()) ==
+              std::max_element(data.begin(), data.end()));
+  BOOST_CHECK(std::max_element(pol, data.begin(), data.end(), comp) ==
+              std::max_element(data.begin(), data.end(), comp));
+  BOOST_CHECK(std::minmax_element(pol, data.begin(), data.end()) ==
+              std::minmax_element(data.begin(), data.end()));
+  BOOST_CHECK(std::minmax_element(pol, data.begin(), data.end(), comp) ==
+              std::minmax_element(data.begin(), data.end(), comp));
+}
+
+
+template<class Policy>
+void empty_tests(Policy&& pol) {
+  test_minmax_element(pol, 0, [](int i){return i;});
+}
+
+template<class Policy>
+void single_element_tests(Policy&& pol) {
+  test_minmax_element(pol, 1, [](int i){return i;});
+  test_minmax_element(pol, 1, [](int i){return 42;});
+}
+
+template<class Policy>
+void medium_size_tests(Policy&& pol) {
+  test_minmax_element(pol, 1000, [](int i){return i;});
+  test_minmax_element(pol, 1000, [](int i){return -i;});
+  test_minmax_element(pol, 1000, [](int i){return (i * 7919) % 1013;});
+  // Repeated extrema need to be resolved like the host implementation
+  test_minmax_element(pol, 1000, [](int i){return i % 10;});
+  test_minmax_element(pol, 1000, [](int i){return 3;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_empty) {
+  empty_tests(std::execution::par_unseq);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_single_element) {
+  single_element_tests(std::execution::par_unseq);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_medium_size) {
+  medium_size_tests(std::execution::par_unseq);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(par_empty) {
+  empty_tests(std::execution::par);
+}
+
+BOOST_AUTO_TEST_CASE(par_single_element) {
+  single_element_tests(std::execution::par);
+}
+
+BOOST_AUTO_TEST_CASE(par_medium_size) {
+  medium_size_tests(std::execution::par);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
+
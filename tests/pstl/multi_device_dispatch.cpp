@@ -0,0 +1,69 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <boost/test/tools/old/interface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+
+#include <cstdint>
+#include <vector>
+#include <hipSYCL/std/stdpar/detail/multi_device_dispatch.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_AUTO_TEST_SUITE(pstl_multi_device_dispatch)
+
+using hipsycl::stdpar::detail::multi_device_dispatch;
+
+BOOST_AUTO_TEST_CASE(update_weights_faster_device) {
+  // Both partitions take the same time, but the first one is three times
+  // as large, so the first device has three times the throughput.
+  std::vector<std::size_t> bounds{0, 3000000, 4000000};
+  std::vector<uint64_t> elapsed_times{1000000, 1000000};
+  std::vector<double> weights{0.5, 0.5};
+
+  multi_device_dispatch::update_weights(bounds, elapsed_times, weights);
+
+  BOOST_CHECK_CLOSE(weights[0], 0.625, 0.01);
+  BOOST_CHECK_CLOSE(weights[1], 0.375, 0.01);
+}
+
+BOOST_AUTO_TEST_CASE(update_weights_balanced_partitions) {
+  // Partition sizes already match the throughput of the devices, so the
+  // weights should not change.
+  std::vector<std::size_t> bounds{0, 1000000, 4000000};
+  std::vector<uint64_t> elapsed_times{2000000, 2000000};
+  std::vector<double> weights{0.25, 0.75};
+
+  multi_device_dispatch::update_weights(bounds, elapsed_times, weights);
+
+  BOOST_CHECK_CLOSE(weights[0], 0.25, 0.01);
+  BOOST_CHECK_CLOSE(weights[1], 0.75, 0.01);
+}
+
+BOOST_AUTO_TEST_CASE(update_weights_is_per_partition) {
+  // The small partition finishes first. Its device is nevertheless slower,
+  // and must lose weight regardless of the order of completion.
+  std::vector<std::size_t> bounds{0, 3000000, 4000000, 6000000};
+  std::vector<uint64_t> elapsed_times{1000000, 2000000, 2000000};
+  std::vector<double> weights{1.0, 1.0, 1.0};
+
+  multi_device_dispatch::update_weights(bounds, elapsed_times, weights);
+
+  // Throughputs are 3 : 0.5 : 1, so the measured weights are
+  // 3 * (3, 0.5, 1) / 4.5 = (2, 1/3, 2/3).
+  BOOST_CHECK_CLOSE(weights[0], 1.5, 0.01);
+  BOOST_CHECK_CLOSE(weights[1], 2.0 / 3.0, 0.01);
+  BOOST_CHECK_CLOSE(weights[2], 5.0 / 6.0, 0.01);
+  BOOST_CHECK_CLOSE(weights[0] + weights[1] + weights[2], 3.0, 0.01);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -14,6 +14,8 @@
 #include <boost/test/tools/old/interface.hpp>
 #include <vector>
 #include <memory>
+#include <hipSYCL/runtime/application.hpp>
+#include <hipSYCL/runtime/dag_node.hpp>
 #include <hipSYCL/runtime/data.hpp>
 #include <hipSYCL/runtime/util.hpp>
 
@@ -79,4 +81,159 @@ BOOST_AUTO_TEST_CASE(page_table) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(data_user_tracker_conflicts) {
+  rt::runtime_keep_alive_token rt;
+
+  auto make_node = [&]() {
+    return std::make_shared<rt::dag_node>(rt::execution_hints{},
+                                          rt::node_list_t{}, nullptr,
+                                          rt.get());
+  };
+  auto conflicts = [](rt::data_user_tracker &tracker, sycl::access::mode mode,
+                      const rt::data_user_tracker::page_range &pages) {
+    std::vector<rt::dag_node_ptr> result;
+    tracker.for_each_conflicting_user(mode, pages, [&](rt::data_user &user) {
+      result.push_back(user.user.lock());
+    });
+    return result;
+  };
+  auto contains = [](const std::vector<rt::dag_node_ptr> &nodes,
+                     const rt::dag_node_ptr &node) {
+    return std::find(nodes.begin(), nodes.end(), node) != nodes.end();
+  };
+
+  const rt::id<3> offset{0, 0, 0};
+  const rt::range<3> size{1, 1, 16};
+  const rt::data_user_tracker::page_range all_pages{rt::id<3>{0, 0, 0},
+                                                    rt::range<3>{1, 1, 4}};
+  const rt::data_user_tracker::page_range first_page{rt::id<3>{0, 0, 0},
+                                                     rt::range<3>{1, 1, 1}};
+  const rt::data_user_tracker::page_range last_page{rt::id<3>{0, 0, 3},
+                                                    rt::range<3>{1, 1, 1}};
+  const auto target = sycl::access::target::device;
+
+  rt::data_user_tracker tracker;
+  auto writer = make_node();
+  tracker.add_user(writer, sycl::access::mode::discard_write, target, offset,
+                   size, all_pages);
+
+  // Reads only depend on the last writer
+  auto reader1 = make_node();
+  auto reader2 = make_node();
+  BOOST_CHECK(conflicts(tracker, sycl::access::mode::read, all_pages) ==
+              std::vector<rt::dag_node_ptr>{writer});
+  tracker.add_user(reader1, sycl::access::mode::read, target, offset, size,
+                   all_pages);
+  tracker.add_user(reader2, sycl::access::mode::read, target, offset, size,
+                   all_pages);
+  BOOST_CHECK(conflicts(tracker, sycl::access::mode::read, all_pages) ==
+              std::vector<rt::dag_node_ptr>{writer});
+
+  // Writes depend on the readers since the last writer, which are
+  // already ordered after the writer.
+  auto write_conflicts =
+      conflicts(tracker, sycl::access::mode::read_write, first_page);
+  BOOST_CHECK(write_conflicts.size() == 2);
+  BOOST_CHECK(contains(write_conflicts, reader1));
+  BOOST_CHECK(contains(write_conflicts, reader2));
+
+  // A write to a subrange does not replace users of the entire range
+  auto partial_writer = make_node();
+  tracker.add_user(partial_writer, sycl::access::mode::read_write, target,
+                   offset, rt::range<3>{1, 1, 4}, first_page);
+  BOOST_CHECK(tracker.has_user(reader1));
+  BOOST_CHECK(tracker.has_user(partial_writer));
+
+  auto read_conflicts = conflicts(tracker, sycl::access::mode::read, all_pages);
+  BOOST_CHECK(read_conflicts.size() == 2);
+  BOOST_CHECK(contains(read_conflicts, writer));
+  BOOST_CHECK(contains(read_conflicts, partial_writer));
+  BOOST_CHECK(conflicts(tracker, sycl::access::mode::read, last_page) ==
+              std::vector<rt::dag_node_ptr>{writer});
+
+  // A write to the entire range replaces all previous users
+  auto full_writer = make_node();
+  tracker.add_user(full_writer, sycl::access::mode::write, target, offset, size,
+                   all_pages);
+  BOOST_CHECK(!tracker.has_user(writer));
+  BOOST_CHECK(!tracker.has_user(reader1));
+  BOOST_CHECK(!tracker.has_user(partial_writer));
+  BOOST_CHECK(tracker.get_users().size() == 1);
+  BOOST_CHECK(conflicts(tracker, sycl::access::mode::write, last_page) ==
+              std::vector<rt::dag_node_ptr>{full_writer});
+
+  // Users that no longer exist are released
+  full_writer = nullptr;
+  tracker.release_dead_users();
+  BOOST_CHECK(tracker.get_users().empty());
+
+  for(auto node : {writer, reader1, reader2, partial_writer})
+    node->cancel();
+}
+
+BOOST_AUTO_TEST_CASE(data_user_tracker_ordered_conflicts) {
+  rt::runtime_keep_alive_token rt;
+
+  auto make_node = [&]() {
+    return std::make_shared<rt::dag_node>(rt::execution_hints{},
+                                          rt::node_list_t{}, nullptr,
+                                          rt.get());
+  };
+  auto conflicts = [](rt::data_user_tracker &tracker, sycl::access::mode mode,
+                      const rt::data_user_tracker::page_range &pages) {
+    std::vector<rt::dag_node_ptr> result;
+    tracker.for_each_conflicting_user(mode, pages, [&](rt::data_user &user) {
+      result.push_back(user.user.lock());
+    });
+    return result;
+  };
+  auto contains = [](const std::vector<rt::dag_node_ptr> &nodes,
+                     const rt::dag_node_ptr &node) {
+    return std::find(nodes.begin(), nodes.end(), node) != nodes.end();
+  };
+  auto make_pages = [](std::size_t begin, std::size_t size) {
+    return rt::data_user_tracker::page_range{rt::id<3>{0, 0, begin},
+                                             rt::range<3>{1, 1, size}};
+  };
+
+  const rt::id<3> offset{0, 0, 0};
+  const rt::range<3> size{1, 1, 16};
+  const auto target = sycl::access::target::device;
+
+  rt::data_user_tracker tracker;
+  // Pages 0 and 1 are read, then pages 1 and 2 are written. The writer
+  // only partially overlaps the reader, so both are tracked.
+  auto reader = make_node();
+  tracker.add_user(reader, sycl::access::mode::read, target, offset, size,
+                   make_pages(0, 2));
+  auto writer = make_node();
+  tracker.add_user(writer, sycl::access::mode::write, target, offset, size,
+                   make_pages(1, 2));
+  BOOST_CHECK(tracker.has_user(reader));
+
+  // The writer is ordered after the reader, so a write within the pages
+  // of the writer only needs to be ordered after the writer.
+  BOOST_CHECK(conflicts(tracker, sycl::access::mode::write, make_pages(1, 1)) ==
+              std::vector<rt::dag_node_ptr>{writer});
+  // Page 0 is not covered by the writer
+  auto write_conflicts =
+      conflicts(tracker, sycl::access::mode::write, make_pages(0, 2));
+  BOOST_CHECK(write_conflicts.size() == 2);
+  BOOST_CHECK(contains(write_conflicts, reader));
+  BOOST_CHECK(contains(write_conflicts, writer));
+
+  // A reader of the first page range that is added after the writer is not
+  // ordered before the writer, and must not be skipped.
+  auto late_reader = make_node();
+  tracker.add_user(late_reader, sycl::access::mode::read, target, offset, size,
+                   make_pages(0, 2));
+  write_conflicts =
+      conflicts(tracker, sycl::access::mode::write, make_pages(1, 1));
+  BOOST_CHECK(contains(write_conflicts, late_reader));
+  BOOST_CHECK(contains(write_conflicts, writer));
+
+  for(auto node : {reader, writer, late_reader})
+    node->cancel();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,46 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "hipSYCL/runtime/device_id.hpp"
+#include "hipSYCL/runtime/kernel_configuration.hpp"
+#include "runtime_test_suite.hpp"
+
+#include <cstdint>
+
+using namespace hipsycl;
+
+BOOST_FIXTURE_TEST_SUITE(kernel_configuration, reset_device_fixture)
+BOOST_AUTO_TEST_CASE(host_target_option_names) {
+  for(auto option : {rt::kernel_build_option::host_target_cpu,
+                     rt::kernel_build_option::host_target_features,
+                     rt::kernel_build_option::host_target_id}) {
+    auto name = rt::to_string(option);
+    BOOST_CHECK(!name.empty());
+    BOOST_CHECK(rt::to_build_option(name) == option);
+  }
+  BOOST_CHECK(rt::to_string(rt::kernel_build_option::host_target_id) ==
+              "host-target-id");
+}
+
+BOOST_AUTO_TEST_CASE(host_target_id_distinguishes_binaries) {
+  auto make_id = [](uint64_t host_target_id) {
+    rt::kernel_configuration config;
+    config.append_base_configuration(
+        rt::kernel_base_config_parameter::backend_id, rt::backend_id::omp);
+    config.set_build_option(rt::kernel_build_option::host_target_id,
+                            host_target_id);
+    return config.generate_id();
+  };
+
+  BOOST_CHECK(make_id(1) == make_id(1));
+  BOOST_CHECK(make_id(1) != make_id(2));
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,171 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/inorder_queue.hpp"
+#include "hipSYCL/runtime/instrumentation.hpp"
+#include "hipSYCL/runtime/multi_queue_executor.hpp"
+#include "hipSYCL/runtime/operations.hpp"
+#include "runtime_test_suite.hpp"
+
+#include <atomic>
+#include <memory>
+
+using namespace hipsycl;
+
+namespace {
+
+template <class BaseInstrumentation>
+class test_timestamp : public BaseInstrumentation {
+public:
+  test_timestamp(std::size_t ns) : _time{rt::profiler_clock::duration{ns}} {}
+
+  rt::profiler_clock::time_point get_time_point() const override {
+    return _time;
+  }
+
+  // The tracker must never block on instrumentations
+  void wait() const override { was_waited_on = true; }
+
+  bool is_available() const override { return is_ready; }
+
+  std::atomic<bool> is_ready = false;
+  mutable std::atomic<bool> was_waited_on = false;
+
+private:
+  rt::profiler_clock::time_point _time;
+};
+
+class idle_queue : public rt::inorder_queue {
+public:
+  std::shared_ptr<rt::dag_node_event> insert_event() override {
+    return nullptr;
+  }
+  std::shared_ptr<rt::dag_node_event> create_queue_completion_event() override {
+    return nullptr;
+  }
+  rt::result submit_memcpy(rt::memcpy_operation &,
+                           const rt::dag_node_ptr &) override {
+    return rt::make_success();
+  }
+  rt::result submit_kernel(rt::kernel_operation &,
+                           const rt::dag_node_ptr &) override {
+    return rt::make_success();
+  }
+  rt::result submit_prefetch(rt::prefetch_operation &,
+                             const rt::dag_node_ptr &) override {
+    return rt::make_success();
+  }
+  rt::result submit_memset(rt::memset_operation &,
+                           const rt::dag_node_ptr &) override {
+    return rt::make_success();
+  }
+  rt::result submit_queue_wait_for(const rt::dag_node_ptr &) override {
+    return rt::make_success();
+  }
+  rt::result submit_external_wait_for(const rt::dag_node_ptr &) override {
+    return rt::make_success();
+  }
+  rt::result wait() override { return rt::make_success(); }
+  rt::device_id get_device() const override { return rt::device_id{}; }
+  void *get_native_type() const override { return nullptr; }
+  rt::result query_status(rt::inorder_queue_status &status) override {
+    status = rt::inorder_queue_status{true};
+    return rt::make_success();
+  }
+};
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(lane_occupancy_tracker, reset_device_fixture)
+BOOST_AUTO_TEST_CASE(learn_without_blocking) {
+  rt::runtime_keep_alive_token rt;
+
+  using start_t = test_timestamp<rt::instrumentations::execution_start_timestamp>;
+  using finish_t =
+      test_timestamp<rt::instrumentations::execution_finish_timestamp>;
+  auto start = std::make_shared<start_t>(1000);
+  auto finish = std::make_shared<finish_t>(3000);
+
+  auto op = std::make_shared<rt::memset_operation>(nullptr, 0, 1024);
+  op->get_instrumentations()
+      .add_instrumentation<rt::instrumentations::execution_start_timestamp>(
+          start);
+  op->get_instrumentations()
+      .add_instrumentation<rt::instrumentations::execution_finish_timestamp>(
+          finish);
+  op->get_instrumentations().mark_set_complete();
+
+  rt::execution_hints hints;
+  hints.set_hint(rt::hints::request_instrumentation_start_timestamp{});
+  hints.set_hint(rt::hints::request_instrumentation_finish_timestamp{});
+  auto node = std::make_shared<rt::dag_node>(hints, rt::node_list_t{}, op,
+                                             rt.get());
+  node->mark_virtually_submitted();
+
+  idle_queue q;
+  rt::lane_occupancy_tracker tracker{1, 1};
+  BOOST_CHECK(tracker.should_sample(op.get()));
+  tracker.insert(0, node, op.get());
+  BOOST_CHECK(tracker.get_expected_backlog(0) == 1.0);
+
+  // The submission is complete, but its timestamps are not available yet
+  tracker.update(0, &q);
+  BOOST_CHECK(tracker.get_expected_backlog(0) == 0.0);
+  BOOST_CHECK(tracker.estimate_cost(op.get()) == 1.0);
+  BOOST_CHECK(!start->was_waited_on);
+  BOOST_CHECK(!finish->was_waited_on);
+
+  // Once they become available, the tracker learns from them
+  start->is_ready = true;
+  finish->is_ready = true;
+  tracker.update(0, &q);
+  BOOST_CHECK(tracker.estimate_cost(op.get()) == 2000.0);
+  BOOST_CHECK(!start->was_waited_on);
+  BOOST_CHECK(!finish->was_waited_on);
+}
+
+BOOST_AUTO_TEST_CASE(expected_completion) {
+  rt::runtime_keep_alive_token rt;
+
+  std::vector<std::shared_ptr<rt::memset_operation>> ops;
+  std::vector<rt::dag_node_ptr> nodes;
+  for(int i = 0; i < 3; ++i) {
+    ops.push_back(std::make_shared<rt::memset_operation>(nullptr, 0, 1024));
+    nodes.push_back(std::make_shared<rt::dag_node>(
+        rt::execution_hints{}, rt::node_list_t{}, ops.back(), rt.get()));
+    nodes.back()->mark_virtually_submitted();
+  }
+
+  rt::lane_occupancy_tracker tracker{2, 0};
+  tracker.insert(0, nodes[0], ops[0].get());
+  tracker.insert(0, nodes[1], ops[1].get());
+  tracker.insert(1, nodes[2], ops[2].get());
+
+  BOOST_CHECK(tracker.get_expected_backlog(0) == 2.0);
+  BOOST_CHECK(tracker.get_expected_backlog(1) == 1.0);
+  BOOST_CHECK(tracker.get_expected_completion(0, nodes[0]) == 1.0);
+  BOOST_CHECK(tracker.get_expected_completion(0, nodes[1]) == 2.0);
+  BOOST_CHECK(tracker.get_expected_completion(1, nodes[2]) == 1.0);
+  // Nodes are only found in the lane they were submitted to
+  BOOST_CHECK(tracker.get_expected_completion(1, nodes[0]) == 0.0);
+
+  idle_queue q;
+  tracker.update(0, &q);
+  BOOST_CHECK(tracker.get_expected_backlog(0) == 0.0);
+  BOOST_CHECK(tracker.get_expected_completion(0, nodes[1]) == 0.0);
+  BOOST_CHECK(tracker.get_expected_backlog(1) == 1.0);
+
+  tracker.insert(0, nodes[1], ops[1].get());
+  BOOST_CHECK(tracker.get_expected_backlog(0) == 1.0);
+  BOOST_CHECK(tracker.get_expected_completion(0, nodes[1]) == 1.0);
+}
+BOOST_AUTO_TEST_SUITE_END()
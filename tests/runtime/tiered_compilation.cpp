@@ -0,0 +1,122 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "hipSYCL/runtime/adaptivity_engine.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+#include "hipSYCL/runtime/kernel_configuration.hpp"
+#include "runtime_test_suite.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+
+using namespace hipsycl;
+
+namespace {
+
+// Settings are read from the environment once, which already happens
+// during static initialization of translation units that include the SYCL
+// headers. The constructor priority enables tiered compilation before that.
+__attribute__((constructor(101))) void enable_tiered_compilation() {
+  setenv("ACPP_JITOPT_TIERED_COMPILATION", "1", 1);
+  setenv("ACPP_JITOPT_TIER_UP_THRESHOLD", "2", 1);
+}
+
+// Binaries end up in the persistent cache, so use an id that is unique
+// to this run.
+rt::kernel_configuration::id_type make_unique_binary_id() {
+  std::random_device rd;
+  std::mt19937_64 gen{rd()};
+  return rt::kernel_configuration::id_type{gen(), gen()};
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(tiered_compilation, reset_device_fixture)
+BOOST_AUTO_TEST_CASE(baseline_binary_is_replaced) {
+  BOOST_REQUIRE(rt::application::get_settings()
+                    .get<rt::setting::jitopt_tiered_compilation>());
+  BOOST_REQUIRE(rt::application::get_settings()
+                    .get<rt::setting::jitopt_tier_up_threshold>() == 2);
+
+  auto cache = rt::kernel_cache::get();
+  glue::jit::cxx_argument_mapper arg_mapper;
+  rt::kernel_adaptivity_engine engine{0,
+                                      "test_kernel",
+                                      nullptr,
+                                      arg_mapper,
+                                      rt::range<3>{1, 1, 1},
+                                      rt::range<3>{1, 1, 1},
+                                      nullptr,
+                                      nullptr,
+                                      0,
+                                      0};
+
+  const auto optimized_id = make_unique_binary_id();
+  std::atomic<int> num_background_compilations = 0;
+  auto make_jit_compiler = [&](const rt::kernel_configuration &,
+                               rt::kernel_configuration::id_type) {
+    return [&](std::string &binary) -> rt::result {
+      ++num_background_compilations;
+      binary = "optimized";
+      return rt::make_success();
+    };
+  };
+
+  auto select_binary = [&]() {
+    rt::kernel_configuration config;
+    return engine.select_compilation_tier(config, optimized_id,
+                                          make_jit_compiler, *cache);
+  };
+
+  // Before the tier-up threshold is reached, the baseline binary is used
+  // and no background compilation takes place.
+  const auto baseline_id = select_binary();
+  BOOST_CHECK(baseline_id != optimized_id);
+  BOOST_CHECK(num_background_compilations == 0);
+
+  // Reaching the threshold schedules the optimized binary for background
+  // compilation while launches continue with the baseline binary.
+  BOOST_CHECK(select_binary() == baseline_id);
+
+  auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds{30};
+  while(!cache->is_binary_available(optimized_id) &&
+        std::chrono::steady_clock::now() < timeout)
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  BOOST_REQUIRE(cache->is_binary_available(optimized_id));
+  BOOST_CHECK(num_background_compilations == 1);
+
+  // Once it is available, launches switch to the optimized binary,
+  // which is not JIT-compiled again.
+  BOOST_CHECK(select_binary() == optimized_id);
+  BOOST_CHECK(select_binary() == optimized_id);
+
+  bool was_jit_compiled = false;
+  std::string used_binary;
+  cache->get_or_construct_jit_code_object(
+      optimized_id, optimized_id,
+      [&](std::string &) {
+        was_jit_compiled = true;
+        return false;
+      },
+      [&](const std::string &binary) -> rt::code_object * {
+        used_binary = binary;
+        return nullptr;
+      });
+  BOOST_CHECK(!was_jit_compiled);
+  BOOST_CHECK(used_binary == "optimized");
+  BOOST_CHECK(num_background_compilations == 1);
+}
+BOOST_AUTO_TEST_SUITE_END()
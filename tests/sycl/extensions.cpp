@@ -1223,4 +1223,172 @@ BOOST_AUTO_TEST_CASE(sycl_specialized) {
 }
 #endif
 
+#ifdef ACPP_EXT_USM_MEMORY_POOL
+BOOST_AUTO_TEST_CASE(usm_memory_pool) {
+  using namespace cl;
+  sycl::queue q{sycl::property::queue::in_order{}};
+  sycl::AdaptiveCpp_memory_pool pool{q};
+
+  const std::size_t count = 1024;
+  const std::size_t initial_used_size = pool.get_used_size();
+  int* data = sycl::malloc_async<int>(count, q);
+  BOOST_REQUIRE(data);
+  BOOST_CHECK(pool.get_used_size() >= initial_used_size + count * sizeof(int));
+
+  q.parallel_for(sycl::range{count}, [=](sycl::id<1> idx){
+    data[idx] = static_cast<int>(idx[0]);
+  });
+  const std::size_t reserved_size = pool.get_reserved_size();
+  sycl::free_async(data, q);
+  // Freed blocks are cached by the pool instead of being released
+  BOOST_CHECK(pool.get_used_size() == initial_used_size);
+  BOOST_CHECK(pool.get_reserved_size() == reserved_size);
+
+  // Blocks freed on an in-order queue can be reused immediately
+  // by later operations on the same queue.
+  int* reused = sycl::malloc_async<int>(count, q);
+  BOOST_CHECK(reused == data);
+  BOOST_CHECK(pool.get_reserved_size() == reserved_size);
+  BOOST_CHECK(pool.get_used_size() >= initial_used_size + count * sizeof(int));
+
+  q.parallel_for(sycl::range{count}, [=](sycl::id<1> idx){
+    reused[idx] = 0;
+  });
+  sycl::free_async(reused, q);
+  q.wait();
+
+  pool.trim();
+  BOOST_CHECK(pool.get_reserved_size() == pool.get_used_size());
+
+  pool.set_release_threshold(0);
+  BOOST_CHECK(pool.get_release_threshold() == 0);
+}
+#endif
+
+#ifdef ACPP_EXT_COMMAND_GRAPH
+BOOST_AUTO_TEST_CASE(command_graph) {
+  using namespace cl;
+
+  auto run_test = [](sycl::queue q) {
+    const std::size_t size = 256;
+    int *data = sycl::malloc_shared<int>(size, q);
+    int *increment = sycl::malloc_shared<int>(1, q);
+    q.fill(data, 0, size).wait();
+
+    sycl::AdaptiveCpp_command_graph graph;
+    q.AdaptiveCpp_begin_recording(graph);
+    BOOST_CHECK(q.AdaptiveCpp_is_recording());
+
+    sycl::event add = q.parallel_for(sycl::range<1>{size}, [=](sycl::id<1> idx) {
+      data[idx] += *increment;
+    });
+    q.submit([&](sycl::handler &cgh) {
+      cgh.depends_on(add);
+      cgh.parallel_for(sycl::range<1>{size},
+                       [=](sycl::id<1> idx) { data[idx] *= 2; });
+    });
+
+    q.AdaptiveCpp_end_recording();
+    BOOST_CHECK(!q.AdaptiveCpp_is_recording());
+    BOOST_CHECK(graph.get_num_nodes() == 2);
+
+    // Nothing must have been executed during recording
+    q.wait();
+    for(std::size_t i = 0; i < size; ++i)
+      BOOST_REQUIRE(data[i] == 0);
+
+    sycl::AdaptiveCpp_executable_command_graph exec_graph = graph.finalize();
+    BOOST_CHECK(exec_graph.get_num_nodes() == 2);
+
+    int expected = 0;
+    for(int iteration = 0; iteration < 4; ++iteration) {
+      *increment = iteration;
+      q.AdaptiveCpp_execute_graph(exec_graph).wait();
+      expected = (expected + iteration) * 2;
+    }
+    for(std::size_t i = 0; i < size; ++i)
+      BOOST_REQUIRE(data[i] == expected);
+
+    // Graph execution must be ordered with regular submissions
+    *increment = 1;
+    q.parallel_for(sycl::range<1>{size}, [=](sycl::id<1> idx) {
+      data[idx] = 1;
+    });
+    q.AdaptiveCpp_execute_graph(exec_graph);
+    q.wait();
+    for(std::size_t i = 0; i < size; ++i)
+      BOOST_REQUIRE(data[i] == 4);
+
+    sycl::free(data, q);
+    sycl::free(increment, q);
+  };
+
+  run_test(sycl::queue{});
+  run_test(sycl::queue{sycl::property::queue::in_order{}});
+
+  sycl::queue q;
+  sycl::buffer<int> buff{sycl::range<1>{16}};
+  sycl::AdaptiveCpp_command_graph graph;
+  q.AdaptiveCpp_begin_recording(graph);
+  BOOST_CHECK_THROW(q.submit([&](sycl::handler &cgh) {
+    sycl::accessor acc{buff, cgh, sycl::no_init};
+    cgh.parallel_for(sycl::range<1>{16}, [=](sycl::id<1> idx) { acc[idx] = 0; });
+  }), sycl::exception);
+  q.AdaptiveCpp_end_recording();
+  BOOST_CHECK(graph.get_num_nodes() == 0);
+}
+
+#if defined(__ACPP_ENABLE_LLVM_SSCP_TARGET__) &&                               \
+    !defined(__ACPP_ENABLE_OMPHOST_TARGET__) &&                                \
+    !defined(__ACPP_ENABLE_CUDA_TARGET__) &&                                   \
+    !defined(__ACPP_ENABLE_HIP_TARGET__)
+BOOST_AUTO_TEST_CASE(command_graph_set_kernel_args) {
+  using namespace cl;
+
+  sycl::queue q{sycl::property::queue::in_order{}};
+  const std::size_t size = 256;
+  int *a = sycl::malloc_shared<int>(size, q);
+  int *b = sycl::malloc_shared<int>(size, q);
+  q.fill(a, 0, size);
+  q.fill(b, 0, size);
+  q.wait();
+
+  // All kernels created by this function have the same type
+  auto make_kernel = [](int *data, int value) {
+    return [=](sycl::id<1> idx) { data[idx] += value; };
+  };
+
+  sycl::AdaptiveCpp_command_graph graph;
+  q.AdaptiveCpp_begin_recording(graph);
+  sycl::event recorded =
+      q.parallel_for(sycl::range<1>{size}, make_kernel(a, 1));
+  q.AdaptiveCpp_end_recording();
+
+  sycl::AdaptiveCpp_executable_command_graph exec_graph = graph.finalize();
+
+  // Submit several executions with different arguments without waiting in
+  // between, such that updates overlap with executions in flight.
+  sycl::event e1 = q.AdaptiveCpp_execute_graph(exec_graph);
+  exec_graph.set_kernel_args(recorded, make_kernel(b, 2));
+  sycl::event e2 = q.AdaptiveCpp_execute_graph(exec_graph);
+  exec_graph.set_kernel_args(recorded, make_kernel(a, 3));
+  sycl::event e3 = q.AdaptiveCpp_execute_graph(exec_graph);
+  sycl::event::wait({e1, e2, e3});
+
+  for(std::size_t i = 0; i < size; ++i) {
+    BOOST_REQUIRE(a[i] == 4);
+    BOOST_REQUIRE(b[i] == 2);
+  }
+
+  // Kernels of a different type are rejected
+  BOOST_CHECK_THROW(exec_graph.set_kernel_args(
+                        recorded, [=](sycl::id<1> idx) { a[idx] = 0; }),
+                    sycl::exception);
+
+  sycl::free(a, q);
+  sycl::free(b, q);
+}
+#endif
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,142 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "hipSYCL/algorithms/algorithm.hpp"
+#include "sycl_test_suite.hpp"
+#include <boost/test/unit_test_suite.hpp>
+
+using namespace cl;
+namespace algorithms = hipsycl::algorithms;
+
+BOOST_FIXTURE_TEST_SUITE(histogram, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(histogram_even) {
+  sycl::queue q{sycl::property_list{sycl::property::queue::in_order{}}};
+  algorithms::util::allocation_cache cache{
+      algorithms::util::allocation_type::device};
+  algorithms::util::allocation_group scratch{
+      &cache, q.get_device().AdaptiveCpp_device_id()};
+
+  for(std::size_t n : {0, 10, 100000}) {
+    for(std::size_t num_bins : {1, 7, 256, 100000}) {
+      int *data = sycl::malloc_shared<int>(n + 1, q);
+      uint32_t *counts = sycl::malloc_shared<uint32_t>(num_bins, q);
+      // Includes values below and above the histogram range
+      for(std::size_t i = 0; i < n; ++i)
+        data[i] = static_cast<int>((i * 7919) % 1100) - 50;
+
+      algorithms::histogram_even(q, scratch, data, data + n, counts, num_bins,
+                                 0, 1000);
+      q.wait();
+
+      std::vector<uint32_t> expected(num_bins, 0);
+      for(std::size_t i = 0; i < n; ++i)
+        if(data[i] >= 0 && data[i] < 1000)
+          ++expected[static_cast<std::size_t>(data[i]) * num_bins / 1000];
+      for(std::size_t b = 0; b < num_bins; ++b)
+        BOOST_CHECK_EQUAL(counts[b], expected[b]);
+
+      sycl::free(data, q);
+      sycl::free(counts, q);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(histogram_even_full_int64_range) {
+  sycl::queue q{sycl::property_list{sycl::property::queue::in_order{}}};
+  algorithms::util::allocation_cache cache{
+      algorithms::util::allocation_type::device};
+  algorithms::util::allocation_group scratch{
+      &cache, q.get_device().AdaptiveCpp_device_id()};
+
+  const int64_t lower = std::numeric_limits<int64_t>::min();
+  const int64_t upper = std::numeric_limits<int64_t>::max();
+  const std::size_t n = 10000;
+
+  for(std::size_t num_bins : {1, 3, 256, 100000}) {
+    int64_t *data = sycl::malloc_shared<int64_t>(n, q);
+    uint32_t *counts = sycl::malloc_shared<uint32_t>(num_bins, q);
+    // Values spread across the entire range, including both ends
+    uint64_t x = 0x9e3779b97f4a7c15ull;
+    for(std::size_t i = 0; i < n; ++i) {
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+      data[i] = static_cast<int64_t>(x);
+    }
+    data[0] = lower;
+    data[1] = upper - 1;
+    data[2] = upper;
+
+    algorithms::histogram_even(q, scratch, data, data + n, counts, num_bins,
+                               lower, upper);
+    q.wait();
+
+    const unsigned __int128 width = static_cast<uint64_t>(upper) -
+                                    static_cast<uint64_t>(lower);
+    std::vector<uint32_t> expected(num_bins, 0);
+    for(std::size_t i = 0; i < n; ++i) {
+      if(data[i] == upper)
+        continue;
+      unsigned __int128 offset = static_cast<uint64_t>(data[i]) -
+                                 static_cast<uint64_t>(lower);
+      ++expected[static_cast<std::size_t>(offset * num_bins / width)];
+    }
+    for(std::size_t b = 0; b < num_bins; ++b)
+      BOOST_CHECK_EQUAL(counts[b], expected[b]);
+
+    sycl::free(data, q);
+    sycl::free(counts, q);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(histogram_range) {
+  sycl::queue q{sycl::property_list{sycl::property::queue::in_order{}}};
+  algorithms::util::allocation_cache cache{
+      algorithms::util::allocation_type::device};
+  algorithms::util::allocation_group scratch{
+      &cache, q.get_device().AdaptiveCpp_device_id()};
+
+  const std::size_t n = 50000;
+  std::vector<float> boundaries = {-1.0f, 0.0f, 0.5f, 0.75f, 10.0f};
+  const std::size_t num_bins = boundaries.size() - 1;
+
+  float *data = sycl::malloc_shared<float>(n, q);
+  float *boundary_data = sycl::malloc_shared<float>(boundaries.size(), q);
+  uint64_t *counts = sycl::malloc_shared<uint64_t>(num_bins, q);
+  std::copy(boundaries.begin(), boundaries.end(), boundary_data);
+  for(std::size_t i = 0; i < n; ++i)
+    data[i] = static_cast<float>(i % 1000) / 80.0f - 2.0f;
+
+  algorithms::histogram_range(q, scratch, data, data + n, counts, num_bins,
+                              boundary_data);
+  q.wait();
+
+  std::vector<uint64_t> expected(num_bins, 0);
+  for(std::size_t i = 0; i < n; ++i) {
+    auto it = std::upper_bound(boundaries.begin(), boundaries.end(), data[i]);
+    if(it != boundaries.begin() && it != boundaries.end())
+      ++expected[std::distance(boundaries.begin(), it) - 1];
+  }
+  for(std::size_t b = 0; b < num_bins; ++b)
+    BOOST_CHECK_EQUAL(counts[b], expected[b]);
+
+  sycl::free(data, q);
+  sycl::free(boundary_data, q);
+  sycl::free(counts, q);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -168,5 +168,46 @@ BOOST_AUTO_TEST_CASE(hierarchical_private_memory) {
 #endif // ACPP_LIBKERNEL_CUDA_NVCXX
 #endif // __ACPP_ENABLE_LLVM_SSCP_TARGET__
 
+#if defined(__ACPP_ENABLE_LLVM_SSCP_TARGET__) &&                               \
+    !defined(__ACPP_ENABLE_OMPHOST_TARGET__) &&                                \
+    !defined(__ACPP_ENABLE_CUDA_TARGET__) &&                                   \
+    !defined(__ACPP_ENABLE_HIP_TARGET__)
+// On the host, each JIT-compiled kernel is linked into the process as a
+// separate code object. Specializations of the same kernel define identical
+// symbols in different code objects, and all code objects are unloaded when
+// the runtime shuts down after the queue goes out of scope.
+BOOST_AUTO_TEST_CASE(load_and_unload_code_objects) {
+  namespace s = cl::sycl;
+  constexpr std::size_t size = 64;
+
+  for(int iteration = 0; iteration < 3; ++iteration) {
+    s::queue q{s::property::queue::in_order{}};
+    int* data = s::malloc_shared<int>(size, q);
+
+    q.parallel_for(s::range{size}, [=](s::id<1> idx){
+      data[idx] = static_cast<int>(idx[0]);
+    });
+    for(int offset = 1; offset <= 4; ++offset) {
+      s::specialized<int> spec_offset{offset + iteration};
+      q.parallel_for(s::range{size}, [=](s::id<1> idx){
+        data[idx] += spec_offset;
+      });
+    }
+    q.single_task([=](){
+      data[0] *= 2;
+    });
+    q.wait();
+
+    // 1 + 2 + 3 + 4 + 4 * iteration
+    const int expected_offset = 10 + 4 * iteration;
+    BOOST_CHECK(data[0] == 2 * expected_offset);
+    for(std::size_t i = 1; i < size; ++i)
+      BOOST_REQUIRE(data[i] == static_cast<int>(i) + expected_offset);
+
+    s::free(data, q);
+  }
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END() // NOTE: Make sure not to add anything below this
                             // line
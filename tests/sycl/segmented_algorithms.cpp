@@ -0,0 +1,187 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "hipSYCL/algorithms/numeric.hpp"
+#include "sycl_test_suite.hpp"
+#include <boost/test/unit_test_suite.hpp>
+
+using namespace cl;
+namespace algorithms = hipsycl::algorithms;
+
+namespace {
+
+// Segments of various sizes, including empty segments and segments
+// that span multiple work groups
+std::vector<std::size_t> make_offsets() {
+  std::vector<std::size_t> sizes = {0, 1, 7, 128, 129, 0, 1000, 3, 300};
+  std::vector<std::size_t> offsets{0};
+  for(std::size_t s : sizes)
+    offsets.push_back(offsets.back() + s);
+  return offsets;
+}
+
+std::vector<int> make_input(std::size_t n) {
+  std::vector<int> input(n);
+  for(std::size_t i = 0; i < n; ++i)
+    input[i] = static_cast<int>(i % 13) - 6;
+  return input;
+}
+
+struct maximum {
+  int operator()(int a, int b) const { return a > b ? a : b; }
+};
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(segmented_algorithms, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(segmented_reduce) {
+  sycl::queue q{sycl::property_list{sycl::property::queue::in_order{}}};
+  auto offsets = make_offsets();
+  auto input = make_input(offsets.back());
+  std::size_t num_segments = offsets.size() - 1;
+
+  int *data = sycl::malloc_shared<int>(input.size(), q);
+  std::size_t *segment_offsets =
+      sycl::malloc_shared<std::size_t>(offsets.size(), q);
+  int *sums = sycl::malloc_shared<int>(num_segments, q);
+  int *maxima = sycl::malloc_shared<int>(num_segments, q);
+  std::copy(input.begin(), input.end(), data);
+  std::copy(offsets.begin(), offsets.end(), segment_offsets);
+
+  algorithms::segmented_reduce(q, data, segment_offsets,
+                               segment_offsets + offsets.size(), sums, 10);
+  // No known identity
+  algorithms::segmented_reduce(q, data, segment_offsets,
+                               segment_offsets + offsets.size(), maxima, -100,
+                               maximum{});
+  q.wait();
+
+  for(std::size_t s = 0; s < num_segments; ++s) {
+    auto begin = input.begin() + offsets[s];
+    auto end = input.begin() + offsets[s + 1];
+    BOOST_CHECK_EQUAL(sums[s], std::accumulate(begin, end, 10));
+    BOOST_CHECK_EQUAL(maxima[s], std::accumulate(begin, end, -100, maximum{}));
+  }
+
+  sycl::free(data, q);
+  sycl::free(segment_offsets, q);
+  sycl::free(sums, q);
+  sycl::free(maxima, q);
+}
+
+BOOST_AUTO_TEST_CASE(segmented_scan) {
+  sycl::queue q{sycl::property_list{sycl::property::queue::in_order{}}};
+  auto offsets = make_offsets();
+  auto input = make_input(offsets.back());
+
+  int *data = sycl::malloc_shared<int>(input.size(), q);
+  std::size_t *segment_offsets =
+      sycl::malloc_shared<std::size_t>(offsets.size(), q);
+  int *inclusive = sycl::malloc_shared<int>(input.size(), q);
+  int *exclusive = sycl::malloc_shared<int>(input.size(), q);
+  std::copy(input.begin(), input.end(), data);
+  std::copy(offsets.begin(), offsets.end(), segment_offsets);
+
+  algorithms::segmented_inclusive_scan(q, data, segment_offsets,
+                                       segment_offsets + offsets.size(),
+                                       inclusive);
+  algorithms::segmented_exclusive_scan(q, data, segment_offsets,
+                                       segment_offsets + offsets.size(),
+                                       exclusive, 5);
+  q.wait();
+
+  std::vector<int> expected_inclusive(input.size());
+  std::vector<int> expected_exclusive(input.size());
+  for(std::size_t s = 0; s + 1 < offsets.size(); ++s) {
+    std::inclusive_scan(input.begin() + offsets[s],
+                        input.begin() + offsets[s + 1],
+                        expected_inclusive.begin() + offsets[s]);
+    std::exclusive_scan(input.begin() + offsets[s],
+                        input.begin() + offsets[s + 1],
+                        expected_exclusive.begin() + offsets[s], 5);
+  }
+  for(std::size_t i = 0; i < input.size(); ++i) {
+    BOOST_CHECK_EQUAL(inclusive[i], expected_inclusive[i]);
+    BOOST_CHECK_EQUAL(exclusive[i], expected_exclusive[i]);
+  }
+
+  sycl::free(data, q);
+  sycl::free(segment_offsets, q);
+  sycl::free(inclusive, q);
+  sycl::free(exclusive, q);
+}
+
+BOOST_AUTO_TEST_CASE(by_key) {
+  sycl::queue q{sycl::property_list{sycl::property::queue::in_order{}}};
+  algorithms::util::allocation_cache cache{
+      algorithms::util::allocation_type::device};
+  algorithms::util::allocation_group scratch{
+      &cache, q.get_device().AdaptiveCpp_device_id()};
+
+  for(std::size_t n : {0, 1, 100, 100000}) {
+    std::vector<int> keys(n);
+    for(std::size_t i = 0; i < n; ++i)
+      keys[i] = static_cast<int>((i / 7) % 3 + (i / 1000));
+    auto values = make_input(n);
+
+    int *key_data = sycl::malloc_shared<int>(n + 1, q);
+    int *value_data = sycl::malloc_shared<int>(n + 1, q);
+    int *keys_out = sycl::malloc_shared<int>(n + 1, q);
+    int *values_out = sycl::malloc_shared<int>(n + 1, q);
+    int *scanned = sycl::malloc_shared<int>(n + 1, q);
+    std::size_t *num_segments = sycl::malloc_shared<std::size_t>(1, q);
+    std::copy(keys.begin(), keys.end(), key_data);
+    std::copy(values.begin(), values.end(), value_data);
+
+    algorithms::reduce_by_key(q, scratch, key_data, key_data + n, value_data,
+                              keys_out, values_out, num_segments);
+    algorithms::inclusive_scan_by_key(q, scratch, key_data, key_data + n,
+                                      value_data, scanned);
+    q.wait();
+
+    std::vector<int> expected_keys;
+    std::vector<int> expected_values;
+    std::vector<int> expected_scan(n);
+    for(std::size_t i = 0; i < n; ++i) {
+      if(i == 0 || keys[i] != keys[i - 1]) {
+        expected_keys.push_back(keys[i]);
+        expected_values.push_back(values[i]);
+        expected_scan[i] = values[i];
+      } else {
+        expected_values.back() += values[i];
+        expected_scan[i] = expected_scan[i - 1] + values[i];
+      }
+    }
+
+    BOOST_REQUIRE_EQUAL(*num_segments, expected_keys.size());
+    for(std::size_t s = 0; s < expected_keys.size(); ++s) {
+      BOOST_CHECK_EQUAL(keys_out[s], expected_keys[s]);
+      BOOST_CHECK_EQUAL(values_out[s], expected_values[s]);
+    }
+    for(std::size_t i = 0; i < n; ++i)
+      BOOST_CHECK_EQUAL(scanned[i], expected_scan[i]);
+
+    sycl::free(key_data, q);
+    sycl::free(value_data, q);
+    sycl::free(keys_out, q);
+    sycl::free(values_out, q);
+    sycl::free(scanned, q);
+    sycl::free(num_segments, q);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
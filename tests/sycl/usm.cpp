@@ -420,5 +420,31 @@ BOOST_AUTO_TEST_CASE(prefetch) {
   
   sycl::free(shared_mem, q);
 }
+// Kernel arguments may alias pointers that the kernel loads from memory.
+// This must also hold for launches in which all pointer arguments point
+// into distinct allocations (see ACPP_JITOPT_NOALIAS_INFERENCE).
+BOOST_AUTO_TEST_CASE(argument_aliases_pointer_in_usm) {
+  sycl::queue q{sycl::property_list{sycl::property::queue::in_order{}}};
+
+  const std::size_t test_size = 1024;
+  int *data = sycl::malloc_shared<int>(test_size, q);
+  int **indirect = sycl::malloc_shared<int *>(1, q);
+  *indirect = data;
+
+  for(int launch = 0; launch < 3; ++launch) {
+    q.parallel_for(sycl::range<1>{test_size}, [=](sycl::id<1> idx) {
+      data[idx] = 1;
+      (*indirect)[idx] += 1;
+      data[idx] *= 3;
+    });
+  }
+  q.wait();
+
+  for (std::size_t i = 0; i < test_size; ++i)
+    BOOST_REQUIRE(data[i] == 6);
+
+  sycl::free(indirect, q);
+  sycl::free(data, q);
+}
 BOOST_AUTO_TEST_SUITE_END() // NOTE: Make sure not to add anything below this
                             // line